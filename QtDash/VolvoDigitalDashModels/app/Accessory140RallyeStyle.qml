@@ -39,7 +39,6 @@ Item {
                 item.imageResource = accGauge.imageSource
 
                 item.needleResource = "qrc:/needles/needle-rsport.png"
-                item.needleColor = "burlywood"
                 item.needleWidth = smallGaugeNeedleWidth240
                 item.needleLength = smallGaugeSize * accGauge.needleLength
                 item.needleOffset = smallGaugeSize * accGauge.needleOffset
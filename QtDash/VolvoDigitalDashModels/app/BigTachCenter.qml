@@ -22,6 +22,15 @@ Item {
 
         }
 
+        ShiftLight {
+            id: shiftLight
+            width: tachSize * 0.4
+            height: tachSize / 30
+            anchors.horizontalCenter: tachContainer.horizontalCenter
+            anchors.top: tachContainer.top
+            anchors.topMargin: tachSize * 0.22
+        }
+
         Rectangle {
             id: speedoContainer
             width: speedoSize
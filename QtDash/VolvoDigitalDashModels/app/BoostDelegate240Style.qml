@@ -22,8 +22,6 @@ Component {
 
             item.imageResource = "qrc:/accCluster/later-240-boost.png"
 
-            item.needleColor = "orange"
-
             item.needleWidth = smallGaugeNeedleWidth240
             item.needleLength = smallGaugeSize * 0.55
             item.needleOffset = smallGaugeSize * .25 / 2
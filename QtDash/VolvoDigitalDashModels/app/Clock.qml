@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
+import DigitalDash 1.0
 
 Item
 {
@@ -19,8 +20,11 @@ Item
 
     function timeChanged() {
         var date = new Date;
-        valueText.text = date.toLocaleTimeString();
         var hrLocal = parseInt(date.toTimeString().substring(0,2), 10);
+        // 12 hour readout -- glyphs only change when the digits do
+        var hr12 = hrLocal % 12 === 0 ? 12 : hrLocal % 12;
+        valueText.value = hr12 * 3600 + date.getMinutes() * 60 + date.getSeconds();
+        valueText.units = hrLocal < 12 ? "AM" : "PM";
         hours = hrLocal + date.getMinutes()/60;
         if(hours > 12) {
             hours -= 12.0;
@@ -31,17 +35,11 @@ Item
     }
 
     Timer {
-        interval: 250; running: true; repeat: true;
+        // stopped while hidden (a cached layout), catches up as soon as shown
+        interval: 250; running: clock.visible; repeat: true; triggeredOnStart: true
         onTriggered: clock.timeChanged()
     }
 
-    Behavior on seconds {
-        RotationAnimation {
-            duration: 250
-            direction: RotationAnimation.Shortest
-        }
-    }
-
     Gauge {
         id: secondHand
         anchors.fill: parent
@@ -69,7 +67,7 @@ Item
 
         needleCenterRadius: clock.needleCenterRadius
 
-        dir: RotationAnimation.Shortest
+        wrapAround: true
     }
 
     Gauge {
@@ -99,7 +97,7 @@ Item
 
         needleCenterRadius: clock.needleCenterRadius
 
-        dir: RotationAnimation.Shortest
+        wrapAround: true
     }
 
     Gauge {
@@ -129,24 +127,20 @@ Item
 
         needleCenterRadius: clock.needleCenterRadius
 
-        dir: RotationAnimation.Shortest
+        wrapAround: true
     }
 
-    Text {
+    DigitReadout {
         property int textSize: clock.height/8
         id: valueText
 
-        horizontalAlignment: Text.AlignHCenter
-        verticalAlignment: Text.AlignVCenter
-
         anchors.horizontalCenter: parent.horizontalCenter
         anchors.bottom: parent.bottom
         anchors.bottomMargin: -textSize
 
-        fontSizeMode: Text.Fit
         font.pixelSize: textSize
 
-        text: "--:--:--"
+        format: DigitReadout.Time
         color: "white"
     }
 }
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
+import DigitalDash 1.0
 
 Item
 {
@@ -35,21 +36,15 @@ Item
         minutes = date.getMinutes()
         seconds = date.getUTCSeconds();
         dateString = date.toTimeString();
-        valueText.text = date.toTimeString();
+        valueText.value = hrLocal * 3600 + date.getMinutes() * 60 + date.getSeconds();
     }
 
     Timer {
-        interval: 250; running: true; repeat: true;
+        // stopped while hidden (a cached layout), catches up as soon as shown
+        interval: 250; running: clockLarge.visible; repeat: true; triggeredOnStart: true
         onTriggered: clockLarge.timeChanged()
     }
 
-    Behavior on seconds {
-        RotationAnimation {
-            duration: 250
-            direction: RotationAnimation.Shortest
-        }
-    }
-
     Gauge {
         id: minuteHand
         anchors.fill: parent
@@ -73,7 +68,6 @@ Item
         imageResource: generation === "740" ? imageSource : ""
         needleResource: clockLarge.needleResource
 
-        needleColor: generation === "740" ? "red" : "orange"
 
         needleWidth: generation === "740" ? parent.width * 0.03 : parent.width * 0.015
         needleLength: generation === "740" ? parent.width * 0.525 : parent.width * 0.425
@@ -81,7 +75,7 @@ Item
 
         needleCenterRadius: generation === "740" ? 0.15: 0.10
 
-        dir: RotationAnimation.Shortest
+        wrapAround: true
     }
 
     Gauge {
@@ -108,7 +102,6 @@ Item
         imageResource: generation === "740" ? "" : imageSource
         needleResource: clockLarge.needleResource
 
-        needleColor: generation === "740" ? "red" : "orange"
 
         needleWidth: generation === "740" ? parent.width * 0.02 : parent.width * 0.015
         needleLength: generation === "740" ? parent.width * 0.525 : parent.width * 0.425
@@ -116,7 +109,7 @@ Item
 
         needleCenterRadius: generation === "740" ? 0.15: 0.10
 
-        dir: RotationAnimation.Shortest
+        wrapAround: true
     }
 
     Gauge {
@@ -141,7 +134,6 @@ Item
 
         imageResource: ""
 
-        needleColor: generation === "740" ? "red" : "orange"
         needleResource: clockLarge.needleResource
 
         needleWidth: generation === "740" ? parent.width * 0.035 : parent.width * 0.020
@@ -150,24 +142,20 @@ Item
 
         needleCenterRadius: generation === "740" ? 0.15: 0.10
 
-        dir: RotationAnimation.Shortest
+        wrapAround: true
     }
 
-    Text {
+    DigitReadout {
         property int textSize: clockLarge.height * 0.075
         id: valueText
 
-        horizontalAlignment: Text.AlignHCenter
-        verticalAlignment: Text.AlignVCenter
-
         anchors.horizontalCenter: parent.horizontalCenter
         anchors.verticalCenter: parent.verticalCenter
         anchors.verticalCenterOffset: generation === "740" ? (parent.height / 6.0) : (parent.height / 8.0)
 
-        fontSizeMode: Text.Fit
         font.pixelSize: textSize
 
-        text: "--:--:--"
+        format: DigitReadout.Time
         color: "white"
     }
 }
@@ -24,8 +24,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-r-sport/r_sport_coolant_fahrenhet.png"
             item.needleResource = "qrc:/needles/needle-rsport.png"
 
-            item.needleColor = "burlywood"
-
             item.needleWidth = smallGaugeSize * 0.035
             item.needleLength = smallGaugeSize * 0.65
             item.needleOffset = smallGaugeSize * 0.25 / 2
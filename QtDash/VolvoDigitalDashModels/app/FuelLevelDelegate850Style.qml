@@ -23,8 +23,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-850/850_fuel_level.png"
             item.needleResource = "qrc:/needles/needle-740-940.png"
 
-            item.needleColor = "red"
-
             item.needleWidth = smallGaugeSize * 0.05
             item.needleLength = smallGaugeSize * 0.50
             item.needleOffset = smallGaugeSize * .25 / 2
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
+import DigitalDash 1.0
 
 Item {
     id: gauge
@@ -8,10 +9,7 @@ Item {
     property int maxValue: 100
     property int minValue: 0
     property real value: 0
-    property real internalValue: clockwise ? value : (maxValue - (value - minValue))
-    property real angle: (internalValue <= initialValueOffset) ?
-                           (initialValueOffset - minValue) / (maxValue - minValue) * (maxAngle - minAngle) + minAngle :
-                           (internalValue - minValue) / (maxValue - minValue) * (maxAngle - minAngle) + minAngle;
+    property real angle: gaugeItem.angle
     property string units: "F"
     property int lowAlarm: 0
     property int highAlarm: 0
@@ -24,7 +22,6 @@ Item {
 
     property real needleWidth: parent.height * 0.03
     property real needleLength: parent.width * 0.6
-    property real needleTipRadius: needleWidth
     property real needleOffset: parent.height * .20
 
     property real needleCenterRadius: 0.15
@@ -32,8 +29,6 @@ Item {
     property string imageResource
     property string needleResource: "qrc:/needles/needle-240.png"
 
-    property color needleColor: "orange"
-
     property real textOffset:  parent.height / 2.0
     property real textXOffset: 0
     property real textSize: parent.height / 8
@@ -46,141 +41,82 @@ Item {
     property real topTextOffset: parent.height / 4.0
     property bool topValueEnabled: false
 
-    property real dir: RotationAnimation.Numerical
+    property bool wrapAround: false // full circle dial, the needle takes the short way round (clock hands)
 
     width: smallGaugeSize
     height: smallGaugeSize
 
-    function boundedAngle(angle, min, max) {
-        if (angle > max) {
-            angle = max;
-        } else if (angle < min) {
-            angle = min;
-        }
-
-        return angle;
-    }
-
-//    Behavior on angle {
-//        RotationAnimation {
-//            duration: 150
-//        }
-//    }
-
     Rectangle {
         anchors.fill: parent
         color: "transparent"
 
-        Image {
-            source: gauge.imageResource
-            cache: true
-            rotation: 0
+        // dial, needle center and needle in one scene graph item
+        GaugeItem {
+            id: gaugeItem
             anchors.fill: parent
-            mipmap: true
             z: -1
-        }
-
-        NeedleCenter {
-            id: needleCenter
-            size: needleCenterRadius * parent.width
-            x: parent.width / 2 + offsetX
-            y: parent.height / 2 + offset
-            antialiasing: true
-            smooth: true
-
-            transform: [
-                Rotation {
-                    angle: gauge.angle > gauge.maxAngle ?
-                               gauge.maxAngle : (gauge.angle < minAngle) ?
-                                   gauge.minAngle : gauge.angle
-                    origin.x: 0
-                    origin.y: 0
-
-                    Behavior on angle {
-                        RotationAnimation {
-                            duration: 150
-                            direction: gauge.dir
-                        }
-                    }
-                }
-            ]
-        }
 
-        Image {
-            id: needle
-
-            x: parent.width / 2 + offsetX
-            y: parent.height / 2 + offset
-            width: gauge.needleLength
-            height: gauge.needleWidth
-
-            antialiasing: true
-            smooth: true
-            source: needleResource
-
-            transform: [
-                Translate {
-                    y: -needle.height / 2
-                    x: -needleOffset
-                },
-
-                Rotation {
-                    angle: gauge.angle > gauge.maxAngle ?
-                               gauge.maxAngle : (gauge.angle < minAngle) ?
-                                   gauge.minAngle : gauge.angle
-                    origin.x: 0
-                    origin.y: 0
-
-                    Behavior on angle {
-                        RotationAnimation {
-                            duration: 150
-                            direction: gauge.dir
-                        }
-                    }
-                }
-            ]
+            value: gauge.value
+            minValue: gauge.minValue
+            maxValue: gauge.maxValue
+            minAngle: gauge.minAngle
+            maxAngle: gauge.maxAngle
+            initialValueOffset: gauge.initialValueOffset
+            clockwise: gauge.clockwise
+            wrapAround: gauge.wrapAround
+
+            dialSource: gauge.imageResource
+            needleSource: gauge.needleResource
+            pivotX: width / 2 + gauge.offsetX
+            pivotY: height / 2 + gauge.offset
+            needleLength: gauge.needleLength
+            needleWidth: gauge.needleWidth
+            needleOffset: gauge.needleOffset
+            centerSize: gauge.needleCenterRadius * width
+
+            lowAlarm: gauge.lowAlarm
+            highAlarm: gauge.highAlarm
         }
 
-        Text {
+        DigitReadout {
 
             id: valueText
             z: 10
             visible: textEnabled
 
-            horizontalAlignment: Text.AlignHCenter
-            verticalAlignment: Text.AlignVCenter
-
             anchors.horizontalCenter: parent.horizontalCenter
             anchors.horizontalCenterOffset: gauge.textXOffset
             anchors.verticalCenter: parent.verticalCenter
             anchors.verticalCenterOffset: gauge.textOffset
 
-            fontSizeMode: Text.Fit
+            // shrink values wider than the dial, like Text.Fit did
+            width: parent.width
+            fit: true
             font.pixelSize: gauge.textSize
 
-            text: Number(gauge.value).toFixed(significantDigits).toLocaleString(Qt.locale("en_US")) + " " + units
-            color: ( (gauge.value < gauge.lowAlarm)  || (gauge.value > gauge.highAlarm))
-                   ? "#ff7011" : "white"
+            value: gauge.value
+            decimals: gauge.significantDigits
+            units: gauge.units
+            color: gaugeItem.alarm ? "#ff7011" : "white"
         }
 
-        Text {
+        DigitReadout {
 
             id: topValueText
 
             visible: topValueEnabled
 
-            horizontalAlignment: Text.AlignHCenter
-            verticalAlignment: Text.AlignVCenter
-            anchors.horizontalCenterOffset: 0
-
             anchors.horizontalCenter: parent.horizontalCenter
             anchors.verticalCenter: parent.verticalCenter
             anchors.verticalCenterOffset: gauge.topTextOffset
 
-            fontSizeMode: Text.Fit
+            width: parent.width
+            fit: true
             font.pixelSize: gauge.topTextSize
 
-            text: Number(gauge.topValue).toFixed(1).toLocaleString(Qt.locale("en_US")) + " " + gauge.topUnits
+            value: gauge.topValue
+            decimals: 1
+            units: gauge.topUnits
             color: "white"
         }
     }
@@ -69,7 +69,8 @@ Item {
 
         contentItem: Rectangle {
             id: bar
-            width: control.visualPosition > 0.0 ? control.visualPosition * parent.width : 0.0
+            // whole pixels -- sub pixel noise doesn't restart the animation
+            width: control.visualPosition > 0.0 ? Math.round(control.visualPosition * parent.width) : 0.0
             antialiasing: true
             smooth: true
             height: parent.height
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
+import DigitalDash 1.0
 
 Item {
     id: odometer
@@ -37,21 +38,45 @@ Item {
             color: "white"
         }
 
-        Text {
+        // one readout per line of labelText
+        Column {
             id: valueText
 
             visible: textEnabled
-
-            horizontalAlignment: Text.AlignRight
-            verticalAlignment: Text.AlignVCenter
-
             anchors.fill: parent
 
-            fontSizeMode: Text.Fit
-            font.pixelSize: odometer.textSize
-
-            text: odometerValue.toFixed(significantDigits) + "\n" + tripAValue.toFixed(significantDigits) + "\n" + tripBValue.toFixed(significantDigits)
-            color: "white"
+            DigitReadout {
+                width: parent.width
+                height: parent.height / 3
+                fit: true
+                horizontalAlignment: Qt.AlignRight
+                font.pixelSize: odometer.textSize
+                value: odometer.odometerValue
+                decimals: significantDigits
+                color: "white"
+            }
+
+            DigitReadout {
+                width: parent.width
+                height: parent.height / 3
+                fit: true
+                horizontalAlignment: Qt.AlignRight
+                font.pixelSize: odometer.textSize
+                value: odometer.tripAValue
+                decimals: significantDigits
+                color: "white"
+            }
+
+            DigitReadout {
+                width: parent.width
+                height: parent.height / 3
+                fit: true
+                horizontalAlignment: Qt.AlignRight
+                font.pixelSize: odometer.textSize
+                value: odometer.tripBValue
+                decimals: significantDigits
+                color: "white"
+            }
         }
     }
 
@@ -22,8 +22,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-740-940/740_oil_pressure.png"
             item.needleResource = "qrc:/needles/needle-740-940.png"
 
-            item.needleColor = "red"
-
             item.needleWidth = smallGaugeSize * 0.05
             item.needleLength = smallGaugeSize * 0.75
             item.needleOffset = smallGaugeSize * 0.25 / 2
@@ -21,8 +21,6 @@ Component {
 
             item.imageResource = "qrc:/accCluster/later-240-oil-temp.png"
 
-            item.needleColor = "orange"
-
             item.needleWidth = smallGaugeNeedleWidth240
             item.needleLength = smallGaugeSize * 0.7
             item.needleOffset = smallGaugeSize * .125
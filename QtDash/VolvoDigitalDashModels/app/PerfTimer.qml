@@ -0,0 +1,89 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+
+Item {
+    id: perfTimer
+
+    property real textSize: height / 9.0
+
+    width: parent.width
+    height: parent.height
+
+    function formatSeconds(seconds) {
+        return isNaN(seconds) ? "--.--" : seconds.toFixed(2);
+    }
+
+    function formatLap(seconds) {
+        if (isNaN(seconds)) {
+            return "-:--.---";
+        }
+        var minutes = Math.floor(seconds / 60);
+        var rest = seconds - minutes * 60;
+        return minutes + ":" + (rest < 10 ? "0" : "") + rest.toFixed(3);
+    }
+
+    function stateText(state) {
+        switch (state) {
+        case 1:
+            return "READY";
+        case 2:
+            return "TIMING";
+        default:
+            return "";
+        }
+    }
+
+    Column {
+        anchors.fill: parent
+
+        Text {
+            width: parent.width
+            height: perfTimer.textSize * 1.2
+            horizontalAlignment: Text.AlignHCenter
+            font.pixelSize: perfTimer.textSize
+            text: stateText(perfTimerModel.runState)
+            color: perfTimerModel.runState == 2 ? "orange" : "white"
+        }
+
+        // one row per run target: name, time, speed at the target
+        Repeater {
+            model: perfTimerModel
+
+            Item {
+                width: perfTimer.width
+                height: perfTimer.textSize * 1.2
+
+                Text {
+                    anchors.left: parent.left
+                    font.pixelSize: perfTimer.textSize
+                    text: name
+                    color: "white"
+                }
+
+                Text {
+                    anchors.right: parent.right
+                    font.pixelSize: perfTimer.textSize
+                    text: formatSeconds(seconds) + "s" +
+                          (isNaN(speed) ? "" : " @ " + speed.toFixed(0) + " " + perfTimerModel.speedUnits)
+                    color: "white"
+                }
+            }
+        }
+
+        Text {
+            width: parent.width
+            height: perfTimer.textSize * 1.2
+            font.pixelSize: perfTimer.textSize
+            text: "Lap " + perfTimerModel.lapCount + ": " + formatLap(perfTimerModel.lastLap)
+            color: "white"
+        }
+
+        Text {
+            width: parent.width
+            height: perfTimer.textSize * 1.2
+            font.pixelSize: perfTimer.textSize
+            text: "Best: " + formatLap(perfTimerModel.bestLap)
+            color: "white"
+        }
+    }
+}
@@ -0,0 +1,25 @@
+import QtQuick 2.15
+
+Component {
+    id: perfTimerDelegate
+    Loader {
+        source: "qrc:/PerfTimer.qml"
+        asynchronous: true
+        onLoaded: {
+            item.height = smallGaugeSize
+            item.width = smallGaugeSize
+        }
+
+        Binding {
+            target: item
+            property: "width"
+            value: smallGaugeSize
+        }
+
+        Binding {
+            target: item
+            property: "height"
+            value: smallGaugeSize
+        }
+    }
+}
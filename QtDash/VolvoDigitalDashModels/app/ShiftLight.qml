@@ -0,0 +1,52 @@
+import QtQuick 2.15
+
+Item {
+    id: shiftLight
+
+    property int stage: shiftLightModel.stage
+    property int stages: shiftLightModel.stages
+    property bool shiftNow: stages > 0 && stage >= stages
+    property real segmentSpacing: 6
+
+    width: parent.width
+    height: parent.height
+
+    // green, then yellow, then red for the last stages
+    function segmentColor(index) {
+        var position = (index + 1) / stages;
+        if (position > 0.8) {
+            return "red";
+        } else if (position > 0.5) {
+            return "yellow";
+        }
+        return "lime";
+    }
+
+    Row {
+        anchors.centerIn: parent
+        spacing: segmentSpacing
+
+        Repeater {
+            model: stages
+
+            Rectangle {
+                width: (shiftLight.width - (stages - 1) * segmentSpacing) / Math.max(stages, 1)
+                height: shiftLight.height
+                radius: height / 4
+                color: index < stage ? segmentColor(index) : "#202020"
+                opacity: shiftNow && blink.off ? 0.2 : 1.0
+            }
+        }
+    }
+
+    // all stages lit: flash them until the shift
+    Timer {
+        id: blink
+        property bool off: false
+        interval: 80
+        repeat: true
+        running: shiftNow
+        onTriggered: off = !off
+        onRunningChanged: off = false
+    }
+}
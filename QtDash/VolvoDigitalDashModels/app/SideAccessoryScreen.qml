@@ -96,6 +96,9 @@ Window {
         },
         VoltmeterDelegate740Style {
             id: voltMeterDelegate740
+        },
+        PerfTimerDelegate {
+            id: perfTimerDelegate740
         }
     ]
 
@@ -119,6 +122,9 @@ Window {
         ListElement {
             name: "voltmeter"
         }
+        ListElement {
+            name: "performance"
+        }
     }
 
     // 240 gauges
@@ -137,6 +143,9 @@ Window {
         },
         ClockDelegate240Style {
             id: clockDelegate240Style
+        },
+        PerfTimerDelegate {
+            id: perfTimerDelegate240
         }
     ]
     ListModel {
@@ -156,6 +165,9 @@ Window {
         ListElement {
             name: "clock"
         }
+        ListElement {
+            name: "performance"
+        }
     }
 
     //p1800 gauges
@@ -174,6 +186,9 @@ Window {
         },
         ClockDelegateP1800Style {
             id: clockDelegateP1800Style
+        },
+        PerfTimerDelegate {
+            id: perfTimerDelegateP1800
         }
     ]
 
@@ -194,6 +209,9 @@ Window {
         ListElement {
             name: "clock"
         }
+        ListElement {
+            name: "performance"
+        }
     }
 
     // R-sport gauges
@@ -212,6 +230,9 @@ Window {
         },
         VoltmeterDelegateRSportStyle {
             id: voltmeterDelegateRSportStyle
+        },
+        PerfTimerDelegate {
+            id: perfTimerDelegateRSport
         }
     ]
 
@@ -232,6 +253,9 @@ Window {
         ListElement {
             name: "voltmeter"
         }
+        ListElement {
+            name: "performance"
+        }
     }
 
     // 140 Rallye gauges
@@ -280,6 +304,10 @@ Window {
             significatDigits: 2
 
             imageSource: "qrc:/gauge-faces-140-rallye/140-rallye-voltmeter.png"
+        },
+        Item {
+            id: perfTimerDelegate140Rallye
+            property Component component: PerfTimerDelegate {}
         }
     ]
 
@@ -300,6 +328,9 @@ Window {
         ListElement {
             name: "voltmeter"
         }
+        ListElement {
+            name: "performance"
+        }
     }
 }
 
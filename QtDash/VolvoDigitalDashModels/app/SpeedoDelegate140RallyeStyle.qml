@@ -30,7 +30,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-140-rallye/140-rallye-speedo.png"
 
             item.needleResource = "qrc:/needles/needle-rsport.png"
-            item.needleColor = "burlywood"
 
             item.needleWidth = speedoSize * 0.02
             item.needleLength = speedoSize * 0.5
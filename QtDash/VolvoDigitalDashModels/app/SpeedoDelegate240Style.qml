@@ -29,8 +29,6 @@ Component {
 
             item.imageResource = "qrc:/mainCluster/later-240-speedo.png"
 
-            item.needleColor = "orange"
-
             item.needleWidth = speedoSize * 0.02
             item.needleLength = speedoSize * 0.45
             item.needleOffset = speedoSize * 0.15 / 2
@@ -31,8 +31,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-740-940/740_speedo.png"
             item.needleResource = "qrc:/needles/needle-740-940.png"
 
-            item.needleColor = "red"
-
             item.needleWidth = speedoSize * 0.0325
             item.needleLength = speedoSize * 0.45
             item.needleOffset = speedoSize * 0.15 / 2
@@ -30,7 +30,6 @@ Component {
             item.imageResource = "qrc:/gauges-early-240/early-240-speedo-with-border.png"
 
             item.needleResource = "qrc:/needles/needle-rsport.png"
-            item.needleColor = "burlywood"
 
             item.needleWidth = speedoSize * 0.02
             item.needleLength = speedoSize * 0.45
@@ -30,8 +30,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-r-sport/r_sport_speedo_mph.png"
             item.needleResource = "qrc:/needles/needle-rsport.png"
 
-            item.needleColor = "burlywood"
-
             item.needleWidth = speedoSize * 0.025
             item.needleLength = speedoSize * 0.525
             item.needleOffset = speedoSize * 0.2 / 2
@@ -24,7 +24,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-140-rallye/140-rallye-tach.png"
 
             item.needleResource = "qrc:/needles/needle-rsport.png"
-            item.needleColor = "burlywood"
 
             item.needleWidth = tachSize * 0.02
             item.needleLength = tachSize * 0.5
@@ -24,8 +24,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-p1800/tach-p1800.png"
             item.needleResource = "qrc:/needles/needle-rsport.png"
 
-            item.needleColor = "burlywood"
-
             item.needleWidth = item.width * 0.025
             item.needleLength = item.width * 0.375
             item.needleOffset = 0
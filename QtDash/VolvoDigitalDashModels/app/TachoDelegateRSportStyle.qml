@@ -24,8 +24,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-r-sport/r_sport_tachometer.png"
             item.needleResource = "qrc:/needles/needle-rsport.png"
 
-            item.needleColor = "burlywood"
-
             item.needleWidth = tachSize * 0.025
             item.needleLength = tachSize * 0.525
             item.needleOffset = tachSize * 0.2 / 2
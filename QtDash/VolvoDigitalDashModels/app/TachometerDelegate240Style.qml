@@ -23,8 +23,6 @@ Component {
 
             item.imageResource = "qrc:/mainCluster/later-240-tacho.png"
 
-            item.needleColor = "orange"
-
             item.needleWidth = tachSize * 0.02
             item.needleLength = tachSize * 0.45
             item.needleOffset = tachSize * 0.15 / 2
@@ -23,8 +23,6 @@ Component {
             item.imageResource = "qrc:/gauge-faces-740-940/740_tach.png"
             item.needleResource = "qrc:/needles/needle-740-940.png"
 
-            item.needleColor = "red"
-
             item.needleWidth = tachSize * 0.035
             item.needleLength = tachSize * 0.45
             item.needleOffset = tachSize * 0.15 / 2
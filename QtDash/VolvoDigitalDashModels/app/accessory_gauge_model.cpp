@@ -19,6 +19,7 @@ QHash<int, QByteArray> AccessoryGaugeModel::roleNames() const
     roles[AccessoryGaugeRoles::UnitsRole] = "gaugeUnits";
     roles[AccessoryGaugeRoles::LowAlarmRole] = "gaugeLowAlarm";
     roles[AccessoryGaugeRoles::HighAlarmRole] = "gaugeHighAlarm";
+    roles[AccessoryGaugeRoles::FaultRole] = "gaugeFault";
     return roles;
 }
 
@@ -48,6 +49,10 @@ QVariant AccessoryGaugeModel::headerData(int section, Qt::Orientation orientatio
     {
         return QVariant("gaugeHighAlarm");
     }
+    else if(role == AccessoryGaugeRoles::FaultRole)
+    {
+        return QVariant("gaugeFault");
+    }
     return QVariant("");
 }
 
@@ -82,6 +87,10 @@ QVariant AccessoryGaugeModel::data(const QModelIndex &index, int role) const
     {
         return mHighAlarm;
     }
+    else if(role == AccessoryGaugeRoles::FaultRole)
+    {
+        return mFault;
+    }
     // Default return:
     return mCurrentValue;
 }
@@ -136,6 +145,10 @@ bool AccessoryGaugeModel::setData(const QModelIndex &index, const QVariant &valu
                          QVector<int>() << AccessoryGaugeRoles::HighAlarmRole);
         emit highAlarmChanged();
     }
+    else if(role == AccessoryGaugeRoles::FaultRole)
+    {
+        setFault(value.toString());
+    }
     else
     {
         emit layoutChanged();
@@ -178,6 +191,11 @@ qreal AccessoryGaugeModel::highAlarm()
     return mHighAlarm;
 }
 
+QString AccessoryGaugeModel::fault()
+{
+    return mFault;
+}
+
 void AccessoryGaugeModel::setMinValue(qreal minValue)
 {
     mMinValue = minValue;
@@ -231,3 +249,15 @@ void AccessoryGaugeModel::setHighAlarm(qreal highAlarm)
                      QVector<int>() << AccessoryGaugeRoles::HighAlarmRole);
     emit highAlarmChanged();
 }
+
+void AccessoryGaugeModel::setFault(QString fault)
+{
+    if (fault == mFault) {
+        return;
+    }
+    mFault = fault;
+    emit dataChanged(createIndex(0,0),
+                     createIndex(1, 0),
+                     QVector<int>() << AccessoryGaugeRoles::FaultRole);
+    emit faultChanged();
+}
@@ -13,6 +13,7 @@ class AccessoryGaugeModel : public QAbstractListModel
     Q_PROPERTY(QString units READ units WRITE setUnits NOTIFY unitsChanged)
     Q_PROPERTY(qreal lowAlarm READ lowAlarm WRITE setLowAlarm NOTIFY lowAlarmChanged)
     Q_PROPERTY(qreal highAlarm READ highAlarm WRITE setHighAlarm NOTIFY highAlarmChanged)
+    Q_PROPERTY(QString fault READ fault WRITE setFault NOTIFY faultChanged)
 
 public:
     static constexpr char COOLANT_TEMP_MODEL_NAME[] = "coolantTempModel";
@@ -29,6 +30,7 @@ public:
         UnitsRole           = Qt::UserRole + 4,
         LowAlarmRole        = Qt::UserRole + 5,
         HighAlarmRole       = Qt::UserRole + 6,
+        FaultRole           = Qt::UserRole + 7,
     };
 
     explicit AccessoryGaugeModel(QObject *parent = nullptr);
@@ -91,6 +93,7 @@ public:
     QString units();
     qreal lowAlarm();
     qreal highAlarm();
+    QString fault();
 
 private:
     qreal mMinValue;
@@ -99,6 +102,7 @@ private:
     QString mUnits;
     qreal mLowAlarm;
     qreal mHighAlarm;
+    QString mFault; //!< sensor fault, empty while the sensor is healthy
 
 signals:
     void minValueChanged();
@@ -107,6 +111,7 @@ signals:
     void unitsChanged();
     void lowAlarmChanged();
     void highAlarmChanged();
+    void faultChanged();
 
 public slots:
     void setMinValue(qreal minValue);
@@ -115,6 +120,7 @@ public slots:
     void setUnits(QString units);
     void setLowAlarm(qreal lowAlarm);
     void setHighAlarm(qreal highAlarm);
+    void setFault(QString fault);
 
 };
 
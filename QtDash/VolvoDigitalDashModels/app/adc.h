@@ -169,6 +169,11 @@ private:
      * @return path to the device if found. empty string if not found
      */
     std::string findDevicePath(std::string& path, std::string name) {
+        // no iio subsystem (desktop/benchmark builds) -- nothing to search
+        if (!std::filesystem::is_directory(path)) {
+            return "";
+        }
+
         for (auto& device : std::filesystem::directory_iterator(path)) {
             if (std::filesystem::is_directory(device.path())) {
                 std::cout << device << std::endl;
@@ -0,0 +1,295 @@
+#ifndef ALARM_ENGINE_H
+#define ALARM_ENGINE_H
+
+#include <QDebug>
+#include <QMap>
+#include <QObject>
+#include <QVector>
+#include <QtMath>
+
+#include <channel_expression.h>
+#include <config.h>
+#include <sensor.h>
+#include <sensor_health.h>
+
+/**
+ * @brief Alarm rules over the sensor channels, e.g. low oil pressure while
+ * the engine is revving, or coolant temperature climbing fast. Each rule is
+ * a condition expression (see @ref ChannelExpression) over the same channels
+ * as the derived channels, plus each channel's rate of change per second as
+ * "<name>_rate".
+ *
+ * An alarm triggers once its condition has held for its delay, and clears
+ * when its clear expression is true -- or its condition is false when it has
+ * none -- so a threshold can have hysteresis. Rules are evaluated on a timer,
+ * and only the transitions are signalled, so the lights and the buzzer
+ * aren't touched while nothing changes.
+ *
+ * A channel whose sensor reports a fault has no value, rather than the last
+ * good one, until the sensor recovers -- rules reading it are skipped.
+ */
+class AlarmEngine : public QObject {
+    Q_OBJECT
+public:
+    static constexpr char RATE_SUFFIX[] = "_rate"; //!< suffix of a channel's rate of change input
+    static constexpr qint64 RATE_WINDOW_MSEC = 500; //!< rates are taken over at least this long
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     */
+    AlarmEngine(QObject * parent) : QObject(parent) {
+    }
+
+    /**
+     * @brief Add a sensor rules can read, and its rate of change
+     * @param name: channel name in expressions
+     * @param sensor: sensor, its filtered full rate samples and its health are read
+     */
+    void addInput(QString name, Sensor * sensor) {
+        int index = addInput(name);
+        QObject::connect(sensor, &Sensor::sampleReady, this, [this, index](qreal value) {
+            setInput(index, value, SensorHealth::nowMsec());
+        });
+        QObject::connect(sensor, &Sensor::healthChanged, this, [this, index](int status) {
+            setHealthy(index, (SensorHealth::Status) status == SensorHealth::Status::OK);
+        });
+    }
+
+    /**
+     * @brief Add a channel rules can read, and its rate of change
+     * @param name: channel name in expressions
+     * @return input index for @ref setInput
+     */
+    int addInput(QString name) {
+        Input_t input;
+        input.value = addInputSlot(name);
+        input.rate = addInputSlot(name + RATE_SUFFIX);
+        mChannels.append(input);
+        return mChannels.size() - 1;
+    }
+
+    /**
+     * @brief Compile an alarm rule -- after the inputs are added
+     * @param config: rule config
+     * @return true if the rule compiled
+     */
+    bool addAlarm(Config::AlarmConfig_t config) {
+        Alarm_t alarm;
+        alarm.config = config;
+        if (!alarm.condition.compile(config.expression, mInputNames)) {
+            qDebug() << "Invalid alarm " << config.name << ": " << alarm.condition.getError();
+            return false;
+        }
+        if (!config.clear.isEmpty() && !alarm.clear.compile(config.clear, mInputNames)) {
+            qDebug() << "Invalid alarm clear " << config.name << ": " << alarm.clear.getError();
+            return false;
+        }
+
+        alarm.inputs = alarm.condition.getInputs();
+        for (int input : alarm.clear.getInputs()) {
+            if (!alarm.inputs.contains(input)) {
+                alarm.inputs.append(input);
+            }
+        }
+        mAlarms.append(alarm);
+        return true;
+    }
+
+    int getNumAlarms() const {
+        return mAlarms.size();
+    }
+
+    /**
+     * @brief Check whether an alarm is on
+     * @param name: alarm name
+     * @return true if on
+     */
+    bool isActive(QString name) const {
+        for (const Alarm_t & alarm : mAlarms) {
+            if (alarm.config.name == name) {
+                return alarm.active;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Update a channel
+     * @param input: input index from @ref addInput
+     * @param value: channel value, ignored while the channel is faulted
+     * @param msec: monotonic time of the sample
+     */
+    void setInput(int input, qreal value, qint64 msec) {
+        Input_t & channel = mChannels[input];
+        if (!channel.healthy) {
+            return;
+        }
+        mInputs[channel.value] = value;
+
+        if (channel.anchorMsec < 0 || qIsNaN(channel.anchorValue)) {
+            channel.anchorValue = value;
+            channel.anchorMsec = msec;
+        } else if (msec - channel.anchorMsec >= RATE_WINDOW_MSEC) {
+            mInputs[channel.rate] = (value - channel.anchorValue) * 1000.0 / (msec - channel.anchorMsec);
+            channel.anchorValue = value;
+            channel.anchorMsec = msec;
+        }
+    }
+
+    /**
+     * @brief Report a channel's sensor health -- a faulted channel and its rate
+     * have no value until the sensor recovers and samples again
+     * @param input: input index from @ref addInput
+     * @param healthy: false if the sensor reports a fault
+     */
+    void setHealthy(int input, bool healthy) {
+        Input_t & channel = mChannels[input];
+        channel.healthy = healthy;
+        if (!healthy) {
+            mInputs[channel.value] = qQNaN();
+            mInputs[channel.rate] = qQNaN();
+            channel.anchorValue = qQNaN();
+            channel.anchorMsec = -1;
+        }
+    }
+
+    /**
+     * @brief Evaluate every rule, signalling the alarms that changed
+     * @param msec: monotonic time
+     */
+    void evaluate(qint64 msec) {
+        for (Alarm_t & alarm : mAlarms) {
+            if (!hasInputs(alarm)) {
+                // keep the state until every channel the rule reads has a value,
+                // but a pending delay has to start over
+                alarm.sinceMsec = -1;
+                continue;
+            }
+
+            if (alarm.active) {
+                bool cleared = alarm.clear.isValid() ?
+                            alarm.clear.evaluate(mInputs.constData()) != 0 :
+                            alarm.condition.evaluate(mInputs.constData()) == 0;
+                if (cleared) {
+                    setActive(alarm, false);
+                }
+            } else if (alarm.condition.evaluate(mInputs.constData()) != 0) {
+                if (alarm.sinceMsec < 0) {
+                    alarm.sinceMsec = msec;
+                }
+                if (msec - alarm.sinceMsec >= alarm.config.delayMsec) {
+                    setActive(alarm, true);
+                }
+            } else {
+                alarm.sinceMsec = -1;
+            }
+        }
+    }
+
+signals:
+    /**
+     * @brief An alarm turned on or off
+     * @param name: alarm name
+     * @param active: true if on
+     */
+    void alarmChanged(QString name, bool active);
+
+    /**
+     * @brief A warning light's alarms turned it on, or all went off
+     * @param light: warning light model name
+     * @param on: true if any of its alarms is on
+     */
+    void lightChanged(QString light, bool on);
+
+    /**
+     * @brief The first buzzer alarm turned on, or the last went off
+     * @param on: true if any buzzer alarm is on
+     */
+    void buzzerChanged(bool on);
+
+public slots:
+    /**
+     * @brief Evaluate every rule now
+     */
+    void update() {
+        evaluate(SensorHealth::nowMsec());
+    }
+
+private:
+    /**
+     * @brief A channel and the anchor its rate is measured from
+     */
+    typedef struct Input {
+        int value = -1; //!< input slot of the value
+        int rate = -1; //!< input slot of the rate of change
+        qreal anchorValue = qQNaN(); //!< value at the start of the rate window
+        qint64 anchorMsec = -1; //!< start of the rate window
+        bool healthy = true; //!< sensor reports no fault
+    } Input_t;
+
+    /**
+     * @brief A compiled alarm rule
+     */
+    typedef struct Alarm {
+        Config::AlarmConfig_t config; //!< rule config
+        ChannelExpression condition; //!< triggers the alarm
+        ChannelExpression clear; //!< clears the alarm, invalid to clear on !condition
+        QVector<int> inputs; //!< inputs the expressions read
+        qint64 sinceMsec = -1; //!< when the condition started holding, -1 if it isn't
+        bool active = false; //!< alarm is on
+    } Alarm_t;
+
+    QStringList mInputNames; //!< input names, in expression variable order
+    QVector<qreal> mInputs; //!< latest input values, NaN until the first sample
+    QVector<Input_t> mChannels; //!< channels by input index
+    QVector<Alarm_t> mAlarms; //!< alarm rules
+    QMap<QString, int> mLightCounts; //!< alarms on, by warning light
+    int mBuzzerCount = 0; //!< buzzer alarms on
+
+    int addInputSlot(QString name) {
+        mInputNames.append(name);
+        mInputs.append(qQNaN());
+        return mInputs.size() - 1;
+    }
+
+    bool hasInputs(const Alarm_t & alarm) const {
+        for (int input : alarm.inputs) {
+            if (qIsNaN(mInputs.at(input))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Turn an alarm on or off and pass it on to its light and the buzzer
+     * @param alarm: alarm
+     * @param active: true to turn it on
+     */
+    void setActive(Alarm_t & alarm, bool active) {
+        alarm.active = active;
+        alarm.sinceMsec = -1;
+        int step = active ? 1 : -1;
+        qDebug() << "Alarm " << alarm.config.name << (active ? "on" : "off");
+        emit alarmChanged(alarm.config.name, active);
+
+        QString light = alarm.config.light;
+        if (!light.isEmpty()) {
+            int count = mLightCounts.value(light, 0) + step;
+            mLightCounts.insert(light, count);
+            if (count == (active ? 1 : 0)) {
+                emit lightChanged(light, active);
+            }
+        }
+
+        if (alarm.config.buzzer) {
+            mBuzzerCount += step;
+            if (mBuzzerCount == (active ? 1 : 0)) {
+                emit buzzerChanged(active);
+            }
+        }
+    }
+};
+
+#endif // ALARM_ENGINE_H
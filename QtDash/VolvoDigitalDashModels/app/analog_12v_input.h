@@ -22,7 +22,9 @@ public:
         // check if we need to fit data to determine k3
         if (mConfig.order == 1) {
             // we've been supplied with fit data, calculate K3 and offset based on inputs
-            mConfig.coeff = SensorUtils::polynomialRegression(mConfig.x, mConfig.y, mConfig.order);
+            if (mConfig.coeff.size() != mConfig.order + 1) {
+                mConfig.coeff = SensorUtils::polynomialRegression(mConfig.x, mConfig.y, mConfig.order);
+            }
             mConfig.gainK3 = mConfig.coeff.at(1) / (mConfig.optoR2 / mConfig.optoR1) / (mConfig.inputR2 / (mConfig.inputR2 + mConfig.inputR1));
             mConfig.offset = mConfig.coeff.at(0);
             qDebug() << mConfig.type << " Calculated K3 gain: " << mConfig.gainK3;
@@ -18,11 +18,15 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += main.cpp \
     indicator_model.cpp \
     odometer_model.cpp \
+    perf_timer_model.cpp \
+    shift_light_model.cpp \
     tachometer_model.cpp \
     accessory_gauge_model.cpp \
     speedometer_model.cpp \
     temp_and_fuel_gauge_model.cpp \
-    warning_light_model.cpp
+    warning_light_model.cpp \
+    gauge_item.cpp \
+    digit_readout.cpp
 
 RESOURCES += qml.qrc
 
@@ -405,51 +409,83 @@ HEADERS += \
     ../../eigen/Eigen/src/plugins/MatrixCwiseUnaryOps.h \
     ../../eigen/Eigen/src/plugins/ReshapedMethods.h \
     adc.h \
+    alarm_engine.h \
     analog_12v_input.h \
+    artwork_cache.h \
     backlight_control.h \
+    boot_profiler.h \
     can_frame_config.h \
+    channel_expression.h \
+    clock_discipline.h \
     config.h \
+    config_cache.h \
     dash_host.h \
     dash_lights.h \
     dash_new.h \
+    data_log.h \
+    data_logger.h \
+    digit_readout.h \
     event_timers.h \
+    frame_stats.h \
     gauge.h \
     gauge_accessory.h \
+    gauge_item.h \
     gauge_odo.h \
+    gauge_snapshot.h \
     gauge_speedo.h \
     gauge_tach.h \
     gauge_temp_fuel_cluster.h \
+    gpio_output.h \
     gps_helper.h \
     indicator_model.h \
     key_press_emitter.h \
     map_sensor.h \
     mcp23017.h \
+    needle_dynamics.h \
     ntc.h \
     odometer_model.h \
+    perf_timer.h \
+    perf_timer_model.h \
     pulse_counter.h \
     pwm.h \
     sensor.h \
+    sensor_acquisition.h \
     sensor_can.h \
+    sensor_derived.h \
+    sensor_fallback.h \
+    sensor_filter.h \
+    sensor_health.h \
+    sensor_health_monitor.h \
+    sensor_log.h \
     sensor_map.h \
     sensor_ntc.h \
     sensor_odometer.h \
+    sensor_recorder.h \
     sensor_resistive.h \
     sensor_source.h \
     sensor_source_adc.h \
     sensor_source_can.h \
+    sensor_source_derived.h \
     sensor_source_gpio.h \
     sensor_source_gps.h \
+    sensor_source_replay.h \
     sensor_source_tach.h \
     sensor_source_vss.h \
     sensor_speedo.h \
     sensor_tach.h \
     sensor_utils.h \
     sensor_voltmeter.h \
+    shift_light.h \
+    shift_light_model.h \
+    shm_refclock.h \
+    speed_fusion.h \
     tach_input.h \
     tachometer_model.h \
     accessory_gauge_model.h \
     speedometer_model.h \
     temp_and_fuel_gauge_model.h \
+    timezone_lookup.h \
+    ubx_parser.h \
     vss_input.h \
     warning_light_model.h
 
@@ -0,0 +1,255 @@
+#ifndef ARTWORK_CACHE_H
+#define ARTWORK_CACHE_H
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+
+/**
+ * @brief Gauge artwork baked to its on screen size.
+ *
+ * The dial and needle PNGs are several times larger than they are ever drawn.
+ * Artwork is decoded, scaled to the requested size, premultiplied (the
+ * format the scene graph uploads without converting) and kept in a bounded
+ * memory cache shared by every gauge. Each baked image is also written to a
+ * disk cache, so later boots read raw pixels instead of decoding and scaling
+ * the PNG again. Disk entries are keyed on the source, its size and its
+ * modification time, so new artwork in an update invalidates them. Entries for
+ * sizes no longer drawn are never read again, so the disk cache is pruned to
+ * DISK_LIMIT_KB, least recently used first, when it is first used.
+ *
+ * Disk entry layout (QDataStream, big endian):
+ *  quint32 MAGIC, quint16 VERSION, QString source, qint64 source size,
+ *  qint64 source modified time (ms), qint32 width, qint32 height,
+ *  qint32 bytes per line, QByteArray pixels (ARGB32 premultiplied)
+ */
+class ArtworkCache {
+public:
+    static constexpr quint32 MAGIC = 0x56444143; //!< "VDAC"
+    static constexpr quint16 VERSION = 1; //!< current disk entry version
+    static constexpr char DIR_NAME[] = "artwork"; //!< disk cache dir under the app cache location
+    static constexpr char FILE_EXTENSION[] = ".art"; //!< disk entry extension
+    static constexpr int MEMORY_LIMIT_KB = 32 * 1024; //!< baked images kept in memory
+    static constexpr qint64 DISK_LIMIT_KB = 64 * 1024; //!< disk cache size
+
+    /**
+     * @brief Get artwork scaled to a size
+     * @param source: image url or path ("qrc:/x.png", ":/x.png", "file:///x.png", "/x.png")
+     * @param size: size the image is drawn at
+     * @return premultiplied image, null if the source can't be read
+     */
+    static QImage load(QString source, QSize size) {
+        if (source.isEmpty() || size.isEmpty()) {
+            return QImage();
+        }
+
+        State & state = getState();
+        QString key = source + QString("@%1x%2").arg(size.width()).arg(size.height());
+        if (QImage * cached = state.memory.object(key)) {
+            return *cached;
+        }
+
+        if (state.prunedDir != state.dir) {
+            state.prunedDir = state.dir;
+            prune();
+        }
+
+        QString path = localPath(source);
+        QFileInfo info(path);
+        QImage image = readEntry(entryPath(key), source, info, size);
+        if (image.isNull()) {
+            image = bake(path, size);
+            if (image.isNull()) {
+                qDebug() << "Unable to load artwork: " << source;
+                return image;
+            }
+            writeEntry(entryPath(key), source, info, image);
+        }
+
+        state.memory.insert(key, new QImage(image), qMax(1, (int)(image.sizeInBytes() / 1024)));
+        return image;
+    }
+
+    /**
+     * @brief Set the disk cache directory
+     * @param path: directory, empty to disable the disk cache
+     */
+    static void setDirectory(QString path) {
+        getState().dir = path;
+    }
+
+    static QString getDirectory() {
+        return getState().dir;
+    }
+
+    /**
+     * @brief Drop the in memory images -- the disk cache is kept
+     */
+    static void clearMemory() {
+        getState().memory.clear();
+    }
+
+    /**
+     * @brief Delete the least recently used disk entries until the disk cache fits a limit
+     * @param limitKb: disk cache size
+     */
+    static void prune(qint64 limitKb = DISK_LIMIT_KB) {
+        QString dir = getState().dir;
+        if (dir.isEmpty()) {
+            return;
+        }
+
+        // oldest first -- an entry's modification time is when it was last read
+        QFileInfoList entries = QDir(dir).entryInfoList({QString("*") + FILE_EXTENSION}, QDir::Files,
+                                                        QDir::Time | QDir::Reversed);
+        qint64 total = 0;
+        for (const QFileInfo & entry : entries) {
+            total += entry.size();
+        }
+        for (const QFileInfo & entry : entries) {
+            if (total <= limitKb * 1024) {
+                break;
+            }
+            if (QFile::remove(entry.filePath())) {
+                total -= entry.size();
+            }
+        }
+    }
+
+    /**
+     * @brief Convert an image url to a path QFile/QImageReader understand
+     * @param source: image url or path
+     * @return local or resource path
+     */
+    static QString localPath(QString source) {
+        QUrl url(source);
+        if (url.scheme() == "qrc") {
+            return ":" + url.path();
+        } else if (url.isLocalFile()) {
+            return url.toLocalFile();
+        }
+        return source;
+    }
+
+private:
+    /**
+     * @struct State
+     */
+    typedef struct State {
+        QCache<QString, QImage> memory{MEMORY_LIMIT_KB}; //!< key -> baked image, cost in KB
+        QString dir = defaultDirectory(); //!< disk cache dir, empty = disabled
+        QString prunedDir; //!< disk cache dir last pruned
+    } State_t;
+
+    static State & getState() {
+        static State state;
+        return state;
+    }
+
+    static QString defaultDirectory() {
+        QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        return base.isEmpty() ? QString() : QDir(base).filePath(DIR_NAME);
+    }
+
+    static QString entryPath(QString key) {
+        QString dir = getState().dir;
+        if (dir.isEmpty()) {
+            return QString();
+        }
+        QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+        return QDir(dir).filePath(QString::fromLatin1(hash) + FILE_EXTENSION);
+    }
+
+    /**
+     * @brief Decode and scale an image
+     * @param path: local or resource path
+     * @param size: target size
+     * @return premultiplied image, null on failure
+     */
+    static QImage bake(QString path, QSize size) {
+        QImageReader reader(path);
+        QImage image = reader.read();
+        if (image.isNull()) {
+            return image;
+        }
+        if (image.size() != size) {
+            image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        }
+        return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    /**
+     * @brief Read a disk entry
+     * @return image, null if missing, stale or corrupt
+     */
+    static QImage readEntry(QString path, QString source, const QFileInfo & info, QSize size) {
+        if (path.isEmpty()) {
+            return QImage();
+        }
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QImage();
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic = 0;
+        quint16 version = 0;
+        QString entrySource;
+        qint64 sourceSize = 0, sourceModified = 0;
+        qint32 width = 0, height = 0, bytesPerLine = 0;
+        QByteArray pixels;
+        stream >> magic >> version >> entrySource >> sourceSize >> sourceModified
+               >> width >> height >> bytesPerLine >> pixels;
+
+        if (stream.status() != QDataStream::Ok || magic != MAGIC || version != VERSION ||
+                entrySource != source || sourceSize != info.size() ||
+                sourceModified != info.lastModified().toMSecsSinceEpoch() ||
+                QSize(width, height) != size) {
+            return QImage();
+        }
+
+        QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+        if (image.bytesPerLine() != bytesPerLine || pixels.size() != image.sizeInBytes()) {
+            return QImage();
+        }
+        memcpy(image.bits(), pixels.constData(), pixels.size());
+
+        // mark the entry used, for pruning
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        return image;
+    }
+
+    /**
+     * @brief Write a disk entry -- failures only cost the next boot a decode
+     */
+    static void writeEntry(QString path, QString source, const QFileInfo & info, const QImage & image) {
+        if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).path())) {
+            return;
+        }
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << MAGIC << VERSION << source << info.size()
+               << info.lastModified().toMSecsSinceEpoch()
+               << (qint32) image.width() << (qint32) image.height() << (qint32) image.bytesPerLine()
+               << QByteArray::fromRawData((const char *) image.constBits(), (int) image.sizeInBytes());
+        file.commit();
+    }
+};
+
+#endif // ARTWORK_CACHE_H
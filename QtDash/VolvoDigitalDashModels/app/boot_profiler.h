@@ -0,0 +1,82 @@
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QProcess>
+#include <QQuickWindow>
+#include <QSharedPointer>
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+#include <time.h>
+#endif
+
+/**
+ * @brief Boot timeline marks for the dash's part of the boot.
+ *
+ * The init scripts append "<seconds since boot> <event>" lines to the file
+ * named by BOOT_TIMELINE_ENV (see /etc/sysconfig/bootprofile on the target).
+ * The dash appends its own startup stages to the same file, and once the
+ * first gauge frame is on screen runs the report script, which merges the
+ * timeline with the kernel's log and writes the boot report.
+ *
+ * Does nothing when BOOT_TIMELINE_ENV isn't set, e.g. on the desktop.
+ */
+class BootProfiler {
+public:
+    static constexpr char BOOT_TIMELINE_ENV[] = "BOOT_TIMELINE"; //!< timeline file, set by rcS
+    static constexpr char BOOT_REPORT_CMD[] = "/usr/sbin/boot-report"; //!< writes the report from the timeline
+
+    /**
+     * @brief Append an event to the boot timeline
+     * @param event: event name
+     */
+    static void mark(const char * event) {
+        QByteArray path = qgetenv(BOOT_TIMELINE_ENV);
+        if (path.isEmpty()) {
+            return;
+        }
+
+        QFile file(QString::fromLocal8Bit(path));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            file.write(QByteArray::number(uptime(), 'f', 3) + ' ' + event + '\n');
+        }
+    }
+
+    /**
+     * @brief Mark the first frame the window shows and write the boot report
+     * @param window: window showing the gauges
+     */
+    static void markFirstFrame(QQuickWindow * window) {
+        if (!window || !qEnvironmentVariableIsSet(BOOT_TIMELINE_ENV)) {
+            return;
+        }
+
+        // frameSwapped comes from the render thread -- mark it there, report from the gui thread
+        QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
+        *connection = QObject::connect(window, &QQuickWindow::frameSwapped, window, [window, connection]() {
+            QObject::disconnect(*connection);
+            mark("first frame");
+            QMetaObject::invokeMethod(window, []() {
+                QProcess::startDetached(BOOT_REPORT_CMD, QStringList());
+            }, Qt::QueuedConnection);
+        }, Qt::DirectConnection);
+    }
+
+private:
+    /**
+     * @brief Seconds since boot, same clock as /proc/uptime and the kernel log
+     */
+    static double uptime() {
+#ifdef Q_OS_LINUX
+        struct timespec ts;
+        if (clock_gettime(CLOCK_BOOTTIME, &ts) == 0) {
+            return ts.tv_sec + ts.tv_nsec / 1e9;
+        }
+#endif
+        return 0;
+    }
+};
+
+#endif // BOOT_PROFILER_H
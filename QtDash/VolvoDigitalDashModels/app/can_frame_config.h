@@ -128,6 +128,41 @@ public:
         return ret;
     }
 
+    /**
+     * @brief Write the config to a stream
+     * @param stream: stream
+     */
+    void write(QDataStream & stream) const {
+        stream << (quint32) mFrameId << (quint8) mOffset << (quint8) mSize << mSigned
+               << mName << mUnits << mGaugeName << (qint32) mOperations.size();
+        for (const Operation_t & op : mOperations) {
+            stream << (qint32) op.type << op.value;
+        }
+    }
+
+    /**
+     * @brief Read a config written by @ref write
+     * @param stream: stream
+     * @return config
+     */
+    static CanFrameConfig read(QDataStream & stream) {
+        quint32 frameId = 0;
+        quint8 offset = 0, size = 0;
+        bool sign = false;
+        QString name, units, gauge;
+        qint32 operations = 0;
+        stream >> frameId >> offset >> size >> sign >> name >> units >> gauge >> operations;
+
+        CanFrameConfig config(frameId, offset, size, sign, units, name, gauge);
+        for (int i = 0; i < operations && stream.status() == QDataStream::Ok; i++) {
+            qint32 type = 0;
+            qreal value = 0;
+            stream >> type >> value;
+            config.addOperation((OperationType) type, value);
+        }
+        return config;
+    }
+
 private:
     uint32_t mFrameId;
     uint8_t mOffset;
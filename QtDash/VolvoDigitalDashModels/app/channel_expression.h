@@ -0,0 +1,562 @@
+#ifndef CHANNEL_EXPRESSION_H
+#define CHANNEL_EXPRESSION_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtMath>
+
+#include <algorithm>
+
+/**
+ * @brief An arithmetic expression over sensor channels, compiled once to
+ * a flat stack machine program and evaluated without allocating.
+ *
+ * Grammar, lowest precedence first:
+ *  - a || b, a && b
+ *  - a == b, a != b, a < b, a > b, a <= b, a >= b
+ *  - a + b, a - b
+ *  - a * b, a / b
+ *  - -a, !a
+ *  - a ^ b (right associative)
+ *  - numbers, channel names, (a), and function calls
+ *
+ * Functions: abs, sqrt, log, exp, floor, round, min(a, b, ...), max(a, b, ...),
+ * clamp(x, low, high), if(cond, a, b) and nearest(x, a, b, ...), the 1 based
+ * index of the value nearest to x (e.g. the gear from an rpm/speed ratio).
+ * Comparisons are 1 or 0, anything but 0 is true. Both sides of an if are
+ * evaluated. Operations on constants only are folded when compiling.
+ */
+class ChannelExpression {
+public:
+    static constexpr int MAX_STACK = 32; //!< deepest evaluation stack an expression can need
+    static constexpr int MAX_ARGS = 16; //!< most arguments to a function
+
+    /**
+     * @brief Instruction op codes
+     */
+    enum class OpCode : quint8 {
+        CONST = 0, //!< push value
+        LOAD, //!< push input arg
+        NEG, //!< -a
+        NOT, //!< !a
+        ADD, //!< a + b
+        SUB, //!< a - b
+        MUL, //!< a * b
+        DIV, //!< a / b
+        POW, //!< a ^ b
+        LT, //!< a < b
+        GT, //!< a > b
+        LE, //!< a <= b
+        GE, //!< a >= b
+        EQ, //!< a == b
+        NE, //!< a != b
+        AND, //!< a && b
+        OR, //!< a || b
+        ABS, //!< abs(a)
+        SQRT, //!< sqrt(a)
+        LOG, //!< natural log
+        EXP, //!< exp(a)
+        FLOOR, //!< floor(a)
+        ROUND, //!< round(a)
+        MIN, //!< smallest of arg values
+        MAX, //!< largest of arg values
+        CLAMP, //!< clamp(x, low, high)
+        IF, //!< if(cond, a, b)
+        NEAREST, //!< nearest(x, ...) over arg values
+    };
+
+    /**
+     * @brief One stack machine instruction
+     */
+    typedef struct Instruction {
+        OpCode op; //!< op code
+        int arg; //!< input index for LOAD, value count for the variadic functions
+        qreal value; //!< value for CONST
+    } Instruction_t;
+
+    /**
+     * @brief Compile an expression
+     * @param source: expression text
+     * @param variables: channel names, the input order for @ref evaluate
+     * @return true if the expression compiled, see @ref getError otherwise
+     */
+    bool compile(QString source, QStringList variables) {
+        mSource = source;
+        mVariables = variables;
+        mPos = 0;
+        mDepth = 0;
+        mMaxDepth = 0;
+        mError.clear();
+        mCode.clear();
+        mInputs.clear();
+
+        bool ok = parseOr();
+        skipSpace();
+        if (ok && mPos < mSource.size()) {
+            ok = fail(QString("unexpected '%1'").arg(mSource.at(mPos)));
+        }
+        if (ok && mMaxDepth > MAX_STACK) {
+            ok = fail("expression too deep");
+        }
+        if (!ok) {
+            mCode.clear();
+            mInputs.clear();
+        }
+
+        std::sort(mInputs.begin(), mInputs.end());
+        return ok;
+    }
+
+    /**
+     * @brief Evaluate the compiled expression
+     * @param inputs: channel values, in the order of the compiled variables
+     * @return value, NaN if the expression didn't compile
+     */
+    qreal evaluate(const qreal * inputs) const {
+        if (mCode.isEmpty()) {
+            return qQNaN();
+        }
+        return run(mCode.constData(), mCode.size(), inputs);
+    }
+
+    bool isValid() const {
+        return !mCode.isEmpty();
+    }
+
+    /**
+     * @brief Get why the last compile failed
+     * @return error with its position, empty if it compiled
+     */
+    QString getError() const {
+        return mError;
+    }
+
+    /**
+     * @brief Get the inputs the expression reads
+     * @return variable indices, ascending
+     */
+    QVector<int> getInputs() const {
+        return mInputs;
+    }
+
+    /**
+     * @brief Get the compiled program
+     * @return instructions
+     */
+    QVector<Instruction_t> getCode() const {
+        return mCode;
+    }
+
+private:
+    /**
+     * @brief Function name, op code and argument count
+     */
+    typedef struct Function {
+        const char * name; //!< name
+        OpCode op; //!< op code
+        int minArgs; //!< fewest arguments
+        int maxArgs; //!< most arguments
+    } Function_t;
+
+    QString mSource; //!< expression being compiled
+    QStringList mVariables; //!< channel names
+    int mPos = 0; //!< parse position
+    int mDepth = 0; //!< stack depth at the parse position
+    int mMaxDepth = 0; //!< deepest stack of the program
+    QString mError; //!< compile error
+    QVector<Instruction_t> mCode; //!< compiled program
+    QVector<int> mInputs; //!< variables read
+
+    /**
+     * @brief Run a program
+     * @param code: instructions
+     * @param size: instruction count
+     * @param inputs: channel values
+     * @return value left on the stack
+     */
+    static qreal run(const Instruction_t * code, int size, const qreal * inputs) {
+        qreal stack[MAX_STACK];
+        int sp = 0;
+
+        for (int pc = 0; pc < size; pc++) {
+            const Instruction_t & ins = code[pc];
+            switch (ins.op) {
+            case OpCode::CONST: stack[sp++] = ins.value; break;
+            case OpCode::LOAD: stack[sp++] = inputs[ins.arg]; break;
+            case OpCode::NEG: stack[sp - 1] = -stack[sp - 1]; break;
+            case OpCode::NOT: stack[sp - 1] = stack[sp - 1] == 0; break;
+            case OpCode::ADD: sp--; stack[sp - 1] += stack[sp]; break;
+            case OpCode::SUB: sp--; stack[sp - 1] -= stack[sp]; break;
+            case OpCode::MUL: sp--; stack[sp - 1] *= stack[sp]; break;
+            case OpCode::DIV: sp--; stack[sp - 1] /= stack[sp]; break;
+            case OpCode::POW: sp--; stack[sp - 1] = qPow(stack[sp - 1], stack[sp]); break;
+            case OpCode::LT: sp--; stack[sp - 1] = stack[sp - 1] < stack[sp]; break;
+            case OpCode::GT: sp--; stack[sp - 1] = stack[sp - 1] > stack[sp]; break;
+            case OpCode::LE: sp--; stack[sp - 1] = stack[sp - 1] <= stack[sp]; break;
+            case OpCode::GE: sp--; stack[sp - 1] = stack[sp - 1] >= stack[sp]; break;
+            case OpCode::EQ: sp--; stack[sp - 1] = stack[sp - 1] == stack[sp]; break;
+            case OpCode::NE: sp--; stack[sp - 1] = stack[sp - 1] != stack[sp]; break;
+            case OpCode::AND: sp--; stack[sp - 1] = stack[sp - 1] != 0 && stack[sp] != 0; break;
+            case OpCode::OR: sp--; stack[sp - 1] = stack[sp - 1] != 0 || stack[sp] != 0; break;
+            case OpCode::ABS: stack[sp - 1] = qAbs(stack[sp - 1]); break;
+            case OpCode::SQRT: stack[sp - 1] = qSqrt(stack[sp - 1]); break;
+            case OpCode::LOG: stack[sp - 1] = qLn(stack[sp - 1]); break;
+            case OpCode::EXP: stack[sp - 1] = qExp(stack[sp - 1]); break;
+            case OpCode::FLOOR: stack[sp - 1] = std::floor(stack[sp - 1]); break;
+            case OpCode::ROUND: stack[sp - 1] = std::round(stack[sp - 1]); break;
+            case OpCode::MIN:
+                sp -= ins.arg - 1;
+                for (int i = 0; i < ins.arg - 1; i++) {
+                    stack[sp - 1] = qMin(stack[sp - 1], stack[sp + i]);
+                }
+                break;
+            case OpCode::MAX:
+                sp -= ins.arg - 1;
+                for (int i = 0; i < ins.arg - 1; i++) {
+                    stack[sp - 1] = qMax(stack[sp - 1], stack[sp + i]);
+                }
+                break;
+            case OpCode::CLAMP:
+                sp -= 2;
+                stack[sp - 1] = qBound(stack[sp], stack[sp - 1], stack[sp + 1]);
+                break;
+            case OpCode::IF:
+                sp -= 2;
+                stack[sp - 1] = stack[sp - 1] != 0 ? stack[sp] : stack[sp + 1];
+                break;
+            case OpCode::NEAREST: {
+                sp -= ins.arg - 1;
+                qreal x = stack[sp - 1];
+                int nearest = 1;
+                for (int i = 1; i < ins.arg - 1; i++) {
+                    if (qAbs(stack[sp + i] - x) < qAbs(stack[sp + nearest - 1] - x)) {
+                        nearest = i + 1;
+                    }
+                }
+                stack[sp - 1] = nearest;
+                break;
+            }
+            }
+        }
+        return stack[0];
+    }
+
+    /**
+     * @brief Record a compile error
+     * @param message: what went wrong
+     * @return false
+     */
+    bool fail(QString message) {
+        if (mError.isEmpty()) {
+            mError = QString("%1 at %2 in \"%3\"").arg(message).arg(mPos).arg(mSource);
+        }
+        return false;
+    }
+
+    void skipSpace() {
+        while (mPos < mSource.size() && mSource.at(mPos).isSpace()) {
+            mPos++;
+        }
+    }
+
+    /**
+     * @brief Consume a token if it is next
+     * @param token: operator text
+     * @return true if consumed
+     */
+    bool accept(const char * token) {
+        skipSpace();
+        QLatin1String t(token);
+        if (mSource.midRef(mPos, t.size()) == t) {
+            mPos += t.size();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Append an instruction, folding it into a constant when all its
+     * operands are constants
+     * @param op: op code
+     * @param operands: values the instruction pops
+     * @param arg: instruction argument
+     * @param value: instruction value
+     */
+    void emitOp(OpCode op, int operands, int arg = 0, qreal value = 0) {
+        mCode.push_back({op, arg, value});
+        mDepth += 1 - operands;
+        mMaxDepth = qMax(mMaxDepth, mDepth);
+
+        if (op == OpCode::CONST || op == OpCode::LOAD || mCode.size() <= operands) {
+            return;
+        }
+        int first = mCode.size() - 1 - operands;
+        for (int i = first; i < mCode.size() - 1; i++) {
+            if (mCode.at(i).op != OpCode::CONST) {
+                return;
+            }
+        }
+        qreal folded = run(mCode.constData() + first, operands + 1, nullptr);
+        mCode.resize(first);
+        mCode.push_back({OpCode::CONST, 0, folded});
+    }
+
+    bool parseOr() {
+        if (!parseAnd()) {
+            return false;
+        }
+        while (accept("||")) {
+            if (!parseAnd()) {
+                return false;
+            }
+            emitOp(OpCode::OR, 2);
+        }
+        return true;
+    }
+
+    bool parseAnd() {
+        if (!parseComparison()) {
+            return false;
+        }
+        while (accept("&&")) {
+            if (!parseComparison()) {
+                return false;
+            }
+            emitOp(OpCode::AND, 2);
+        }
+        return true;
+    }
+
+    bool parseComparison() {
+        if (!parseSum()) {
+            return false;
+        }
+        while (true) {
+            OpCode op;
+            // two character operators first
+            if (accept("==")) {
+                op = OpCode::EQ;
+            } else if (accept("!=")) {
+                op = OpCode::NE;
+            } else if (accept("<=")) {
+                op = OpCode::LE;
+            } else if (accept(">=")) {
+                op = OpCode::GE;
+            } else if (accept("<")) {
+                op = OpCode::LT;
+            } else if (accept(">")) {
+                op = OpCode::GT;
+            } else {
+                return true;
+            }
+            if (!parseSum()) {
+                return false;
+            }
+            emitOp(op, 2);
+        }
+    }
+
+    bool parseSum() {
+        if (!parseProduct()) {
+            return false;
+        }
+        while (true) {
+            OpCode op;
+            if (accept("+")) {
+                op = OpCode::ADD;
+            } else if (accept("-")) {
+                op = OpCode::SUB;
+            } else {
+                return true;
+            }
+            if (!parseProduct()) {
+                return false;
+            }
+            emitOp(op, 2);
+        }
+    }
+
+    bool parseProduct() {
+        if (!parseUnary()) {
+            return false;
+        }
+        while (true) {
+            OpCode op;
+            if (accept("*")) {
+                op = OpCode::MUL;
+            } else if (accept("/")) {
+                op = OpCode::DIV;
+            } else {
+                return true;
+            }
+            if (!parseUnary()) {
+                return false;
+            }
+            emitOp(op, 2);
+        }
+    }
+
+    bool parseUnary() {
+        if (accept("-")) {
+            if (!parseUnary()) {
+                return false;
+            }
+            emitOp(OpCode::NEG, 1);
+            return true;
+        }
+        if (accept("!")) {
+            if (!parseUnary()) {
+                return false;
+            }
+            emitOp(OpCode::NOT, 1);
+            return true;
+        }
+        accept("+");
+        return parsePower();
+    }
+
+    bool parsePower() {
+        if (!parsePrimary()) {
+            return false;
+        }
+        if (accept("^")) {
+            // right associative, and binds tighter than a unary minus on its left
+            if (!parseUnary()) {
+                return false;
+            }
+            emitOp(OpCode::POW, 2);
+        }
+        return true;
+    }
+
+    bool parsePrimary() {
+        skipSpace();
+        if (mPos >= mSource.size()) {
+            return fail("unexpected end");
+        }
+
+        QChar c = mSource.at(mPos);
+        if (accept("(")) {
+            if (!parseOr()) {
+                return false;
+            }
+            return accept(")") || fail("expected ')'");
+        }
+        if (c.isDigit() || c == '.') {
+            return parseNumber();
+        }
+        if (c.isLetter() || c == '_') {
+            return parseName();
+        }
+        return fail(QString("unexpected '%1'").arg(c));
+    }
+
+    bool parseNumber() {
+        int start = mPos;
+        while (mPos < mSource.size() && (mSource.at(mPos).isDigit() || mSource.at(mPos) == '.')) {
+            mPos++;
+        }
+        // exponent
+        if (mPos < mSource.size() && mSource.at(mPos).toLower() == 'e') {
+            int mantissaEnd = mPos++;
+            if (mPos < mSource.size() && (mSource.at(mPos) == '+' || mSource.at(mPos) == '-')) {
+                mPos++;
+            }
+            if (mPos < mSource.size() && mSource.at(mPos).isDigit()) {
+                while (mPos < mSource.size() && mSource.at(mPos).isDigit()) {
+                    mPos++;
+                }
+            } else {
+                mPos = mantissaEnd;
+            }
+        }
+
+        bool ok = false;
+        qreal value = mSource.mid(start, mPos - start).toDouble(&ok);
+        if (!ok) {
+            mPos = start;
+            return fail("invalid number");
+        }
+        emitOp(OpCode::CONST, 0, 0, value);
+        return true;
+    }
+
+    bool parseName() {
+        int start = mPos;
+        while (mPos < mSource.size() && (mSource.at(mPos).isLetterOrNumber() || mSource.at(mPos) == '_')) {
+            mPos++;
+        }
+        QString name = mSource.mid(start, mPos - start);
+
+        if (accept("(")) {
+            return parseCall(name, start);
+        }
+
+        int index = mVariables.indexOf(name);
+        if (index < 0) {
+            mPos = start;
+            return fail(QString("unknown channel '%1'").arg(name));
+        }
+        if (!mInputs.contains(index)) {
+            mInputs.push_back(index);
+        }
+        emitOp(OpCode::LOAD, 0, index);
+        return true;
+    }
+
+    /**
+     * @brief Parse a function call's arguments, the name and '(' are consumed
+     * @param name: function name
+     * @param start: position of the name, for errors
+     * @return true if parsed
+     */
+    bool parseCall(QString name, int start) {
+        static const Function_t functions[] = {
+            {"abs", OpCode::ABS, 1, 1},
+            {"sqrt", OpCode::SQRT, 1, 1},
+            {"log", OpCode::LOG, 1, 1},
+            {"exp", OpCode::EXP, 1, 1},
+            {"floor", OpCode::FLOOR, 1, 1},
+            {"round", OpCode::ROUND, 1, 1},
+            {"min", OpCode::MIN, 2, MAX_ARGS},
+            {"max", OpCode::MAX, 2, MAX_ARGS},
+            {"clamp", OpCode::CLAMP, 3, 3},
+            {"if", OpCode::IF, 3, 3},
+            {"nearest", OpCode::NEAREST, 2, MAX_ARGS},
+        };
+
+        const Function_t * function = nullptr;
+        for (const Function_t & f : functions) {
+            if (name == f.name) {
+                function = &f;
+            }
+        }
+        if (function == nullptr) {
+            mPos = start;
+            return fail(QString("unknown function '%1'").arg(name));
+        }
+
+        int args = 0;
+        if (!accept(")")) {
+            do {
+                if (!parseOr()) {
+                    return false;
+                }
+                args++;
+            } while (accept(","));
+            if (!accept(")")) {
+                return fail("expected ')'");
+            }
+        }
+
+        if (args < function->minArgs || args > function->maxArgs) {
+            mPos = start;
+            return fail(QString("wrong number of arguments to '%1'").arg(name));
+        }
+        emitOp(function->op, args, args);
+        return true;
+    }
+};
+
+#endif // CHANNEL_EXPRESSION_H
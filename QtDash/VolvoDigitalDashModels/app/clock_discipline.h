@@ -0,0 +1,176 @@
+#ifndef CLOCK_DISCIPLINE_H
+#define CLOCK_DISCIPLINE_H
+
+#include <QtGlobal>
+#include <QDebug>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/timex.h>
+
+/**
+ * @brief Keeps the system clock on gps time, in process.
+ *
+ * Each fix gives an offset: the fix time less the system time it arrived at.
+ * The serial port only ever delays a fix, so the largest offset of a window
+ * of fixes is the one with the least delay -- that's the estimate. The first
+ * fix steps the clock if it's far off (no RTC, so it boots in 1970); after
+ * that the kernel slews out the estimate so the clock never runs backwards
+ * under the data logger.
+ */
+class ClockDiscipline {
+public:
+    static constexpr qint64 NSEC_PER_SEC = 1000000000;
+    static constexpr qint64 STEP_NSEC = NSEC_PER_SEC / 2; //!< offsets over this are stepped instead of slewed
+    static constexpr qint64 DEADBAND_NSEC = 2000000; //!< offsets under this are serial jitter, left alone
+    static constexpr int WINDOW = 10; //!< fixes per offset estimate
+
+    /**
+     * @brief What to do to the system clock
+     */
+    enum class Action {
+        NONE = 0,
+        STEP, //!< set it
+        SLEW, //!< speed it up or slow it down until the offset is gone
+    };
+
+    /**
+     * @brief A system clock correction
+     */
+    typedef struct Correction {
+        Action action; //!< correction to make
+        qint64 offsetNsec; //!< nanoseconds to add to the system clock
+    } Correction_t;
+
+    /**
+     * @brief Constructor
+     * @param latencyNsec: delay from the fix time to the fix arriving
+     */
+    ClockDiscipline(qint64 latencyNsec = 0) : mLatencyNsec(latencyNsec) {
+    }
+
+    /**
+     * @brief Add a gps fix
+     * @param fixNsec: fix time (UTC nanoseconds since the epoch)
+     * @param systemNsec: system time the fix arrived at, @ref realtimeNsec
+     * @return correction due, if any
+     */
+    Correction_t addFix(qint64 fixNsec, qint64 systemNsec) {
+        qint64 offset = fixNsec + mLatencyNsec - systemNsec;
+
+        if (!mSynced) {
+            mSynced = true;
+            if (qAbs(offset) > STEP_NSEC) {
+                mOffsetNsec = offset;
+                return {Action::STEP, offset};
+            }
+        }
+
+        mBestNsec = (mCount == 0) ? offset : qMax(mBestNsec, offset);
+        if (++mCount < WINDOW) {
+            return {Action::NONE, 0};
+        }
+        mCount = 0;
+        mOffsetNsec = mBestNsec;
+
+        if (qAbs(mBestNsec) > STEP_NSEC) {
+            return {Action::STEP, mBestNsec};
+        } else if (qAbs(mBestNsec) > DEADBAND_NSEC) {
+            return {Action::SLEW, mBestNsec};
+        }
+        return {Action::NONE, 0};
+    }
+
+    /**
+     * @brief Get the last offset estimate
+     * @return nanoseconds the system clock was behind gps time
+     */
+    qint64 getOffsetNsec() const {
+        return mOffsetNsec;
+    }
+
+    /**
+     * @brief Check whether a fix has been seen
+     * @return true once the clock has been checked against gps time
+     */
+    bool isSynced() const {
+        return mSynced;
+    }
+
+    /**
+     * @brief Make a correction to the system clock. Needs CAP_SYS_TIME;
+     * only done on the Pi so a desktop build never touches the host clock.
+     * @param correction: from @ref addFix
+     * @return true if successful
+     */
+    static bool apply(Correction_t correction) {
+        switch (correction.action) {
+        case Action::STEP:
+            return step(correction.offsetNsec);
+        case Action::SLEW:
+            return slew(correction.offsetNsec);
+        default:
+            return true;
+        }
+    }
+
+    /**
+     * @brief Read the system clock
+     * @return UTC nanoseconds since the epoch
+     */
+    static qint64 realtimeNsec() {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return (qint64) ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+    }
+
+private:
+    qint64 mLatencyNsec; //!< fix delivery delay
+    bool mSynced = false; //!< a fix has been seen
+    int mCount = 0; //!< fixes in the current window
+    qint64 mBestNsec = 0; //!< largest offset in the current window
+    qint64 mOffsetNsec = 0; //!< last offset estimate
+
+    /**
+     * @brief Set the system clock
+     * @param offsetNsec: nanoseconds to add
+     * @return true if successful
+     */
+    static bool step(qint64 offsetNsec) {
+        qDebug() << "Stepping the system clock" << offsetNsec / 1e9 << "s";
+#ifdef RASPBERRY_PI
+        qint64 now = realtimeNsec() + offsetNsec;
+        struct timespec ts;
+        ts.tv_sec = now / NSEC_PER_SEC;
+        ts.tv_nsec = now % NSEC_PER_SEC;
+        if (clock_settime(CLOCK_REALTIME, &ts) != 0) {
+            qDebug() << "clock_settime failed: " << strerror(errno);
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Slew the system clock -- replaces any slew still in progress
+     * @param offsetNsec: nanoseconds to add
+     * @return true if successful
+     */
+    static bool slew(qint64 offsetNsec) {
+#ifdef RASPBERRY_PI
+        struct timex tx;
+        std::memset(&tx, 0, sizeof(tx));
+        tx.modes = ADJ_OFFSET_SINGLESHOT;
+        tx.offset = offsetNsec / 1000;
+        if (adjtimex(&tx) < 0) {
+            qDebug() << "adjtimex failed: " << strerror(errno);
+            return false;
+        }
+#else
+        Q_UNUSED(offsetNsec)
+#endif
+        return true;
+    }
+};
+
+#endif // CLOCK_DISCIPLINE_H
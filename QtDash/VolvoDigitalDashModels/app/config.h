@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QSettings>
+#include <QDataStream>
 #include <QDebug>
 #include <iostream>
 
@@ -29,8 +30,21 @@ public:
     static constexpr char ANALOG_INPUT_12V_GROUP[] = "12v_analog";
     static constexpr char VSS_INPUT_GROUP[] = "vss_input";
     static constexpr char ODOMETER_GROUP[] = "odometer";
+    static constexpr char VSS_CALIBRATION_GROUP[] = "vss_calibration";
     static constexpr char BACKLIGHT_GROUP[] = "backlight";
     static constexpr char USER_INPUT_GROUP[] = "user_inputs";
+    static constexpr char RECORDER_GROUP[] = "recorder";
+    static constexpr char DATA_LOGGER_GROUP[] = "data_logger";
+    static constexpr char SENSOR_FILTER_GROUP[] = "sensor_filter";
+    static constexpr char SAMPLE_RATE_GROUP[] = "sample_rate";
+    static constexpr char DERIVED_CHANNEL_GROUP[] = "derived_channel";
+    static constexpr char PERF_TIMER_GROUP[] = "perf_timer";
+    static constexpr char GPS_GROUP[] = "gps";
+    static constexpr char CLOCK_GROUP[] = "clock";
+    static constexpr char SENSOR_HEALTH_GROUP[] = "sensor_health";
+    static constexpr char ALARM_GROUP[] = "alarm";
+    static constexpr char BUZZER_GROUP[] = "buzzer";
+    static constexpr char SHIFT_LIGHT_GROUP[] = "shift_light";
 
     // units for sensors
     static constexpr char UNITS_KPA[] = "kpa";
@@ -129,6 +143,7 @@ public:
     static constexpr char VSS_DISTANCE_UNITS[] = "distance_units";
     static constexpr char VSS_MAX_SPEED[] = "max_speed";
     static constexpr char VSS_USE_GPS[] = "use_gps";
+    static constexpr char VSS_AUTO_CALIBRATE[] = "auto_calibrate";
 
     //expected keys for resistive sensors
     static constexpr char RES_SENSOR_TYPE[] = "type";
@@ -165,6 +180,9 @@ public:
     static constexpr char ODO_VALUE[] = "value";
     static constexpr char ODO_WRITE_INTERVAL[] = "interval";
 
+    //expected keys for the learned vss calibration
+    static constexpr char VSS_CALIBRATION_SCALE[] = "scale";
+
     static constexpr char ODO_NAME_ODOMETER[] = "odometer";
     static constexpr char ODO_NAME_TRIPA[] = "tripA";
     static constexpr char ODO_NAME_TRIPB[] = "tripB";
@@ -178,6 +196,79 @@ public:
     static constexpr char BACKLIGHT_USE_DIMMER[] = "use_dimmer";
     static constexpr char BACKLIGHT_ACTIVE_LOW[] = "active_low";
 
+    //sensor session recorder keys
+    static constexpr char RECORDER_ENABLE[] = "enable";
+    static constexpr char RECORDER_PATH[] = "path";
+
+    //channel data logger keys
+    static constexpr char DATA_LOGGER_ENABLE[] = "enable";
+    static constexpr char DATA_LOGGER_PATH[] = "path";
+    static constexpr char DATA_LOGGER_BLOCK_SECONDS[] = "block_seconds";
+    static constexpr char DATA_LOGGER_SYNC_SECONDS[] = "sync_seconds";
+    static constexpr char DATA_LOGGER_MAX_PENDING[] = "max_pending_samples";
+
+    //sensor filter keys -- the analog sensors use their sensor channel key
+    static constexpr char FILTER_TACH_KEY[] = "tach";
+    static constexpr char FILTER_SPEEDO_KEY[] = "speedo";
+
+    //sample rate keys -- every other key is a sensor key (see sensor filter keys) and its rate in Hz
+    static constexpr char SAMPLE_RATE_DISPLAY_HZ[] = "display_hz";
+    static constexpr qreal DEFAULT_DISPLAY_HZ = 20.0;
+
+    //derived channel keys
+    static constexpr char DERIVED_CHANNEL_NAME[] = "name";
+    static constexpr char DERIVED_CHANNEL_EXPRESSION[] = "expr";
+    static constexpr char DERIVED_CHANNEL_UNITS[] = "units";
+    static constexpr char DERIVED_CHANNEL_GAUGE[] = "gauge";
+
+    //performance timer keys
+    static constexpr char PERF_TIMER_SOURCE[] = "source";
+    static constexpr char PERF_TIMER_SOURCE_GPS[] = "gps";
+    static constexpr char PERF_TIMER_FINISH_LINE[] = "finish_line";
+
+    //gps receiver keys
+    static constexpr char GPS_PORT[] = "port";
+    static constexpr char GPS_PROTOCOL[] = "protocol";
+    static constexpr char GPS_PROTOCOL_NMEA[] = "nmea";
+    static constexpr char GPS_RATE_HZ[] = "rate_hz";
+    static constexpr char DEFAULT_GPS_PORT[] = "/dev/ttyACM0";
+    static constexpr qreal DEFAULT_GPS_RATE_HZ = 10.0;
+
+    //clock keys
+    static constexpr char CLOCK_SET_TIME[] = "set_time";
+    static constexpr char CLOCK_TIME_ZONE[] = "timezone";
+    static constexpr char CLOCK_TIME_ZONE_AUTO[] = "auto";
+    static constexpr char CLOCK_TIME_ZONE_SYSTEM[] = "system";
+    static constexpr char CLOCK_SHM_UNIT[] = "shm_unit";
+    static constexpr char CLOCK_LATENCY_MSEC[] = "latency_ms";
+
+    //sensor health keys
+    static constexpr char SENSOR_HEALTH_ENABLED[] = "enabled";
+    static constexpr char SENSOR_HEALTH_TIMEOUT_MSEC[] = "timeout_ms";
+    static constexpr char SENSOR_HEALTH_FAULT_MSEC[] = "fault_ms";
+    static constexpr char SENSOR_HEALTH_RECOVER_MSEC[] = "recover_ms";
+
+    //alarm keys
+    static constexpr char ALARM_NAME[] = "name";
+    static constexpr char ALARM_EXPRESSION[] = "expr";
+    static constexpr char ALARM_CLEAR[] = "clear";
+    static constexpr char ALARM_DELAY_MSEC[] = "delay_ms";
+    static constexpr char ALARM_LIGHT[] = "light";
+    static constexpr char ALARM_BUZZER[] = "buzzer";
+
+    //buzzer keys
+    static constexpr char BUZZER_PIN[] = "pin";
+    static constexpr char BUZZER_ACTIVE_LOW[] = "active_low";
+
+    //shift light keys
+    static constexpr char SHIFT_LIGHT_ENABLED[] = "enabled";
+    static constexpr char SHIFT_LIGHT_SHIFT_RPM[] = "shift_rpm";
+    static constexpr char SHIFT_LIGHT_RATIOS[] = "ratios";
+    static constexpr char SHIFT_LIGHT_STAGES[] = "stages";
+    static constexpr char SHIFT_LIGHT_STAGE_RPM[] = "stage_rpm";
+    static constexpr char SHIFT_LIGHT_LEAD_MSEC[] = "lead_ms";
+    static constexpr char SHIFT_LIGHT_MCP_ADDRESS[] = "mcp_address";
+
     //gauge config groups
     static constexpr char BOOST_GAUGE_GROUP[] = "boost";
     static constexpr char COOLANT_TEMP_GAUGE_GROUP[] = "coolant_temp";
@@ -485,6 +576,7 @@ public:
         DistanceUnits distanceUnits; //!< unit of distance for pulsePerUnitDistance
         int maxSpeed; //!< Max speed -- lowest possible value it best will filter out noisy signals better
         bool useGps = false;
+        bool autoCalibrate = true; //!< learn the calibration from gps speed
     } VssInputConfig_t;
 
     /**
@@ -511,6 +603,113 @@ public:
         bool activeLow;
     } BacklightControlConfig_t;
 
+    /**
+     * @struct RecorderConfig
+     */
+    typedef struct RecorderConfig {
+        bool enable; //!< record every sensor source sample to a session log
+        QString path; //!< directory session logs are written to
+    } RecorderConfig_t;
+
+    /**
+     * @struct DataLoggerConfig
+     */
+    typedef struct DataLoggerConfig {
+        bool enable; //!< log every sensor channel
+        QString path; //!< directory channel logs are written to
+        int blockSeconds; //!< seconds of samples compressed into each block
+        int syncSeconds; //!< seconds between fsyncs
+        int maxPendingSamples; //!< samples buffered before new ones are dropped
+    } DataLoggerConfig_t;
+
+    /**
+     * @struct SampleRateConfig
+     */
+    typedef struct SampleRateConfig {
+        qreal displayHz = DEFAULT_DISPLAY_HZ; //!< rate gauges are updated at when a sensor samples faster
+        QMap<QString, qreal> acquireHz; //!< acquisition rate by sensor key, unset sensors use their default timer
+    } SampleRateConfig_t;
+
+    /**
+     * @struct DerivedChannelConfig
+     */
+    typedef struct DerivedChannelConfig {
+        QString name; //!< channel name, for expressions, filters, sample rates and logging
+        QString expression; //!< expression over other channels, see @ref ChannelExpression
+        QString units; //!< units of the expression's value
+        QString gauge; //!< accessory gauge the channel drives instead of its default sensor, empty for none
+    } DerivedChannelConfig_t;
+
+    /**
+     * @struct PerfTimerConfig
+     */
+    typedef struct PerfTimerConfig {
+        bool useGps = false; //!< time runs from gps fixes instead of VSS pulses
+        QList<qreal> finishLine; //!< lap start/finish line as lat1, lon1, lat2, lon2 -- empty for no lap timing
+    } PerfTimerConfig_t;
+
+    /**
+     * @struct GpsConfig
+     */
+    typedef struct GpsConfig {
+        QString port = DEFAULT_GPS_PORT; //!< receiver serial port
+        bool useUbx = true; //!< configure a u-blox receiver for UBX NAV-PVT, false to read its NMEA output
+        qreal rateHz = DEFAULT_GPS_RATE_HZ; //!< navigation rate (UBX only)
+    } GpsConfig_t;
+
+    /**
+     * @struct ClockConfig
+     */
+    typedef struct ClockConfig {
+        bool setTime = true; //!< discipline the system clock to gps time
+        QString timeZone = CLOCK_TIME_ZONE_AUTO; //!< "auto" to look it up from the first fix, "system" to leave it, or a tz database id
+        int shmUnit = -1; //!< ntp shared memory refclock unit to serve gps time on, -1 for none
+        int latencyMsec = 0; //!< delay from the fix time to the fix arriving over the serial port
+    } ClockConfig_t;
+
+    /**
+     * @struct SensorHealthConfig
+     */
+    typedef struct SensorHealthConfig {
+        bool enabled = true; //!< watch the gauge sensors and fall back when they fault
+        int timeoutMsec = 2000; //!< no samples for this long is stale
+        int faultMsec = 300; //!< a fault has to hold this long to be reported
+        int recoverMsec = 2000; //!< ok has to hold this long to clear a fault
+    } SensorHealthConfig_t;
+
+    /**
+     * @struct AlarmConfig
+     */
+    typedef struct AlarmConfig {
+        QString name; //!< alarm name
+        QString expression; //!< condition that triggers the alarm, see @ref ChannelExpression
+        QString clear; //!< condition that clears the alarm, empty to clear when the trigger is false
+        int delayMsec = 0; //!< the trigger has to hold this long
+        QString light; //!< warning light model the alarm turns on, empty for none
+        bool buzzer = false; //!< the alarm sounds the buzzer
+    } AlarmConfig_t;
+
+    /**
+     * @struct BuzzerConfig
+     */
+    typedef struct BuzzerConfig {
+        int pin = -1; //!< sysfs gpio number of the buzzer output, -1 for none
+        bool activeLow = false; //!< the output is low when sounding
+    } BuzzerConfig_t;
+
+    /**
+     * @struct ShiftLightConfig
+     */
+    typedef struct ShiftLightConfig {
+        bool enabled = true; //!< drive the shift light
+        QList<qreal> shiftRpm; //!< shift point by gear, empty for the tach redline
+        QList<qreal> ratios; //!< rpm/speed ratio by gear, speed in the speedo's units -- empty for no gears
+        int stages = 5; //!< progressive stages, the last one lights at the shift point
+        qreal stageRpm = 250; //!< rpm between stages
+        int leadMsec = 100; //!< how far ahead the rpm is predicted
+        int mcpAddress = -1; //!< i2c address of an mcp23017 driving one led per stage, -1 for none
+    } ShiftLightConfig_t;
+
     /**
      * @struct GaugeConfig
      */
@@ -543,6 +742,8 @@ public:
     static constexpr char DEFAULT_GAUGE_CONFIG_PATH[] = "/opt/config_gauges.ini"; //!< default gauge config location
     static constexpr char DEFAULT_ODO_CONFIG_PATH[] = "/opt/config_odo.ini"; //!< default odometer config location
     static constexpr char DEFAULT_CAN_CONFIG_PATH[] = "/opt/config_can.ini"; //!< default CAN frame config location
+    static constexpr char DEFAULT_RECORDER_PATH[] = "/opt/recordings/"; //!< default session log location
+    static constexpr char DEFAULT_DATA_LOGGER_PATH[] = "/opt/logs/"; //!< default channel log location
 
     /**
      * @brief Constructor
@@ -554,18 +755,59 @@ public:
            QString gaugeConfigPath = DEFAULT_GAUGE_CONFIG_PATH,
            QString odoConfigPath = DEFAULT_ODO_CONFIG_PATH,
            QString canConfigPath = DEFAULT_CAN_CONFIG_PATH) :
-        QObject(parent) {
-        mConfig = new QSettings(configPath, QSettings::IniFormat);
-        loadConfig();
+        Config(parent, {configPath, gaugeConfigPath, odoConfigPath, canConfigPath}, QByteArray()) {
 
-        mGaugeConfig = new QSettings(gaugeConfigPath, QSettings::IniFormat);
-        loadGaugeConfigs();
+    }
 
-        mOdometerConfig = new QSettings(odoConfigPath, QSettings::IniFormat);
+    /**
+     * @brief Constructor -- restores a snapshot instead of parsing the ini files
+     * @param parent: Parent QObject
+     * @param configPaths: config, gauge, odometer and can config paths
+     * @param snapshot: @ref snapshot of the config, gauge and can configs -- the files are parsed if empty or invalid
+     */
+    Config(QObject * parent, QStringList configPaths, QByteArray snapshot) :
+        QObject(parent), mConfigPaths(configPaths) {
+        if (!restoreSnapshot(snapshot)) {
+            mConfig = new QSettings(mConfigPaths.at(0), QSettings::IniFormat);
+            loadConfig();
+
+            mGaugeConfig = new QSettings(mConfigPaths.at(1), QSettings::IniFormat);
+            loadGaugeConfigs();
+
+            mCanConfig = new QSettings(mConfigPaths.at(3), QSettings::IniFormat);
+            loadCanFrameConfigs();
+        }
+
+        // the odometer file is rewritten while driving -- always read live
+        mOdometerConfig = new QSettings(mConfigPaths.at(2), QSettings::IniFormat);
         loadOdometerConfigs();
+    }
 
-        mCanConfig = new QSettings(canConfigPath, QSettings::IniFormat);
-        loadCanFrameConfigs();
+    /**
+     * @brief Serialize everything parsed from the config, gauge and can configs
+     * (not the odometer) so a later boot can skip parsing them
+     * @return snapshot
+     */
+    QByteArray snapshot() {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        QMap<int, int> userInputs;
+        for (auto it = mUserInputConfig.cbegin(); it != mUserInputConfig.cend(); ++it) {
+            userInputs.insert(it.key(), (int) it.value());
+        }
+
+        stream << mSensorChannelConfig << mSensorSupplyVoltage << mDashLightConfig
+               << userInputs << mUserInputPinConfig << mMapSensorConfig << mTempSensorConfigs
+               << mTachConfig << mResistiveSensorConfig << mAnalog12VInputConfig
+               << mGaugeConfigs << mSpeedoGaugeConfig << mTachGaugeConfig << mVssInputConfig
+               << mBacklightConfig << mRecorderConfig << mDataLoggerConfig << mSensorFilterConfig
+               << mSampleRateConfig << mDerivedChannelConfigs << mPerfTimerConfig << mGpsConfig << mClockConfig << mSensorHealthConfig << mAlarmConfigs << mBuzzerConfig << mShiftLightConfig << mEnableCan << (qint32) mCanFrameConfigs.size();
+        for (const CanFrameConfig & conf : mCanFrameConfigs) {
+            conf.write(stream);
+        }
+        return data;
     }
 
     bool isCanEnabled() {
@@ -649,6 +891,15 @@ public:
         }
 
         mOdometerConfig->endArray();
+
+        mOdometerConfig->beginGroup(VSS_CALIBRATION_GROUP);
+        printKeys("odo", mOdometerConfig);
+        mVssCalibration = mOdometerConfig->value(VSS_CALIBRATION_SCALE, 1.0).toReal();
+        if (mVssCalibration <= 0) {
+            qDebug() << "Invalid VSS calibration" << mVssCalibration << "-- using 1.0";
+            mVssCalibration = 1.0;
+        }
+        mOdometerConfig->endGroup();
         return true;
     }
 
@@ -667,6 +918,20 @@ public:
         return true;
     }
 
+    /**
+     * @brief Write the learned VSS calibration to the odometer file
+     * @param scale: true distance per distance measured with the configured VSS input
+     * @return true if successful
+     */
+    bool writeVssCalibration(qreal scale) {
+        mVssCalibration = scale;
+        mOdometerConfig->beginGroup(VSS_CALIBRATION_GROUP);
+        mOdometerConfig->setValue(VSS_CALIBRATION_SCALE, scale);
+        mOdometerConfig->endGroup();
+        mOdometerConfig->sync();
+        return mOdometerConfig->status() == QSettings::NoError;
+    }
+
     /**
      * @brief Load gauge configs from the .ini file
      * @return true if successful
@@ -943,6 +1208,7 @@ public:
         mVssInputConfig.distanceUnits = getDistanceUnits(distanceUnits);
         mVssInputConfig.maxSpeed = mConfig->value(VSS_MAX_SPEED, 160).toInt();
         mVssInputConfig.useGps = mConfig->value(VSS_USE_GPS, false).toBool();
+        mVssInputConfig.autoCalibrate = mConfig->value(VSS_AUTO_CALIBRATE, true).toBool();
 
         printKeys("VSS Input: ", mConfig);
 
@@ -962,6 +1228,172 @@ public:
 
         mConfig->endGroup();
 
+        mConfig->beginGroup(RECORDER_GROUP);
+        mRecorderConfig.enable = mConfig->value(RECORDER_ENABLE, false).toBool();
+        mRecorderConfig.path = mConfig->value(RECORDER_PATH, DEFAULT_RECORDER_PATH).toString();
+
+        printKeys("Recorder Config: ", mConfig);
+
+        mConfig->endGroup();
+
+        mConfig->beginGroup(DATA_LOGGER_GROUP);
+        mDataLoggerConfig.enable = mConfig->value(DATA_LOGGER_ENABLE, false).toBool();
+        mDataLoggerConfig.path = mConfig->value(DATA_LOGGER_PATH, DEFAULT_DATA_LOGGER_PATH).toString();
+        mDataLoggerConfig.blockSeconds = mConfig->value(DATA_LOGGER_BLOCK_SECONDS, 10).toInt();
+        mDataLoggerConfig.syncSeconds = mConfig->value(DATA_LOGGER_SYNC_SECONDS, 30).toInt();
+        mDataLoggerConfig.maxPendingSamples = mConfig->value(DATA_LOGGER_MAX_PENDING, 65536).toInt();
+
+        printKeys("Data Logger Config: ", mConfig);
+
+        mConfig->endGroup();
+
+        // sensor filter chains, one list of stages per sensor
+        mConfig->beginGroup(SENSOR_FILTER_GROUP);
+        for (QString key : mConfig->childKeys()) {
+            mSensorFilterConfig.insert(key, mConfig->value(key).toStringList());
+        }
+
+        printKeys("Sensor Filters: ", mConfig);
+
+        mConfig->endGroup();
+
+        // sensor acquisition rates
+        mConfig->beginGroup(SAMPLE_RATE_GROUP);
+        for (QString key : mConfig->childKeys()) {
+            if (key == SAMPLE_RATE_DISPLAY_HZ) {
+                mSampleRateConfig.displayHz = mConfig->value(key, DEFAULT_DISPLAY_HZ).toReal();
+            } else {
+                mSampleRateConfig.acquireHz.insert(key, mConfig->value(key, 0).toReal());
+            }
+        }
+
+        printKeys("Sample Rates: ", mConfig);
+
+        mConfig->endGroup();
+
+        // channels computed from other channels
+        size = mConfig->beginReadArray(DERIVED_CHANNEL_GROUP);
+        for (int i = 0; i < size; ++i) {
+            mConfig->setArrayIndex(i);
+            DerivedChannelConfig_t derived;
+            derived.name = mConfig->value(DERIVED_CHANNEL_NAME, "").toString();
+            // an unquoted expression with commas reads as a list
+            derived.expression = mConfig->value(DERIVED_CHANNEL_EXPRESSION, "").toStringList().join(",");
+            derived.units = mConfig->value(DERIVED_CHANNEL_UNITS, "").toString();
+            derived.gauge = mConfig->value(DERIVED_CHANNEL_GAUGE, "").toString();
+
+            if (!derived.name.isEmpty()) {
+                mDerivedChannelConfigs.append(derived);
+            }
+            printKeys("Derived Channel: ", mConfig);
+        }
+        mConfig->endArray();
+
+        // acceleration and lap timing
+        mConfig->beginGroup(PERF_TIMER_GROUP);
+        mPerfTimerConfig.useGps = mConfig->value(PERF_TIMER_SOURCE, "vss").toString() == PERF_TIMER_SOURCE_GPS;
+        QStringList finishLine = mConfig->value(PERF_TIMER_FINISH_LINE).toStringList();
+        if (finishLine.size() == 4) {
+            for (QString coord : finishLine) {
+                mPerfTimerConfig.finishLine.append(coord.toDouble());
+            }
+        } else if (!finishLine.isEmpty()) {
+            qDebug() << "Invalid finish line, expected lat1, lon1, lat2, lon2: " << finishLine;
+        }
+
+        printKeys("Performance Timer: ", mConfig);
+
+        mConfig->endGroup();
+
+        // gps receiver
+        mConfig->beginGroup(GPS_GROUP);
+        mGpsConfig.port = mConfig->value(GPS_PORT, DEFAULT_GPS_PORT).toString();
+        mGpsConfig.useUbx = mConfig->value(GPS_PROTOCOL, "ubx").toString() != GPS_PROTOCOL_NMEA;
+        mGpsConfig.rateHz = mConfig->value(GPS_RATE_HZ, DEFAULT_GPS_RATE_HZ).toReal();
+
+        printKeys("GPS: ", mConfig);
+
+        mConfig->endGroup();
+
+        // gps time and time zone
+        mConfig->beginGroup(CLOCK_GROUP);
+        mClockConfig.setTime = mConfig->value(CLOCK_SET_TIME, true).toBool();
+        mClockConfig.timeZone = mConfig->value(CLOCK_TIME_ZONE, CLOCK_TIME_ZONE_AUTO).toString();
+        mClockConfig.shmUnit = mConfig->value(CLOCK_SHM_UNIT, -1).toInt();
+        mClockConfig.latencyMsec = mConfig->value(CLOCK_LATENCY_MSEC, 0).toInt();
+
+        printKeys("Clock: ", mConfig);
+
+        mConfig->endGroup();
+
+        // sensor fault detection
+        mConfig->beginGroup(SENSOR_HEALTH_GROUP);
+        mSensorHealthConfig.enabled = mConfig->value(SENSOR_HEALTH_ENABLED, true).toBool();
+        mSensorHealthConfig.timeoutMsec = mConfig->value(SENSOR_HEALTH_TIMEOUT_MSEC, 2000).toInt();
+        mSensorHealthConfig.faultMsec = mConfig->value(SENSOR_HEALTH_FAULT_MSEC, 300).toInt();
+        mSensorHealthConfig.recoverMsec = mConfig->value(SENSOR_HEALTH_RECOVER_MSEC, 2000).toInt();
+
+        printKeys("Sensor health: ", mConfig);
+
+        mConfig->endGroup();
+
+        // alarm rules
+        size = mConfig->beginReadArray(ALARM_GROUP);
+        for (int i = 0; i < size; ++i) {
+            mConfig->setArrayIndex(i);
+            AlarmConfig_t alarm;
+            alarm.name = mConfig->value(ALARM_NAME, "").toString();
+            // an unquoted expression with commas reads as a list
+            alarm.expression = mConfig->value(ALARM_EXPRESSION, "").toStringList().join(",");
+            alarm.clear = mConfig->value(ALARM_CLEAR, "").toStringList().join(",");
+            alarm.delayMsec = mConfig->value(ALARM_DELAY_MSEC, 0).toInt();
+            alarm.light = mConfig->value(ALARM_LIGHT, "").toString();
+            alarm.buzzer = mConfig->value(ALARM_BUZZER, false).toBool();
+
+            if (!alarm.name.isEmpty()) {
+                mAlarmConfigs.append(alarm);
+            }
+            printKeys("Alarm: ", mConfig);
+        }
+        mConfig->endArray();
+
+        // alarm buzzer output
+        mConfig->beginGroup(BUZZER_GROUP);
+        mBuzzerConfig.pin = mConfig->value(BUZZER_PIN, -1).toInt();
+        mBuzzerConfig.activeLow = mConfig->value(BUZZER_ACTIVE_LOW, false).toBool();
+
+        printKeys("Buzzer: ", mConfig);
+
+        mConfig->endGroup();
+
+        // progressive shift light
+        mConfig->beginGroup(SHIFT_LIGHT_GROUP);
+        mShiftLightConfig.enabled = mConfig->value(SHIFT_LIGHT_ENABLED, true).toBool();
+        for (QString rpm : mConfig->value(SHIFT_LIGHT_SHIFT_RPM).toStringList()) {
+            mShiftLightConfig.shiftRpm.append(rpm.toDouble());
+        }
+        for (QString ratio : mConfig->value(SHIFT_LIGHT_RATIOS).toStringList()) {
+            mShiftLightConfig.ratios.append(ratio.toDouble());
+        }
+        mShiftLightConfig.stages = mConfig->value(SHIFT_LIGHT_STAGES, 5).toInt();
+        mShiftLightConfig.stageRpm = mConfig->value(SHIFT_LIGHT_STAGE_RPM, 250).toReal();
+        mShiftLightConfig.leadMsec = mConfig->value(SHIFT_LIGHT_LEAD_MSEC, 100).toInt();
+        // hex, like i2cdetect shows it
+        bool ok = false;
+        int mcpAddress = mConfig->value(SHIFT_LIGHT_MCP_ADDRESS, "-1").toString().toInt(&ok, 0);
+        mShiftLightConfig.mcpAddress = ok ? mcpAddress : -1;
+
+        printKeys("Shift light: ", mConfig);
+
+        mConfig->endGroup();
+
+        // the resistive sensor lag setting is the first stage of its chain
+        for (const ResistiveSensorConfig_t & conf : mResistiveSensorConfig) {
+            if (conf.lag != 1.0) {
+                mSensorFilterConfig[conf.type].prepend(QString("lag:%1").arg(conf.lag));
+            }
+        }
+
         return keys.size() > 0;
     }
 
@@ -1094,10 +1526,83 @@ public:
         return {DistanceUnits::MILE, 0, 0, ""};
     }
 
+    /**
+     * @brief Get the learned VSS calibration
+     * @return true distance per distance measured with the configured VSS input, 1.0 if not learned
+     */
+    qreal getVssCalibration() {
+        return mVssCalibration;
+    }
+
     BacklightControlConfig_t getBackLightConfig() {
         return mBacklightConfig;
     }
 
+    RecorderConfig_t getRecorderConfig() {
+        return mRecorderConfig;
+    }
+
+    DataLoggerConfig_t getDataLoggerConfig() {
+        return mDataLoggerConfig;
+    }
+
+    /**
+     * @brief Get a sensor's filter chain
+     * @param name: sensor key
+     * @return filter stage specs, see @ref SensorFilter -- empty if unfiltered
+     */
+    QStringList getSensorFilterConfig(QString name) {
+        return mSensorFilterConfig.value(name);
+    }
+
+    SampleRateConfig_t getSampleRateConfig() {
+        return mSampleRateConfig;
+    }
+
+    /**
+     * @brief Get the derived channels
+     * @return channel configs, in config order -- a channel can read the ones before it
+     */
+    QList<DerivedChannelConfig_t> getDerivedChannelConfigs() {
+        return mDerivedChannelConfigs;
+    }
+
+    PerfTimerConfig_t getPerfTimerConfig() {
+        return mPerfTimerConfig;
+    }
+
+    GpsConfig_t getGpsConfig() {
+        return mGpsConfig;
+    }
+
+    ClockConfig_t getClockConfig() {
+        return mClockConfig;
+    }
+
+    SensorHealthConfig_t getSensorHealthConfig() {
+        return mSensorHealthConfig;
+    }
+
+    QList<AlarmConfig_t> getAlarmConfigs() {
+        return mAlarmConfigs;
+    }
+
+    BuzzerConfig_t getBuzzerConfig() {
+        return mBuzzerConfig;
+    }
+
+    ShiftLightConfig_t getShiftLightConfig() {
+        return mShiftLightConfig;
+    }
+
+    /**
+     * @brief Get the paths of the ini files this config was loaded from
+     * @return config, gauge config, odometer config and can config paths
+     */
+    QStringList getConfigFilePaths() {
+        return mConfigPaths;
+    }
+
     QList<CanFrameConfig> getCanFrameConfigs() {
         return mCanFrameConfigs;
     }
@@ -1130,6 +1635,9 @@ signals:
 public slots:
 
 private:
+    friend class ConfigCache;
+
+    QStringList mConfigPaths; //!< config, gauge, odometer and can config paths
     QSettings * mConfig = nullptr;  //!< QSettings for reading config.ini file
     QMap<QString, int> mSensorChannelConfig; //!< sensor channel configuration
     qreal mSensorSupplyVoltage = DEFAULT_V_SUPPLY;
@@ -1150,13 +1658,289 @@ private:
 
     QSettings * mOdometerConfig = nullptr;
     QList<OdometerConfig_t> mOdoConfig;
+    qreal mVssCalibration = 1.0; //!< learned VSS calibration
 
     BacklightControlConfig_t mBacklightConfig;
 
-    QSettings * mCanConfig;
+    RecorderConfig_t mRecorderConfig; //!< sensor session recorder config
+    DataLoggerConfig_t mDataLoggerConfig; //!< channel data logger config
+    QMap<QString, QStringList> mSensorFilterConfig; //!< filter stage specs by sensor key
+    SampleRateConfig_t mSampleRateConfig; //!< sensor acquisition and display rates
+    QList<DerivedChannelConfig_t> mDerivedChannelConfigs; //!< channels computed from other channels
+    PerfTimerConfig_t mPerfTimerConfig; //!< acceleration and lap timing config
+    GpsConfig_t mGpsConfig; //!< gps receiver config
+    ClockConfig_t mClockConfig; //!< gps time config
+    SensorHealthConfig_t mSensorHealthConfig; //!< sensor fault detection config
+    QList<AlarmConfig_t> mAlarmConfigs; //!< alarm rules
+    BuzzerConfig_t mBuzzerConfig; //!< alarm buzzer output
+    ShiftLightConfig_t mShiftLightConfig; //!< progressive shift light config
+
+    QSettings * mCanConfig = nullptr;
     bool mEnableCan = false;
     QList<CanFrameConfig> mCanFrameConfigs;
 
+    /**
+     * @brief Restore a @ref snapshot
+     * @param data: snapshot
+     * @return true if restored, false if empty or corrupt
+     */
+    bool restoreSnapshot(QByteArray data) {
+        if (data.isEmpty()) {
+            return false;
+        }
+
+        QDataStream stream(data);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        QMap<int, int> userInputs;
+        qint32 canFrames = 0;
+        stream >> mSensorChannelConfig >> mSensorSupplyVoltage >> mDashLightConfig
+               >> userInputs >> mUserInputPinConfig >> mMapSensorConfig >> mTempSensorConfigs
+               >> mTachConfig >> mResistiveSensorConfig >> mAnalog12VInputConfig
+               >> mGaugeConfigs >> mSpeedoGaugeConfig >> mTachGaugeConfig >> mVssInputConfig
+               >> mBacklightConfig >> mRecorderConfig >> mDataLoggerConfig >> mSensorFilterConfig
+               >> mSampleRateConfig >> mDerivedChannelConfigs >> mPerfTimerConfig >> mGpsConfig >> mClockConfig >> mSensorHealthConfig >> mAlarmConfigs >> mBuzzerConfig >> mShiftLightConfig >> mEnableCan >> canFrames;
+        mUserInputConfig.clear();
+        for (auto it = userInputs.cbegin(); it != userInputs.cend(); ++it) {
+            mUserInputConfig.insert(it.key(), (Qt::Key) it.value());
+        }
+        mCanFrameConfigs.clear();
+        for (int i = 0; i < canFrames && stream.status() == QDataStream::Ok; i++) {
+            mCanFrameConfigs.append(CanFrameConfig::read(stream));
+        }
+
+        if (stream.status() != QDataStream::Ok || !stream.atEnd()) {
+            qDebug() << "Config snapshot is corrupt -- parsing config files";
+            // the loaders append to the lists, so drop whatever was read before the error
+            clearSnapshotConfigs();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reset everything a @ref snapshot holds to its unparsed state
+     */
+    void clearSnapshotConfigs() {
+        mSensorChannelConfig.clear();
+        mSensorSupplyVoltage = DEFAULT_V_SUPPLY;
+        mDashLightConfig.clear();
+        mUserInputConfig.clear();
+        mUserInputPinConfig.clear();
+        mMapSensorConfig = MapSensorConfig_t();
+        mTempSensorConfigs.clear();
+        mTachConfig = TachInputConfig_t();
+        mResistiveSensorConfig.clear();
+        mAnalog12VInputConfig.clear();
+        mGaugeConfigs.clear();
+        mSpeedoGaugeConfig = SpeedoConfig_t();
+        mTachGaugeConfig = TachoConfig_t();
+        mVssInputConfig = VssInputConfig_t();
+        mBacklightConfig = BacklightControlConfig_t();
+        mRecorderConfig = RecorderConfig_t();
+        mDataLoggerConfig = DataLoggerConfig_t();
+        mSensorFilterConfig.clear();
+        mSampleRateConfig = SampleRateConfig_t();
+        mDerivedChannelConfigs.clear();
+        mPerfTimerConfig = PerfTimerConfig_t();
+        mGpsConfig = GpsConfig_t();
+        mClockConfig = ClockConfig_t();
+        mSensorHealthConfig = SensorHealthConfig_t();
+        mAlarmConfigs.clear();
+        mBuzzerConfig = BuzzerConfig_t();
+        mShiftLightConfig = ShiftLightConfig_t();
+        mEnableCan = false;
+        mCanFrameConfigs.clear();
+    }
+
+    // snapshot serialization for the config structs
+    friend QDataStream & operator<<(QDataStream & s, const ResistiveSensorConfig_t & c) {
+        return s << c.type << (qint32) c.fitType << c.x << c.y << c.coeff << (qint32) c.order
+                 << c.rBalance << c.units << c.lag << c.vSupply;
+    }
+    friend QDataStream & operator>>(QDataStream & s, ResistiveSensorConfig_t & c) {
+        qint32 fitType = 0, order = 0;
+        s >> c.type >> fitType >> c.x >> c.y >> c.coeff >> order >> c.rBalance >> c.units >> c.lag >> c.vSupply;
+        c.fitType = (ResistiveSensorType) fitType;
+        c.order = order;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const Analog12VInputConfig_t & c) {
+        return s << c.type << c.optoR1 << c.optoR2 << c.inputR1 << c.inputR2 << c.gainK3 << c.offset
+                 << c.x << c.y << c.coeff << (qint32) c.order;
+    }
+    friend QDataStream & operator>>(QDataStream & s, Analog12VInputConfig_t & c) {
+        qint32 order = 0;
+        s >> c.type >> c.optoR1 >> c.optoR2 >> c.inputR1 >> c.inputR2 >> c.gainK3 >> c.offset
+          >> c.x >> c.y >> c.coeff >> order;
+        c.order = order;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const MapSensorConfig_t & c) {
+        return s << c.p0V << c.p5V << c.pAtm << (qint32) c.units;
+    }
+    friend QDataStream & operator>>(QDataStream & s, MapSensorConfig_t & c) {
+        qint32 units = 0;
+        s >> c.p0V >> c.p5V >> c.pAtm >> units;
+        c.units = (PressureUnits) units;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const TempSensorConfig_t & c) {
+        return s << c.rBalance << c.vSupply << c.t1 << c.t2 << c.t3 << c.r1 << c.r2 << c.r3
+                 << (qint32) c.units << (qint32) c.type;
+    }
+    friend QDataStream & operator>>(QDataStream & s, TempSensorConfig_t & c) {
+        qint32 units = 0, type = 0;
+        s >> c.rBalance >> c.vSupply >> c.t1 >> c.t2 >> c.t3 >> c.r1 >> c.r2 >> c.r3 >> units >> type;
+        c.units = (TemperatureUnits) units;
+        c.type = (TemperatureSensorType) type;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const TachInputConfig_t & c) {
+        return s << (qint32) c.pulsesPerRot << (qint32) c.maxRpm << (qint32) c.avgNumSamples;
+    }
+    friend QDataStream & operator>>(QDataStream & s, TachInputConfig_t & c) {
+        qint32 pulsesPerRot = 0, maxRpm = 0, avgNumSamples = 0;
+        s >> pulsesPerRot >> maxRpm >> avgNumSamples;
+        c = {pulsesPerRot, maxRpm, avgNumSamples};
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const VssInputConfig_t & c) {
+        return s << (qint32) c.pulsePerRot << c.tireDiameter << (qint32) c.tireDiameterUnits
+                 << (qint32) c.pulsePerUnitDistance << (qint32) c.distanceUnits << (qint32) c.maxSpeed << c.useGps
+                 << c.autoCalibrate;
+    }
+    friend QDataStream & operator>>(QDataStream & s, VssInputConfig_t & c) {
+        qint32 pulsePerRot = 0, tireDiameterUnits = 0, pulsePerUnitDistance = 0, distanceUnits = 0, maxSpeed = 0;
+        s >> pulsePerRot >> c.tireDiameter >> tireDiameterUnits >> pulsePerUnitDistance
+          >> distanceUnits >> maxSpeed >> c.useGps >> c.autoCalibrate;
+        c.pulsePerRot = pulsePerRot;
+        c.tireDiameterUnits = (DistanceUnits) tireDiameterUnits;
+        c.pulsePerUnitDistance = pulsePerUnitDistance;
+        c.distanceUnits = (DistanceUnits) distanceUnits;
+        c.maxSpeed = maxSpeed;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const BacklightControlConfig_t & c) {
+        return s << c.minDutyCycle << c.maxDutyCycle << c.lightsOffDutyCycle << c.lightsOnDutyCycle
+                 << c.minDimmerRatio << c.maxDimmerRatio << c.useDimmer << c.activeLow;
+    }
+    friend QDataStream & operator>>(QDataStream & s, BacklightControlConfig_t & c) {
+        return s >> c.minDutyCycle >> c.maxDutyCycle >> c.lightsOffDutyCycle >> c.lightsOnDutyCycle
+                 >> c.minDimmerRatio >> c.maxDimmerRatio >> c.useDimmer >> c.activeLow;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const RecorderConfig_t & c) {
+        return s << c.enable << c.path;
+    }
+    friend QDataStream & operator>>(QDataStream & s, RecorderConfig_t & c) {
+        return s >> c.enable >> c.path;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const DataLoggerConfig_t & c) {
+        return s << c.enable << c.path << (qint32) c.blockSeconds << (qint32) c.syncSeconds
+                 << (qint32) c.maxPendingSamples;
+    }
+    friend QDataStream & operator>>(QDataStream & s, DataLoggerConfig_t & c) {
+        qint32 blockSeconds = 0, syncSeconds = 0, maxPendingSamples = 0;
+        s >> c.enable >> c.path >> blockSeconds >> syncSeconds >> maxPendingSamples;
+        c.blockSeconds = blockSeconds;
+        c.syncSeconds = syncSeconds;
+        c.maxPendingSamples = maxPendingSamples;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const SampleRateConfig_t & c) {
+        return s << c.displayHz << c.acquireHz;
+    }
+    friend QDataStream & operator>>(QDataStream & s, SampleRateConfig_t & c) {
+        return s >> c.displayHz >> c.acquireHz;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const DerivedChannelConfig_t & c) {
+        return s << c.name << c.expression << c.units << c.gauge;
+    }
+    friend QDataStream & operator>>(QDataStream & s, DerivedChannelConfig_t & c) {
+        return s >> c.name >> c.expression >> c.units >> c.gauge;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const PerfTimerConfig_t & c) {
+        return s << c.useGps << c.finishLine;
+    }
+    friend QDataStream & operator>>(QDataStream & s, PerfTimerConfig_t & c) {
+        return s >> c.useGps >> c.finishLine;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const GpsConfig_t & c) {
+        return s << c.port << c.useUbx << c.rateHz;
+    }
+    friend QDataStream & operator>>(QDataStream & s, GpsConfig_t & c) {
+        return s >> c.port >> c.useUbx >> c.rateHz;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const ClockConfig_t & c) {
+        return s << c.setTime << c.timeZone << (qint32) c.shmUnit << (qint32) c.latencyMsec;
+    }
+    friend QDataStream & operator>>(QDataStream & s, ClockConfig_t & c) {
+        qint32 shmUnit = -1, latencyMsec = 0;
+        s >> c.setTime >> c.timeZone >> shmUnit >> latencyMsec;
+        c.shmUnit = shmUnit;
+        c.latencyMsec = latencyMsec;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const SensorHealthConfig_t & c) {
+        return s << c.enabled << (qint32) c.timeoutMsec << (qint32) c.faultMsec << (qint32) c.recoverMsec;
+    }
+    friend QDataStream & operator>>(QDataStream & s, SensorHealthConfig_t & c) {
+        qint32 timeoutMsec = 0, faultMsec = 0, recoverMsec = 0;
+        s >> c.enabled >> timeoutMsec >> faultMsec >> recoverMsec;
+        c.timeoutMsec = timeoutMsec;
+        c.faultMsec = faultMsec;
+        c.recoverMsec = recoverMsec;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const AlarmConfig_t & c) {
+        return s << c.name << c.expression << c.clear << (qint32) c.delayMsec << c.light << c.buzzer;
+    }
+    friend QDataStream & operator>>(QDataStream & s, AlarmConfig_t & c) {
+        qint32 delayMsec = 0;
+        s >> c.name >> c.expression >> c.clear >> delayMsec >> c.light >> c.buzzer;
+        c.delayMsec = delayMsec;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const BuzzerConfig_t & c) {
+        return s << (qint32) c.pin << c.activeLow;
+    }
+    friend QDataStream & operator>>(QDataStream & s, BuzzerConfig_t & c) {
+        qint32 pin = -1;
+        s >> pin >> c.activeLow;
+        c.pin = pin;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const ShiftLightConfig_t & c) {
+        return s << c.enabled << c.shiftRpm << c.ratios << (qint32) c.stages << c.stageRpm
+                 << (qint32) c.leadMsec << (qint32) c.mcpAddress;
+    }
+    friend QDataStream & operator>>(QDataStream & s, ShiftLightConfig_t & c) {
+        qint32 stages = 0, leadMsec = 0, mcpAddress = -1;
+        s >> c.enabled >> c.shiftRpm >> c.ratios >> stages >> c.stageRpm >> leadMsec >> mcpAddress;
+        c.stages = stages;
+        c.leadMsec = leadMsec;
+        c.mcpAddress = mcpAddress;
+        return s;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const GaugeConfig_t & c) {
+        return s << c.min << c.max << c.lowAlarm << c.highAlarm << c.displayUnits;
+    }
+    friend QDataStream & operator>>(QDataStream & s, GaugeConfig_t & c) {
+        return s >> c.min >> c.max >> c.lowAlarm >> c.highAlarm >> c.displayUnits;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const SpeedoConfig_t & c) {
+        return s << c.gaugeConfig << c.topSource << c.topUnits;
+    }
+    friend QDataStream & operator>>(QDataStream & s, SpeedoConfig_t & c) {
+        return s >> c.gaugeConfig >> c.topSource >> c.topUnits;
+    }
+    friend QDataStream & operator<<(QDataStream & s, const TachoConfig_t & c) {
+        return s << c.maxRpm << c.redline;
+    }
+    friend QDataStream & operator>>(QDataStream & s, TachoConfig_t & c) {
+        return s >> c.maxRpm >> c.redline;
+    }
+
     /**
      * @brief Check that values are valid in a map
      * @param map: map to check
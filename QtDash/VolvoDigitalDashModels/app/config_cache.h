@@ -0,0 +1,259 @@
+#ifndef CONFIG_CACHE_H
+#define CONFIG_CACHE_H
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <config.h>
+#include <sensor_utils.h>
+
+/**
+ * @brief Parsed config cached as a binary snapshot.
+ *
+ * Parsing the ini files and fitting the sensor calibration curves is done on a
+ * worker thread started with @ref preload as early as possible in startup, so
+ * it overlaps with bringing up the display and QML engine. The result
+ * (including the fitted polynomial coefficients) is written to a disk cache
+ * and read back directly on later boots while the ini files are unchanged.
+ *
+ * The odometer file is rewritten while driving, so it is left out of the
+ * snapshot and always parsed by @ref Config.
+ *
+ * Disk entry layout (QDataStream, big endian):
+ *  quint32 MAGIC, quint16 VERSION, qint32 file count,
+ *  per file (QString path, qint64 size, qint64 modified time (ms)),
+ *  QByteArray snapshot (@ref Config::snapshot)
+ */
+class ConfigCache {
+public:
+    static constexpr quint32 MAGIC = 0x56444343; //!< "VDCC"
+    static constexpr quint16 VERSION = 11; //!< bump when the snapshot layout changes
+    static constexpr char FILE_NAME[] = "config.cache"; //!< disk entry name under the app cache location
+
+    /**
+     * @brief Start loading a config on a worker thread
+     * @param configPaths: config, gauge, odometer and can config paths
+     */
+    static void preload(QStringList configPaths) {
+        State & state = getState();
+        QMutexLocker lock(&state.mutex);
+        if (state.thread) {
+            return;
+        }
+        state.paths = configPaths;
+        state.thread = QThread::create([configPaths]() {
+            QByteArray snapshot = load(configPaths);
+            State & state = getState();
+            QMutexLocker lock(&state.mutex);
+            state.snapshot = snapshot;
+        });
+        state.thread->start();
+    }
+
+    /**
+     * @brief Get the snapshot for a config -- waits for a matching @ref preload,
+     * otherwise loads it on the calling thread
+     * @param configPaths: config, gauge, odometer and can config paths
+     * @return snapshot to construct a @ref Config with
+     */
+    static QByteArray take(QStringList configPaths) {
+        State & state = getState();
+        QMutexLocker lock(&state.mutex);
+        if (state.thread && state.paths == configPaths) {
+            QThread * thread = state.thread;
+            lock.unlock();
+            thread->wait();
+            lock.relock();
+
+            QByteArray snapshot = state.snapshot;
+            delete state.thread;
+            state.thread = nullptr;
+            state.snapshot.clear();
+            return snapshot;
+        }
+        lock.unlock();
+        return load(configPaths);
+    }
+
+    /**
+     * @brief Read the snapshot from the disk cache, or parse the config and cache it
+     * @param configPaths: config, gauge, odometer and can config paths
+     * @return snapshot
+     */
+    static QByteArray load(QStringList configPaths) {
+        QString path = getPath();
+        QByteArray snapshot = readEntry(path, configPaths);
+        if (!snapshot.isEmpty()) {
+            return snapshot;
+        }
+
+        Config config(nullptr, configPaths, QByteArray());
+        fitCurves(&config);
+        validate(&config);
+
+        snapshot = config.snapshot();
+        writeEntry(path, configPaths, snapshot);
+        return snapshot;
+    }
+
+    /**
+     * @brief Set the disk cache path
+     * @param path: file path, empty to disable the disk cache
+     */
+    static void setPath(QString path) {
+        State & state = getState();
+        QMutexLocker lock(&state.mutex);
+        state.path = path;
+    }
+
+    static QString getPath() {
+        State & state = getState();
+        QMutexLocker lock(&state.mutex);
+        return state.path;
+    }
+
+private:
+    /**
+     * @struct State
+     */
+    typedef struct State {
+        QMutex mutex; //!< guards everything below
+        QString path = defaultPath(); //!< disk cache file, empty = disabled
+        QStringList paths; //!< paths being preloaded
+        QThread * thread = nullptr; //!< preload thread
+        QByteArray snapshot; //!< preload result
+    } State_t;
+
+    static State & getState() {
+        static State state;
+        return state;
+    }
+
+    static QString defaultPath() {
+        QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        return base.isEmpty() ? QString() : QDir(base).filePath(FILE_NAME);
+    }
+
+    /**
+     * @brief Files the snapshot depends on -- config, gauge and can configs
+     */
+    static QStringList sourceFiles(QStringList configPaths) {
+        return {configPaths.at(0), configPaths.at(1), configPaths.at(3)};
+    }
+
+    /**
+     * @brief Fit the polynomial calibration curves so the sensors don't have to
+     * @param config: parsed config
+     */
+    static void fitCurves(Config * config) {
+        for (Config::ResistiveSensorConfig_t & conf : config->mResistiveSensorConfig) {
+            if (conf.fitType == Config::ResistiveSensorType::POLYNOMIAL) {
+                conf.coeff = SensorUtils::polynomialRegression(conf.x, conf.y, conf.order);
+            }
+        }
+        for (Config::Analog12VInputConfig_t & conf : config->mAnalog12VInputConfig) {
+            if (conf.order == 1) {
+                conf.coeff = SensorUtils::polynomialRegression(conf.x, conf.y, conf.order);
+            }
+        }
+    }
+
+    /**
+     * @brief Log config problems once, when the files are parsed
+     * @param config: parsed config
+     */
+    static void validate(Config * config) {
+        if (!config->isSensorConfigValid()) {
+            qDebug() << "Config: sensor channels are missing or share an ADC channel";
+        }
+        if (!config->isDashLightConfigValid()) {
+            qDebug() << "Config: dash lights are missing or share an input";
+        }
+        if (!config->mMapSensorConfig.isValid()) {
+            qDebug() << "Config: invalid MAP sensor calibration";
+        }
+        for (Config::TempSensorConfig_t & conf : config->mTempSensorConfigs) {
+            if (!conf.isValid()) {
+                qDebug() << "Config: invalid temperature sensor calibration, type" << (int) conf.type;
+            }
+        }
+    }
+
+    /**
+     * @brief Read a disk entry
+     * @return snapshot, empty if missing, stale or corrupt
+     */
+    static QByteArray readEntry(QString path, QStringList configPaths) {
+        if (path.isEmpty()) {
+            return QByteArray();
+        }
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QByteArray();
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic = 0;
+        quint16 version = 0;
+        qint32 count = 0;
+        stream >> magic >> version >> count;
+        if (stream.status() != QDataStream::Ok || magic != MAGIC || version != VERSION) {
+            return QByteArray();
+        }
+
+        QStringList sources = sourceFiles(configPaths);
+        if (count != sources.size()) {
+            return QByteArray();
+        }
+        for (const QString & source : sources) {
+            QString entryPath;
+            qint64 size = 0, modified = 0;
+            stream >> entryPath >> size >> modified;
+
+            QFileInfo info(source);
+            if (entryPath != info.absoluteFilePath() || size != info.size() ||
+                    modified != info.lastModified().toMSecsSinceEpoch()) {
+                return QByteArray();
+            }
+        }
+
+        QByteArray snapshot;
+        stream >> snapshot;
+        return (stream.status() == QDataStream::Ok) ? snapshot : QByteArray();
+    }
+
+    /**
+     * @brief Write a disk entry -- failures only cost the next boot a parse
+     */
+    static void writeEntry(QString path, QStringList configPaths, QByteArray snapshot) {
+        if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).path())) {
+            return;
+        }
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        QStringList sources = sourceFiles(configPaths);
+        stream << MAGIC << VERSION << (qint32) sources.size();
+        for (const QString & source : sources) {
+            QFileInfo info(source);
+            stream << info.absoluteFilePath() << info.size() << info.lastModified().toMSecsSinceEpoch();
+        }
+        stream << snapshot;
+        file.commit();
+    }
+};
+
+#endif // CONFIG_CACHE_H
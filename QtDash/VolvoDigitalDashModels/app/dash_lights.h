@@ -6,6 +6,8 @@
 #include <warning_light_model.h>
 #include <config.h>
 #include <QMap>
+#include <QSet>
+#include <QDebug>
 #include <mcp23017.h>
 #include <QElapsedTimer>
 
@@ -109,6 +111,7 @@ public:
 signals:
     void userInputActive(uint8_t input);
     void userInputLongPress(uint8_t input);
+    void inputsRead(quint16 inputs);
 
 public slots:
     /**
@@ -125,25 +128,49 @@ public slots:
         // combine ports
         uint16_t inputs = (portB << 8) | portA;
 
+        emit inputsRead(inputs);
+        setInputs(inputs);
+#else
+        mLeftBlinkerModel.setOn(true);
+        mRightBlinkerModel.setOn(true);
+        mHighBeamLightModel.setOn(true);
+        mParkingBrakeLightModel.setOn(true);
+        mBrakeFailureLightModel.setOn(true);
+        mBulbFailureLightModel.setOn(true);
+        mSrsWarningLightModel.setOn(true);
+        mOilWarningLightModel.setOn(true);
+        mBatteryWarningLightModel.setOn(true);
+        mAbsWarningLightModel.setOn(true);
+        mCheckEngineLightModel.setOn(true);
+        mShiftUpLightModel.setOn(true);
+        mServiceLightModel.setOn(true);
+#endif
+    }
+
+    /**
+     * @brief Apply a raw GPIO input word (port B << 8 | port A) to the lights and user inputs
+     * @param inputs: gpio input word -- read from the mcp23017 or replayed from a session log
+     */
+    void setInputs(quint16 inputs) {
         auto lightConf = mLightsConfig;
         bool activeLow = mLightsConfig.value(Config::ACTIVE_LOW, true);
 
         // set em
         mLeftBlinkerModel.setOn(readPin(lightConf.value(Config::BLINKER_LEFT_KEY), inputs, activeLow));
         mRightBlinkerModel.setOn(readPin(lightConf.value(Config::BLINKER_RIGHT_KEY), inputs, activeLow));
-        mHighBeamLightModel.setOn(readPin(lightConf.value(Config::HIGH_BEAM_KEY), inputs, activeLow));
-        mParkingBrakeLightModel.setOn(readPin(lightConf.value(Config::PARKING_BRAKE_KEY), inputs, activeLow));
-        mBrakeFailureLightModel.setOn(readPin(lightConf.value(Config::BRAKE_FAILURE_KEY), inputs, activeLow));
-        mBulbFailureLightModel.setOn(readPin(lightConf.value(Config::BULB_FAILURE_KEY), inputs, activeLow));;
-        mSrsWarningLightModel.setOn(readPin(lightConf.value(Config::OD_LAMP_KEY), inputs, activeLow));
-        mOilWarningLightModel.setOn(readPin(lightConf.value(Config::OIL_PRESSURE_SW_KEY), inputs, activeLow));
-        mBatteryWarningLightModel.setOn(readPin(lightConf.value(Config::CHARGING_LIGHT_KEY), inputs, activeLow));
-        mAbsWarningLightModel.setOn(readPin(lightConf.value(Config::CONN_32_PIN3), inputs, activeLow));
-        mCheckEngineLightModel.setOn(readPin(lightConf.value(Config::CHECK_ENGINE_KEY), inputs, activeLow));
-
-        // not used at the moment?
-        mShiftUpLightModel.setOn(0);
-        mServiceLightModel.setOn(0);
+        setLight(HIGH_BEAM_MODEL_NAME, readPin(lightConf.value(Config::HIGH_BEAM_KEY), inputs, activeLow));
+        setLight(PARKING_BRAKE_MODEL_NAME, readPin(lightConf.value(Config::PARKING_BRAKE_KEY), inputs, activeLow));
+        setLight(BRAKE_FAILURE_MODEL_NAME, readPin(lightConf.value(Config::BRAKE_FAILURE_KEY), inputs, activeLow));
+        setLight(BULB_FAILURE_MODEL_NAME, readPin(lightConf.value(Config::BULB_FAILURE_KEY), inputs, activeLow));
+        setLight(SRS_WARNING_MODEL_NAME, readPin(lightConf.value(Config::OD_LAMP_KEY), inputs, activeLow));
+        setLight(OIL_WARNING_MODEL_NAME, readPin(lightConf.value(Config::OIL_PRESSURE_SW_KEY), inputs, activeLow));
+        setLight(BATTERY_WARNING_MODEL_NAME, readPin(lightConf.value(Config::CHARGING_LIGHT_KEY), inputs, activeLow));
+        setLight(ABS_WARNING_MODEL_NAME, readPin(lightConf.value(Config::CONN_32_PIN3), inputs, activeLow));
+        setLight(CHECK_ENGINE_MODEL_NAME, readPin(lightConf.value(Config::CHECK_ENGINE_KEY), inputs, activeLow));
+
+        // no input pins, only alarms and the shift light drive these
+        setLight(SHIFT_UP_MODEL_NAME, false);
+        setLight(SERVICE_ENGINE_MODEL_NAME, false);
 
         // deal with user inputs here
         auto userInputPinConfig = mConfig->getUserInputPinConfig();
@@ -184,22 +211,32 @@ public slots:
         } else {
             mActiveInput.reset();
         }
+    }
 
-#else
-        mLeftBlinkerModel.setOn(true);
-        mRightBlinkerModel.setOn(true);
-        mHighBeamLightModel.setOn(true);
-        mParkingBrakeLightModel.setOn(true);
-        mBrakeFailureLightModel.setOn(true);
-        mBulbFailureLightModel.setOn(true);
-        mSrsWarningLightModel.setOn(true);
-        mOilWarningLightModel.setOn(true);
-        mBatteryWarningLightModel.setOn(true);
-        mAbsWarningLightModel.setOn(true);
-        mCheckEngineLightModel.setOn(true);
-        mShiftUpLightModel.setOn(true);
-        mServiceLightModel.setOn(true);
-#endif
+    /**
+     * @brief Turn a warning light on for an alarm, on top of its input pin
+     * @param name: warning light model name
+     * @param on: true while the alarm is on
+     */
+    void setAlarm(QString name, bool on) {
+        WarningLightModel * model = mWarningLightModels.value(name, nullptr);
+        if (model == nullptr) {
+            qDebug() << "No warning light " << name << " for the alarm";
+            return;
+        }
+
+        // the alarm engine and the shift light can share a light
+        int count = qMax(0, mAlarmLights.value(name, 0) + (on ? 1 : -1));
+        mAlarmLights.insert(name, count);
+        model->setOn(count > 0 || mPinLights.contains(name));
+    }
+
+    /**
+     * @brief Turn the shift up light on or off
+     * @param on: true when it's time to shift
+     */
+    void setShiftUp(bool on) {
+        setAlarm(SHIFT_UP_MODEL_NAME, on);
     }
 
     bool readPin(int pin, uint16_t inputs, bool activeLow) {
@@ -232,6 +269,8 @@ private:
     QMap<QString, WarningLightModel*> mWarningLightModels; //!< map of warning light model names (from qml) and c++/qobject model references
     QMap<QString, IndicatorModel*> mIndicatorModels; //!< map of indicator model names (from qml) and c++/qobject model references
     ActiveInput mActiveInput;
+    QSet<QString> mPinLights; //!< warning lights on from their input pins
+    QMap<QString, int> mAlarmLights; //!< alarms holding each warning light on
 
     IndicatorModel mLeftBlinkerModel; //!< left blinker model
     IndicatorModel mRightBlinkerModel; //!< right blinker model
@@ -251,6 +290,20 @@ private:
     mcp23017 mDashLightInputs; //!< dash light inputs
 #endif
 
+    /**
+     * @brief Set a warning light from its input pin, kept on while an alarm is
+     * @param name: warning light model name
+     * @param pin: true if the input pin is active
+     */
+    void setLight(QString name, bool pin) {
+        if (pin) {
+            mPinLights.insert(name);
+        } else {
+            mPinLights.remove(name);
+        }
+        mWarningLightModels.value(name)->setOn(pin || mAlarmLights.value(name, 0) > 0);
+    }
+
 };
 
 #endif // DASH_LIGHTS_H
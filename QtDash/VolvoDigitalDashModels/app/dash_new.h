@@ -3,8 +3,14 @@
 
 #include <QObject>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QMap>
 #include <QKeyEvent>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTimer>
+
+#include <functional>
 
 #include <tachometer_model.h>
 #include <accessory_gauge_model.h>
@@ -15,6 +21,7 @@
 #include <odometer_model.h>
 
 #include <config.h>
+#include <config_cache.h>
 #include <event_timers.h>
 #include <dash_lights.h>
 #include <backlight_control.h>
@@ -41,6 +48,30 @@
 #include <sensor_source_can.h>
 #include <sensor_can.h>
 
+#include <sensor_source_derived.h>
+#include <sensor_derived.h>
+
+#include <sensor_fallback.h>
+#include <sensor_acquisition.h>
+#include <sensor_health_monitor.h>
+
+#include <alarm_engine.h>
+#include <gpio_output.h>
+
+#include <perf_timer.h>
+#include <speed_fusion.h>
+#include <clock_discipline.h>
+#include <shm_refclock.h>
+#include <timezone_lookup.h>
+#include <perf_timer_model.h>
+#include <shift_light.h>
+#include <shift_light_model.h>
+
+#include <data_logger.h>
+#include <gauge_snapshot.h>
+#include <sensor_recorder.h>
+#include <sensor_source_replay.h>
+
 /**
  * @brief A class to run the digital dash
  */
@@ -57,14 +88,17 @@ public:
     static constexpr char SPEEDO_MODEL_NAME[] = "speedoModel"; //!< speedometer model name
     static constexpr char TEMP_FUEL_CLUSTER_MODEL_NAME[] = "tempFuelModel"; //!< 240 combined temp/fuel model name
     static constexpr char ODOMETER_MODEL_NAME[] = "odometerModel";
+    static constexpr char DASH_LIGHTS_STREAM_NAME[] = "dash_lights"; //!< session log stream for the raw gpio inputs
 
     /**
      * @brief Constructor
      * @param parent: parent qobject
      * @param context: qml context to link the gauge models to their respective c++ model
+     * @param replayPath: session log to replay instead of reading the hardware (empty for live data)
+     * @param replaySpeed: replay speed (1.0 = real time)
      */
-    DashNew(QObject * parent, QQmlContext * context) :
-        QObject(parent), mContext(context), mEventTiming(parent), mConfig(parent) {
+    DashNew(QObject * parent, QQmlContext * context, QString replayPath = "", qreal replaySpeed = 1.0) :
+        DashNew(parent, context, replayPath, replaySpeed, SensorReplay::configPaths(replayPath)) {
 
     }
 
@@ -75,13 +109,24 @@ public:
         initSensorSources();
         initSensors();
         initCanSensors();
+        initDerivedChannels();
+        initSensorFilters();
+        initSensorHealth();
         initAccessoryGauges();
         initSpeedo();
         initTacho();
         initOdometer();
+        initSpeedFusion();
+        initPerfTimer();
+        initClock();
         initBackLightControl();
 
         initDashLights();
+        initAlarms();
+        initShiftLight();
+        initRecorder();
+        initDataLogger();
+        initSnapshot();
     }
 
     /**
@@ -89,6 +134,31 @@ public:
      */
     void start() {
         mEventTiming.start();
+        if (mReplay != nullptr) {
+            mReplay->start();
+        } else if (mRecorder != nullptr) {
+            mRecorder->start();
+        }
+
+        if (mDataLogger != nullptr) {
+            mDataLogger->start();
+        }
+
+        if (mHealthMonitor != nullptr) {
+            mHealthMonitor->start();
+        }
+
+        if (mAcquisition != nullptr) {
+            mAcquisition->start();
+        }
+
+        if (mAlarmThread != nullptr) {
+            mAlarmThread->start(QThread::HighPriority);
+        }
+
+        if (mSnapshot != nullptr) {
+            mSnapshot->start();
+        }
     }
 
     /**
@@ -96,6 +166,37 @@ public:
      */
     void stop() {
         mEventTiming.stop();
+        if (mAcquisition != nullptr) {
+            mAcquisition->stop();
+        }
+
+        if (mReplay != nullptr) {
+            mReplay->stop();
+        } else if (mRecorder != nullptr) {
+            mRecorder->stop();
+        }
+
+        if (mDataLogger != nullptr) {
+            mDataLogger->stop();
+        }
+
+        if (mHealthMonitor != nullptr) {
+            mHealthMonitor->stop();
+        }
+
+        if (mAlarmThread != nullptr) {
+            mAlarmThread->quit();
+            mAlarmThread->wait();
+        }
+
+        if (mBuzzer != nullptr) {
+            mBuzzer->set(false);
+        }
+
+        if (mSnapshot != nullptr) {
+            mSnapshot->stop();
+            mSnapshot->save();
+        }
     }
 
 signals:
@@ -119,14 +220,27 @@ private:
     QQmlContext * mContext; //!< QML Context
     EventTimers mEventTiming; //!< Event Timer
     Config mConfig; //!< Dash Config
+    QString mReplayPath; //!< session log being replayed, empty for live data
+    qreal mReplaySpeed; //!< session replay speed
+
+    SensorRecorder * mRecorder = nullptr; //!< session recorder (live data only)
+    SensorReplay * mReplay = nullptr; //!< session replay (replay only)
+    DataLogger * mDataLogger = nullptr; //!< channel data logger
+    GaugeSnapshot * mSnapshot = nullptr; //!< last shown values (live data only)
+    SensorHealthMonitor * mHealthMonitor = nullptr; //!< gauge sensor fault detection
+    SensorAcquisition * mAcquisition = nullptr; //!< reads the fast sampled sensors off the GUI thread
 
     DashLights * mDashLights; //!< Dash lights
+    AlarmEngine * mAlarmEngine = nullptr; //!< alarm rules, drive the warning lights and buzzer
+    QThread * mAlarmThread = nullptr; //!< evaluates the alarm rules off the GUI thread
+    GpioOutput * mBuzzer = nullptr; //!< alarm buzzer output
 
     AdcSource * mAdcSource; //!< ADC source
     GpsSource * mGpsSource; //!< GPS speed/position/heading source
     TachSource * mTachSource; //!< tach source (pulse counter)
     VssSource * mVssSource; //!< vehicle speed sensor source (pulse counter)
     CanSource * mCanSource; //!< can data source
+    DerivedSource * mDerivedSource = nullptr; //!< channels computed from other channels
 
     Map_Sensor * mMapSensor; //!< map sensor
     NtcSensor * mCoolantTempSensor; //!< coolant temp sensor
@@ -151,6 +265,12 @@ private:
     AccessoryGaugeModel mVoltMeterModel; //!< voltmeter QML model
     TempAndFuelGaugeModel mTempFuelModel; //!< 240 combined temp/fuel QML model
     OdometerModel mOdometerModel; //!< odometer QML model
+    PerfTimerModel mPerfTimerModel; //!< performance timer QML model
+    ShiftLight * mShiftLight = nullptr; //!< progressive shift light
+    ShiftLightModel mShiftLightModel; //!< shift light QML model
+#ifdef RASPBERRY_PI
+    mcp23017 * mShiftLightLeds = nullptr; //!< shift light leds, one per stage
+#endif
 
     SpeedometerModel mSpeedoModel; //!< speedometer QML model
     TachometerModel mTachoModel; //!< Tachometer QML model
@@ -166,21 +286,172 @@ private:
     SpeedometerGauge * mSpeedoGauge; //!< speedometer gauge
     TachometerGauge * mTachoGauge; //!< tachometer gauge
     OdometerGauge * mOdoGauge; //!< odometer gauge
+    PerfTimer * mPerfTimer = nullptr; //!< acceleration and lap timer
+    SpeedFusion * mSpeedFusion = nullptr; //!< VSS calibration learned from gps speed
+    QElapsedTimer mFusionClock; //!< VSS and gps arrival clock for @ref mSpeedFusion
+    ClockDiscipline mClockDiscipline; //!< system clock to gps time
+    ShmRefclock mShmRefclock; //!< gps time for ntpd/chrony
+    bool mTimeZoneSet = false; //!< local time zone has been set
 
-    BackLightControl * mBacklightControl;
+    BackLightControl * mBacklightControl = nullptr;
 
     QVector<CanSensor *> mCanSensors;
+    QVector<DerivedSensor *> mDerivedSensors;
+
+    /**
+     * @brief Private constructor -- the config is loaded from the session log when replaying
+     * @param parent: parent qobject
+     * @param context: qml context
+     * @param replayPath: session log to replay
+     * @param replaySpeed: replay speed
+     * @param configPaths: config, gauge, odometer and can config paths
+     */
+    DashNew(QObject * parent, QQmlContext * context, QString replayPath, qreal replaySpeed, QStringList configPaths) :
+        QObject(parent), mContext(context), mEventTiming(parent),
+        mConfig(parent, configPaths, ConfigCache::take(configPaths)),
+        mReplayPath(replayPath), mReplaySpeed(replaySpeed) {
+
+    }
+
+    bool isReplay() {
+        return !mReplayPath.isEmpty();
+    }
+
+    /**
+     * @brief Log every sensor channel to the SD card when enabled in the config
+     */
+    void initDataLogger() {
+        if (isReplay() || !mConfig.getDataLoggerConfig().enable) {
+            return;
+        }
+
+        mDataLogger = new DataLogger(this, mConfig.getDataLoggerConfig());
+        mDataLogger->addSensor(Config::MAP_SENSOR_KEY, mMapSensor);
+        mDataLogger->addSensor(Config::COOLANT_TEMP_KEY, mCoolantTempSensor);
+        mDataLogger->addSensor(Config::AMBIENT_TEMP_KEY, mAmbientTempSensor);
+        mDataLogger->addSensor(Config::OIL_TEMP_KEY, mOilTempSensor);
+        mDataLogger->addSensor(Config::OIL_PRESSURE_KEY, mOilPressureSensor);
+        mDataLogger->addSensor(Config::FUEL_LEVEL_KEY, mFuelLevelSensor);
+        mDataLogger->addSensor(Config::ANALOG_INPUT_12V_VOLTMETER, mVoltmeterSensor);
+        mDataLogger->addSensor(Config::ANALOG_INPUT_12V_RHEOSTAT, mDimmerVoltageSensor);
+        mDataLogger->addSensor("vss_speed", mSpeedoSensor);
+        mDataLogger->addSensor("gps_speed", mGpsSpeedoSensor);
+        mDataLogger->addSensor("rpm", mTachSensor);
+
+        for (CanSensor * sensor : mCanSensors) {
+            mDataLogger->addSensor(
+                        "can_" + mCanSource->getChannelConfig(sensor->getChannel()).getName(),
+                        sensor);
+        }
+
+        for (DerivedSensor * sensor : mDerivedSensors) {
+            mDataLogger->addSensor(sensor->getName(), sensor);
+        }
+    }
+
+    /**
+     * @brief Show the values from the last drive until the sensors report. Only
+     * slow moving values are restored -- a stale speed, rpm, boost or oil
+     * pressure would be misleading. The odometer is already loaded from its config.
+     */
+    void initSnapshot() {
+        if (isReplay()) {
+            return;
+        }
+
+        QFileInfo odoConfig(mConfig.getConfigFilePaths().at(2));
+        mSnapshot = new GaugeSnapshot(this, odoConfig.dir().filePath(GaugeSnapshot::FILE_NAME));
+
+        mSnapshot->addChannel("coolant_temp", &mCoolantTempModel, "currentValue",
+                              mCoolantTempGauge->getSensors().at(0), &Sensor::sensorDataReady);
+        mSnapshot->addChannel("oil_temp", &mOilTemperatureModel, "currentValue",
+                              mOilTempGauge->getSensors().at(0), &Sensor::sensorDataReady);
+        mSnapshot->addChannel("fuel_level", &mFuelLevelModel, "currentValue",
+                              mFuelLevelGauge->getSensors().at(0), &Sensor::sensorDataReady);
+        mSnapshot->addChannel("voltmeter", &mVoltMeterModel, "currentValue",
+                              mVoltmeterGauge->getSensors().at(0), &Sensor::sensorDataReady);
+        mSnapshot->addChannel("cluster_temp", &mTempFuelModel, "currentTemp",
+                              mTempFuelClusterGauge->getSensors().at(0), &Sensor::sensorDataReady);
+        mSnapshot->addChannel("cluster_fuel", &mTempFuelModel, "fuelLevel",
+                              mTempFuelClusterGauge->getSensors().at(1), &Sensor::sensorDataReady);
+        mSnapshot->addChannel("speedo_top", &mSpeedoModel, "topValue",
+                              mSpeedoGauge->getSensors().at(1), &Sensor::sensorDataReady);
+
+        // warning lights -- live on the first gpio read
+        QMap<QString, WarningLightModel *> * lights = mDashLights->getWarningLightModels();
+        for (auto it = lights->cbegin(); it != lights->cend(); ++it) {
+            mSnapshot->addChannel(it.key(), it.value(), "on", mDashLights, &DashLights::inputsRead);
+        }
+
+        int restored = mSnapshot->restore();
+        qDebug() << "Restored" << restored << "gauge values from" << mSnapshot->getPath();
+    }
 
     /**
      * @brief Initialize sensor sources
      */
     void initSensorSources() {
         qDebug() << "Sensor Source Init";
+        if (isReplay()) {
+            initReplaySources();
+            return;
+        }
+
         mAdcSource = new AdcSource(this->parent(), &mConfig);
         mGpsSource = new GpsSource(this->parent(), &mConfig);
         mTachSource = new TachSource(this->parent(), &mConfig);
         mVssSource = new VssSource(this->parent(), &mConfig);
         mCanSource = new CanSource(this->parent(), &mConfig);
+
+        // a replay is fed from the GUI thread, so only live sources are read from it
+        mAcquisition = new SensorAcquisition(this);
+    }
+
+    /**
+     * @brief Initialize sources that play back a recorded session
+     */
+    void initReplaySources() {
+        qDebug() << "Replaying sensor session: " << mReplayPath << " x" << mReplaySpeed;
+        mReplay = new SensorReplay(this, mReplayPath, mReplaySpeed);
+
+        ReplaySource<AdcSource> * adc = new ReplaySource<AdcSource>(this->parent(), &mConfig);
+        ReplaySource<GpsSource> * gps = new ReplaySource<GpsSource>(this->parent(), &mConfig);
+        ReplaySource<TachSource> * tach = new ReplaySource<TachSource>(this->parent(), &mConfig);
+        ReplaySource<VssSource> * vss = new ReplaySource<VssSource>(this->parent(), &mConfig);
+        ReplaySource<CanSource> * can = new ReplaySource<CanSource>(this->parent(), &mConfig);
+
+        mReplay->addSource(adc);
+        mReplay->addSource(gps);
+        mReplay->addSource(tach);
+        mReplay->addSource(vss);
+        mReplay->addSource(can);
+
+        mAdcSource = adc;
+        mGpsSource = gps;
+        mTachSource = tach;
+        mVssSource = vss;
+        mCanSource = can;
+    }
+
+    /**
+     * @brief Record every source sample and the dash light inputs when enabled in the config
+     */
+    void initRecorder() {
+        if (isReplay() || !mConfig.getRecorderConfig().enable) {
+            return;
+        }
+
+        mRecorder = new SensorRecorder(this, &mConfig);
+        mRecorder->addSource(mAdcSource);
+        mRecorder->addSource(mGpsSource);
+        mRecorder->addSource(mTachSource);
+        mRecorder->addSource(mVssSource);
+        mRecorder->addSource(mCanSource);
+
+        QString stream = mRecorder->addStream(DASH_LIGHTS_STREAM_NAME);
+        QObject::connect(mDashLights, &DashLights::inputsRead, [=](quint16 inputs) {
+            mRecorder->record(stream, 0, inputs);
+        });
     }
 
     void initCanSensors() {
@@ -193,6 +464,162 @@ private:
         }
     }
 
+    /**
+     * @brief Compile the [derived_channel] expressions. Expressions read the
+     * sensors by their filter/sample rate keys, speedo is the vss speed, plus
+     * gps_speed, the can channels by name and the derived channels before them.
+     * Each channel is evaluated on the fast timer, or at its [sample_rate].
+     */
+    void initDerivedChannels() {
+        mDerivedSource = new DerivedSource(this->parent(), &mConfig);
+        if (mConfig.getSensorHealthConfig().enabled) {
+            mDerivedSource->setTimeout(mConfig.getSensorHealthConfig().timeoutMsec);
+        }
+        mDerivedSource->addInput(Config::MAP_SENSOR_KEY, mMapSensor);
+        mDerivedSource->addInput(Config::COOLANT_TEMP_KEY, mCoolantTempSensor);
+        mDerivedSource->addInput(Config::AMBIENT_TEMP_KEY, mAmbientTempSensor);
+        mDerivedSource->addInput(Config::OIL_TEMP_KEY, mOilTempSensor);
+        mDerivedSource->addInput(Config::OIL_PRESSURE_KEY, mOilPressureSensor);
+        mDerivedSource->addInput(Config::FUEL_LEVEL_KEY, mFuelLevelSensor);
+        mDerivedSource->addInput(Config::FUSE8_12V_KEY, mVoltmeterSensor);
+        mDerivedSource->addInput(Config::DIMMER_VOLTAGE_KEY, mDimmerVoltageSensor);
+        mDerivedSource->addInput(Config::FILTER_TACH_KEY, mTachSensor);
+        mDerivedSource->addInput(Config::FILTER_SPEEDO_KEY, mSpeedoSensor);
+        mDerivedSource->addInput("gps_speed", mGpsSpeedoSensor);
+        for (CanSensor * sensor : mCanSensors) {
+            mDerivedSource->addInput(sensor->getName(), sensor);
+        }
+
+        for (const Config::DerivedChannelConfig_t & conf : mConfig.getDerivedChannelConfigs()) {
+            int channel = mDerivedSource->addChannel(conf);
+            if (channel < 0) {
+                continue;
+            }
+
+            DerivedSensor * sensor = new DerivedSensor(this->parent(), &mConfig,
+                                                       mDerivedSource, channel);
+            mDerivedSensors.push_back(sensor);
+            // the inputs are updated on the GUI thread, so the channel is evaluated there
+            pollSensor(sensor, conf.name, EventTimers::DataTimers::FAST_TIMER, [=]() {
+                mDerivedSource->update(channel);
+            }, true);
+            qDebug() << "Derived channel " << conf.name << " = " << conf.expression;
+        }
+    }
+
+    /**
+     * @brief Poll a sensor from one of the default timers, or at its own
+     * acquisition rate when [sample_rate] sets one -- the gauge then gets
+     * anti-aliased values at the display rate, logging gets every sample.
+     * Sensors at an acquisition rate are read on the acquisition thread.
+     * @param sensor: sensor
+     * @param key: sensor key in the config
+     * @param timer: default timer
+     * @param update: reads the sensor's source channel
+     * @param guiThread: read on the GUI thread even at an acquisition rate
+     */
+    void pollSensor(Sensor * sensor, QString key, EventTimers::DataTimers timer, std::function<void()> update,
+                    bool guiThread = false) {
+        Config::SampleRateConfig_t rates = mConfig.getSampleRateConfig();
+        qreal acquireHz = rates.acquireHz.value(key, 0);
+        QTimer * pollTimer = mEventTiming.getTimer(static_cast<int>(timer));
+
+        if (acquireHz > 0 && rates.displayHz > 0) {
+            int intervalMsec = qMax(1, qRound(1000 / acquireHz));
+            int factor = qRound(1000.0 / intervalMsec / rates.displayHz);
+            sensor->setDecimation(factor);
+            if (sensor->getDecimation() != factor) {
+                qDebug() << "Warning: " << key << " decimation " << factor << " limited to "
+                         << sensor->getDecimation() << " -- its gauge is updated faster than display_hz";
+            }
+            qDebug() << "Sampling " << key << " every " << intervalMsec << " msec, decimation "
+                     << sensor->getDecimation();
+
+            if (mAcquisition != nullptr && !guiThread) {
+                mAcquisition->addRead(intervalMsec, update);
+                return;
+            }
+
+            // sensors at the same rate share a timer
+            int timerId = EventTimers::ACQUISITION_TIMER_ID + intervalMsec;
+            if (mEventTiming.addTimer(timerId, intervalMsec)) {
+                mEventTiming.getTimer(timerId)->setTimerType(Qt::PreciseTimer);
+            }
+            pollTimer = mEventTiming.getTimer(timerId);
+        }
+
+        QObject::connect(pollTimer, &QTimer::timeout, update);
+    }
+
+    /**
+     * @brief Set each sensor's filter chain from the [sensor_filter] config group
+     */
+    void initSensorFilters() {
+        QMap<QString, Sensor *> sensors;
+        sensors.insert(Config::MAP_SENSOR_KEY, mMapSensor);
+        sensors.insert(Config::COOLANT_TEMP_KEY, mCoolantTempSensor);
+        sensors.insert(Config::AMBIENT_TEMP_KEY, mAmbientTempSensor);
+        sensors.insert(Config::OIL_TEMP_KEY, mOilTempSensor);
+        sensors.insert(Config::OIL_PRESSURE_KEY, mOilPressureSensor);
+        sensors.insert(Config::FUEL_LEVEL_KEY, mFuelLevelSensor);
+        sensors.insert(Config::FUSE8_12V_KEY, mVoltmeterSensor);
+        sensors.insert(Config::DIMMER_VOLTAGE_KEY, mDimmerVoltageSensor);
+        sensors.insert(Config::FILTER_TACH_KEY, mTachSensor);
+
+        for (auto it = sensors.cbegin(); it != sensors.cend(); ++it) {
+            it.value()->setFilter(mConfig.getSensorFilterConfig(it.key()));
+        }
+
+        // both speed sources drive the speedo
+        mSpeedoSensor->setFilter(mConfig.getSensorFilterConfig(Config::FILTER_SPEEDO_KEY));
+        mGpsSpeedoSensor->setFilter(mConfig.getSensorFilterConfig(Config::FILTER_SPEEDO_KEY));
+
+        // can sensors by frame name
+        for (CanSensor * sensor : mCanSensors) {
+            sensor->setFilter(mConfig.getSensorFilterConfig(sensor->getName()));
+        }
+
+        for (DerivedSensor * sensor : mDerivedSensors) {
+            sensor->setFilter(mConfig.getSensorFilterConfig(sensor->getName()));
+        }
+    }
+
+    /**
+     * @brief Watch the gauge sensors for faults from a monitor thread, see @ref SensorHealth
+     */
+    void initSensorHealth() {
+        if (!mConfig.getSensorHealthConfig().enabled) {
+            return;
+        }
+        mHealthMonitor = new SensorHealthMonitor(this);
+    }
+
+    /**
+     * @brief Watch the sensor that drives a gauge, and switch the gauge to a
+     * fallback sensor while it's faulted
+     * @param primary: sensor to drive the gauge
+     * @param fallback: sensor to use while the primary is faulted, nullptr for none
+     * @return sensor for the gauge
+     */
+    Sensor * watchSensor(Sensor * primary, Sensor * fallback = nullptr) {
+        if (mHealthMonitor == nullptr) {
+            return primary;
+        }
+
+        Config::SensorHealthConfig_t conf = mConfig.getSensorHealthConfig();
+        for (Sensor * sensor : {primary, fallback}) {
+            if (sensor != nullptr) {
+                sensor->setHealthTiming(conf.timeoutMsec, conf.faultMsec, conf.recoverMsec);
+                mHealthMonitor->addSensor(sensor);
+            }
+        }
+
+        if (fallback == nullptr || fallback == primary) {
+            return primary;
+        }
+        return new FallbackSensor(this->parent(), &mConfig, primary, fallback);
+    }
+
     CanSensor * getCanSensor(QString gaugeName) {
         // check if we have a can sensor
         qDebug() << "Get Can Sensor for: " << gaugeName;
@@ -205,6 +632,21 @@ private:
         return nullptr;
     }
 
+    /**
+     * @brief Get the sensor that drives an accessory gauge instead of its
+     * default sensor -- a derived channel, then a can channel
+     * @param gaugeName: gauge config group
+     * @return sensor, nullptr to use the default
+     */
+    Sensor * getGaugeSensor(QString gaugeName) {
+        for (DerivedSensor * sensor : mDerivedSensors) {
+            if (sensor->getGauge().toLower() == gaugeName) {
+                return sensor;
+            }
+        }
+        return getCanSensor(gaugeName);
+    }
+
     /**
      * @brief Initialize sensors
      */
@@ -216,10 +658,7 @@ private:
                     mConfig.getSensorConfig().value(Config::MAP_SENSOR_KEY)
                     );
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::FAST_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mMapSensor, Config::MAP_SENSOR_KEY, EventTimers::DataTimers::FAST_TIMER, [=]() {
             mAdcSource->update(mMapSensor->getChannel());
         });
 
@@ -229,10 +668,7 @@ private:
                     mConfig.getSensorConfig().value(Config::COOLANT_TEMP_KEY),
                     Config::TemperatureSensorType::COOLANT);
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::MEDIUM_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mCoolantTempSensor, Config::COOLANT_TEMP_KEY, EventTimers::DataTimers::MEDIUM_TIMER, [=]() {
             mAdcSource->update(mCoolantTempSensor->getChannel());
         });
 
@@ -242,10 +678,7 @@ private:
                     mConfig.getSensorConfig().value(Config::AMBIENT_TEMP_KEY),
                     Config::TemperatureSensorType::AMBIENT);
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::MEDIUM_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mAmbientTempSensor, Config::AMBIENT_TEMP_KEY, EventTimers::DataTimers::MEDIUM_TIMER, [=]() {
             mAdcSource->update(mAmbientTempSensor->getChannel());
         });
 
@@ -255,10 +688,7 @@ private:
                     mConfig.getSensorConfig().value(Config::OIL_TEMP_KEY),
                     Config::TemperatureSensorType::OIL);
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::MEDIUM_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mOilTempSensor, Config::OIL_TEMP_KEY, EventTimers::DataTimers::MEDIUM_TIMER, [=]() {
             mAdcSource->update(mOilTempSensor->getChannel());
         });
 
@@ -269,10 +699,7 @@ private:
                     mConfig.getResistiveSensorConfig(Config::RES_SENSOR_TYPE_OIL_PRESSURE)
                     );
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::FAST_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mOilPressureSensor, Config::OIL_PRESSURE_KEY, EventTimers::DataTimers::FAST_TIMER, [=]() {
             mAdcSource->update(mOilPressureSensor->getChannel());
         });
 
@@ -283,10 +710,7 @@ private:
                     mConfig.getResistiveSensorConfig(Config::RES_SENSOR_TYPE_FUEL_LEVEL)
                     );
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::MEDIUM_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mFuelLevelSensor, Config::FUEL_LEVEL_KEY, EventTimers::DataTimers::MEDIUM_TIMER, [=]() {
             mAdcSource->update(mFuelLevelSensor->getChannel());
         });
 
@@ -298,10 +722,7 @@ private:
                     mConfig.getAnalog12VInputConfig(Config::ANALOG_INPUT_12V_VOLTMETER)
                     );
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::MEDIUM_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mVoltmeterSensor, Config::FUSE8_12V_KEY, EventTimers::DataTimers::MEDIUM_TIMER, [=]() {
             mAdcSource->update(mVoltmeterSensor->getChannel());
         });
 
@@ -312,10 +733,7 @@ private:
                     mConfig.getAnalog12VInputConfig(Config::ANALOG_INPUT_12V_RHEOSTAT)
                     );
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::MEDIUM_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mDimmerVoltageSensor, Config::DIMMER_VOLTAGE_KEY, EventTimers::DataTimers::MEDIUM_TIMER, [=]() {
             mAdcSource->update(mDimmerVoltageSensor->getChannel());
         });
 
@@ -328,10 +746,7 @@ private:
                     this->parent(), &mConfig, mVssSource,
                     (int) VssSource::VssDataChannel::MPH);
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::VERY_FAST_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mSpeedoSensor, Config::FILTER_SPEEDO_KEY, EventTimers::DataTimers::VERY_FAST_TIMER, [=]() {
             mVssSource->update((int) VssSource::VssDataChannel::MPH);
         });
 
@@ -340,10 +755,7 @@ private:
                     this->parent(), &mConfig, mTachSource,
                     (int) TachSource::TachDataChannel::RPM_CHANNEL);
 
-        QObject::connect(
-                    mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::VERY_FAST_TIMER)),
-                    &QTimer::timeout,
-                    [=]() {
+        pollSensor(mTachSensor, Config::FILTER_TACH_KEY, EventTimers::DataTimers::VERY_FAST_TIMER, [=]() {
             mTachSource->update((int) TachSource::TachDataChannel::RPM_CHANNEL);
         });
 
@@ -400,13 +812,13 @@ private:
     void initAccessoryGauges() {
         qDebug() << "Accessory Gauge Models Init";
         // boost gauge
-        CanSensor * sensor = getCanSensor(Config::BOOST_GAUGE_GROUP);
+        Sensor * sensor = getGaugeSensor(Config::BOOST_GAUGE_GROUP);
 
         QList<Sensor *> boostSensors;
         if (sensor != nullptr) {
-            boostSensors.push_back(sensor);
+            boostSensors.push_back(watchSensor(sensor, mMapSensor));
         } else {
-            boostSensors.push_back(mMapSensor);
+            boostSensors.push_back(watchSensor(mMapSensor));
         }
 
         mBoostGauge = new AccessoryGauge(
@@ -415,12 +827,12 @@ private:
                     mContext);
 
         // coolant temp gauge
-        sensor = getCanSensor(Config::COOLANT_TEMP_GAUGE_GROUP);
+        sensor = getGaugeSensor(Config::COOLANT_TEMP_GAUGE_GROUP);
         QList<Sensor *> coolantSensors;
         if (sensor != nullptr) {
-            coolantSensors.push_back(sensor);
+            coolantSensors.push_back(watchSensor(sensor, mCoolantTempSensor));
         } else {
-            coolantSensors.push_back(mCoolantTempSensor);
+            coolantSensors.push_back(watchSensor(mCoolantTempSensor));
         }
 
         mCoolantTempGauge = new AccessoryGauge(
@@ -429,12 +841,12 @@ private:
                     mContext);
 
         // oil temp gauge
-        sensor = getCanSensor(Config::OIL_TEMPERATURE_GAUGE_GROUP);
+        sensor = getGaugeSensor(Config::OIL_TEMPERATURE_GAUGE_GROUP);
         QList<Sensor *> oilTempSensors;
         if (sensor != nullptr) {
-            oilTempSensors.push_back(sensor);
+            oilTempSensors.push_back(watchSensor(sensor, mOilTempSensor));
         } else {
-            oilTempSensors.push_back(mOilTempSensor);
+            oilTempSensors.push_back(watchSensor(mOilTempSensor));
         }
 
         mOilTempGauge = new AccessoryGauge(
@@ -443,12 +855,12 @@ private:
                     mContext);
 
         // voltmeter
-        sensor = getCanSensor(Config::VOLTMETER_GAUGE_GROUP);
+        sensor = getGaugeSensor(Config::VOLTMETER_GAUGE_GROUP);
         QList<Sensor *> voltmeterSensors;
         if (sensor != nullptr) {
-            voltmeterSensors.push_back(sensor);
+            voltmeterSensors.push_back(watchSensor(sensor, mVoltmeterSensor));
         } else {
-            voltmeterSensors.push_back(mVoltmeterSensor);
+            voltmeterSensors.push_back(watchSensor(mVoltmeterSensor));
         }
 
         mVoltmeterGauge = new AccessoryGauge(
@@ -458,12 +870,12 @@ private:
                     );
 
         // fuel level (acc gauge)
-        sensor = getCanSensor(Config::FUEL_GAUGE_GROUP);
+        sensor = getGaugeSensor(Config::FUEL_GAUGE_GROUP);
         QList<Sensor *> fuelGaugeSensors;
         if (sensor != nullptr) {
-            fuelGaugeSensors.push_back(sensor);
+            fuelGaugeSensors.push_back(watchSensor(sensor, mFuelLevelSensor));
         } else {
-            fuelGaugeSensors.push_back(mFuelLevelSensor);
+            fuelGaugeSensors.push_back(watchSensor(mFuelLevelSensor));
         }
 
         mFuelLevelGauge = new AccessoryGauge(
@@ -473,12 +885,12 @@ private:
                     );
 
         // oil pressure gauge
-        sensor = getCanSensor(Config::OIL_PRESSURE_GAUGE_GROUP);
+        sensor = getGaugeSensor(Config::OIL_PRESSURE_GAUGE_GROUP);
         QList<Sensor *> oilPressureSensors;
         if (sensor != nullptr) {
-            oilPressureSensors.push_back(sensor);
+            oilPressureSensors.push_back(watchSensor(sensor, mOilPressureSensor));
         } else {
-            oilPressureSensors.push_back(mOilPressureSensor);
+            oilPressureSensors.push_back(watchSensor(mOilPressureSensor));
         }
 
         mOilPressureGauge = new AccessoryGauge(
@@ -502,10 +914,12 @@ private:
     void initSpeedo() {
         qDebug() << "Speedometer Gauge Model Init";
 
-        // init gauge -- default is VSS
-        QList<Sensor *> speedoSensors = {mSpeedoSensor};
+        // init gauge -- default is VSS, gps while the VSS is faulted
+        QList<Sensor *> speedoSensors;
         if (mConfig.getVssConfig().useGps) {
-            speedoSensors.replace(0, mGpsSpeedoSensor);
+            speedoSensors.append(watchSensor(mGpsSpeedoSensor));
+        } else {
+            speedoSensors.append(watchSensor(mSpeedoSensor, mGpsSpeedoSensor));
         }
 
         // Speedometer has a secondary output -- assign it now
@@ -554,7 +968,9 @@ private:
 
         // If no can source is available -- use the kernel module tach sensor
         if (tachSensors.isEmpty()) {
-            tachSensors.push_back(mTachSensor);
+            tachSensors.push_back(watchSensor(mTachSensor));
+        } else {
+            tachSensors.replace(0, watchSensor(tachSensors.at(0), mTachSensor));
         }
 
         // initialize
@@ -576,6 +992,137 @@ private:
                     );
     }
 
+    /**
+     * @brief Apply the learned VSS calibration and keep learning it from gps
+     * speed. The speedo and odometer stay on the VSS; good gps fixes at a
+     * steady speed refine the factor, which is written to the odometer file
+     * when it moves.
+     */
+    void initSpeedFusion() {
+        // a replay has the calibrated speed recorded already
+        if (isReplay() || !mConfig.getVssConfig().autoCalibrate) {
+            return;
+        }
+
+        qreal calibration = mConfig.getVssCalibration();
+        qDebug() << "VSS calibration: " << calibration;
+        mVssSource->setCalibration(calibration);
+        mSpeedFusion = new SpeedFusion(calibration);
+        mFusionClock.start();
+
+        QObject::connect(mVssSource, &SensorSource::dataReady, this, [=](QVariant data, int channel) {
+            if (channel != (int) VssSource::VssDataChannel::MPH) {
+                return;
+            }
+            qreal speed = SensorUtils::convert(data.toReal(), Config::UNITS_METERS_PER_SECOND, Config::UNITS_MPH);
+            mSpeedFusion->addVss(mFusionClock.elapsed(), speed / mVssSource->getCalibration());
+        });
+
+        QObject::connect(mGpsSource, &GpsSource::fixReady, [=](qint64, qreal, qreal, qreal speed, qreal accuracy) {
+            if (!mSpeedFusion->addGps(mFusionClock.elapsed(), speed, accuracy)) {
+                return;
+            }
+            mVssSource->setCalibration(mSpeedFusion->getCalibration());
+            if (mSpeedFusion->takeStoreDue()) {
+                qDebug() << "Learned VSS calibration: " << mSpeedFusion->getCalibration()
+                         << "+/-" << mSpeedFusion->getStdDev();
+                mConfig.writeVssCalibration(mSpeedFusion->getCalibration());
+            }
+        });
+    }
+
+    /**
+     * @brief Initialize the acceleration and lap timer. Runs are timed from
+     * the VSS pulse timestamps, or from gps fixes -- a replay only has gps.
+     */
+    void initPerfTimer() {
+        Config::PerfTimerConfig_t conf = mConfig.getPerfTimerConfig();
+        mPerfTimer = new PerfTimer(this, mVssSource->getMetersPerPulse(), conf.useGps, conf.finishLine);
+
+        QObject::connect(mGpsSource, &GpsSource::fixReady, mPerfTimer, &PerfTimer::addFix);
+        if (!isReplay()) {
+            QObject::connect(mVssSource, &VssSource::pulseEdge, mPerfTimer, &PerfTimer::addPulse);
+            QObject::connect(mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::VERY_FAST_TIMER)),
+                             &QTimer::timeout, [=]() {
+                mVssSource->updateEdges();
+                mPerfTimer->update(PerfTimer::monotonicNsec());
+            });
+        }
+
+        // trap speeds in the speedo's units
+        QString units = mConfig.getSpeedoConfig().gaugeConfig.displayUnits;
+        if (units.isEmpty()) {
+            units = Config::UNITS_MPH;
+        }
+        mPerfTimerModel.setSpeedUnits(units);
+
+        auto updateRun = [=]() {
+            const PerfTimer::Target_t * targets = PerfTimer::getTargets();
+            for (int i = 0; i < PerfTimer::NUM_TARGETS; i++) {
+                PerfTimer::Result_t result = mPerfTimer->getResult(i);
+                mPerfTimerModel.setResult(i, targets[i].name, result.seconds,
+                                          SensorUtils::convert(result.speed, units, Config::UNITS_METERS_PER_SECOND));
+            }
+            mPerfTimerModel.setRunState((int) mPerfTimer->getState());
+        };
+        updateRun();
+        QObject::connect(mPerfTimer, &PerfTimer::runChanged, updateRun);
+        QObject::connect(mPerfTimer, &PerfTimer::lapChanged, [=]() {
+            mPerfTimerModel.setLastLap(mPerfTimer->getLastLap());
+            mPerfTimerModel.setBestLap(mPerfTimer->getBestLap());
+            mPerfTimerModel.setLapCount(mPerfTimer->getLapCount());
+        });
+
+        mContext->setContextProperty(PerfTimerModel::PERF_TIMER_MODEL_NAME, &mPerfTimerModel);
+    }
+
+    /**
+     * @brief Keep the system clock on gps time, serve it to ntp when
+     * configured, and set the local time zone from the config or the first fix
+     */
+    void initClock() {
+        Config::ClockConfig_t conf = mConfig.getClockConfig();
+        bool lookupZone = conf.timeZone == Config::CLOCK_TIME_ZONE_AUTO;
+        if (!lookupZone && conf.timeZone != Config::CLOCK_TIME_ZONE_SYSTEM) {
+            setTimeZone(conf.timeZone.toUtf8());
+        }
+
+        // a replay's fixes are from another day
+        if (isReplay()) {
+            return;
+        }
+
+        qint64 latencyNsec = conf.latencyMsec * 1000000LL;
+        mClockDiscipline = ClockDiscipline(latencyNsec);
+        if (conf.shmUnit >= 0) {
+            mShmRefclock.open(conf.shmUnit);
+        }
+
+        QObject::connect(mGpsSource, &GpsSource::fixReady, [=](qint64 nsec, qreal latitude, qreal longitude) {
+            qint64 now = ClockDiscipline::realtimeNsec();
+            mShmRefclock.publish(nsec + latencyNsec, now);
+            if (conf.setTime) {
+                ClockDiscipline::apply(mClockDiscipline.addFix(nsec, now));
+            }
+            if (lookupZone && !mTimeZoneSet) {
+                setTimeZone(TimeZoneLookup::resolve(latitude, longitude));
+            }
+        });
+    }
+
+    /**
+     * @brief Set the local time zone
+     * @param tz: tz database id or POSIX TZ string
+     */
+    void setTimeZone(QByteArray tz) {
+        qDebug() << "Time zone: " << tz;
+        TimeZoneLookup::apply(tz);
+        mTimeZoneSet = true;
+
+        // the QML clocks cache the zone
+        mContext->engine()->evaluate("Date.timeZoneUpdated()");
+    }
+
     /**
      * @brief Initialize the dash lights and indicators
      */
@@ -626,6 +1173,15 @@ private:
                         mDashLights->getIndicatorModels()->value(modelName));
         }
 
+        // replayed gpio inputs drive the lights instead of the mcp23017
+        if (isReplay()) {
+            mReplay->addStreamHandler(DASH_LIGHTS_STREAM_NAME, [=](QVariant data, int channel) {
+                (void) channel;
+                mDashLights->setInputs(data.toUInt());
+            });
+            return;
+        }
+
         // hook up dash light timing
         QObject::connect(
                     mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::FAST_TIMER)),
@@ -635,7 +1191,134 @@ private:
                     );
     }
 
+    /**
+     * @brief Compile the [alarm] rules. Rules read the same channels as the
+     * derived channels, and the derived channels, each with its rate of
+     * change. They're evaluated at the fast timer rate on their own thread, so
+     * a busy GUI thread doesn't hold an alarm back -- samples and sensor health
+     * are queued to it. Alarms turn on their warning lights, through the dash
+     * lights, and drive the [buzzer] output straight from that thread.
+     */
+    void initAlarms() {
+        QList<Config::AlarmConfig_t> configs = mConfig.getAlarmConfigs();
+        if (configs.isEmpty()) {
+            return;
+        }
+
+        // no parent, it's moved to the alarm thread once set up
+        mAlarmEngine = new AlarmEngine(nullptr);
+        mAlarmEngine->addInput(Config::MAP_SENSOR_KEY, mMapSensor);
+        mAlarmEngine->addInput(Config::COOLANT_TEMP_KEY, mCoolantTempSensor);
+        mAlarmEngine->addInput(Config::AMBIENT_TEMP_KEY, mAmbientTempSensor);
+        mAlarmEngine->addInput(Config::OIL_TEMP_KEY, mOilTempSensor);
+        mAlarmEngine->addInput(Config::OIL_PRESSURE_KEY, mOilPressureSensor);
+        mAlarmEngine->addInput(Config::FUEL_LEVEL_KEY, mFuelLevelSensor);
+        mAlarmEngine->addInput(Config::FUSE8_12V_KEY, mVoltmeterSensor);
+        mAlarmEngine->addInput(Config::DIMMER_VOLTAGE_KEY, mDimmerVoltageSensor);
+        mAlarmEngine->addInput(Config::FILTER_TACH_KEY, mTachSensor);
+        mAlarmEngine->addInput(Config::FILTER_SPEEDO_KEY, mSpeedoSensor);
+        mAlarmEngine->addInput("gps_speed", mGpsSpeedoSensor);
+        for (CanSensor * sensor : mCanSensors) {
+            mAlarmEngine->addInput(sensor->getName(), sensor);
+        }
+        for (DerivedSensor * sensor : mDerivedSensors) {
+            mAlarmEngine->addInput(sensor->getName(), sensor);
+        }
+
+        for (const Config::AlarmConfig_t & conf : configs) {
+            if (mAlarmEngine->addAlarm(conf)) {
+                qDebug() << "Alarm " << conf.name << " = " << conf.expression;
+            }
+        }
+
+        QObject::connect(mAlarmEngine, &AlarmEngine::lightChanged, mDashLights, &DashLights::setAlarm);
+
+        Config::BuzzerConfig_t buzzer = mConfig.getBuzzerConfig();
+        if (buzzer.pin >= 0 && !isReplay()) {
+            mBuzzer = new GpioOutput(buzzer.pin, buzzer.activeLow);
+            QObject::connect(mAlarmEngine, &AlarmEngine::buzzerChanged, mAlarmEngine, [=](bool on) {
+                mBuzzer->set(on);
+            });
+        }
+
+        QTimer * timer = new QTimer(mAlarmEngine);
+        timer->setInterval(EventTimers::FAST_TIMER_TIMEOUT_MSEC);
+        QObject::connect(timer, &QTimer::timeout, mAlarmEngine, &AlarmEngine::update);
+
+        mAlarmThread = new QThread(this);
+        mAlarmEngine->moveToThread(mAlarmThread);
+        QObject::connect(mAlarmThread, &QThread::started, timer, QOverload<>::of(&QTimer::start));
+        QObject::connect(mAlarmThread, &QThread::finished, mAlarmEngine, &QObject::deleteLater);
+    }
+
+    /**
+     * @brief Initialize the progressive shift light. The rpm is predicted
+     * from the tach pulse timestamps, read on the very fast timer, and the
+     * gear from the tach/speedo ratio. All stages lit turns on the shift up
+     * light, and each stage can light an led on an mcp23017.
+     */
+    void initShiftLight() {
+        Config::ShiftLightConfig_t conf = mConfig.getShiftLightConfig();
+        if (conf.shiftRpm.isEmpty() && mConfig.getTachGaugeConfig().redline > 0) {
+            conf.shiftRpm.append(mConfig.getTachGaugeConfig().redline);
+        }
+        mContext->setContextProperty(ShiftLightModel::SHIFT_LIGHT_MODEL_NAME, &mShiftLightModel);
+        if (!conf.enabled || conf.shiftRpm.isEmpty()) {
+            return;
+        }
+
+        mShiftLight = new ShiftLight(this, conf, mConfig.getTachInputConfig().pulsesPerRot);
+        mShiftLightModel.setStages(mShiftLight->getStages());
+
+        QObject::connect(mTachSensor, &Sensor::sampleReady, mShiftLight, [=](qreal rpm) {
+            mShiftLight->addRpm(rpm, PerfTimer::monotonicNsec());
+        });
+        QObject::connect(mSpeedoSensor, &Sensor::sampleReady, mShiftLight, &ShiftLight::setSpeed);
+        if (!isReplay()) {
+            QObject::connect(mTachSource, &TachSource::pulseEdge, mShiftLight, &ShiftLight::addPulse);
+        }
+        QObject::connect(mEventTiming.getTimer(static_cast<int>(EventTimers::DataTimers::VERY_FAST_TIMER)),
+                         &QTimer::timeout, [=]() {
+            if (!isReplay()) {
+                mTachSource->updateEdges();
+            }
+            mShiftLight->update(PerfTimer::monotonicNsec());
+        });
+
+        QObject::connect(mShiftLight, &ShiftLight::gearChanged, &mShiftLightModel, &ShiftLightModel::setGear);
+        QObject::connect(mShiftLight, &ShiftLight::stageChanged, [=](int stage) {
+            bool shift = stage >= mShiftLight->getStages();
+            if (shift != (mShiftLightModel.stage() >= mShiftLight->getStages())) {
+                mDashLights->setShiftUp(shift);
+            }
+            mShiftLightModel.setStage(stage);
+        });
+
+#ifdef RASPBERRY_PI
+        if (conf.mcpAddress >= 0 && !isReplay()) {
+            mShiftLightLeds = new mcp23017(0x01, conf.mcpAddress);
+            if (mShiftLightLeds->openDevice()) {
+                mShiftLightLeds->write(mcp23017::RegisterAddr::IODIRA, 0x00);
+                mShiftLightLeds->write(mcp23017::RegisterAddr::IODIRB, 0x00);
+                mShiftLightLeds->write(mcp23017::RegisterAddr::OLATA, 0x00);
+                mShiftLightLeds->write(mcp23017::RegisterAddr::OLATB, 0x00);
+                QObject::connect(mShiftLight, &ShiftLight::stageChanged, [=](int stage) {
+                    // port A then port B, one led per stage
+                    quint16 leds = (quint16) ((1u << qMin(stage, 16)) - 1);
+                    mShiftLightLeds->write(mcp23017::RegisterAddr::OLATA, leds & 0xff);
+                    mShiftLightLeds->write(mcp23017::RegisterAddr::OLATB, leds >> 8);
+                });
+            }
+        }
+#endif
+    }
+
     void initBackLightControl() {
+        // no backlight pwm to drive when replaying on the desktop
+        if (isReplay()) {
+            return;
+        }
+
         mBacklightControl = new BackLightControl(
                     this,
                     &mConfig,
@@ -0,0 +1,444 @@
+#ifndef DATA_LOG_H
+#define DATA_LOG_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QMap>
+#include <QVector>
+#include <QtMath>
+#include <QDebug>
+#include <limits>
+
+/**
+ * @brief Columnar, block compressed channel log format written by DataLogger.
+ *
+ * File layout (QDataStream, big endian):
+ *  header: quint32 FILE_MAGIC, quint16 VERSION, qint64 start time (ms since epoch),
+ *          quint32 time tick (us), quint16 channel count,
+ *          then {QString name, QString units, double resolution} per channel
+ *  blocks: quint32 BLOCK_MAGIC, qint64 first sample time (us), qint64 last sample time (us),
+ *          quint32 sample count, quint32 dropped sample count, QByteArray zlib payload
+ *  index:  quint32 INDEX_MAGIC, quint32 block count, {qint64 offset, qint64 first, qint64 last} per block,
+ *          qint64 index offset, quint32 INDEX_MAGIC
+ *
+ * The index is only written on a clean close -- after a power cut the blocks
+ * are still found by scanning.
+ *
+ * Block payload (varints, zigzag for signed values), one run per channel present:
+ *  channel id, sample count,
+ *  time column: first tick relative to the block start, then delta-of-delta ticks,
+ *  value column: first quantized value, then deltas of the quantized values
+ *  (mod 2^64) -- a non-finite value is quantized to NAN_CODE and read back as NaN
+ *
+ * Periodic samples give near zero delta-of-delta times and small value deltas,
+ * so most samples cost 2 bytes before compression.
+ */
+class DataLog {
+public:
+    static constexpr quint32 FILE_MAGIC = 0x5644434C; //!< "VDCL"
+    static constexpr quint32 BLOCK_MAGIC = 0x424C4B30; //!< "BLK0"
+    static constexpr quint32 INDEX_MAGIC = 0x56444958; //!< "VDIX"
+    static constexpr quint16 VERSION = 1; //!< current format version
+    static constexpr quint32 TIME_TICK_US = 100; //!< timestamp quantization
+    static constexpr int COMPRESSION_LEVEL = 6; //!< zlib level
+    static constexpr qint64 NAN_CODE = std::numeric_limits<qint64>::min(); //!< quantized value of NaN/inf
+    static constexpr qreal MAX_QUANTIZED = 9007199254740992.0; //!< 2^53, finite values are clamped to +-this many steps
+
+    static constexpr char FILE_EXTENSION[] = ".vdcl"; //!< channel log extension
+
+    /**
+     * @struct Channel
+     */
+    typedef struct Channel {
+        QString name; //!< channel name
+        QString units; //!< units of the logged values
+        qreal resolution; //!< quantization step
+    } Channel_t;
+
+    /**
+     * @struct Sample
+     */
+    typedef struct Sample {
+        qint64 timeUs; //!< time since the start of the log
+        qreal value; //!< channel value
+        quint16 channel; //!< channel id
+    } Sample_t;
+
+    /**
+     * @struct BlockIndex
+     */
+    typedef struct BlockIndex {
+        qint64 offset; //!< file offset of the block
+        qint64 firstUs; //!< first sample time in the block
+        qint64 lastUs; //!< last sample time in the block
+    } BlockIndex_t;
+
+    /**
+     * @brief Pick a quantization step for a channel from its units
+     * @param units: channel units
+     * @return resolution in the channel's units
+     */
+    static qreal defaultResolution(QString units) {
+        static const QMap<QString, qreal> resolutions = {
+            {"rpm", 1.0},
+            {"V", 0.001}, {"volts", 0.001},
+            {"F", 0.1}, {"C", 0.1}, {"K", 0.1},
+            {"kpa", 0.1}, {"psi", 0.01}, {"bar", 0.001},
+            {"mph", 0.01}, {"kph", 0.01}, {"m/s", 0.01},
+            {"%", 0.1}
+        };
+        return resolutions.value(units, 0.001);
+    }
+
+    /**
+     * @brief Quantize a value
+     * @param value: channel value
+     * @param resolution: quantization step
+     * @return steps, NAN_CODE if the value isn't finite
+     */
+    static qint64 quantize(qreal value, qreal resolution) {
+        qreal steps = value / resolution;
+        if (!qIsFinite(steps)) {
+            return NAN_CODE;
+        }
+        return qRound64(qBound(-MAX_QUANTIZED, steps, MAX_QUANTIZED));
+    }
+
+    /**
+     * @brief Undo @ref quantize
+     * @param steps: quantized value
+     * @param resolution: quantization step
+     * @return value, NaN for NAN_CODE
+     */
+    static qreal dequantize(qint64 steps, qreal resolution) {
+        return (steps == NAN_CODE) ? qQNaN() : steps * resolution;
+    }
+
+    static quint64 zigzag(qint64 value) {
+        return ((quint64) value << 1) ^ (quint64)(value >> 63);
+    }
+
+    static qint64 unzigzag(quint64 value) {
+        return (qint64)(value >> 1) ^ -(qint64)(value & 1);
+    }
+
+    static void putVarint(QByteArray & out, quint64 value) {
+        while (value >= 0x80) {
+            out.append((char)((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.append((char) value);
+    }
+
+    /**
+     * @brief Read a varint
+     * @param in: encoded data
+     * @param pos: read position, advanced past the varint
+     * @param value: decoded value
+     * @return false if the data ends mid varint
+     */
+    static bool getVarint(const QByteArray & in, int & pos, quint64 & value) {
+        value = 0;
+        for (int shift = 0; pos < in.size() && shift < 64; shift += 7) {
+            quint8 byte = (quint8) in.at(pos++);
+            value |= (quint64)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Encode a block of samples into the columnar payload (uncompressed)
+     * @param samples: samples in arrival order
+     * @param channels: channel table (for the resolutions)
+     * @param blockStartUs: time the block's first tick is relative to
+     * @return payload
+     */
+    static QByteArray encodeBlock(const QVector<Sample_t> & samples, const QVector<Channel_t> & channels,
+                                  qint64 blockStartUs) {
+        // split into per channel columns (samples of one channel are already in time order)
+        QVector<QVector<int>> columns(channels.size());
+        for (int i = 0; i < samples.size(); i++) {
+            if (samples.at(i).channel < channels.size()) {
+                columns[samples.at(i).channel].append(i);
+            }
+        }
+
+        QByteArray out;
+        out.reserve(samples.size() * 2 + 16);
+
+        int present = 0;
+        for (const auto & column : columns) {
+            present += column.isEmpty() ? 0 : 1;
+        }
+        putVarint(out, present);
+
+        for (int ch = 0; ch < columns.size(); ch++) {
+            const QVector<int> & column = columns.at(ch);
+            if (column.isEmpty()) {
+                continue;
+            }
+            putVarint(out, ch);
+            putVarint(out, column.size());
+
+            qint64 lastTick = blockStartUs / TIME_TICK_US;
+            qint64 lastDelta = 0;
+            for (int i : column) {
+                qint64 tick = samples.at(i).timeUs / TIME_TICK_US;
+                qint64 delta = tick - lastTick;
+                putVarint(out, zigzag(delta - lastDelta));
+                lastDelta = delta;
+                lastTick = tick;
+            }
+
+            qreal resolution = channels.at(ch).resolution;
+            qint64 lastValue = 0;
+            for (int i : column) {
+                // wrapping deltas, the step to or from NAN_CODE overflows
+                qint64 value = quantize(samples.at(i).value, resolution);
+                putVarint(out, zigzag((qint64) ((quint64) value - (quint64) lastValue)));
+                lastValue = value;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Decode a block payload
+     * @param in: payload (uncompressed)
+     * @param channels: channel table
+     * @param blockStartUs: time the block's first tick is relative to
+     * @param samples: decoded samples, grouped by channel
+     * @return false if the payload is corrupt
+     */
+    static bool decodeBlock(const QByteArray & in, const QVector<Channel_t> & channels,
+                            qint64 blockStartUs, QVector<Sample_t> & samples) {
+        int pos = 0;
+        quint64 present = 0;
+        if (!getVarint(in, pos, present)) {
+            return false;
+        }
+
+        for (quint64 c = 0; c < present; c++) {
+            quint64 ch = 0;
+            quint64 count = 0;
+            if (!getVarint(in, pos, ch) || !getVarint(in, pos, count) || ch >= (quint64) channels.size()) {
+                return false;
+            }
+
+            int first = samples.size();
+            qint64 tick = blockStartUs / TIME_TICK_US;
+            qint64 delta = 0;
+            for (quint64 i = 0; i < count; i++) {
+                quint64 raw = 0;
+                if (!getVarint(in, pos, raw)) {
+                    return false;
+                }
+                delta += unzigzag(raw);
+                tick += delta;
+                samples.append({tick * TIME_TICK_US, 0, (quint16) ch});
+            }
+
+            qreal resolution = channels.at(ch).resolution;
+            qint64 value = 0;
+            for (quint64 i = 0; i < count; i++) {
+                quint64 raw = 0;
+                if (!getVarint(in, pos, raw)) {
+                    return false;
+                }
+                value = (qint64) ((quint64) value + (quint64) unzigzag(raw));
+                samples[first + i].value = dequantize(value, resolution);
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Reads a channel log written by DataLogger
+ */
+class DataLogReader {
+public:
+    DataLogReader() {}
+
+    /**
+     * @brief Open the log, read the header and the block index
+     * @param path: log path
+     * @return true if the file is a channel log of a supported version
+     */
+    bool open(QString path) {
+        mFile.setFileName(path);
+        if (!mFile.open(QIODevice::ReadOnly)) {
+            qDebug() << "Unable to open data log: " << path;
+            return false;
+        }
+
+        mStream.setDevice(&mFile);
+        mStream.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0;
+        quint16 version = 0;
+        quint32 tick = 0;
+        quint16 count = 0;
+        mStream >> magic >> version >> mStartTimeMs >> tick >> count;
+        if (magic != DataLog::FILE_MAGIC || version > DataLog::VERSION || tick != DataLog::TIME_TICK_US) {
+            qDebug() << "Not a data log (or unsupported version): " << path;
+            mFile.close();
+            return false;
+        }
+
+        for (int i = 0; i < count; i++) {
+            DataLog::Channel_t channel;
+            mStream >> channel.name >> channel.units >> channel.resolution;
+            mChannels.append(channel);
+        }
+        mFirstBlock = mFile.pos();
+
+        if (!readIndex()) {
+            scanIndex();
+        }
+        return mStream.status() == QDataStream::Ok;
+    }
+
+    qint64 getStartTime() {
+        return mStartTimeMs;
+    }
+
+    QVector<DataLog::Channel_t> getChannels() {
+        return mChannels;
+    }
+
+    /**
+     * @brief Get the block time index
+     * @return block offsets and time spans
+     */
+    QVector<DataLog::BlockIndex_t> getBlockIndex() {
+        return mIndex;
+    }
+
+    /**
+     * @brief Decode a block
+     * @param block: block number from the index
+     * @param samples: decoded samples, appended
+     * @param dropped: samples dropped by the logger while this block was filling
+     * @return false if the block is corrupt
+     */
+    bool readBlock(int block, QVector<DataLog::Sample_t> & samples, quint32 * dropped = nullptr) {
+        if (block < 0 || block >= mIndex.size()) {
+            return false;
+        }
+
+        mFile.seek(mIndex.at(block).offset);
+        mStream.resetStatus();
+
+        quint32 magic = 0;
+        qint64 first = 0;
+        qint64 last = 0;
+        quint32 count = 0;
+        quint32 droppedCount = 0;
+        QByteArray payload;
+        mStream >> magic >> first >> last >> count >> droppedCount >> payload;
+        if (magic != DataLog::BLOCK_MAGIC || mStream.status() != QDataStream::Ok) {
+            return false;
+        }
+        if (dropped != nullptr) {
+            *dropped = droppedCount;
+        }
+        return DataLog::decodeBlock(qUncompress(payload), mChannels, first, samples);
+    }
+
+    /**
+     * @brief Decode every sample between two times
+     * @param fromUs: start time (us since the start of the log)
+     * @param toUs: end time
+     * @return samples grouped by block then channel
+     */
+    QVector<DataLog::Sample_t> readRange(qint64 fromUs, qint64 toUs) {
+        QVector<DataLog::Sample_t> samples;
+        for (int i = 0; i < mIndex.size(); i++) {
+            if (mIndex.at(i).lastUs < fromUs || mIndex.at(i).firstUs > toUs) {
+                continue;
+            }
+            QVector<DataLog::Sample_t> block;
+            readBlock(i, block);
+            for (auto sample : block) {
+                if (sample.timeUs >= fromUs && sample.timeUs <= toUs) {
+                    samples.append(sample);
+                }
+            }
+        }
+        return samples;
+    }
+
+private:
+    QFile mFile; //!< log file
+    QDataStream mStream; //!< header/block reader
+    qint64 mStartTimeMs = 0; //!< log start time
+    qint64 mFirstBlock = 0; //!< offset of the first block
+    QVector<DataLog::Channel_t> mChannels; //!< channel table
+    QVector<DataLog::BlockIndex_t> mIndex; //!< block index
+
+    /**
+     * @brief Read the index written on a clean close
+     * @return false if there is no index
+     */
+    bool readIndex() {
+        static constexpr int TRAILER_SIZE = sizeof(qint64) + sizeof(quint32);
+        if (mFile.size() - mFirstBlock < TRAILER_SIZE) {
+            return false;
+        }
+
+        mFile.seek(mFile.size() - TRAILER_SIZE);
+        qint64 indexOffset = 0;
+        quint32 magic = 0;
+        mStream >> indexOffset >> magic;
+        if (magic != DataLog::INDEX_MAGIC || indexOffset < mFirstBlock || indexOffset >= mFile.size()) {
+            mStream.resetStatus();
+            return false;
+        }
+
+        mFile.seek(indexOffset);
+        quint32 count = 0;
+        mStream >> magic >> count;
+        for (quint32 i = 0; i < count && mStream.status() == QDataStream::Ok; i++) {
+            DataLog::BlockIndex_t entry;
+            mStream >> entry.offset >> entry.firstUs >> entry.lastUs;
+            mIndex.append(entry);
+        }
+
+        if (magic != DataLog::INDEX_MAGIC || mStream.status() != QDataStream::Ok) {
+            mIndex.clear();
+            mStream.resetStatus();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Rebuild the index by walking the blocks (log wasn't closed cleanly)
+     */
+    void scanIndex() {
+        mFile.seek(mFirstBlock);
+        while (!mStream.atEnd()) {
+            DataLog::BlockIndex_t entry;
+            entry.offset = mFile.pos();
+
+            quint32 magic = 0;
+            quint32 count = 0;
+            quint32 dropped = 0;
+            QByteArray payload;
+            mStream >> magic >> entry.firstUs >> entry.lastUs >> count >> dropped >> payload;
+            if (magic != DataLog::BLOCK_MAGIC || mStream.status() != QDataStream::Ok) {
+                // index or a truncated block
+                break;
+            }
+            mIndex.append(entry);
+        }
+        mStream.resetStatus();
+    }
+};
+
+#endif // DATA_LOG_H
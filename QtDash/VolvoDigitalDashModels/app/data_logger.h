@@ -0,0 +1,285 @@
+#ifndef DATA_LOGGER_H
+#define DATA_LOGGER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include <config.h>
+#include <data_log.h>
+#include <sensor.h>
+
+/**
+ * @brief Logs every sensor channel to a columnar, block compressed file (see DataLog).
+ *
+ * Samples are timestamped and queued on the GUI thread; a background thread
+ * encodes, compresses and writes a block every few seconds and only fsyncs
+ * every sync interval so the SD card never stalls rendering. The queue is
+ * bounded -- if the writer falls behind, new samples are dropped and the drop
+ * count is stored with the next block.
+ */
+class DataLogger : public QObject {
+    Q_OBJECT
+public:
+    static constexpr char FILE_PREFIX[] = "log_"; //!< channel log file name prefix
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param config: data logger config
+     */
+    DataLogger(QObject * parent, Config::DataLoggerConfig_t config) :
+        QObject(parent), mConfig(config), mThread(this) {
+        mConfig.blockSeconds = qMax(1, mConfig.blockSeconds);
+        mConfig.syncSeconds = qMax(mConfig.blockSeconds, mConfig.syncSeconds);
+        mConfig.maxPendingSamples = qMax(1024, mConfig.maxPendingSamples);
+
+        mPending.reserve(mConfig.maxPendingSamples);
+        mWriting.reserve(mConfig.maxPendingSamples);
+    }
+
+    ~DataLogger() {
+        stop();
+    }
+
+    /**
+     * @brief Add a channel -- channels must be added before start()
+     * @param name: channel name
+     * @param units: units of the logged values
+     * @param resolution: quantization step, 0 to pick one from the units
+     * @return channel id, -1 if already logging
+     */
+    int addChannel(QString name, QString units, qreal resolution = 0) {
+        if (isLogging()) {
+            return -1;
+        }
+        if (resolution <= 0) {
+            resolution = DataLog::defaultResolution(units);
+        }
+        mChannels.append({name, units, resolution});
+        return mChannels.size() - 1;
+    }
+
+    /**
+     * @brief Log every sample a sensor takes, at full rate (before decimation for the gauge)
+     * @param name: channel name
+     * @param sensor: sensor
+     * @return channel id, -1 if already logging
+     */
+    int addSensor(QString name, Sensor * sensor) {
+        int channel = addChannel(name, sensor->getUnits());
+        if (channel >= 0) {
+            QObject::connect(sensor, &Sensor::sampleReady, this, [=](qreal value) {
+                log(channel, value);
+            });
+        }
+        return channel;
+    }
+
+    /**
+     * @brief Open a new log in the configured directory and start the writer thread
+     * @return true if logging
+     */
+    bool start() {
+        if (isLogging()) {
+            return true;
+        }
+
+        QDir dir(mConfig.path);
+        if (!dir.exists() && !dir.mkpath(".")) {
+            qDebug() << "Unable to create data log directory: " << dir.path();
+            return false;
+        }
+
+        QDateTime now = QDateTime::currentDateTime();
+        mFile.setFileName(dir.filePath(
+                    FILE_PREFIX + now.toString("yyyyMMdd-hhmmss") + DataLog::FILE_EXTENSION));
+        if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qDebug() << "Unable to open data log: " << mFile.fileName();
+            return false;
+        }
+
+        QDataStream stream(&mFile);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << DataLog::FILE_MAGIC << DataLog::VERSION << now.toMSecsSinceEpoch()
+               << DataLog::TIME_TICK_US << (quint16) mChannels.size();
+        for (auto channel : mChannels) {
+            stream << channel.name << channel.units << channel.resolution;
+        }
+
+        qDebug() << "Logging " << mChannels.size() << " channels to: " << mFile.fileName();
+        mStopping = false;
+        mDropped = 0;
+        mIndex.clear();
+        mClock.start();
+
+        // the file is only touched by the writer thread from here on
+        mThread.start(QThread::LowPriority);
+        return true;
+    }
+
+    /**
+     * @brief Write out the remaining samples, the block index and close the log
+     */
+    void stop() {
+        if (!isLogging()) {
+            return;
+        }
+
+        mMutex.lock();
+        mStopping = true;
+        mWake.wakeOne();
+        mMutex.unlock();
+
+        mThread.wait();
+    }
+
+    bool isLogging() {
+        return mThread.isRunning();
+    }
+
+public slots:
+    /**
+     * @brief Queue a sample with the current log time
+     * @param channel: channel id from addChannel
+     * @param value: channel value
+     */
+    void log(int channel, qreal value) {
+        if (channel < 0 || !isLogging()) {
+            return;
+        }
+
+        qint64 now = mClock.nsecsElapsed() / 1000;
+        QMutexLocker lock(&mMutex);
+        if (mPending.size() >= mConfig.maxPendingSamples) {
+            mDropped++;
+            return;
+        }
+        mPending.append({now, value, (quint16) channel});
+
+        // don't wait for the block timer if the queue is filling up
+        if (mPending.size() == mConfig.maxPendingSamples * 3 / 4) {
+            mWake.wakeOne();
+        }
+    }
+
+private:
+    /**
+     * @brief Background writer thread
+     */
+    class WriterThread : public QThread {
+    public:
+        WriterThread(DataLogger * logger) : mLogger(logger) {}
+
+    protected:
+        void run() override {
+            mLogger->writeLoop();
+        }
+
+    private:
+        DataLogger * mLogger;
+    };
+
+    Config::DataLoggerConfig_t mConfig; //!< data logger config
+    QVector<DataLog::Channel_t> mChannels; //!< channel table
+    WriterThread mThread; //!< block writer thread
+    QFile mFile; //!< log file (owned by the writer thread while logging)
+    QElapsedTimer mClock; //!< log clock
+
+    QMutex mMutex; //!< guards mPending, mDropped and mStopping
+    QWaitCondition mWake; //!< wakes the writer early
+    QVector<DataLog::Sample_t> mPending; //!< samples queued by the GUI thread
+    QVector<DataLog::Sample_t> mWriting; //!< samples being encoded by the writer thread
+    quint32 mDropped = 0; //!< samples dropped since the last block
+    bool mStopping = false; //!< writer should flush and exit
+
+    QVector<DataLog::BlockIndex_t> mIndex; //!< written blocks
+
+    /**
+     * @brief Writer thread body -- one block per block interval, fsync every sync interval
+     */
+    void writeLoop() {
+        QDataStream stream(&mFile);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        QElapsedTimer syncTimer;
+        syncTimer.start();
+
+        bool stopping = false;
+        while (!stopping) {
+            quint32 dropped = 0;
+
+            mMutex.lock();
+            if (!mStopping) {
+                mWake.wait(&mMutex, mConfig.blockSeconds * 1000);
+            }
+            // swap buffers -- both keep their reserved capacity
+            mPending.swap(mWriting);
+            dropped = mDropped;
+            mDropped = 0;
+            stopping = mStopping;
+            mMutex.unlock();
+
+            if (!mWriting.isEmpty() || dropped > 0) {
+                writeBlock(stream, dropped);
+                mWriting.clear();
+            }
+
+            if (stopping || syncTimer.elapsed() >= mConfig.syncSeconds * 1000) {
+                sync();
+                syncTimer.restart();
+            }
+        }
+
+        // block index for seeking
+        qint64 indexOffset = mFile.pos();
+        stream << DataLog::INDEX_MAGIC << (quint32) mIndex.size();
+        for (auto entry : mIndex) {
+            stream << entry.offset << entry.firstUs << entry.lastUs;
+        }
+        stream << indexOffset << DataLog::INDEX_MAGIC;
+        sync();
+        mFile.close();
+    }
+
+    /**
+     * @brief Encode, compress and append the samples in mWriting
+     * @param stream: log stream
+     * @param dropped: samples dropped while this block was filling
+     */
+    void writeBlock(QDataStream & stream, quint32 dropped) {
+        DataLog::BlockIndex_t entry = {mFile.pos(), 0, 0};
+        if (!mWriting.isEmpty()) {
+            entry.firstUs = mWriting.first().timeUs;
+            entry.lastUs = mWriting.last().timeUs;
+        }
+
+        QByteArray payload = qCompress(
+                    DataLog::encodeBlock(mWriting, mChannels, entry.firstUs),
+                    DataLog::COMPRESSION_LEVEL);
+
+        stream << DataLog::BLOCK_MAGIC << entry.firstUs << entry.lastUs
+               << (quint32) mWriting.size() << dropped << payload;
+        mIndex.append(entry);
+    }
+
+    /**
+     * @brief Push written blocks to the SD card
+     */
+    void sync() {
+        mFile.flush();
+#ifdef Q_OS_UNIX
+        ::fsync(mFile.handle());
+#endif
+    }
+};
+
+#endif // DATA_LOGGER_H
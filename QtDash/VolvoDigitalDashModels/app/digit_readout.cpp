@@ -0,0 +1,487 @@
+#include "digit_readout.h"
+
+#include <QFontMetricsF>
+#include <QCache>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGTextureMaterial>
+#include <QtMath>
+#include <QtQml>
+
+namespace {
+
+constexpr int MAX_DECIMALS = 6;
+constexpr quint64 POWERS_OF_TEN[MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+constexpr qreal MAX_MAGNITUDE = 1e18; //!< keeps the scaled value inside a qint64
+constexpr int UNITS_QUAD = DigitReadout::MAX_CELLS; //!< quad index of the units
+constexpr int VERTICES_PER_QUAD = 6;
+constexpr int PADDING = 1; //!< transparent border around each glyph so edges filter cleanly
+constexpr int STRIP_CACHE_LIMIT_KB = 4 * 1024; //!< strips kept for reuse, least recently used go first
+
+/**
+ * @brief One textured quad per cell plus the units, preallocated so an update
+ * only rewrites vertices
+ */
+class ReadoutNode : public QSGGeometryNode
+{
+public:
+    ReadoutNode() :
+        mGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(),
+                  (DigitReadout::MAX_CELLS + 1) * VERTICES_PER_QUAD)
+    {
+        mGeometry.setDrawingMode(QSGGeometry::DrawTriangles);
+        memset(mGeometry.vertexData(), 0, mGeometry.vertexCount() * mGeometry.sizeOfVertex());
+        setGeometry(&mGeometry);
+        mMaterial.setFiltering(QSGTexture::Linear);
+        setMaterial(&mMaterial);
+    }
+
+    ~ReadoutNode()
+    {
+        delete mTexture;
+    }
+
+    /**
+     * @brief Write one quad, an empty rect hides it
+     * @param index: quad index
+     * @param rect: position in item coordinates
+     * @param source: normalized texture rect
+     */
+    void setQuad(int index, const QRectF & rect, const QRectF & source)
+    {
+        QSGGeometry::TexturedPoint2D * v =
+                mGeometry.vertexDataAsTexturedPoint2D() + index * VERTICES_PER_QUAD;
+        float l = rect.left(), r = rect.right(), t = rect.top(), b = rect.bottom();
+        float sl = source.left(), sr = source.right(), st = source.top(), sb = source.bottom();
+        v[0].set(l, t, sl, st);
+        v[1].set(r, t, sr, st);
+        v[2].set(l, b, sl, sb);
+        v[3].set(r, t, sr, st);
+        v[4].set(r, b, sr, sb);
+        v[5].set(l, b, sl, sb);
+    }
+
+    QSGGeometry mGeometry;
+    QSGTextureMaterial mMaterial;
+    QSGTexture * mTexture = nullptr;
+};
+
+} // namespace
+
+DigitReadout::DigitReadout(QQuickItem * parent) :
+    QQuickItem(parent),
+    mValue(0),
+    mDecimals(0),
+    mFormat(Number),
+    mUnits(""),
+    mColor(Qt::white),
+    mHorizontalAlignment(Qt::AlignHCenter),
+    mFit(false),
+    mStrip(),
+    mStripDirty(true),
+    mTextureDirty(false),
+    mCount(0),
+    mContentWidth(0),
+    mDirtyCells(0),
+    mLayoutDirty(true)
+{
+    setFlag(ItemHasContents, true);
+    memset(mGlyphs, 0, sizeof(mGlyphs));
+    memset(mCellX, 0, sizeof(mCellX));
+    polish();
+}
+
+void DigitReadout::registerType()
+{
+    qmlRegisterType<DigitReadout>(QML_URI, 1, 0, QML_NAME);
+}
+
+int DigitReadout::formatGlyphs(qreal value, int decimals, Format format, quint8 * glyphs)
+{
+    int count = 0;
+    quint8 digits[20];
+
+    // most significant digit first, zero padded to minDigits
+    auto putDigits = [&](quint64 number, int minDigits) {
+        int n = 0;
+        do {
+            digits[n++] = number % 10;
+            number /= 10;
+        } while (number > 0 || n < minDigits);
+        while (n > 0 && count < MAX_CELLS) {
+            glyphs[count++] = GLYPH_0 + digits[--n];
+        }
+    };
+    auto put = [&](quint8 glyph) {
+        if (count < MAX_CELLS) {
+            glyphs[count++] = glyph;
+        }
+    };
+
+    if (!qIsFinite(value)) {
+        put(GLYPH_MINUS);
+        put(GLYPH_MINUS);
+        return count;
+    }
+
+    if (format == Time) {
+        quint64 total = (quint64) qRound64(qBound(0.0, value, MAX_MAGNITUDE));
+        putDigits(total / 3600, 1);
+        put(GLYPH_COLON);
+        putDigits((total / 60) % 60, 2);
+        put(GLYPH_COLON);
+        putDigits(total % 60, 2);
+        return count;
+    }
+
+    decimals = qBound(0, decimals, MAX_DECIMALS);
+    quint64 scale = POWERS_OF_TEN[decimals];
+    quint64 scaled = (quint64) qRound64(qMin(qAbs(value) * scale, MAX_MAGNITUDE));
+    if (value < 0 && scaled != 0) {
+        put(GLYPH_MINUS);
+    }
+    putDigits(scaled / scale, 1);
+    if (decimals > 0) {
+        put(GLYPH_POINT);
+        putDigits(scaled % scale, decimals);
+    }
+    return count;
+}
+
+qreal DigitReadout::value() const
+{
+    return mValue;
+}
+
+int DigitReadout::decimals() const
+{
+    return mDecimals;
+}
+
+DigitReadout::Format DigitReadout::format() const
+{
+    return mFormat;
+}
+
+QString DigitReadout::units() const
+{
+    return mUnits;
+}
+
+QFont DigitReadout::font() const
+{
+    return mFont;
+}
+
+QColor DigitReadout::color() const
+{
+    return mColor;
+}
+
+Qt::Alignment DigitReadout::horizontalAlignment() const
+{
+    return mHorizontalAlignment;
+}
+
+bool DigitReadout::fit() const
+{
+    return mFit;
+}
+
+void DigitReadout::setValue(qreal value)
+{
+    if (mValue == value)
+        return;
+
+    mValue = value;
+    emit valueChanged(mValue);
+    updateGlyphs();
+}
+
+void DigitReadout::setDecimals(int decimals)
+{
+    if (mDecimals == decimals)
+        return;
+
+    mDecimals = decimals;
+    emit decimalsChanged(mDecimals);
+    updateGlyphs();
+}
+
+void DigitReadout::setFormat(Format format)
+{
+    if (mFormat == format)
+        return;
+
+    mFormat = format;
+    emit formatChanged(mFormat);
+    updateGlyphs();
+}
+
+void DigitReadout::setUnits(QString units)
+{
+    if (mUnits == units)
+        return;
+
+    mUnits = units;
+    emit unitsChanged(mUnits);
+    markStyleDirty();
+}
+
+void DigitReadout::setFont(QFont font)
+{
+    if (mFont == font)
+        return;
+
+    mFont = font;
+    emit fontChanged(mFont);
+    markStyleDirty();
+}
+
+void DigitReadout::setColor(QColor color)
+{
+    if (mColor == color)
+        return;
+
+    mColor = color;
+    emit colorChanged(mColor);
+    markStyleDirty();
+}
+
+void DigitReadout::setHorizontalAlignment(Qt::Alignment horizontalAlignment)
+{
+    if (mHorizontalAlignment == horizontalAlignment)
+        return;
+
+    mHorizontalAlignment = horizontalAlignment;
+    emit horizontalAlignmentChanged(mHorizontalAlignment);
+    mLayoutDirty = true;
+    update();
+}
+
+void DigitReadout::setFit(bool fit)
+{
+    if (mFit == fit)
+        return;
+
+    mFit = fit;
+    emit fitChanged(mFit);
+    mLayoutDirty = true;
+    update();
+}
+
+QSGNode * DigitReadout::updatePaintNode(QSGNode * oldNode, UpdatePaintNodeData * data)
+{
+    (void) data;
+
+    ReadoutNode * node = static_cast<ReadoutNode *>(oldNode);
+    if (mStrip.image.isNull()) {
+        delete node;
+        return nullptr;
+    }
+    if (!node) {
+        node = new ReadoutNode();
+        mTextureDirty = true;
+    }
+
+    if (mTextureDirty) {
+        delete node->mTexture;
+        node->mTexture = window()->createTextureFromImage(mStrip.image, QQuickWindow::TextureCanUseAtlas);
+        node->mMaterial.setTexture(node->mTexture);
+        node->markDirty(QSGNode::DirtyMaterial);
+        mTextureDirty = false;
+        mLayoutDirty = true;
+    }
+
+    if (!mLayoutDirty && mDirtyCells == 0) {
+        return node;
+    }
+
+    // fit shrinks the whole readout uniformly, like Text.Fit
+    qreal scale = 1.0;
+    if (mFit && width() > 0 && height() > 0 && mContentWidth > 0) {
+        scale = qMin(1.0, qMin(width() / mContentWidth, height() / mStrip.height));
+    }
+
+    qreal x = 0;
+    if (mHorizontalAlignment & Qt::AlignRight) {
+        x = width() - mContentWidth * scale;
+    } else if (mHorizontalAlignment & Qt::AlignHCenter) {
+        x = (width() - mContentWidth * scale) / 2.0;
+    }
+    qreal y = (height() - mStrip.height * scale) / 2.0;
+
+    QRectF sub = node->mTexture->normalizedTextureSubRect();
+    qreal imageWidth = mStrip.image.width();
+    qreal imageHeight = mStrip.image.height();
+    auto quad = [&](int index, qreal cellX, const QRectF & rect) {
+        QRectF position(x + (cellX - PADDING) * scale, y - PADDING * scale,
+                        rect.width() * scale, rect.height() * scale);
+        QRectF source(sub.x() + rect.x() / imageWidth * sub.width(),
+                      sub.y() + rect.y() / imageHeight * sub.height(),
+                      rect.width() / imageWidth * sub.width(),
+                      rect.height() / imageHeight * sub.height());
+        node->setQuad(index, position, source);
+    };
+
+    // only the cells whose digit changed are rewritten
+    for (int i = 0; i < MAX_CELLS; i++) {
+        if (!mLayoutDirty && !(mDirtyCells & (1u << i))) {
+            continue;
+        }
+        if (i < mCount) {
+            quad(i, mCellX[i], mStrip.rects[mGlyphs[i]]);
+        } else {
+            node->setQuad(i, QRectF(), QRectF());
+        }
+    }
+
+    if (mLayoutDirty) {
+        if (mStrip.unitsRect.isEmpty()) {
+            node->setQuad(UNITS_QUAD, QRectF(), QRectF());
+        } else {
+            qreal unitsX = mContentWidth - (mStrip.unitsRect.width() - 2 * PADDING);
+            quad(UNITS_QUAD, unitsX, mStrip.unitsRect);
+        }
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    mDirtyCells = 0;
+    mLayoutDirty = false;
+    return node;
+}
+
+void DigitReadout::updatePolish()
+{
+    if (mStripDirty) {
+        mStrip = buildStrip(mFont, mColor, mUnits);
+        mStripDirty = false;
+        mTextureDirty = true;
+        mLayoutDirty = true;
+        // advances changed -- lay the glyphs out again
+        mCount = -1;
+    }
+    updateGlyphs();
+}
+
+void DigitReadout::geometryChanged(const QRectF & newGeometry, const QRectF & oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        mLayoutDirty = true;
+        update();
+    }
+}
+
+void DigitReadout::itemChange(ItemChange change, const ItemChangeData & value)
+{
+    if (change == ItemVisibleHasChanged && value.boolValue) {
+        updateGlyphs();
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void DigitReadout::updateGlyphs()
+{
+    if (mStripDirty || !isVisible()) {
+        // laid out once the new strip is built, or once shown (a cached layout)
+        return;
+    }
+
+    quint8 glyphs[MAX_CELLS];
+    int count = formatGlyphs(mValue, mDecimals, mFormat, glyphs);
+
+    qreal x = 0;
+    bool moved = (count != mCount);
+    for (int i = 0; i < count; i++) {
+        moved = moved || (mCellX[i] != x);
+        if (mGlyphs[i] != glyphs[i]) {
+            mDirtyCells |= (1u << i);
+        }
+        mGlyphs[i] = glyphs[i];
+        mCellX[i] = x;
+        x += mStrip.advances[glyphs[i]];
+    }
+    if (!mStrip.unitsRect.isEmpty()) {
+        x += mStrip.spaceAdvance + mStrip.unitsRect.width() - 2 * PADDING;
+    }
+
+    if (moved || x != mContentWidth) {
+        mLayoutDirty = true;
+    }
+    mCount = count;
+    mContentWidth = x;
+    setImplicitSize(mContentWidth, mStrip.height);
+
+    if (mLayoutDirty || mDirtyCells) {
+        update();
+    }
+}
+
+void DigitReadout::markStyleDirty()
+{
+    mStripDirty = true;
+    polish();
+}
+
+DigitReadout::GlyphStrip DigitReadout::buildStrip(const QFont & font, const QColor & color, const QString & units)
+{
+    // readouts with the same style share one strip (GUI thread only) -- bounded,
+    // as an animated color or font size would otherwise add a strip per frame
+    static QCache<QString, GlyphStrip> cache(STRIP_CACHE_LIMIT_KB);
+
+    QString key = font.key() + "|" + color.name(QColor::HexArgb) + "|" + units;
+    if (GlyphStrip * cached = cache.object(key)) {
+        return *cached;
+    }
+
+    static const QChar characters[GLYPH_COUNT] = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', '-', ':'
+    };
+
+    QFontMetricsF metrics(font);
+    GlyphStrip strip;
+    strip.height = metrics.height();
+    strip.spaceAdvance = metrics.horizontalAdvance(' ');
+
+    // tabular digits -- every digit gets the widest advance
+    qreal digitAdvance = 0;
+    for (int i = GLYPH_0; i < GLYPH_POINT; i++) {
+        digitAdvance = qMax(digitAdvance, metrics.horizontalAdvance(characters[i]));
+    }
+
+    int cellHeight = qCeil(strip.height) + 2 * PADDING;
+    int imageWidth = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        strip.advances[i] = (i < GLYPH_POINT) ? digitAdvance : metrics.horizontalAdvance(characters[i]);
+        strip.rects[i] = QRectF(imageWidth, 0, qCeil(strip.advances[i]) + 2 * PADDING, cellHeight);
+        imageWidth += strip.rects[i].width();
+    }
+    strip.unitsRect = QRectF();
+    if (!units.isEmpty()) {
+        strip.unitsRect = QRectF(imageWidth, 0, qCeil(metrics.horizontalAdvance(units)) + 2 * PADDING, cellHeight);
+        imageWidth += strip.unitsRect.width();
+    }
+
+    strip.image = QImage(imageWidth, cellHeight, QImage::Format_ARGB32_Premultiplied);
+    strip.image.fill(Qt::transparent);
+
+    QPainter painter(&strip.image);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setFont(font);
+    painter.setPen(color);
+    qreal baseline = PADDING + metrics.ascent();
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        // center each glyph in its cell
+        qreal offset = (strip.advances[i] - metrics.horizontalAdvance(characters[i])) / 2.0;
+        painter.drawText(QPointF(strip.rects[i].x() + PADDING + offset, baseline), QString(characters[i]));
+    }
+    if (!units.isEmpty()) {
+        painter.drawText(QPointF(strip.unitsRect.x() + PADDING, baseline), units);
+    }
+    painter.end();
+
+    cache.insert(key, new GlyphStrip(strip), qMax(1, (int)(strip.image.sizeInBytes() / 1024)));
+    return strip;
+}
@@ -0,0 +1,148 @@
+#ifndef DIGIT_READOUT_H
+#define DIGIT_READOUT_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QRectF>
+
+/**
+ * @brief Numeric readout drawn from a pre-rasterized glyph strip.
+ *
+ * The digits, separators and the units string are rasterized once per
+ * font/color/units into one small image (shared by every readout with the
+ * same style). A new value is formatted into a fixed glyph array without
+ * building a string, and only the quads of the cells whose glyph changed are
+ * rewritten -- no text layout, shaping or JS string allocation per sample.
+ * Digits use tabular (fixed) advances so the readout doesn't jitter.
+ */
+class DigitReadout : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal value READ value WRITE setValue NOTIFY valueChanged)
+    Q_PROPERTY(int decimals READ decimals WRITE setDecimals NOTIFY decimalsChanged)
+    Q_PROPERTY(Format format READ format WRITE setFormat NOTIFY formatChanged)
+    Q_PROPERTY(QString units READ units WRITE setUnits NOTIFY unitsChanged)
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(Qt::Alignment horizontalAlignment READ horizontalAlignment WRITE setHorizontalAlignment NOTIFY horizontalAlignmentChanged)
+    Q_PROPERTY(bool fit READ fit WRITE setFit NOTIFY fitChanged)
+
+public:
+    static constexpr char QML_URI[] = "DigitalDash"; //!< qml import uri
+    static constexpr char QML_NAME[] = "DigitReadout"; //!< qml type name
+    static constexpr int MAX_CELLS = 24; //!< most glyphs a readout shows (units excluded)
+
+    /**
+     * @brief How the value is shown
+     */
+    enum Format {
+        Number, //!< fixed point with decimals digits after the point
+        Time //!< value in seconds as h:mm:ss
+    };
+    Q_ENUM(Format)
+
+    /**
+     * @brief Glyphs in the strip
+     */
+    enum Glyph {
+        GLYPH_0 = 0,
+        GLYPH_POINT = 10,
+        GLYPH_MINUS,
+        GLYPH_COLON,
+        GLYPH_COUNT
+    };
+
+    explicit DigitReadout(QQuickItem * parent = nullptr);
+
+    /**
+     * @brief Register the QML type (import DigitalDash 1.0)
+     */
+    static void registerType();
+
+    qreal value() const;
+    int decimals() const;
+    Format format() const;
+    QString units() const;
+    QFont font() const;
+    QColor color() const;
+    Qt::Alignment horizontalAlignment() const;
+    bool fit() const;
+
+    /**
+     * @brief Format a value into glyphs
+     * @param value: value
+     * @param decimals: digits after the point (Number)
+     * @param format: number or time
+     * @param glyphs: output, MAX_CELLS long
+     * @return glyph count
+     */
+    static int formatGlyphs(qreal value, int decimals, Format format, quint8 * glyphs);
+
+signals:
+    void valueChanged(qreal value);
+    void decimalsChanged(int decimals);
+    void formatChanged(Format format);
+    void unitsChanged(QString units);
+    void fontChanged(QFont font);
+    void colorChanged(QColor color);
+    void horizontalAlignmentChanged(Qt::Alignment horizontalAlignment);
+    void fitChanged(bool fit);
+
+public slots:
+    void setValue(qreal value);
+    void setDecimals(int decimals);
+    void setFormat(Format format);
+    void setUnits(QString units);
+    void setFont(QFont font);
+    void setColor(QColor color);
+    void setHorizontalAlignment(Qt::Alignment horizontalAlignment);
+    void setFit(bool fit);
+
+protected:
+    QSGNode * updatePaintNode(QSGNode * oldNode, UpdatePaintNodeData * data) override;
+    void updatePolish() override;
+    void geometryChanged(const QRectF & newGeometry, const QRectF & oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData & value) override;
+
+private:
+    /**
+     * @struct GlyphStrip
+     */
+    typedef struct GlyphStrip {
+        QImage image; //!< rasterized glyphs and units
+        QRectF rects[GLYPH_COUNT]; //!< glyph rects in the image
+        qreal advances[GLYPH_COUNT]; //!< glyph advances
+        QRectF unitsRect; //!< units rect in the image, empty if no units
+        qreal spaceAdvance; //!< gap between the number and the units
+        qreal height; //!< line height
+    } GlyphStrip_t;
+
+    qreal mValue;
+    int mDecimals;
+    Format mFormat;
+    QString mUnits;
+    QFont mFont;
+    QColor mColor;
+    Qt::Alignment mHorizontalAlignment;
+    bool mFit;
+
+    GlyphStrip mStrip; //!< glyphs for the current style
+    bool mStripDirty; //!< style changed, strip needs rebuilding (polish)
+    bool mTextureDirty; //!< strip rebuilt, texture needs replacing (sync)
+
+    quint8 mGlyphs[MAX_CELLS]; //!< glyphs shown
+    qreal mCellX[MAX_CELLS]; //!< glyph x positions at natural size
+    int mCount; //!< glyphs in use
+    qreal mContentWidth; //!< natural width including the units
+    quint32 mDirtyCells; //!< cells whose glyph changed since the last sync
+    bool mLayoutDirty; //!< every quad needs rewriting
+
+    void updateGlyphs();
+    void markStyleDirty();
+
+    static GlyphStrip buildStrip(const QFont & font, const QColor & color, const QString & units);
+};
+
+#endif // DIGIT_READOUT_H
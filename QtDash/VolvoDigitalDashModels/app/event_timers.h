@@ -16,6 +16,7 @@ public:
     static constexpr int FAST_TIMER_TIMEOUT_MSEC = 100; //!< fast timer timeout
     static constexpr int MEDIUM_TIMER_TIMEOUT_MSEC = 150; //!< medium timer timeout
     static constexpr int SLOW_TIMER_TIMEOUT_MSEC = 500; //!< slow timer timeout
+    static constexpr int ACQUISITION_TIMER_ID = 1000; //!< sensor acquisition timers are this plus their interval (msec)
 
     /**
      * @brief Default timer values
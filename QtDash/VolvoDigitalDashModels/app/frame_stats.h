@@ -0,0 +1,84 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <QAtomicInt>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QQuickWindow>
+#include <QScreen>
+#include <QTimer>
+
+/**
+ * @brief Rendered vs skipped frame counts for a window.
+ *
+ * The scene graph only renders when an item asks for an update, so every
+ * refresh interval without a frame is a frame the dash didn't have to
+ * produce. Counts are reported to the debug log every REPORT_INTERVAL_MSEC.
+ */
+class FrameStats : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int REPORT_INTERVAL_MSEC = 10000; //!< log report interval
+    static constexpr qreal DEFAULT_REFRESH_RATE = 60; //!< used when the screen doesn't report one
+
+    /**
+     * @brief Constructor
+     * @param window: window to count frames of
+     * @param name: name used in the log
+     */
+    FrameStats(QQuickWindow * window, QString name) :
+        QObject(window), mWindow(window), mName(name) {
+        // frameSwapped comes from the render thread
+        connect(window, &QQuickWindow::frameSwapped, this, [this]() {
+            mFrames.ref();
+        }, Qt::DirectConnection);
+        connect(&mTimer, &QTimer::timeout, this, &FrameStats::report);
+
+        mTimer.start(REPORT_INTERVAL_MSEC);
+        mElapsed.start();
+    }
+
+    qint64 getRenderedFrames() const {
+        return mRenderedFrames;
+    }
+
+    qint64 getSkippedFrames() const {
+        return mSkippedFrames;
+    }
+
+public slots:
+    /**
+     * @brief Log the frames since the last report
+     */
+    void report() {
+        qreal seconds = mElapsed.restart() / 1000.0;
+        int rendered = mFrames.fetchAndStoreRelaxed(0);
+
+        qreal refreshRate = mWindow->screen() ? mWindow->screen()->refreshRate() : 0;
+        if (refreshRate <= 0) {
+            refreshRate = DEFAULT_REFRESH_RATE;
+        }
+        int intervals = qRound(seconds * refreshRate);
+        int skipped = qMax(0, intervals - rendered);
+
+        mRenderedFrames += rendered;
+        mSkippedFrames += skipped;
+
+        qDebug("%s: %d frames rendered, %d skipped (%.0f%% idle) in %.1f s",
+               qPrintable(mName), rendered, skipped,
+               intervals > 0 ? 100.0 * skipped / intervals : 0.0, seconds);
+    }
+
+private:
+    QQuickWindow * mWindow; //!< window being counted
+    QString mName; //!< name used in the log
+    QAtomicInt mFrames; //!< frames swapped since the last report
+    QElapsedTimer mElapsed; //!< time since the last report
+    QTimer mTimer; //!< report timer
+    qint64 mRenderedFrames = 0; //!< total frames rendered
+    qint64 mSkippedFrames = 0; //!< total refresh intervals without a frame
+};
+
+#endif // FRAME_STATS_H
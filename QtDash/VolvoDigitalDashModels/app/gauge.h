@@ -39,6 +39,14 @@ public:
         context->setContextProperty(modelName, mModel);
     }
 
+    /**
+     * @brief Get the sensors driving the gauge
+     * @return sensor list
+     */
+    QList<Sensor *> getSensors() {
+        return mSensors;
+    }
+
 protected:
     Config * mConfig; //!< Dash config
     QList<Sensor *> mSensors; //!< sensor list
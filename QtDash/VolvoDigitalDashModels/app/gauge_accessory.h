@@ -48,7 +48,7 @@ public:
         // connect the sensor output to the model value
         QObject::connect(
                     sensors.at(0), &Sensor::sensorDataReady,
-                    [=](QVariant data) {
+                    this, [=](QVariant data) {
 
             // get raw value
             qreal val = data.toReal();
@@ -62,6 +62,14 @@ public:
 
             ((AccessoryGaugeModel *)mModel)->setCurrentValue(val);
         });
+
+        // the needle holds its last good value through a fault, the model says why
+        QObject::connect(
+                    sensors.at(0), &Sensor::healthChanged, mModel,
+                    [=](int status) {
+            ((AccessoryGaugeModel *)mModel)->setFault(
+                        SensorHealth::toString((SensorHealth::Status) status));
+        });
     }
 
 public slots:
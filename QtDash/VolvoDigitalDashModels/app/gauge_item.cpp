@@ -0,0 +1,634 @@
+#include "gauge_item.h"
+
+#include <artwork_cache.h>
+
+#include <QLinearGradient>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QSGTransformNode>
+#include <QtMath>
+#include <QtQml>
+
+namespace {
+
+/**
+ * @brief Gauge node tree: dial, then a transform holding the center cap and
+ * the needle (needle on top)
+ */
+class GaugeNode : public QSGNode
+{
+public:
+    GaugeNode()
+    {
+        mTransform = new QSGTransformNode();
+        appendChildNode(mTransform);
+    }
+
+    QSGTransformNode * mTransform = nullptr;
+    QSGSimpleTextureNode * mDial = nullptr;
+    QSGSimpleTextureNode * mCenter = nullptr;
+    QSGSimpleTextureNode * mNeedle = nullptr;
+
+    /**
+     * @brief Replace the texture node in a slot -- removed if the image is empty
+     * @param slot: texture node slot
+     * @param parent: node the slot lives in
+     * @param image: new artwork
+     * @param window: window to create the texture with
+     * @param front: insert before the parent's other children
+     */
+    static void replace(QSGSimpleTextureNode *& slot, QSGNode * parent, const QImage & image,
+                        QQuickWindow * window, bool front)
+    {
+        if (slot) {
+            parent->removeChildNode(slot);
+            delete slot;
+            slot = nullptr;
+        }
+        if (image.isNull()) {
+            return;
+        }
+
+        slot = new QSGSimpleTextureNode();
+        slot->setTexture(window->createTextureFromImage(image, QQuickWindow::TextureCanUseAtlas));
+        slot->setOwnsTexture(true);
+        slot->setFiltering(QSGTexture::Linear);
+        if (front) {
+            parent->prependChildNode(slot);
+        } else {
+            parent->appendChildNode(slot);
+        }
+    }
+};
+
+} // namespace
+
+GaugeItem::GaugeItem(QQuickItem * parent) :
+    QQuickItem(parent),
+    mValue(0),
+    mMinValue(0),
+    mMaxValue(100),
+    mMinAngle(-235),
+    mMaxAngle(45),
+    mInitialValueOffset(0),
+    mClockwise(true),
+    mResponseTime(NeedleDynamics::DEFAULT_RESPONSE_MSEC),
+    mWrapAround(false),
+    mTargetAngle(0),
+    mDisplayAngle(0),
+    mPivotX(0),
+    mPivotY(0),
+    mNeedleLength(0),
+    mNeedleWidth(0),
+    mNeedleOffset(0),
+    mCenterSize(0),
+    mLowAlarm(0),
+    mHighAlarm(0),
+    mAlarm(false),
+    mPolishDirty(0),
+    mNodeDirty(0)
+{
+    setFlag(ItemHasContents, true);
+    mTargetAngle = valueToAngle(mValue, mMinValue, mMaxValue, mMinAngle, mMaxAngle,
+                                mInitialValueOffset, mClockwise);
+    mDisplayAngle = mTargetAngle;
+    mClock.start();
+    mDynamics.reset(mTargetAngle, 0);
+    updateAlarm();
+}
+
+void GaugeItem::registerType()
+{
+    qmlRegisterType<GaugeItem>(QML_URI, 1, 0, QML_NAME);
+}
+
+qreal GaugeItem::valueToAngle(qreal value, qreal minValue, qreal maxValue,
+                              qreal minAngle, qreal maxAngle,
+                              qreal initialValueOffset, bool clockwise)
+{
+    if (maxValue == minValue) {
+        return minAngle;
+    }
+
+    qreal internalValue = clockwise ? value : (maxValue - (value - minValue));
+    qreal position = (internalValue <= initialValueOffset) ? initialValueOffset : internalValue;
+    qreal angle = (position - minValue) / (maxValue - minValue) * (maxAngle - minAngle) + minAngle;
+
+    return qBound(qMin(minAngle, maxAngle), angle, qMax(minAngle, maxAngle));
+}
+
+qreal GaugeItem::value() const
+{
+    return mValue;
+}
+
+qreal GaugeItem::minValue() const
+{
+    return mMinValue;
+}
+
+qreal GaugeItem::maxValue() const
+{
+    return mMaxValue;
+}
+
+qreal GaugeItem::minAngle() const
+{
+    return mMinAngle;
+}
+
+qreal GaugeItem::maxAngle() const
+{
+    return mMaxAngle;
+}
+
+qreal GaugeItem::initialValueOffset() const
+{
+    return mInitialValueOffset;
+}
+
+bool GaugeItem::clockwise() const
+{
+    return mClockwise;
+}
+
+qreal GaugeItem::angle() const
+{
+    return mTargetAngle;
+}
+
+qreal GaugeItem::responseTime() const
+{
+    return mResponseTime;
+}
+
+bool GaugeItem::wrapAround() const
+{
+    return mWrapAround;
+}
+
+QString GaugeItem::dialSource() const
+{
+    return mDialSource;
+}
+
+QString GaugeItem::needleSource() const
+{
+    return mNeedleSource;
+}
+
+qreal GaugeItem::pivotX() const
+{
+    return mPivotX;
+}
+
+qreal GaugeItem::pivotY() const
+{
+    return mPivotY;
+}
+
+qreal GaugeItem::needleLength() const
+{
+    return mNeedleLength;
+}
+
+qreal GaugeItem::needleWidth() const
+{
+    return mNeedleWidth;
+}
+
+qreal GaugeItem::needleOffset() const
+{
+    return mNeedleOffset;
+}
+
+qreal GaugeItem::centerSize() const
+{
+    return mCenterSize;
+}
+
+qreal GaugeItem::lowAlarm() const
+{
+    return mLowAlarm;
+}
+
+qreal GaugeItem::highAlarm() const
+{
+    return mHighAlarm;
+}
+
+bool GaugeItem::alarm() const
+{
+    return mAlarm;
+}
+
+void GaugeItem::setValue(qreal value)
+{
+    if (qFuzzyCompare(mValue, value))
+        return;
+
+    mValue = value;
+    emit valueChanged(mValue);
+    updateTargetAngle();
+    updateAlarm();
+}
+
+void GaugeItem::setMinValue(qreal minValue)
+{
+    if (qFuzzyCompare(mMinValue, minValue))
+        return;
+
+    mMinValue = minValue;
+    emit minValueChanged(mMinValue);
+    updateTargetAngle();
+}
+
+void GaugeItem::setMaxValue(qreal maxValue)
+{
+    if (qFuzzyCompare(mMaxValue, maxValue))
+        return;
+
+    mMaxValue = maxValue;
+    emit maxValueChanged(mMaxValue);
+    updateTargetAngle();
+}
+
+void GaugeItem::setMinAngle(qreal minAngle)
+{
+    if (qFuzzyCompare(mMinAngle, minAngle))
+        return;
+
+    mMinAngle = minAngle;
+    emit minAngleChanged(mMinAngle);
+    updateTargetAngle();
+}
+
+void GaugeItem::setMaxAngle(qreal maxAngle)
+{
+    if (qFuzzyCompare(mMaxAngle, maxAngle))
+        return;
+
+    mMaxAngle = maxAngle;
+    emit maxAngleChanged(mMaxAngle);
+    updateTargetAngle();
+}
+
+void GaugeItem::setInitialValueOffset(qreal initialValueOffset)
+{
+    if (qFuzzyCompare(mInitialValueOffset, initialValueOffset))
+        return;
+
+    mInitialValueOffset = initialValueOffset;
+    emit initialValueOffsetChanged(mInitialValueOffset);
+    updateTargetAngle();
+}
+
+void GaugeItem::setClockwise(bool clockwise)
+{
+    if (mClockwise == clockwise)
+        return;
+
+    mClockwise = clockwise;
+    emit clockwiseChanged(mClockwise);
+    updateTargetAngle();
+}
+
+void GaugeItem::setResponseTime(qreal responseTime)
+{
+    if (qFuzzyCompare(mResponseTime, responseTime))
+        return;
+
+    mResponseTime = responseTime;
+    emit responseTimeChanged(mResponseTime);
+    mDynamics.setResponse(mResponseTime);
+}
+
+void GaugeItem::setWrapAround(bool wrapAround)
+{
+    if (mWrapAround == wrapAround)
+        return;
+
+    mWrapAround = wrapAround;
+    emit wrapAroundChanged(mWrapAround);
+}
+
+void GaugeItem::setDialSource(QString dialSource)
+{
+    if (mDialSource == dialSource)
+        return;
+
+    mDialSource = dialSource;
+    emit dialSourceChanged(mDialSource);
+    markDirty(DIRTY_DIAL);
+}
+
+void GaugeItem::setNeedleSource(QString needleSource)
+{
+    if (mNeedleSource == needleSource)
+        return;
+
+    mNeedleSource = needleSource;
+    emit needleSourceChanged(mNeedleSource);
+    markDirty(DIRTY_NEEDLE);
+}
+
+void GaugeItem::setPivotX(qreal pivotX)
+{
+    if (qFuzzyCompare(mPivotX, pivotX))
+        return;
+
+    mPivotX = pivotX;
+    emit pivotXChanged(mPivotX);
+    update();
+}
+
+void GaugeItem::setPivotY(qreal pivotY)
+{
+    if (qFuzzyCompare(mPivotY, pivotY))
+        return;
+
+    mPivotY = pivotY;
+    emit pivotYChanged(mPivotY);
+    update();
+}
+
+void GaugeItem::setNeedleLength(qreal needleLength)
+{
+    if (qFuzzyCompare(mNeedleLength, needleLength))
+        return;
+
+    mNeedleLength = needleLength;
+    emit needleLengthChanged(mNeedleLength);
+    markDirty(DIRTY_NEEDLE);
+}
+
+void GaugeItem::setNeedleWidth(qreal needleWidth)
+{
+    if (qFuzzyCompare(mNeedleWidth, needleWidth))
+        return;
+
+    mNeedleWidth = needleWidth;
+    emit needleWidthChanged(mNeedleWidth);
+    markDirty(DIRTY_NEEDLE);
+}
+
+void GaugeItem::setNeedleOffset(qreal needleOffset)
+{
+    if (qFuzzyCompare(mNeedleOffset, needleOffset))
+        return;
+
+    mNeedleOffset = needleOffset;
+    emit needleOffsetChanged(mNeedleOffset);
+    update();
+}
+
+void GaugeItem::setCenterSize(qreal centerSize)
+{
+    if (qFuzzyCompare(mCenterSize, centerSize))
+        return;
+
+    mCenterSize = centerSize;
+    emit centerSizeChanged(mCenterSize);
+    markDirty(DIRTY_CENTER);
+}
+
+void GaugeItem::setLowAlarm(qreal lowAlarm)
+{
+    if (qFuzzyCompare(mLowAlarm, lowAlarm))
+        return;
+
+    mLowAlarm = lowAlarm;
+    emit lowAlarmChanged(mLowAlarm);
+    updateAlarm();
+}
+
+void GaugeItem::setHighAlarm(qreal highAlarm)
+{
+    if (qFuzzyCompare(mHighAlarm, highAlarm))
+        return;
+
+    mHighAlarm = highAlarm;
+    emit highAlarmChanged(mHighAlarm);
+    updateAlarm();
+}
+
+QSGNode * GaugeItem::updatePaintNode(QSGNode * oldNode, UpdatePaintNodeData * data)
+{
+    (void) data;
+
+    GaugeNode * node = static_cast<GaugeNode *>(oldNode);
+    if (!node) {
+        // new window -- every texture has to be created again
+        node = new GaugeNode();
+        mNodeDirty = DIRTY_DIAL | DIRTY_NEEDLE | DIRTY_CENTER;
+    }
+
+    // textures are only rebuilt when the artwork was rescaled
+    if (mNodeDirty & DIRTY_DIAL) {
+        GaugeNode::replace(node->mDial, node, mDialImage, window(), true);
+    }
+    if (mNodeDirty & DIRTY_CENTER) {
+        GaugeNode::replace(node->mCenter, node->mTransform, mCenterImage, window(), true);
+    }
+    if (mNodeDirty & DIRTY_NEEDLE) {
+        GaugeNode::replace(node->mNeedle, node->mTransform, mNeedleImage, window(), false);
+    }
+    mNodeDirty = 0;
+
+    // setRect is a no-op when nothing moved
+    if (node->mDial) {
+        node->mDial->setRect(boundingRect());
+    }
+    if (node->mCenter) {
+        qreal size = mCenterImage.width();
+        node->mCenter->setRect(-size / 2.0, -size / 2.0, size, size);
+    }
+    if (node->mNeedle) {
+        node->mNeedle->setRect(-mNeedleOffset - 1, -mNeedleImage.height() / 2.0,
+                               mNeedleImage.width(), mNeedleImage.height());
+    }
+
+    QMatrix4x4 matrix;
+    matrix.translate(mPivotX, mPivotY);
+    matrix.rotate(mDisplayAngle, 0, 0, 1);
+    if (matrix != node->mTransform->matrix()) {
+        node->mTransform->setMatrix(matrix);
+    }
+
+    return node;
+}
+
+void GaugeItem::updatePolish()
+{
+    if (!isVisible()) {
+        // hidden (a cached layout) -- rescale once shown, not on every size change
+        return;
+    }
+
+    if (mPolishDirty & DIRTY_DIAL) {
+        mDialImage = ArtworkCache::load(mDialSource, QSize(qRound(width()), qRound(height())));
+    }
+
+    if (mPolishDirty & DIRTY_NEEDLE) {
+        QImage image = ArtworkCache::load(mNeedleSource, QSize(qRound(mNeedleLength), qRound(mNeedleWidth)));
+        mNeedleImage = QImage();
+        if (!image.isNull()) {
+            // transparent border so the rotated edges are filtered instead of aliased
+            mNeedleImage = QImage(image.size() + QSize(2, 2), QImage::Format_ARGB32_Premultiplied);
+            mNeedleImage.fill(Qt::transparent);
+            QPainter painter(&mNeedleImage);
+            painter.drawImage(1, 1, image);
+        }
+    }
+
+    if (mPolishDirty & DIRTY_CENTER) {
+        int size = qCeil(mCenterSize);
+        mCenterImage = QImage();
+        if (size > 0) {
+            mCenterImage = QImage(size, size, QImage::Format_ARGB32_Premultiplied);
+            mCenterImage.fill(Qt::transparent);
+            QPainter painter(&mCenterImage);
+            painter.setRenderHint(QPainter::Antialiasing);
+
+            QLinearGradient gradient(0, 0, 0, size);
+            gradient.setColorAt(0.0, Qt::black);
+            gradient.setColorAt(0.5, Qt::gray);
+            gradient.setColorAt(1.0, Qt::black);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(gradient);
+            painter.drawEllipse(QRectF(0, 0, size, size));
+
+            qreal border = size / 15.0;
+            painter.setPen(QPen(Qt::gray, border));
+            painter.setBrush(Qt::NoBrush);
+            painter.drawEllipse(QRectF(border / 2, border / 2, size - border, size - border));
+        }
+    }
+
+    mNodeDirty |= mPolishDirty;
+    mPolishDirty = 0;
+}
+
+void GaugeItem::geometryChanged(const QRectF & newGeometry, const QRectF & oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        markDirty(DIRTY_DIAL);
+    }
+}
+
+void GaugeItem::itemChange(ItemChange change, const ItemChangeData & value)
+{
+    if (change == ItemSceneChange) {
+        stopFrames();
+        if (value.window && isVisible() && !mDynamics.isSettled(mClock.nsecsElapsed() / 1000)) {
+            startFrames();
+        }
+    } else if (change == ItemVisibleHasChanged) {
+        // a hidden gauge (a cached layout) doesn't animate, shown it starts at its value
+        parkNeedle();
+        if (value.boolValue && mPolishDirty) {
+            polish();
+        }
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void GaugeItem::advanceNeedle()
+{
+    qint64 now = mClock.nsecsElapsed() / 1000;
+    qreal angle = mDynamics.advance(now);
+
+    // the spring's tail is sub pixel -- stop on the target once the tip is within the threshold
+    qreal threshold = renderThreshold();
+    bool settled = mDynamics.isSettled(now, threshold, threshold * NOMINAL_FRAME_RATE);
+    if (settled) {
+        angle = mDynamics.settle(now);
+        stopFrames();
+    }
+    if (!mWrapAround) {
+        angle = qBound(qMin(mMinAngle, mMaxAngle), angle, qMax(mMinAngle, mMaxAngle));
+    }
+
+    // keep frames coming while the needle is still chasing its target
+    if (angle != mDisplayAngle || !settled) {
+        mDisplayAngle = angle;
+        update();
+    }
+}
+
+void GaugeItem::updateTargetAngle()
+{
+    qreal angle = valueToAngle(mValue, mMinValue, mMaxValue, mMinAngle, mMaxAngle,
+                               mInitialValueOffset, mClockwise);
+    if (angle == mTargetAngle) {
+        return;
+    }
+
+    mTargetAngle = angle;
+    emit angleChanged(mTargetAngle);
+    if (!isVisible()) {
+        return;
+    }
+
+    if (mWrapAround) {
+        // take the short way round a full circle dial (59 -> 0 seconds)
+        angle += 360.0 * qRound((mDynamics.getTarget() - angle) / 360.0);
+    }
+    if (!mFrameConnection && qAbs(angle - mDisplayAngle) < renderThreshold()) {
+        // the needle is at rest and this wouldn't move it visibly
+        return;
+    }
+    mDynamics.addSample(angle, mClock.nsecsElapsed() / 1000);
+    startFrames();
+}
+
+qreal GaugeItem::renderThreshold() const
+{
+    // angle that moves the needle tip by RENDER_THRESHOLD_PX
+    qreal tipRadius = qMax(1.0, mNeedleLength - mNeedleOffset);
+    return qRadiansToDegrees(RENDER_THRESHOLD_PX / tipRadius);
+}
+
+void GaugeItem::updateAlarm()
+{
+    bool alarm = (mValue < mLowAlarm) || (mValue > mHighAlarm);
+    if (alarm != mAlarm) {
+        mAlarm = alarm;
+        emit alarmChanged(mAlarm);
+    }
+}
+
+void GaugeItem::markDirty(int flags)
+{
+    mPolishDirty |= flags;
+    if (isVisible()) {
+        polish();
+        update();
+    }
+}
+
+void GaugeItem::startFrames()
+{
+    if (window() && !mFrameConnection) {
+        mFrameConnection = QObject::connect(window(), &QQuickWindow::afterAnimating,
+                                            this, &GaugeItem::advanceNeedle);
+        // afterAnimating only fires when a frame is coming
+        update();
+    }
+}
+
+void GaugeItem::parkNeedle()
+{
+    stopFrames();
+    mDisplayAngle = mTargetAngle;
+    mDynamics.reset(mTargetAngle, mClock.nsecsElapsed() / 1000);
+    update();
+}
+
+void GaugeItem::stopFrames()
+{
+    QObject::disconnect(mFrameConnection);
+    mFrameConnection = QMetaObject::Connection();
+}
@@ -0,0 +1,210 @@
+#ifndef GAUGE_ITEM_H
+#define GAUGE_ITEM_H
+
+#include <QQuickItem>
+#include <QElapsedTimer>
+#include <QImage>
+
+#include <needle_dynamics.h>
+
+/**
+ * @brief Scene graph gauge -- draws the dial, needle and needle center cap as
+ * three texture nodes (atlas textures, so they batch) with the needle and cap
+ * under one transform node. The needle angle and the alarm state are
+ * computed in C++; the needle is moved by NeedleDynamics on the window's frame
+ * clock and the transform is only touched when the angle changes.
+ *
+ * Render on demand: a frame is only requested while the needle tip is moving
+ * by at least RENDER_THRESHOLD_PX. Samples that would move it less (sensor
+ * noise at idle) don't wake the render loop, and the needle stops as soon as
+ * it's within the threshold of its target. A hidden gauge (a cached layout)
+ * only tracks its target angle, and starts from it when shown.
+ */
+class GaugeItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal value READ value WRITE setValue NOTIFY valueChanged)
+    Q_PROPERTY(qreal minValue READ minValue WRITE setMinValue NOTIFY minValueChanged)
+    Q_PROPERTY(qreal maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+    Q_PROPERTY(qreal minAngle READ minAngle WRITE setMinAngle NOTIFY minAngleChanged)
+    Q_PROPERTY(qreal maxAngle READ maxAngle WRITE setMaxAngle NOTIFY maxAngleChanged)
+    Q_PROPERTY(qreal initialValueOffset READ initialValueOffset WRITE setInitialValueOffset NOTIFY initialValueOffsetChanged)
+    Q_PROPERTY(bool clockwise READ clockwise WRITE setClockwise NOTIFY clockwiseChanged)
+    Q_PROPERTY(qreal angle READ angle NOTIFY angleChanged)
+    Q_PROPERTY(qreal responseTime READ responseTime WRITE setResponseTime NOTIFY responseTimeChanged)
+    Q_PROPERTY(bool wrapAround READ wrapAround WRITE setWrapAround NOTIFY wrapAroundChanged)
+
+    Q_PROPERTY(QString dialSource READ dialSource WRITE setDialSource NOTIFY dialSourceChanged)
+    Q_PROPERTY(QString needleSource READ needleSource WRITE setNeedleSource NOTIFY needleSourceChanged)
+    Q_PROPERTY(qreal pivotX READ pivotX WRITE setPivotX NOTIFY pivotXChanged)
+    Q_PROPERTY(qreal pivotY READ pivotY WRITE setPivotY NOTIFY pivotYChanged)
+    Q_PROPERTY(qreal needleLength READ needleLength WRITE setNeedleLength NOTIFY needleLengthChanged)
+    Q_PROPERTY(qreal needleWidth READ needleWidth WRITE setNeedleWidth NOTIFY needleWidthChanged)
+    Q_PROPERTY(qreal needleOffset READ needleOffset WRITE setNeedleOffset NOTIFY needleOffsetChanged)
+    Q_PROPERTY(qreal centerSize READ centerSize WRITE setCenterSize NOTIFY centerSizeChanged)
+
+    Q_PROPERTY(qreal lowAlarm READ lowAlarm WRITE setLowAlarm NOTIFY lowAlarmChanged)
+    Q_PROPERTY(qreal highAlarm READ highAlarm WRITE setHighAlarm NOTIFY highAlarmChanged)
+    Q_PROPERTY(bool alarm READ alarm NOTIFY alarmChanged)
+
+public:
+    static constexpr char QML_URI[] = "DigitalDash"; //!< qml import uri
+    static constexpr char QML_NAME[] = "GaugeItem"; //!< qml type name
+    static constexpr qreal RENDER_THRESHOLD_PX = 0.25; //!< needle tip movement worth drawing a frame for
+    static constexpr qreal NOMINAL_FRAME_RATE = 60; //!< frames per second used to judge a settling needle
+
+    explicit GaugeItem(QQuickItem * parent = nullptr);
+
+    /**
+     * @brief Register the QML type (import DigitalDash 1.0)
+     */
+    static void registerType();
+
+    qreal value() const;
+    qreal minValue() const;
+    qreal maxValue() const;
+    qreal minAngle() const;
+    qreal maxAngle() const;
+    qreal initialValueOffset() const;
+    bool clockwise() const;
+    qreal angle() const;
+    qreal responseTime() const;
+    bool wrapAround() const;
+
+    QString dialSource() const;
+    QString needleSource() const;
+    qreal pivotX() const;
+    qreal pivotY() const;
+    qreal needleLength() const;
+    qreal needleWidth() const;
+    qreal needleOffset() const;
+    qreal centerSize() const;
+
+    qreal lowAlarm() const;
+    qreal highAlarm() const;
+    bool alarm() const;
+
+    /**
+     * @brief Map a gauge value to a needle angle
+     * @return angle in degrees, clamped to [minAngle, maxAngle]
+     */
+    static qreal valueToAngle(qreal value, qreal minValue, qreal maxValue,
+                              qreal minAngle, qreal maxAngle,
+                              qreal initialValueOffset, bool clockwise);
+
+signals:
+    void valueChanged(qreal value);
+    void minValueChanged(qreal minValue);
+    void maxValueChanged(qreal maxValue);
+    void minAngleChanged(qreal minAngle);
+    void maxAngleChanged(qreal maxAngle);
+    void initialValueOffsetChanged(qreal initialValueOffset);
+    void clockwiseChanged(bool clockwise);
+    void angleChanged(qreal angle);
+    void responseTimeChanged(qreal responseTime);
+    void wrapAroundChanged(bool wrapAround);
+
+    void dialSourceChanged(QString dialSource);
+    void needleSourceChanged(QString needleSource);
+    void pivotXChanged(qreal pivotX);
+    void pivotYChanged(qreal pivotY);
+    void needleLengthChanged(qreal needleLength);
+    void needleWidthChanged(qreal needleWidth);
+    void needleOffsetChanged(qreal needleOffset);
+    void centerSizeChanged(qreal centerSize);
+
+    void lowAlarmChanged(qreal lowAlarm);
+    void highAlarmChanged(qreal highAlarm);
+    void alarmChanged(bool alarm);
+
+public slots:
+    void setValue(qreal value);
+    void setMinValue(qreal minValue);
+    void setMaxValue(qreal maxValue);
+    void setMinAngle(qreal minAngle);
+    void setMaxAngle(qreal maxAngle);
+    void setInitialValueOffset(qreal initialValueOffset);
+    void setClockwise(bool clockwise);
+    void setResponseTime(qreal responseTime);
+    void setWrapAround(bool wrapAround);
+
+    void setDialSource(QString dialSource);
+    void setNeedleSource(QString needleSource);
+    void setPivotX(qreal pivotX);
+    void setPivotY(qreal pivotY);
+    void setNeedleLength(qreal needleLength);
+    void setNeedleWidth(qreal needleWidth);
+    void setNeedleOffset(qreal needleOffset);
+    void setCenterSize(qreal centerSize);
+
+    void setLowAlarm(qreal lowAlarm);
+    void setHighAlarm(qreal highAlarm);
+
+protected:
+    QSGNode * updatePaintNode(QSGNode * oldNode, UpdatePaintNodeData * data) override;
+    void updatePolish() override;
+    void geometryChanged(const QRectF & newGeometry, const QRectF & oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData & value) override;
+
+private slots:
+    /**
+     * @brief Advance the needle dynamics to the current frame -- called once
+     * per frame while the needle is moving
+     */
+    void advanceNeedle();
+
+private:
+    /**
+     * @brief Artwork that needs rescaling (on polish) or a new texture (on sync)
+     */
+    enum DirtyFlag {
+        DIRTY_DIAL = 0x01,
+        DIRTY_NEEDLE = 0x02,
+        DIRTY_CENTER = 0x04
+    };
+
+    qreal mValue;
+    qreal mMinValue;
+    qreal mMaxValue;
+    qreal mMinAngle;
+    qreal mMaxAngle;
+    qreal mInitialValueOffset;
+    bool mClockwise;
+    qreal mResponseTime;
+    bool mWrapAround;
+
+    qreal mTargetAngle; //!< angle for the current value
+    qreal mDisplayAngle; //!< angle currently drawn
+    NeedleDynamics mDynamics; //!< needle motion model
+    QElapsedTimer mClock; //!< sample and frame clock
+    QMetaObject::Connection mFrameConnection; //!< window frame signal -> advanceNeedle
+
+    QString mDialSource;
+    QString mNeedleSource;
+    qreal mPivotX;
+    qreal mPivotY;
+    qreal mNeedleLength;
+    qreal mNeedleWidth;
+    qreal mNeedleOffset;
+    qreal mCenterSize;
+
+    qreal mLowAlarm;
+    qreal mHighAlarm;
+    bool mAlarm;
+
+    QImage mDialImage; //!< dial artwork scaled to the item size
+    QImage mNeedleImage; //!< needle artwork scaled to the needle size, 1px transparent border
+    QImage mCenterImage; //!< needle center cap
+    int mPolishDirty; //!< DirtyFlag bits -- images to rescale
+    int mNodeDirty; //!< DirtyFlag bits -- textures to replace
+
+    void updateTargetAngle();
+    qreal renderThreshold() const;
+    void updateAlarm();
+    void markDirty(int flags);
+    void startFrames();
+    void stopFrames();
+    void parkNeedle();
+};
+
+#endif // GAUGE_ITEM_H
@@ -0,0 +1,232 @@
+#ifndef GAUGE_SNAPSHOT_H
+#define GAUGE_SNAPSHOT_H
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QObject>
+#include <QSaveFile>
+#include <QTimer>
+#include <QVariant>
+#include <QtMath>
+
+/**
+ * @brief Last displayed gauge values and warning light states, kept on disk
+ * so the next boot can show them before the sensors report.
+ *
+ * Each channel is a model property and the source that drives it. On
+ * @ref restore every channel whose source hasn't reported yet is set to its
+ * saved value; the first valid sample from the source then takes over (the
+ * gauge needle moves from the saved value to the live one). A restored value
+ * its source hasn't confirmed within CONFIRM_TIMEOUT_MSEC is cleared, so a
+ * dead sensor doesn't show last drive's reading for the whole drive. Only
+ * live values are saved, every SAVE_INTERVAL_MSEC while running and when the
+ * app quits -- the car usually just loses power, so the periodic save is the
+ * one that counts.
+ *
+ * File layout (QDataStream, big endian):
+ *  quint32 MAGIC, quint16 VERSION, QVariantMap channel name -> value
+ */
+class GaugeSnapshot : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr quint32 MAGIC = 0x56444753; //!< "VDGS"
+    static constexpr quint16 VERSION = 1; //!< bump when the file layout changes
+    static constexpr char FILE_NAME[] = "gauge_snapshot.dat"; //!< file name, kept next to the odometer config
+    static constexpr int SAVE_INTERVAL_MSEC = 30000; //!< periodic save interval
+    static constexpr int CONFIRM_TIMEOUT_MSEC = 10000; //!< restored values not confirmed by their source by then are cleared
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param path: snapshot file path
+     */
+    GaugeSnapshot(QObject * parent, QString path) :
+        QObject(parent), mPath(path) {
+        connect(&mSaveTimer, &QTimer::timeout, this, &GaugeSnapshot::save);
+        mConfirmTimer.setSingleShot(true);
+        connect(&mConfirmTimer, &QTimer::timeout, this, &GaugeSnapshot::clearUnconfirmed);
+        if (QCoreApplication::instance()) {
+            connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &GaugeSnapshot::save);
+        }
+    }
+
+    /**
+     * @brief Add a channel
+     * @param name: channel name in the file
+     * @param model: model showing the value
+     * @param property: model property holding the value
+     * @param source: object that drives the property
+     * @param signal: source signal, emitted after the source updated the model
+     */
+    template <typename Source, typename Signal>
+    void addChannel(QString name, QObject * model, const char * property, Source * source, Signal signal) {
+        Channel_t channel;
+        channel.model = model;
+        channel.property = property;
+        mChannels.insert(name, channel);
+
+        // connected after the gauge, so the model already holds the sample
+        connect(source, signal, this, [this, name]() {
+            Channel_t & channel = mChannels[name];
+            if (!channel.live && isValid(channel.model->property(channel.property))) {
+                channel.live = true;
+                channel.restored = false;
+            }
+        });
+    }
+
+    /**
+     * @brief Show the saved values on every channel that isn't live yet
+     * @param confirmMsec: restored values still not live after this long are cleared
+     * @return number of channels restored
+     */
+    int restore(int confirmMsec = CONFIRM_TIMEOUT_MSEC) {
+        QVariantMap values = read(mPath);
+        int restored = 0;
+        for (auto it = mChannels.begin(); it != mChannels.end(); ++it) {
+            QVariant value = values.value(it.key());
+            if (it->live || !isValid(value)) {
+                continue;
+            }
+            it->cleared = it->model->property(it->property);
+            it->model->setProperty(it->property, value);
+            it->restored = true;
+            restored++;
+        }
+        if (restored > 0) {
+            mConfirmTimer.start(confirmMsec);
+        }
+        return restored;
+    }
+
+    /**
+     * @brief Start saving periodically
+     */
+    void start() {
+        mSaveTimer.start(SAVE_INTERVAL_MSEC);
+    }
+
+    /**
+     * @brief Stop saving periodically
+     */
+    void stop() {
+        mSaveTimer.stop();
+    }
+
+    /**
+     * @brief Check whether a channel's source has reported a valid value
+     * @param name: channel name
+     * @return true once live
+     */
+    bool isLive(QString name) const {
+        return mChannels.value(name).live;
+    }
+
+    QString getPath() const {
+        return mPath;
+    }
+
+public slots:
+    /**
+     * @brief Write the live values -- a restored value its source never
+     * confirmed isn't carried over to the next boot
+     */
+    void save() {
+        QVariantMap values;
+        for (auto it = mChannels.cbegin(); it != mChannels.cend(); ++it) {
+            if (it->live) {
+                values.insert(it.key(), it->model->property(it->property));
+            }
+        }
+        if (values.isEmpty() || values == mSaved) {
+            return;
+        }
+
+        QSaveFile file(mPath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qDebug() << "Unable to write gauge snapshot: " << mPath;
+            return;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << MAGIC << VERSION << values;
+        if (file.commit()) {
+            mSaved = values;
+        }
+    }
+
+    /**
+     * @brief Put every restored value its source hasn't confirmed back to
+     * what the model showed before @ref restore
+     */
+    void clearUnconfirmed() {
+        for (auto it = mChannels.begin(); it != mChannels.end(); ++it) {
+            if (it->restored) {
+                it->model->setProperty(it->property, it->cleared);
+                it->restored = false;
+            }
+        }
+    }
+
+private:
+    /**
+     * @struct Channel
+     */
+    typedef struct Channel {
+        QObject * model = nullptr; //!< model showing the value
+        const char * property = nullptr; //!< model property
+        bool live = false; //!< source has reported a valid value
+        bool restored = false; //!< showing the saved value, not confirmed by the source yet
+        QVariant cleared; //!< value the model showed before the restore
+    } Channel_t;
+
+    QString mPath; //!< snapshot file
+    QMap<QString, Channel_t> mChannels; //!< channels by name
+    QVariantMap mSaved; //!< last values written
+    QTimer mSaveTimer; //!< periodic save timer
+    QTimer mConfirmTimer; //!< clears the restored values not confirmed in time
+
+    /**
+     * @brief A value worth showing -- NaN/inf mean the sensor had no reading
+     */
+    static bool isValid(QVariant value) {
+        if (!value.isValid()) {
+            return false;
+        }
+        if (value.type() == QVariant::Double) {
+            return qIsFinite(value.toDouble());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read a snapshot file
+     * @return channel values, empty if missing or corrupt
+     */
+    static QVariantMap read(QString path) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QVariantMap();
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic = 0;
+        quint16 version = 0;
+        QVariantMap values;
+        stream >> magic >> version;
+        if (stream.status() != QDataStream::Ok || magic != MAGIC || version != VERSION) {
+            return QVariantMap();
+        }
+        stream >> values;
+        return (stream.status() == QDataStream::Ok) ? values : QVariantMap();
+    }
+};
+
+#endif // GAUGE_SNAPSHOT_H
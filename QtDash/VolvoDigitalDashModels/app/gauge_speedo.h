@@ -40,7 +40,7 @@ public:
         // connect the speed to the model value
         QObject::connect(
                     sensors.at(0), &Sensor::sensorDataReady,
-                    [=](QVariant data) {
+                    this, [=](QVariant data) {
             QString units = sensors.at(0)->getUnits();
             QString displayUnits = speedoConfig.gaugeConfig.displayUnits;
             QString modelUnits = ((SpeedometerModel *)mModel)->units();
@@ -52,7 +52,7 @@ public:
         // connect the secondary values
         QObject::connect(
                     sensors.at(1), &Sensor::sensorDataReady,
-                    [=](QVariant data) {
+                    this, [=](QVariant data) {
             // get raw value
             qreal val = data.toReal();
             Sensor * sensor = sensors.at(1);
@@ -30,8 +30,8 @@ public:
 
         QObject::connect(
                     sensors.at(0), &Sensor::sensorDataReady,
-                    [=](QVariant data) {
-            ((TachometerModel *)mModel)->setRpm(data.toInt());
+                    this, [=](QVariant data) {
+            ((TachometerModel *)mModel)->setRpm(qRound(data.toReal()));
         });
     }
 };
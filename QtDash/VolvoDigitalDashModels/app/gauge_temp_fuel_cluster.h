@@ -57,7 +57,7 @@ public:
         // connect the secondary values
         QObject::connect(
                     sensors.at(1), &Sensor::sensorDataReady,
-                    [=](QVariant data) {
+                    this, [=](QVariant data) {
             ((TempAndFuelGaugeModel *)mModel)->setFuelLevel(data.toReal());
         });
 
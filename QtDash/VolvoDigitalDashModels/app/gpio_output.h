@@ -0,0 +1,71 @@
+#ifndef GPIO_OUTPUT_H
+#define GPIO_OUTPUT_H
+
+#include <QDebug>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief A GPIO output pin driven through the sysfs gpio class (the alarm buzzer)
+ */
+class GpioOutput {
+public:
+    static constexpr char DEFAULT_PATH[] = "/sys/class/gpio/";
+
+    /**
+     * @brief Export the pin and make it an output, off
+     * @param pin: gpio number
+     * @param activeLow: the pin is low when on
+     * @param path: path of the sysfs gpio class
+     */
+    GpioOutput(int pin, bool activeLow = false, std::string path = DEFAULT_PATH) :
+        mPath(path + "gpio" + std::to_string(pin) + "/") {
+        // exporting an exported pin fails, that's fine
+        writeAttribute(path + "export", std::to_string(pin));
+        // polarity first, then an output already at its off level -- "out" would
+        // drive an active low pin on until the first write. The direction's
+        // level is the raw one, active_low doesn't apply to it.
+        mValid = writeAttribute(mPath + "active_low", activeLow ? "1" : "0") &&
+                writeAttribute(mPath + "direction", activeLow ? "high" : "low");
+    }
+
+    ~GpioOutput() {
+        set(false);
+    }
+
+    bool isValid() const {
+        return mValid;
+    }
+
+    /**
+     * @brief Turn the output on or off
+     * @param on: true for on
+     */
+    void set(bool on) {
+        if (mValid) {
+            writeAttribute(mPath + "value", on ? "1" : "0");
+        }
+    }
+
+private:
+    std::string mPath; //!< path of the pin's sysfs directory
+    bool mValid = false; //!< pin was set up as an output
+
+    /**
+     * @brief Write a sysfs attribute
+     * @param path: attribute path
+     * @param value: value to write
+     * @return true if written
+     */
+    static bool writeAttribute(std::string path, std::string value) {
+        std::ofstream ofs(path, std::ofstream::out);
+        if (!ofs.is_open()) {
+            qDebug() << "Error opening " << path.c_str();
+            return false;
+        }
+        ofs << value;
+        return ofs.good();
+    }
+};
+
+#endif // GPIO_OUTPUT_H
@@ -8,20 +8,182 @@
 #include <QScreen>
 #include <QQmlComponent>
 #include <QQuickWindow>
+#include <QCommandLineParser>
 #include <key_press_emitter.h>
+#include <gauge_item.h>
+#include <digit_readout.h>
+#include <frame_stats.h>
+#include <boot_profiler.h>
 
 #include <config.h>
+#include <config_cache.h>
 
-#ifdef RASPBERRY_PI
 #include <dash_new.h>
-#else
+
+/**
+ * @brief Log rendered and skipped frames for both screens
+ * @param engine: qml engine with main.qml loaded
+ */
+static void attachFrameStats(QQmlApplicationEngine & engine) {
+    QQuickWindow * rootWindow = qobject_cast<QQuickWindow *>(engine.rootObjects()[0]);
+    QQuickWindow * accessoryWindow = engine.rootObjects()[0]->findChild<QQuickWindow *>("accessoryScreen");
+    if (rootWindow) {
+        new FrameStats(rootWindow, "Main screen");
+    }
+    if (accessoryWindow) {
+        new FrameStats(accessoryWindow, "Accessory screen");
+    }
+}
+
+/**
+ * @brief Move the accessory screen's content into the main window, to the right
+ * of the cluster. Both displays are then drawn by one window: one surface, one
+ * render loop and one scene graph, so gauge artwork and glyph textures are
+ * uploaded once and share the atlas. The display setup has to present the
+ * window across both outputs.
+ * @param engine: qml engine with main.qml loaded
+ * @param accessorySize: size of the accessory display
+ * @return true if the accessory screen was moved
+ */
+static bool composeSingleWindow(QQmlApplicationEngine & engine, QSize accessorySize) {
+    QQuickWindow * rootWindow = qobject_cast<QQuickWindow *>(engine.rootObjects()[0]);
+    QQuickWindow * accessoryWindow = engine.rootObjects()[0]->findChild<QQuickWindow *>("accessoryScreen");
+    if (!rootWindow || !accessoryWindow) {
+        return false;
+    }
+
+    QQuickItem * panel = new QQuickItem(rootWindow->contentItem());
+    panel->setObjectName("accessoryPanel");
+    panel->setPosition(QPointF(rootWindow->width(), 0));
+    panel->setSize(accessorySize);
+    panel->setClip(true);
+
+    // the hidden window keeps its size -- the accessory layout sizes its gauges from it
+    accessoryWindow->resize(accessorySize);
+    for (QQuickItem * item : accessoryWindow->contentItem()->childItems()) {
+        item->setParentItem(panel);
+    }
+
+    rootWindow->resize(rootWindow->width() + accessorySize.width(),
+                       qMax(rootWindow->height(), accessorySize.height()));
+    return true;
+}
+
+#ifndef RASPBERRY_PI
 #include <dash_host.h>
+
+/**
+ * @brief Hook up a dash to QML and show both screens in desktop windows
+ * @param dash: DashHost (fake data) or DashNew (session replay)
+ * @param app: application
+ * @param engine: qml engine
+ * @param sideScreenKeyPress: accessory screen key press emitter
+ * @param frameStats: log rendered and skipped frames
+ * @param singleWindow: draw the accessory screen in the main window
+ * @return application exit code
+ */
+template <class T>
+int runDesktopDash(T * dash, QGuiApplication & app, QQmlApplicationEngine & engine, KeyPressEmitter * sideScreenKeyPress,
+                   bool frameStats, bool singleWindow) {
+    engine.rootContext()->setContextProperty("RASPBERRY_PI", QVariant(false));
+
+    QObject::connect(dash, &T::keyPress, [&engine](QKeyEvent * ev) {
+        if (ev != nullptr) {
+            qDebug() << ev;
+            QCoreApplication::postEvent(engine.rootObjects().first(), ev);
+        }
+    });
+
+    QObject::connect(sideScreenKeyPress, &KeyPressEmitter::keyPressAndHold, [dash](Qt::Key key) {
+       switch (key) {
+       case Qt::Key_A:
+           dash->odoTripReset(0);
+           break;
+       case Qt::Key_B:
+           dash->odoTripReset(1);
+           break;
+       default:
+           break;
+       }
+    });
+
+    dash->init();
+
+    // load main.qml
+    engine.load(QUrl(QLatin1String("qrc:/main.qml")));
+    if (engine.rootObjects().isEmpty())
+        return -1;
+
+    // connect quit
+    QObject::connect(&engine, SIGNAL(quit()), &app, SLOT(quit()));
+
+    if (!singleWindow || !composeSingleWindow(engine, QSize(480, 800))) {
+        QQuickWindow * accessoryWindow = engine.rootObjects()[0]->findChild<QQuickWindow *>("accessoryScreen");
+        accessoryWindow->setWidth(480);
+        accessoryWindow->setHeight(800);
+        accessoryWindow->setProperty("visible", true);
+    }
+
+    if (frameStats) {
+        attachFrameStats(engine);
+    }
+
+    // Start Dash
+    dash->start();
+
+    return app.exec();
+}
 #endif
 
+/**
+ * @brief Size the scene graph's shared texture atlas so the baked gauge artwork
+ * of a layout (and the layouts cached either side of it) packs into one texture
+ * -- the atlas has to be configured before the first window is created
+ */
+static void configureTextureAtlas() {
+    static constexpr int ATLAS_SIZE = 2048; // clamped to GL_MAX_TEXTURE_SIZE by Qt
+    static constexpr int ATLAS_SIZE_LIMIT = 1024; // larger images get their own texture
+
+    if (!qEnvironmentVariableIsSet("QSG_ATLAS_WIDTH")) {
+        qputenv("QSG_ATLAS_WIDTH", QByteArray::number(ATLAS_SIZE));
+    }
+    if (!qEnvironmentVariableIsSet("QSG_ATLAS_HEIGHT")) {
+        qputenv("QSG_ATLAS_HEIGHT", QByteArray::number(ATLAS_SIZE));
+    }
+    if (!qEnvironmentVariableIsSet("QSG_ATLAS_SIZE_LIMIT")) {
+        qputenv("QSG_ATLAS_SIZE_LIMIT", QByteArray::number(ATLAS_SIZE_LIMIT));
+    }
+}
+
 int main(int argc, char *argv[])
 {
+    BootProfiler::mark("app start");
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
+    configureTextureAtlas();
     QGuiApplication app(argc, argv);
+    BootProfiler::mark("qt platform init");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption replayOption("replay", "Replay a recorded sensor session instead of reading the sensors.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed", "Session replay speed (1.0 = real time).", "speed", "1.0");
+    QCommandLineOption frameStatsOption("frame-stats", "Log rendered and skipped frames.");
+    QCommandLineOption singleWindowOption("single-window", "Draw the accessory screen in the main window.");
+    parser.addOptions({replayOption, replaySpeedOption, frameStatsOption, singleWindowOption});
+    parser.process(app);
+
+    QString replayPath = parser.value(replayOption);
+    qreal replaySpeed = parser.value(replaySpeedOption).toDouble();
+    bool frameStats = parser.isSet(frameStatsOption);
+    bool singleWindow = parser.isSet(singleWindowOption);
+
+#ifdef RASPBERRY_PI
+    if (replayPath.isEmpty()) {
+        // parse the config while the screens and qml engine come up
+        ConfigCache::preload({Config::DEFAULT_CONFIG_PATH, Config::DEFAULT_GAUGE_CONFIG_PATH,
+                              Config::DEFAULT_ODO_CONFIG_PATH, Config::DEFAULT_CAN_CONFIG_PATH});
+    }
+#endif
 
     QList<QScreen *> screens = app.screens();
     qDebug("Application sees %d screens", screens.count());
@@ -38,6 +200,8 @@ int main(int argc, char *argv[])
     app.setFont(mFont);
 
     //Setup QML
+    GaugeItem::registerType();
+    DigitReadout::registerType();
     QQmlApplicationEngine engine;
     QQmlContext * ctxt = engine.rootContext();
 
@@ -47,7 +211,7 @@ int main(int argc, char *argv[])
     // Initialize Dash
 #ifdef RASPBERRY_PI
     //Dash * dash = new Dash(&app, ctxt); //old style dash
-    DashNew * dash = new DashNew(&app, ctxt); // new scheme with sensor source -> sensor -> gauge -> model
+    DashNew * dash = new DashNew(&app, ctxt, replayPath, replaySpeed); // new scheme with sensor source -> sensor -> gauge -> model
     ctxt->setContextProperty("RASPBERRY_PI", QVariant(true));
 
     QObject::connect(dash, &DashNew::keyPress, [&engine](QKeyEvent * ev) {
@@ -70,16 +234,21 @@ int main(int argc, char *argv[])
     });
 
     dash->init();
+    BootProfiler::mark("dash init");
 
     // load main.qml
     engine.load(QUrl(QLatin1String("qrc:/main.qml")));
     if (engine.rootObjects().isEmpty())
         return -1;
+    BootProfiler::mark("qml load");
+    BootProfiler::markFirstFrame(qobject_cast<QQuickWindow *>(engine.rootObjects()[0]));
 
     // connect quit
     QObject::connect(&engine, SIGNAL(quit()), &app, SLOT(quit()));
 
-    if (screens.count() > 1) {
+    if (screens.count() > 1 && singleWindow) {
+        composeSingleWindow(engine, screens[1]->size());
+    } else if (screens.count() > 1) {
         QQuickWindow * accessoryWindow = engine.rootObjects()[0]->findChild<QQuickWindow *>("accessoryScreen");
 
         QScreen * screen = screens[1];
@@ -88,47 +257,19 @@ int main(int argc, char *argv[])
         accessoryWindow->setScreen(screen);
         accessoryWindow->setProperty("visible", true);
     }
-#else
-    DashHost * dash = new DashHost(&app, ctxt);
-    ctxt->setContextProperty("RASPBERRY_PI", QVariant(false));
-
-    QObject::connect(dash, &DashHost::keyPress, [&engine](QKeyEvent * ev) {
-        if (ev != nullptr) {
-            qDebug() << ev;
-            QCoreApplication::postEvent(engine.rootObjects().first(), ev);
-        }
-    });
-
-    QObject::connect(sideScreenKeyPress, &KeyPressEmitter::keyPressAndHold, [dash](Qt::Key key) {
-       switch (key) {
-       case Qt::Key_A:
-           dash->odoTripReset(0);
-           break;
-       case Qt::Key_B:
-           dash->odoTripReset(1);
-           break;
-       default:
-           break;
-       }
-    });
-
-    dash->init();
 
-    // load main.qml
-    engine.load(QUrl(QLatin1String("qrc:/main.qml")));
-    if (engine.rootObjects().isEmpty())
-        return -1;
-
-    // connect quit
-    QObject::connect(&engine, SIGNAL(quit()), &app, SLOT(quit()));
+    if (frameStats) {
+        attachFrameStats(engine);
+    }
 
-    QQuickWindow * accessoryWindow = engine.rootObjects()[0]->findChild<QQuickWindow *>("accessoryScreen");
-    accessoryWindow->setWidth(480);
-    accessoryWindow->setHeight(800);
-    accessoryWindow->setProperty("visible", true);
-#endif
     // Start Dash
     dash->start();
 
     return app.exec();
+#else
+    if (!replayPath.isEmpty()) {
+        return runDesktopDash(new DashNew(&app, ctxt, replayPath, replaySpeed), app, engine, sideScreenKeyPress, frameStats, singleWindow);
+    }
+    return runDesktopDash(new DashHost(&app, ctxt), app, engine, sideScreenKeyPress, frameStats, singleWindow);
+#endif
 }
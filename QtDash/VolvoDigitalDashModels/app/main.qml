@@ -665,31 +665,85 @@ Window {
                   } else {
                       0
                   }
-        property bool initialLoad: true
         antialiasing: true
         smooth: true
-        property int screen: 0
 
-        Loader {
-            id: currentGauge
-            anchors.fill: parent
-            source: "qrc:/Original240Layout.qml"
-            asynchronous: true
-            visible: false
-            onStatusChanged: {
-                if (status == Loader.Ready) {
-                    console.log("Loader Ready")
-                    if (!gaugeItem.initialLoad) {
-                        visible = true;
-                        loadText.visible = false;
-                    } else {
-                        bootTimer.start();
-                        gaugeItem.initialLoad = false
+        property int screen: 2
+        property bool booting: true
+
+        // keep the previous/next layouts instantiated so the side buttons switch instantly --
+        // hidden layouts only store the values their models push: the needles don't animate,
+        // the artwork isn't rescaled, the readouts aren't laid out and the clocks don't tick
+        // until the layout is shown
+        property int layoutCacheRadius: 1
+
+        /**
+         * Layouts in side button order. Sizes left undefined keep their previous value.
+         */
+        property var layouts: [
+            { source: "qrc:/BigTachCenter.qml", speedoMax: 120, smallGauge: 140, tach: 440, speedo: 290, tempFuel: 290, accessory: "240", showLights: true },
+            { source: "qrc:/BigTachLeft.qml", speedoMax: 120, smallGauge: 140, tach: 440, speedo: 290, tempFuel: 290, accessory: "240", showLights: true },
+            { source: "qrc:/Original240Layout.qml", speedoMax: 120, smallGauge: 140, tach: 400, speedo: 440, tempFuel: 400, accessory: "240", showLights: true },
+            { source: "qrc:/Original740Layout.qml", speedoMax: 140, smallGauge: 140, tach: 275, speedo: 350, tempFuel: 300, accessory: "740", showLights: true },
+            { source: "qrc:/Original240LayoutClock.qml", speedoMax: 120, smallGauge: 140, tach: 400, speedo: 440, tempFuel: 400, accessory: "240", showLights: true },
+            { source: "qrc:/Original850R.qml", speedoMax: 140, smallGauge: 200, tach: 350, speedo: 440, tempFuel: undefined, accessory: "740", showLights: true },
+            { source: "qrc:/OriginalRSportLayout.qml", speedoMax: 130, smallGauge: 200, tach: 350, speedo: 350, tempFuel: undefined, accessory: "rSport", showLights: true },
+            { source: "qrc:/Original544Layout.qml", speedoMax: 130, smallGauge: 140, tach: 400, speedo: 440, tempFuel: 400, accessory: "240", showLights: true },
+            { source: "qrc:/OriginalP1800Layout.qml", speedoMax: 130, smallGauge: 200, tach: 350, speedo: 440, tempFuel: undefined, accessory: "p1800", showLights: true },
+            { source: "qrc:/OriginalEarly240Layout.qml", speedoMax: 130, smallGauge: 140, tach: 300, speedo: 400, tempFuel: 400, accessory: "240", showLights: false },
+            { source: "qrc:/Original140RallyeLayout.qml", speedoMax: 130, smallGauge: 200, tach: 400, speedo: 400, tempFuel: 400, accessory: "140rallye", showLights: true }
+        ]
+
+        /**
+         * Only the current layout is loaded while booting, then the ones within
+         * layoutCacheRadius of it. Everything else is unloaded along with its images.
+         */
+        function isCached(index) {
+            if (index === screen) {
+                return true;
+            }
+            if (booting) {
+                return false;
+            }
+
+            var distance = Math.abs(index - screen);
+            distance = Math.min(distance, layouts.length - distance);
+            return distance <= layoutCacheRadius;
+        }
+
+        function currentReady() {
+            var loader = layoutRepeater.itemAt(screen);
+            return loader !== null && loader.status === Loader.Ready;
+        }
+
+        function updateLoadingText() {
+            loadText.visible = booting || !currentReady();
+        }
+
+        Repeater {
+            id: layoutRepeater
+            model: gaugeItem.layouts
+
+            Loader {
+                anchors.fill: parent
+                source: modelData.source
+                asynchronous: true
+                active: gaugeItem.isCached(index)
+                visible: index === gaugeItem.screen && status === Loader.Ready && !gaugeItem.booting
+                onStatusChanged: {
+                    if (index !== gaugeItem.screen) {
+                        return;
                     }
-                } else if (status == Loader.Loading) {
-                    currentGauge.visible = false;
-                    loadText.visible = true;
-                    console.log("Loader Loading")
+
+                    if (status == Loader.Ready) {
+                        console.log("Loader Ready")
+                        if (gaugeItem.booting && !bootTimer.running) {
+                            bootTimer.start();
+                        }
+                    } else if (status == Loader.Loading) {
+                        console.log("Loader Loading")
+                    }
+                    gaugeItem.updateLoadingText();
                 }
             }
         }
@@ -700,173 +754,37 @@ Window {
             running: false
             repeat: false
             onTriggered: {
-                currentGauge.visible = true;
-                loadText.visible = false;
+                gaugeItem.booting = false;
+                gaugeItem.updateLoadingText();
             }
         }
 
         function advanceScreen(forward) {
             if (forward) {
-                if (++screen > 10) {
+                if (++screen >= layouts.length) {
                     screen = 0;
                 }
             } else {
                 if (--screen < 0) {
-                    screen = 10;
+                    screen = layouts.length - 1;
                 }
             }
 
-            switch (screen) {
-                case 0:
-                    //currentGauge.source = "";
-                    currentGauge.source = "qrc:/BigTachCenter.qml";
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(120);
+            var layout = layouts[screen];
+            speedoModel.setUnits("mph");
+            speedoModel.setMaxValue(layout.speedoMax);
 
-                    setSmallGaugeSize(140);
-                    setTachSize(440);
-                    setSpeedoSize(tachSize - smallGaugeSize - 10);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(tachSize - smallGaugeSize - 10);
-                    accessoryScreen.currentStyle = "240";
-                    warningLightBar.item.showLights = true;
+            setSmallGaugeSize(layout.smallGauge);
+            setTachSize(layout.tach);
+            setSpeedoSize(layout.speedo);
+            setSpeedoMax(speedoModel.maxValue);
+            if (layout.tempFuel !== undefined) {
+                setTempFuelSize(layout.tempFuel);
+            }
+            accessoryScreen.currentStyle = layout.accessory;
+            warningLightBar.item.showLights = layout.showLights;
 
-                    break;
-                case 1:
-                    //currentGauge.source = "";
-                    currentGauge.source = "qrc:/BigTachLeft.qml";
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(120);
-
-                    setSmallGaugeSize(140);
-                    setTachSize(440);
-                    setSpeedoSize(tachSize - smallGaugeSize - 10);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(tachSize - smallGaugeSize - 10);
-                    accessoryScreen.currentStyle = "240";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 2:
-                    //currentGauge.source = "";
-                    currentGauge.source = "qrc:/Original240Layout.qml";
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(120);
-
-                    setSmallGaugeSize(140);
-                    setTachSize(400);
-                    setSpeedoSize(440);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(400);
-                    accessoryScreen.currentStyle = "240";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 3:
-                    //currentGauge.source = "";
-                    currentGauge.source = "qrc:/Original740Layout.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(140);
-
-                    setSmallGaugeSize(140);
-                    setTachSize(275);
-                    setSpeedoSize(350);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(300);
-                    accessoryScreen.currentStyle = "740";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 4:
-                    //currentGauge.source = "";
-                    currentGauge.source = "qrc:/Original240LayoutClock.qml";
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(120);
-
-                    setSmallGaugeSize(140);
-                    setTachSize(400);
-                    setSpeedoSize(440);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(400);
-                    accessoryScreen.currentStyle = "240";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 5:
-                    //currentGauge.source = "";
-                    currentGauge.source = "qrc:/Original850R.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(140);
-
-                    setSmallGaugeSize(200);
-                    setTachSize(350);
-                    setSpeedoSize(440);
-                    setSpeedoMax(speedoModel.maxValue);
-                    accessoryScreen.currentStyle = "740";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 6:
-                    currentGauge.source = "qrc:/OriginalRSportLayout.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(130);
-
-                    setSmallGaugeSize(200);
-                    setTachSize(350);
-                    setSpeedoSize(350);
-                    setSpeedoMax(speedoModel.maxValue);
-                    accessoryScreen.currentStyle = "rSport";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 7:
-                    currentGauge.source = "qrc:/Original544Layout.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(130);
-
-                    setSmallGaugeSize(140);
-                    setTachSize(400);
-                    setSpeedoSize(440);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(400);
-                    accessoryScreen.currentStyle = "240";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 8:
-                    currentGauge.source = "qrc:/OriginalP1800Layout.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(130);
-
-                    setSmallGaugeSize(200);
-                    setTachSize(350);
-                    setSpeedoSize(440);
-                    setSpeedoMax(speedoModel.maxValue);
-                    accessoryScreen.currentStyle = "p1800";
-                    warningLightBar.item.showLights = true;
-                    break;
-                case 9:
-                    currentGauge.source = "qrc:/OriginalEarly240Layout.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(130);
-
-                    setSmallGaugeSize(140);
-                    setTachSize(300);
-                    setSpeedoSize(400);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(400);
-                    accessoryScreen.currentStyle = "240";
-                    warningLightBar.item.showLights = false;
-                    break;
-                case 10:
-                    currentGauge.source = "qrc:/Original140RallyeLayout.qml"
-                    speedoModel.setUnits("mph");
-                    speedoModel.setMaxValue(130);
-
-                    setSmallGaugeSize(200);
-                    setTachSize(400);
-                    setSpeedoSize(400);
-                    setSpeedoMax(speedoModel.maxValue);
-                    setTempFuelSize(400);
-                    accessoryScreen.currentStyle = "140rallye";
-                    warningLightBar.item.showLights = true;
-                    break;
-                default:
-                    break;
-                }
+            updateLoadingText();
         }
 
         Keys.onPressed: {
@@ -56,6 +56,14 @@ static inline __s32 i2c_smbus_read_byte_data(int file, __u8 command)
         return 0x0FF & data.byte;
 }
 
+static inline __s32 i2c_smbus_write_byte_data(int file, __u8 command, __u8 value)
+{
+    union i2c_smbus_data data;
+    data.byte = value;
+    return i2c_smbus_access(file,I2C_SMBUS_WRITE,command,
+                            I2C_SMBUS_BYTE_DATA,&data);
+}
+
 /**
  * @brief MCP23017 i2c i/o expander class
  * uses linux i2c-dev interface to read from
@@ -169,6 +177,26 @@ public:
         return ret;
     }
 
+    /**
+     * @brief write
+     * @param reg: register to write
+     * @param value: value to write
+     * @return true if successful
+     */
+    bool write(RegisterAddr reg, uint8_t value) {
+        if (!mIsOpen) {
+            printf("write failed: device not open\n");
+            return false;
+        }
+
+        if (i2c_smbus_write_byte_data(mFd, (uint8_t) reg, value) < 0) {
+            printf("i2c-%d device @0x%02X register addr: 0x%02X write failed: %d\n", mBus, (unsigned int)mAddr, (unsigned int)reg, errno);
+            return false;
+        }
+
+        return true;
+    }
+
     int getNumChannels() {
         return 16;
     }
@@ -0,0 +1,174 @@
+#ifndef NEEDLE_DYNAMICS_H
+#define NEEDLE_DYNAMICS_H
+
+#include <QtGlobal>
+#include <QtMath>
+
+/**
+ * @brief Needle motion model -- a critically damped spring chasing a predicted target.
+ *
+ * Samples are timestamped when they arrive. The rate between the last two
+ * samples is used to predict where the signal is *now*, extrapolating at most
+ * one sample interval ahead, so a steadily changing value (tach, speedo) is
+ * tracked without lag between samples. The needle follows the prediction with
+ * a critically damped spring with velocity feed forward: it settles on steps
+ * without overshoot and follows ramps with no steady state error. When a ramp
+ * stops, the needle can run past the final value by at most one sample's
+ * change before settling back. The spring is integrated in closed form, so a
+ * long or irregular frame can't make it unstable.
+ *
+ * Sporadic signals (temperatures, fuel) arrive further apart than
+ * MAX_PREDICTION_INTERVAL_US and are never extrapolated.
+ */
+class NeedleDynamics {
+public:
+    static constexpr qreal DEFAULT_RESPONSE_MSEC = 20; //!< spring time constant
+    static constexpr qint64 MAX_PREDICTION_INTERVAL_US = 250000; //!< slower samples aren't extrapolated
+    static constexpr qreal SETTLED_POSITION = 0.01; //!< position error considered settled
+    static constexpr qreal SETTLED_VELOCITY = 0.1; //!< velocity error (per second) considered settled
+
+    /**
+     * @brief Constructor
+     * @param responseMsec: spring time constant
+     */
+    NeedleDynamics(qreal responseMsec = DEFAULT_RESPONSE_MSEC) {
+        setResponse(responseMsec);
+    }
+
+    /**
+     * @brief Set the spring time constant -- a step settles in about seven time constants
+     * @param responseMsec: time constant, 0 to jump straight to the target
+     */
+    void setResponse(qreal responseMsec) {
+        mOmega = (responseMsec > 0) ? 1000.0 / responseMsec : 0;
+    }
+
+    /**
+     * @brief Jump to a position and forget the sample history
+     * @param position: needle position
+     * @param timeUs: current time
+     */
+    void reset(qreal position, qint64 timeUs) {
+        mPosition = position;
+        mVelocity = 0;
+        mTime = timeUs;
+        mSample = position;
+        mSampleTime = timeUs;
+        mRate = 0;
+        mInterval = 0;
+        mHasSample = false;
+    }
+
+    /**
+     * @brief Add a sample
+     * @param target: sampled position
+     * @param timeUs: time the sample was taken
+     */
+    void addSample(qreal target, qint64 timeUs) {
+        qint64 interval = timeUs - mSampleTime;
+        if (mHasSample && interval > 0 && interval <= MAX_PREDICTION_INTERVAL_US) {
+            mRate = (target - mSample) / interval;
+            mInterval = interval;
+        } else {
+            mRate = 0;
+            mInterval = 0;
+        }
+        mSample = target;
+        mSampleTime = timeUs;
+        mHasSample = true;
+    }
+
+    /**
+     * @brief Advance the needle to a time
+     * @param timeUs: frame time
+     * @return needle position
+     */
+    qreal advance(qint64 timeUs) {
+        qint64 dt = timeUs - mTime;
+        if (dt <= 0) {
+            return mPosition;
+        }
+
+        qreal start = predict(mTime);
+        qreal end = predict(timeUs);
+        qreal seconds = dt / 1e6;
+        qreal targetVelocity = (end - start) / seconds;
+
+        if (mOmega <= 0) {
+            mPosition = end;
+            mVelocity = targetVelocity;
+        } else {
+            // critically damped error dynamics, exact for a target moving linearly over the step
+            qreal error = mPosition - start;
+            qreal errorVelocity = mVelocity - targetVelocity;
+            qreal decay = qExp(-mOmega * seconds);
+            qreal c = errorVelocity + mOmega * error;
+
+            mPosition = end + (error + c * seconds) * decay;
+            mVelocity = targetVelocity + (errorVelocity - mOmega * c * seconds) * decay;
+        }
+        mTime = timeUs;
+        return mPosition;
+    }
+
+    /**
+     * @brief Target the needle is chasing at a time
+     * @param timeUs: time
+     * @return predicted position
+     */
+    qreal predict(qint64 timeUs) const {
+        // a frame taken just before the sample arrived is on the same line
+        qint64 ahead = qBound(-mInterval, timeUs - mSampleTime, mInterval);
+        return mSample + mRate * ahead;
+    }
+
+    /**
+     * @brief True once the needle sits on the last sample and nothing is being extrapolated
+     * @param timeUs: current time
+     * @param position: position error considered settled
+     * @param velocity: velocity (per second) considered settled
+     */
+    bool isSettled(qint64 timeUs, qreal position = SETTLED_POSITION, qreal velocity = SETTLED_VELOCITY) const {
+        return (timeUs - mSampleTime >= mInterval) &&
+                qAbs(mPosition - predict(timeUs)) < position &&
+                qAbs(mVelocity) < velocity;
+    }
+
+    /**
+     * @brief Put the needle on the last sample and stop it
+     * @param timeUs: current time
+     * @return needle position
+     */
+    qreal settle(qint64 timeUs) {
+        mPosition = predict(timeUs);
+        mVelocity = 0;
+        mTime = timeUs;
+        return mPosition;
+    }
+
+    qreal getPosition() const {
+        return mPosition;
+    }
+
+    qreal getVelocity() const {
+        return mVelocity;
+    }
+
+    qreal getTarget() const {
+        return mSample;
+    }
+
+private:
+    qreal mOmega = 0; //!< spring natural frequency (1/s)
+    qreal mPosition = 0; //!< needle position
+    qreal mVelocity = 0; //!< needle velocity (per second)
+    qint64 mTime = 0; //!< time of mPosition
+
+    qreal mSample = 0; //!< last sample
+    qint64 mSampleTime = 0; //!< time of the last sample
+    qreal mRate = 0; //!< rate between the last two samples (per us)
+    qint64 mInterval = 0; //!< interval between the last two samples, 0 = no prediction
+    bool mHasSample = false; //!< a sample has been added since reset
+};
+
+#endif // NEEDLE_DYNAMICS_H
@@ -0,0 +1,372 @@
+#ifndef PERF_TIMER_H
+#define PERF_TIMER_H
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QtMath>
+
+#include <chrono>
+
+/**
+ * @brief Acceleration run and lap timing.
+ *
+ * Runs are timed from VSS pulse timestamps (kernel time of each pulse, so the
+ * poll rate doesn't matter) or from GPS fixes. A run arms when the car stands
+ * still and starts on the first pulse -- like a drag strip's rollout -- or,
+ * from GPS, when the speed passes LAUNCH_SPEED. Speed targets are interpolated
+ * between the speeds of consecutive pulse intervals (the mean speed of an
+ * interval is the speed at its middle), distance targets between pulses.
+ *
+ * Laps are timed from GPS fixes crossing a start/finish line, interpolated
+ * between the two fixes either side of it.
+ */
+class PerfTimer : public QObject {
+    Q_OBJECT
+public:
+    static constexpr qint64 STANDSTILL_NSEC = 500000000; //!< no pulse for this long is standing still
+    static constexpr qint64 MAX_RUN_NSEC = 60000000000; //!< runs are abandoned after this long
+    static constexpr qreal STANDSTILL_SPEED = 0.3; //!< gps speed (m/s) that counts as standing still
+    static constexpr qreal LAUNCH_SPEED = 0.5; //!< gps speed (m/s) a run starts at
+    static constexpr qreal MIN_LAP_SECONDS = 10; //!< line crossings closer than this are gps jitter
+    static constexpr qreal EARTH_RADIUS = 6371000; //!< meters
+
+    /**
+     * @brief Run state
+     */
+    enum class RunState {
+        IDLE = 0, //!< moving, not timing
+        ARMED, //!< standing still, timing starts on launch
+        RUNNING, //!< timing
+    };
+
+    /**
+     * @brief A run target -- a speed or a distance from standstill
+     */
+    typedef struct Target {
+        const char * name; //!< display name
+        bool distance; //!< true for a distance target
+        qreal value; //!< m/s or meters
+    } Target_t;
+
+    /**
+     * @brief A target's result
+     */
+    typedef struct Result {
+        qreal seconds = qQNaN(); //!< time from launch, NaN if not reached
+        qreal speed = qQNaN(); //!< speed (m/s) at the target
+    } Result_t;
+
+    static constexpr int NUM_TARGETS = 4; //!< number of run targets
+
+    /**
+     * @brief Get the run targets
+     * @return targets, speeds then distances
+     */
+    static const Target_t * getTargets() {
+        static const Target_t targets[NUM_TARGETS] = {
+            {"0-60 mph", false, 26.8224},
+            {"0-100 km/h", false, 100 / 3.6},
+            {"1/8 mile", true, 201.168},
+            {"1/4 mile", true, 402.336},
+        };
+        return targets;
+    }
+
+    /**
+     * @brief Current CLOCK_MONOTONIC time, the pulse timestamps' clock
+     * @return nanoseconds
+     */
+    static qint64 monotonicNsec() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param metersPerPulse: VSS distance per pulse
+     * @param useGps: time runs from gps fixes instead of VSS pulses
+     * @param finishLine: start/finish line latitude, longitude of both ends -- empty for no lap timing
+     */
+    PerfTimer(QObject * parent, qreal metersPerPulse, bool useGps = false, QList<qreal> finishLine = QList<qreal>()) :
+        QObject(parent), mMetersPerPulse(metersPerPulse), mUseGps(useGps), mResults(NUM_TARGETS) {
+        if (finishLine.size() == 4) {
+            mLineStart = {finishLine.at(0), finishLine.at(1)};
+            mLineEnd = {finishLine.at(2), finishLine.at(3)};
+            mHasLine = true;
+        }
+    }
+
+    RunState getState() const {
+        return mState;
+    }
+
+    /**
+     * @brief Get a target's result of the current or last run
+     * @param target: index into @ref getTargets
+     * @return result
+     */
+    Result_t getResult(int target) const {
+        return mResults.value(target);
+    }
+
+    qreal getLastLap() const {
+        return mLastLap;
+    }
+
+    qreal getBestLap() const {
+        return mBestLap;
+    }
+
+    int getLapCount() const {
+        return mLapCount;
+    }
+
+signals:
+    /**
+     * @brief The run state or a result changed
+     */
+    void runChanged();
+
+    /**
+     * @brief A lap was completed
+     */
+    void lapChanged();
+
+public slots:
+    /**
+     * @brief A VSS pulse
+     * @param nsec: CLOCK_MONOTONIC time of the pulse
+     * @param count: pulse count
+     */
+    void addPulse(qint64 nsec, quint32 count) {
+        if (mUseGps) {
+            return;
+        }
+
+        if (mLastPulseNsec == 0 || nsec - mLastPulseNsec > STANDSTILL_NSEC) {
+            // first pulse after standing still
+            startRun(nsec);
+            mStartCount = count;
+        } else if (mState == RunState::RUNNING && nsec > mLastPulseNsec) {
+            // mean speed over the interval is the speed at its middle
+            qreal distance = (quint32)(count - mStartCount) * mMetersPerPulse;
+            qreal speed = (distance - mDistance) * 1e9 / (nsec - mLastPulseNsec);
+            qint64 mid = mLastPulseNsec + (nsec - mLastPulseNsec) / 2;
+
+            advance(mid, speed, nsec, distance);
+        }
+        mLastPulseNsec = nsec;
+    }
+
+    /**
+     * @brief A GPS fix
+     * @param nsec: fix time
+     * @param latitude: latitude (degrees)
+     * @param longitude: longitude (degrees)
+     * @param speed: ground speed (m/s)
+     */
+    void addFix(qint64 nsec, qreal latitude, qreal longitude, qreal speed) {
+        if (mHasLine && mLastFixNsec != 0) {
+            checkLine(mLastFixNsec, mLastFix, nsec, {latitude, longitude});
+        }
+
+        if (mUseGps && !qIsNaN(speed)) {
+            if (speed < STANDSTILL_SPEED) {
+                if (mState != RunState::ARMED) {
+                    setState(RunState::ARMED);
+                }
+            } else if (mState == RunState::ARMED && speed >= LAUNCH_SPEED && mLastFixNsec != 0) {
+                // launch between the fixes
+                qint64 launch = interpolate(mLastFixSpeed, mLastFixNsec, speed, nsec, LAUNCH_SPEED);
+                startRun(launch);
+                mSpeedNsec = launch;
+                mSpeed = LAUNCH_SPEED;
+                mDistanceNsec = launch;
+            }
+
+            if (mState == RunState::RUNNING && nsec > mSpeedNsec) {
+                // trapezoid over the speed
+                qreal distance = mDistance + (mSpeed + speed) / 2 * (nsec - mSpeedNsec) / 1e9;
+                advance(nsec, speed, nsec, distance);
+            }
+            mLastFixSpeed = speed;
+        }
+
+        mLastFixNsec = nsec;
+        mLastFix = {latitude, longitude};
+    }
+
+    /**
+     * @brief Check for a standstill and a run timing out -- call regularly
+     * @param nsec: current CLOCK_MONOTONIC time
+     */
+    void update(qint64 nsec) {
+        if (mUseGps) {
+            return;
+        }
+
+        if (mLastPulseNsec == 0 || nsec - mLastPulseNsec > STANDSTILL_NSEC) {
+            if (mState != RunState::ARMED) {
+                setState(RunState::ARMED);
+            }
+        } else if (mState == RunState::RUNNING && nsec - mStartNsec > MAX_RUN_NSEC) {
+            setState(RunState::IDLE);
+        }
+    }
+
+private:
+    /**
+     * @brief Latitude/longitude pair
+     */
+    typedef struct Position {
+        qreal latitude; //!< degrees
+        qreal longitude; //!< degrees
+    } Position_t;
+
+    qreal mMetersPerPulse; //!< VSS distance per pulse
+    bool mUseGps; //!< runs are timed from gps fixes
+    RunState mState = RunState::IDLE; //!< run state
+    QVector<Result_t> mResults; //!< results of the current or last run
+
+    qint64 mStartNsec = 0; //!< launch time
+    quint32 mStartCount = 0; //!< pulse count at launch
+    qint64 mLastPulseNsec = 0; //!< time of the last pulse
+    qint64 mSpeedNsec = 0; //!< time of the last speed
+    qreal mSpeed = 0; //!< last speed (m/s)
+    qint64 mDistanceNsec = 0; //!< time of the last distance
+    qreal mDistance = 0; //!< last distance from launch (m)
+
+    qint64 mLastFixNsec = 0; //!< time of the last gps fix
+    Position_t mLastFix = {0, 0}; //!< last gps position
+    qreal mLastFixSpeed = 0; //!< last gps speed
+
+    bool mHasLine = false; //!< lap timing enabled
+    Position_t mLineStart = {0, 0}; //!< start/finish line end
+    Position_t mLineEnd = {0, 0}; //!< start/finish line end
+    qint64 mLastCrossingNsec = 0; //!< time of the last line crossing
+    qreal mLastLap = qQNaN(); //!< last lap (seconds)
+    qreal mBestLap = qQNaN(); //!< best lap (seconds)
+    int mLapCount = 0; //!< completed laps
+
+    void setState(RunState state) {
+        mState = state;
+        emit runChanged();
+    }
+
+    void startRun(qint64 nsec) {
+        mResults.fill(Result_t());
+        mStartNsec = nsec;
+        mSpeedNsec = nsec;
+        mSpeed = 0;
+        mDistanceNsec = nsec;
+        mDistance = 0;
+        setState(RunState::RUNNING);
+    }
+
+    /**
+     * @brief Time at which a linear segment passes a value
+     * @return interpolated time
+     */
+    static qint64 interpolate(qreal v0, qint64 t0, qreal v1, qint64 t1, qreal value) {
+        if (v1 == v0) {
+            return t1;
+        }
+        qreal f = qBound(0.0, (value - v0) / (v1 - v0), 1.0);
+        return t0 + qRound64(f * (t1 - t0));
+    }
+
+    /**
+     * @brief Record the targets passed since the last speed and distance
+     * @param speedNsec: time of the new speed
+     * @param speed: new speed (m/s)
+     * @param distanceNsec: time of the new distance
+     * @param distance: new distance from launch (m)
+     */
+    void advance(qint64 speedNsec, qreal speed, qint64 distanceNsec, qreal distance) {
+        const Target_t * targets = getTargets();
+        bool changed = false;
+        bool done = true;
+
+        for (int i = 0; i < NUM_TARGETS; i++) {
+            Result_t & result = mResults[i];
+            if (!qIsNaN(result.seconds)) {
+                continue;
+            }
+
+            if (targets[i].distance && distance >= targets[i].value) {
+                qint64 t = interpolate(mDistance, mDistanceNsec, distance, distanceNsec, targets[i].value);
+                result.seconds = (t - mStartNsec) / 1e9;
+                result.speed = speed;
+                changed = true;
+            } else if (!targets[i].distance && speed >= targets[i].value) {
+                qint64 t = interpolate(mSpeed, mSpeedNsec, speed, speedNsec, targets[i].value);
+                result.seconds = (t - mStartNsec) / 1e9;
+                result.speed = targets[i].value;
+                changed = true;
+            } else {
+                done = false;
+            }
+        }
+
+        mSpeed = speed;
+        mSpeedNsec = speedNsec;
+        mDistance = distance;
+        mDistanceNsec = distanceNsec;
+
+        if (done) {
+            setState(RunState::IDLE);
+        } else if (changed) {
+            emit runChanged();
+        }
+    }
+
+    /**
+     * @brief Time a lap if the path between two fixes crosses the line
+     */
+    void checkLine(qint64 t0, Position_t p0, qint64 t1, Position_t p1) {
+        // flat projection around the line, meters
+        qreal lat0 = qDegreesToRadians(mLineStart.latitude);
+        auto project = [&](Position_t p, qreal & x, qreal & y) {
+            x = qDegreesToRadians(p.longitude - mLineStart.longitude) * qCos(lat0) * EARTH_RADIUS;
+            y = qDegreesToRadians(p.latitude - mLineStart.latitude) * EARTH_RADIUS;
+        };
+
+        qreal ax, ay, bx, by, px, py, qx, qy;
+        project(mLineStart, ax, ay);
+        project(mLineEnd, bx, by);
+        project(p0, px, py);
+        project(p1, qx, qy);
+
+        // path p + u (q - p) meets line a + v (b - a)
+        qreal rx = qx - px, ry = qy - py;
+        qreal sx = bx - ax, sy = by - ay;
+        qreal denom = rx * sy - ry * sx;
+        if (denom == 0) {
+            return;
+        }
+        qreal u = ((ax - px) * sy - (ay - py) * sx) / denom;
+        qreal v = ((ax - px) * ry - (ay - py) * rx) / denom;
+        if (u < 0 || u >= 1 || v < 0 || v > 1) {
+            return;
+        }
+
+        qint64 crossing = t0 + qRound64(u * (t1 - t0));
+        if (mLastCrossingNsec != 0) {
+            qreal lap = (crossing - mLastCrossingNsec) / 1e9;
+            if (lap < MIN_LAP_SECONDS) {
+                return;
+            }
+            mLastLap = lap;
+            if (qIsNaN(mBestLap) || lap < mBestLap) {
+                mBestLap = lap;
+            }
+            mLapCount++;
+            emit lapChanged();
+        }
+        mLastCrossingNsec = crossing;
+    }
+};
+
+#endif // PERF_TIMER_H
@@ -0,0 +1,125 @@
+#include "perf_timer_model.h"
+
+#include <QtMath>
+
+PerfTimerModel::PerfTimerModel(QObject *parent) : QAbstractListModel{parent},
+    mLastLap(qQNaN()), mBestLap(qQNaN())
+{
+
+}
+
+QHash<int, QByteArray> PerfTimerModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[PerfTimerModelRoles::NameRole] = "name";
+    roles[PerfTimerModelRoles::SecondsRole] = "seconds";
+    roles[PerfTimerModelRoles::SpeedRole] = "speed";
+    return roles;
+}
+
+QVariant PerfTimerModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role == PerfTimerModelRoles::NameRole)
+    {
+        return QVariant("name");
+    }
+    else if(role == PerfTimerModelRoles::SecondsRole)
+    {
+        return QVariant("seconds");
+    }
+    else if(role == PerfTimerModelRoles::SpeedRole)
+    {
+        return QVariant("speed");
+    }
+    return QVariant("");
+}
+
+int PerfTimerModel::rowCount(const QModelIndex &parent) const
+{
+    return mRows.size();
+}
+
+QVariant PerfTimerModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mRows.size()) {
+        return QVariant();
+    }
+
+    const Row_t & row = mRows.at(index.row());
+    if (role == PerfTimerModelRoles::NameRole) {
+        return row.name;
+    } else if(role == PerfTimerModelRoles::SecondsRole) {
+        return row.seconds;
+    } else if(role == PerfTimerModelRoles::SpeedRole) {
+        return row.speed;
+    }
+    return row.name;
+}
+
+Qt::ItemFlags PerfTimerModel::flags(const QModelIndex &index) const {
+    return Qt::NoItemFlags;
+}
+
+int PerfTimerModel::runState() {
+    return mRunState;
+}
+
+QString PerfTimerModel::speedUnits() {
+    return mSpeedUnits;
+}
+
+qreal PerfTimerModel::lastLap() {
+    return mLastLap;
+}
+
+qreal PerfTimerModel::bestLap() {
+    return mBestLap;
+}
+
+int PerfTimerModel::lapCount() {
+    return mLapCount;
+}
+
+void PerfTimerModel::setResult(int row, QString name, qreal seconds, qreal speed) {
+    if (row < 0) {
+        return;
+    }
+
+    if (row >= mRows.size()) {
+        beginInsertRows(QModelIndex(), mRows.size(), row);
+        mRows.resize(row + 1);
+        endInsertRows();
+    }
+
+    mRows[row] = {name, seconds, speed};
+    emit dataChanged(createIndex(row, 0),
+                     createIndex(row, 0),
+                     QVector<int>() << PerfTimerModelRoles::NameRole
+                                    << PerfTimerModelRoles::SecondsRole
+                                    << PerfTimerModelRoles::SpeedRole);
+}
+
+void PerfTimerModel::setRunState(int runState) {
+    mRunState = runState;
+    emit runStateChanged();
+}
+
+void PerfTimerModel::setSpeedUnits(QString speedUnits) {
+    mSpeedUnits = speedUnits;
+    emit speedUnitsChanged();
+}
+
+void PerfTimerModel::setLastLap(qreal lastLap) {
+    mLastLap = lastLap;
+    emit lastLapChanged();
+}
+
+void PerfTimerModel::setBestLap(qreal bestLap) {
+    mBestLap = bestLap;
+    emit bestLapChanged();
+}
+
+void PerfTimerModel::setLapCount(int lapCount) {
+    mLapCount = lapCount;
+    emit lapCountChanged();
+}
@@ -0,0 +1,119 @@
+#ifndef PERF_TIMER_MODEL_H
+#define PERF_TIMER_MODEL_H
+
+#include <QAbstractListModel>
+#include <QObject>
+#include <QVector>
+
+/**
+ * @brief Performance timer results -- one row per run target, lap times as properties
+ */
+class PerfTimerModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int runState READ runState WRITE setRunState NOTIFY runStateChanged)
+    Q_PROPERTY(QString speedUnits READ speedUnits WRITE setSpeedUnits NOTIFY speedUnitsChanged)
+    Q_PROPERTY(qreal lastLap READ lastLap WRITE setLastLap NOTIFY lastLapChanged)
+    Q_PROPERTY(qreal bestLap READ bestLap WRITE setBestLap NOTIFY bestLapChanged)
+    Q_PROPERTY(int lapCount READ lapCount WRITE setLapCount NOTIFY lapCountChanged)
+
+public:
+    static constexpr char PERF_TIMER_MODEL_NAME[] = "perfTimerModel";
+
+    enum PerfTimerModelRoles {
+        NameRole        = Qt::UserRole + 1,
+        SecondsRole     = Qt::UserRole + 2,
+        SpeedRole       = Qt::UserRole + 3,
+    };
+
+    explicit PerfTimerModel(QObject *parent = nullptr);
+
+    /**
+     * Provides the header data for given params.
+     *
+     * @param section section of data
+     * @param orientation orientation of data
+     * @param role role of data
+     * @return
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * Returns the row count -- one row per run target.
+     *
+     * @param parent
+     * @return
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * Provides the data found at given index and role.
+     *
+     * @param index
+     * @param role
+     * @return
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * Returns the flags for model.
+     *
+     * @param index index to consider when providing flags
+     */
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    /**
+     * Enables integration with QML by providing names for use as refs in QML.
+     *
+     * @return hash map of role (int) -> name
+     */
+    QHash<int, QByteArray> roleNames() const override;
+
+    int runState();
+    QString speedUnits();
+    qreal lastLap();
+    qreal bestLap();
+    int lapCount();
+
+private:
+    /**
+     * @brief A run target's result
+     */
+    typedef struct Row {
+        QString name; //!< target name
+        qreal seconds; //!< time from launch, NaN if not reached
+        qreal speed; //!< speed at the target, in speedUnits
+    } Row_t;
+
+    QVector<Row_t> mRows;
+    int mRunState = 0;
+    QString mSpeedUnits;
+    qreal mLastLap;
+    qreal mBestLap;
+    int mLapCount = 0;
+
+signals:
+    void runStateChanged();
+    void speedUnitsChanged();
+    void lastLapChanged();
+    void bestLapChanged();
+    void lapCountChanged();
+
+public slots:
+    /**
+     * @brief Set a run target's result, adding the row if it's new
+     * @param row: target index
+     * @param name: target name
+     * @param seconds: time from launch, NaN if not reached
+     * @param speed: speed at the target
+     */
+    void setResult(int row, QString name, qreal seconds, qreal speed);
+
+    void setRunState(int runState);
+    void setSpeedUnits(QString speedUnits);
+    void setLastLap(qreal lastLap);
+    void setBestLap(qreal bestLap);
+    void setLapCount(int lapCount);
+};
+
+#endif // PERF_TIMER_MODEL_H
@@ -10,6 +10,8 @@
 #include <filesystem>
 #include <map>
 #include <cmath>
+#include <sstream>
+#include <vector>
 
 /**
  * @brief Class to interface with the
@@ -19,6 +21,14 @@
 class PulseCounter {
 
 public:
+    /**
+     * @brief A pulse and when it happened
+     */
+    typedef struct PulseEdge {
+        quint32 count; //!< pulse count at the pulse
+        qint64 nsec; //!< CLOCK_MONOTONIC time of the pulse
+    } PulseEdge_t;
+
     /**
      * @brief Constructor
      * @param path: path where the sysfs pulse_counter device is found
@@ -27,7 +37,8 @@ public:
     }
 
     /**
-     * @brief Get the current pulse frequency
+     * @brief Get the current pulse frequency. Read errors are reported once,
+     * until a read succeeds again -- the sensors report the -1 as a fault.
      * @return -1 if invalid 0 to max rpm if valid
      */
     int getFrequency() {
@@ -35,7 +46,7 @@ public:
         std::string fullPath = mPath + PULSE_SPACING_AVG;
         std::ifstream ifs(fullPath, std::ios::in);
         if (!ifs.is_open()) {
-            std::cout << "Error opening pulse spacing file" << std::endl;
+            reportError("Error opening pulse spacing file");
             return -1.0;
         }
 
@@ -47,12 +58,16 @@ public:
         try {
             spacingNano = std::stoi(val);
         } catch (std::invalid_argument& e) {
-            std::cout << "tach input, invalid argument -- rpm will be 0" << std::endl;
+            reportError("pulse spacing, invalid argument");
+            return -1.0;
         } catch (std::out_of_range& e) {
-            std::cout << "tach input, out of range -- rpm will be 0" << std::endl;
+            reportError("pulse spacing, out of range");
+            return -1.0;
         } catch (...) {
-            std::cout << "tach input, other exception -- rpm will be 0" << std::endl;
+            reportError("pulse spacing, other exception");
+            return -1.0;
         }
+        mErrorReported = false;
 
         if (spacingNano != 0) {
             return 1.0e9 / ((float)spacingNano);
@@ -91,6 +106,29 @@ public:
         return count;
     }
 
+    /**
+     * @brief Get the timestamps of the latest pulses. Not every kernel module
+     * version has them, so a missing attribute is quietly empty.
+     * @return pulses, oldest first
+     */
+    std::vector<PulseEdge_t> getEdges() {
+        std::vector<PulseEdge_t> edges;
+        std::ifstream ifs(mPath + PULSE_EDGES_ATTR, std::ios::in);
+        if (!ifs.is_open()) {
+            return edges;
+        }
+
+        std::string line;
+        while (std::getline(ifs, line)) {
+            std::istringstream ss(line);
+            unsigned long long count = 0, nsec = 0;
+            if (ss >> count >> nsec) {
+                edges.push_back({(quint32) count, (qint64) nsec});
+            }
+        }
+        return edges;
+    }
+
     /**
      * @brief Set the maximum frequency for incoming pulses.
      * This is ideally a little higher than the max expected frequency.
@@ -119,6 +157,7 @@ protected:
     static constexpr char PULSE_SPACING_AVG[] = "pulse_spacing_avg"; //!< average pulse spacing attribute
     static constexpr char PULSE_SPACING_MIN[] = "pulse_spacing_min"; //!< minimum pulse spacing (in nsec)
     static constexpr char PULSE_SPACING_AVG_NUM_SAMPLES[] = "pulse_spacing_avg_num_samples"; //!< number of samples to average over
+    static constexpr char PULSE_EDGES_ATTR[] = "pulse_edges"; //!< timestamps of the latest pulses
 
     /**
      * @brief Write attribute in the tach input sysfs
@@ -144,6 +183,18 @@ protected:
     }
 
     std::string mPath; //!< path to sysfs tach input class
+    bool mErrorReported = false; //!< a read error has been printed
+
+    /**
+     * @brief Print a read error, once per run of errors
+     * @param error: error message
+     */
+    void reportError(const char * error) {
+        if (!mErrorReported) {
+            std::cout << mPath << ": " << error << std::endl;
+            mErrorReported = true;
+        }
+    }
 };
 
 #endif // PULSE_COUNTER_H
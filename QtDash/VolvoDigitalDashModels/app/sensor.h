@@ -1,18 +1,36 @@
 #ifndef SENSOR_H
 #define SENSOR_H
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QVector>
 #include <sensor_source.h>
+#include <sensor_filter.h>
+#include <sensor_health.h>
 #include <config.h>
 
 /**
  * @brief Sensor class -- takes data from a sensor source,
  * performs the necessary transform from the raw sensor source
  * values to the value to be displayed by a gauge
+ *
+ * Every filtered sample is kept in a short history and emitted with
+ * sampleReady (for logging and derived channels). With a decimation factor
+ * set, the gauge only gets an anti-aliased sensorDataReady every factor
+ * samples, so a sensor can be read far faster than it is displayed.
+ *
+ * Each sample is classified as it's transformed (@ref classify) and counted
+ * in the sensor's @ref SensorHealth. Bad samples go no further: the gauge
+ * holds the last good value and learns about the fault from healthChanged.
+ *
+ * A sample is transformed on the thread that read the source -- a sensor read
+ * by @ref SensorAcquisition filters on that thread, and its signals are
+ * queued to receivers on the GUI thread.
  */
 class Sensor : public QObject {
     Q_OBJECT
 public:
+    static constexpr int HISTORY_SIZE = 256; //!< full rate samples kept
     /**
      * @brief Constructor
      * @param parent: Parent QObject
@@ -24,10 +42,13 @@ public:
            SensorSource * source, int channel) :
     QObject(parent), mConfig(config), mSource(source),
     mChannel(channel) {
-        // connect the source dataReady signal to the sensor's transform slot
-        QObject::connect(
-                    mSource, &SensorSource::dataReady,
-                    this, &Sensor::transform);
+        // connect the source dataReady signal to the sensor's transform slot,
+        // run by whichever thread read the source
+        if (mSource != nullptr) {
+            QObject::connect(
+                        mSource, &SensorSource::dataReady,
+                        this, &Sensor::transform, Qt::DirectConnection);
+        }
     }
 
     /**
@@ -44,12 +65,88 @@ public:
      */
     virtual QString getUnits() = 0;
 
+    /**
+     * @brief Set the filter chain applied to the transformed values
+     * @param stages: filter stage specs, see @ref SensorFilter -- empty for no filtering
+     */
+    void setFilter(QStringList stages) {
+        mFilter = SensorFilter();
+        mFilter.parse(stages);
+    }
+
+    /**
+     * @brief Set how many samples go into each value sent to the gauge
+     * @param factor: samples per displayed value, 1 = display every sample
+     */
+    void setDecimation(int factor) {
+        mDecimator = Decimator(factor);
+    }
+
+    int getDecimation() const {
+        return mDecimator.getFactor();
+    }
+
+    /**
+     * @brief Get the latest full rate samples
+     * @param count: number of samples, at most HISTORY_SIZE
+     * @return samples, oldest first
+     */
+    QVector<qreal> getHistory(int count = HISTORY_SIZE) const {
+        count = qMin(count, mHistory.count());
+        QVector<qreal> samples(count);
+        for (int i = 0; i < count; i++) {
+            samples[i] = mHistory.at(count - 1 - i);
+        }
+        return samples;
+    }
+
+    /**
+     * @brief Get the channel health
+     * @return reported status
+     */
+    virtual SensorHealth::Status getHealth() {
+        return mHealth.getStatus();
+    }
+
+    /**
+     * @brief Set the health timing, see @ref SensorHealth::setTiming
+     * @param timeoutMsec: no samples for this long is stale
+     * @param faultMsec: a fault has to hold this long to be reported
+     * @param recoverMsec: ok has to hold this long to clear a fault
+     */
+    void setHealthTiming(qint64 timeoutMsec, qint64 faultMsec, qint64 recoverMsec) {
+        mHealth.setTiming(timeoutMsec, faultMsec, recoverMsec);
+    }
+
+    /**
+     * @brief Evaluate the channel health -- called from the health monitor
+     * thread, healthChanged is queued to the sensor's thread
+     * @param msec: monotonic time, see @ref SensorHealth::nowMsec
+     */
+    void updateHealth(qint64 msec) {
+        if (mHealth.evaluate(msec)) {
+            emit healthChanged((int) mHealth.getStatus());
+        }
+    }
+
 signals:
     /**
      * @brief Signal to emit when the data has been transformed -- picked up by the gauge
      * @param data: data that has been transformed
      */
     void sensorDataReady(QVariant data);
+
+    /**
+     * @brief Emitted for every filtered sample, before decimation
+     * @param value: filtered sample
+     */
+    void sampleReady(qreal value);
+
+    /**
+     * @brief Emitted when the channel health changes
+     * @param status: new @ref SensorHealth::Status
+     */
+    void healthChanged(int status);
 public slots:
     /**
      * @brief Transform the raw data from the sensor source to the desired units.
@@ -69,6 +166,70 @@ protected:
     Config * mConfig; //!< Dash config
     SensorSource * mSource; //!< Sensor source
     int mChannel; //!< Channel from the sensor source
+    SensorHealth mHealth; //!< channel health
+
+    /**
+     * @brief Classify a sample. The default only rejects values that aren't
+     * numbers; sensors that can tell more from the raw value override it.
+     * @param raw: raw value from the source
+     * @param value: transformed value
+     * @return sample status
+     */
+    virtual SensorHealth::Status classify(qreal raw, qreal value) {
+        Q_UNUSED(raw)
+        return qIsNaN(value) ? SensorHealth::Status::OUT_OF_RANGE : SensorHealth::Status::OK;
+    }
+
+    /**
+     * @brief Filter a transformed value, and pass it on to the gauge when due
+     * @param value: transformed value
+     * @param status: sample status -- anything but OK is only counted
+     */
+    void publish(qreal value, SensorHealth::Status status = SensorHealth::Status::OK) {
+        if (status == SensorHealth::Status::OK && qIsNaN(value)) {
+            status = SensorHealth::Status::OUT_OF_RANGE;
+        }
+        mHealth.record(status, SensorHealth::nowMsec());
+        if (status != SensorHealth::Status::OK) {
+            return;
+        }
+
+        qreal display = 0;
+        if (acquire(value, elapsed(), display)) {
+            emit sensorDataReady(display);
+        }
+    }
+
+private:
+    SensorFilter mFilter; //!< filter chain for the transformed values
+    QElapsedTimer mFilterTimer; //!< time between samples, for rate limited stages
+    Decimator mDecimator; //!< full rate samples to gauge values
+    FilterRing<qreal, HISTORY_SIZE> mHistory; //!< latest full rate samples
+
+    /**
+     * @brief Filter a sample, keep it and emit it at full rate
+     * @param value: transformed value
+     * @param dt: seconds since the previous sample
+     * @param display: value for the gauge, set when due
+     * @return true if a gauge value is due
+     */
+    bool acquire(qreal value, qreal dt, qreal & display) {
+        if (!mFilter.isEmpty()) {
+            value = mFilter.process(value, dt);
+        }
+        mHistory.push(value);
+        emit sampleReady(value);
+        return mDecimator.process(value, display);
+    }
+
+    /**
+     * @brief Seconds since the previous call
+     */
+    qreal elapsed() {
+        qreal dt = mFilterTimer.isValid() ? mFilterTimer.nsecsElapsed() / 1e9 : 0;
+        mFilterTimer.start();
+        return dt;
+    }
 };
 
 #endif // SENSOR_H
@@ -0,0 +1,160 @@
+#ifndef SENSOR_ACQUISITION_H
+#define SENSOR_ACQUISITION_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QWaitCondition>
+#include <functional>
+
+/**
+ * @brief Reads the sensors sampled faster than the gauges are drawn on its
+ * own thread, so a 100 Hz acquisition rate costs the GUI thread nothing.
+ *
+ * A sensor's transform runs on the thread that read its source (see
+ * @ref Sensor), so filtering and decimation happen here too. Only the
+ * decimated gauge values and the full rate samples cross to the GUI thread,
+ * as queued signals.
+ */
+class SensorAcquisition : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     */
+    SensorAcquisition(QObject * parent) : QObject(parent), mThread(this) {
+    }
+
+    ~SensorAcquisition() {
+        stop();
+    }
+
+    /**
+     * @brief Read a source channel periodically -- only before @ref start.
+     * Reads at the same interval are made back to back.
+     * @param intervalMsec: read interval
+     * @param read: reads the source channel, called on the acquisition thread
+     */
+    void addRead(int intervalMsec, std::function<void()> read) {
+        for (Read_t & r : mReads) {
+            if (r.intervalMsec == intervalMsec) {
+                r.reads.append(read);
+                return;
+            }
+        }
+
+        Read_t r;
+        r.intervalMsec = intervalMsec;
+        r.reads.append(read);
+        mReads.append(r);
+    }
+
+    /**
+     * @brief Start reading
+     */
+    void start() {
+        if (mThread.isRunning() || mReads.isEmpty()) {
+            return;
+        }
+        mStopping = false;
+        mThread.start(QThread::HighPriority);
+    }
+
+    /**
+     * @brief Stop reading
+     */
+    void stop() {
+        if (!mThread.isRunning()) {
+            return;
+        }
+
+        mMutex.lock();
+        mStopping = true;
+        mWake.wakeOne();
+        mMutex.unlock();
+
+        mThread.wait();
+    }
+
+private:
+    /**
+     * @brief Background acquisition thread
+     */
+    class AcquisitionThread : public QThread {
+    public:
+        AcquisitionThread(SensorAcquisition * acquisition) : mAcquisition(acquisition) {}
+
+    protected:
+        void run() override {
+            mAcquisition->acquisitionLoop();
+        }
+
+    private:
+        SensorAcquisition * mAcquisition;
+    };
+
+    /**
+     * @brief The reads made at one interval
+     */
+    typedef struct Read {
+        int intervalMsec = 0; //!< read interval
+        QList<std::function<void()>> reads; //!< source reads
+        qint64 nextMsec = 0; //!< when the reads are next due
+    } Read_t;
+
+    QList<Read_t> mReads; //!< reads by interval, fixed while running
+    AcquisitionThread mThread; //!< acquisition thread
+
+    QMutex mMutex; //!< guards mStopping
+    QWaitCondition mWake; //!< wakes the thread to stop
+    bool mStopping = false; //!< thread should exit
+
+    /**
+     * @brief Acquisition thread body -- sleeps until the next reads are due
+     */
+    void acquisitionLoop() {
+        QElapsedTimer clock;
+        clock.start();
+        for (Read_t & r : mReads) {
+            r.nextMsec = 0;
+        }
+
+        while (true) {
+            qint64 next = mReads.first().nextMsec;
+            for (const Read_t & r : mReads) {
+                next = qMin(next, r.nextMsec);
+            }
+
+            mMutex.lock();
+            qint64 wait = next - clock.elapsed();
+            if (!mStopping && wait > 0) {
+                mWake.wait(&mMutex, (unsigned long) wait);
+            }
+            bool stopping = mStopping;
+            mMutex.unlock();
+            if (stopping) {
+                break;
+            }
+
+            qint64 now = clock.elapsed();
+            for (Read_t & r : mReads) {
+                if (r.nextMsec > now) {
+                    continue;
+                }
+                for (const std::function<void()> & read : r.reads) {
+                    read();
+                }
+                // reads missed by a stall are dropped, not made back to back
+                r.nextMsec += r.intervalMsec;
+                if (r.nextMsec <= now) {
+                    r.nextMsec = now + r.intervalMsec;
+                }
+            }
+        }
+    }
+};
+
+#endif // SENSOR_ACQUISITION_H
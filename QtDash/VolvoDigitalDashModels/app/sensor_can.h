@@ -19,12 +19,21 @@ public:
     CanSensor(QObject * parent, Config * config,
                CanSource * source, int channel) :
     Sensor(parent, config, source, channel) {
+        // the channel is down with the bus, whether or not frames arrive
+        QObject::connect(source, &CanSource::busStateChanged, this, [=](bool busOff) {
+            mHealth.setLatched(busOff ? SensorHealth::Status::BUS_OFF : SensorHealth::Status::OK);
+        });
     }
 
     QString getUnits() override {
         return mSource->getUnits(mChannel);
     }
 
+    QString getName() {
+        CanFrameConfig conf = ((CanSource *)mSource)->getChannelConfig(mChannel);
+        return conf.getName();
+    }
+
     QString getGuage() {
         CanFrameConfig conf = ((CanSource *)mSource)->getChannelConfig(mChannel);
         return conf.getGauge();
@@ -32,14 +41,14 @@ public:
 
 public slots:
     /**
-     * @brief Pass values on
+     * @brief Pass values on -- a short payload comes through as NaN
      * @param data: data from CAN source
      * @param channel: adc channel
      */
     void transform(QVariant data, int channel) override {
         if (channel == getChannel()) {
             qreal value = data.toReal();
-            emit sensorDataReady(value);
+            publish(value);
         }
     }
 
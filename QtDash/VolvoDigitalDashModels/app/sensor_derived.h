@@ -0,0 +1,49 @@
+#ifndef SENSOR_DERIVED_H
+#define SENSOR_DERIVED_H
+
+#include <sensor.h>
+#include <sensor_source_derived.h>
+
+/**
+ * @brief A channel computed from other sensors
+ */
+class DerivedSensor : public Sensor {
+public:
+    /**
+     * @brief Derived channel sensor constructor
+     * @param parent: parent object
+     * @param config: dash config
+     * @param source: derived channel source
+     * @param channel: derived channel
+     */
+    DerivedSensor(QObject * parent, Config * config,
+                  DerivedSource * source, int channel) :
+    Sensor(parent, config, source, channel) {
+    }
+
+    QString getUnits() override {
+        return mSource->getUnits(mChannel);
+    }
+
+    QString getName() {
+        return ((DerivedSource *)mSource)->getChannelConfig(mChannel).name;
+    }
+
+    QString getGauge() {
+        return ((DerivedSource *)mSource)->getChannelConfig(mChannel).gauge;
+    }
+
+public slots:
+    /**
+     * @brief Pass values on
+     * @param data: data from the derived source
+     * @param channel: derived channel
+     */
+    void transform(QVariant data, int channel) override {
+        if (channel == getChannel()) {
+            publish(data.toReal());
+        }
+    }
+};
+
+#endif // SENSOR_DERIVED_H
@@ -0,0 +1,96 @@
+#ifndef SENSOR_FALLBACK_H
+#define SENSOR_FALLBACK_H
+
+#include <sensor.h>
+#include <sensor_utils.h>
+
+/**
+ * @brief Drives a gauge from a primary sensor, and from a fallback sensor
+ * while the primary is faulted (can to analog, vss to gps). Values are
+ * passed on as they are -- both sensors filter their own -- with the
+ * fallback's converted to the primary's units. Switching follows the
+ * sensors' health, which already has hysteresis, so it doesn't chatter.
+ */
+class FallbackSensor : public Sensor {
+public:
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param config: dash config
+     * @param primary: sensor used while it's healthy
+     * @param fallback: sensor used while the primary isn't
+     */
+    FallbackSensor(QObject * parent, Config * config, Sensor * primary, Sensor * fallback) :
+        Sensor(parent, config, nullptr, -1), mPrimary(primary), mFallback(fallback),
+        mActive(primary) {
+        QObject::connect(mPrimary, &Sensor::sensorDataReady, this, [=](QVariant data) {
+            if (mActive == mPrimary) {
+                emit sensorDataReady(data);
+            }
+        });
+        QObject::connect(mFallback, &Sensor::sensorDataReady, this, [=](QVariant data) {
+            if (mActive == mFallback) {
+                emit sensorDataReady(SensorUtils::convert(
+                                         data.toReal(), mPrimary->getUnits(), mFallback->getUnits()));
+            }
+        });
+
+        QObject::connect(mPrimary, &Sensor::healthChanged, this, &FallbackSensor::select);
+        QObject::connect(mFallback, &Sensor::healthChanged, this, &FallbackSensor::select);
+    }
+
+    QString getUnits() override {
+        return mPrimary->getUnits();
+    }
+
+    /**
+     * @brief Get the health of the sensor driving the gauge
+     * @return status
+     */
+    SensorHealth::Status getHealth() override {
+        return mActive->getHealth();
+    }
+
+    /**
+     * @brief Get the sensor driving the gauge
+     * @return primary or fallback sensor
+     */
+    Sensor * getActive() {
+        return mActive;
+    }
+
+public slots:
+    void transform(QVariant data, int channel) override {
+        Q_UNUSED(data)
+        Q_UNUSED(channel)
+    }
+
+private:
+    Sensor * mPrimary; //!< preferred sensor
+    Sensor * mFallback; //!< sensor used while the primary is faulted
+    Sensor * mActive; //!< sensor driving the gauge
+    SensorHealth::Status mReported = SensorHealth::Status::OK; //!< last health emitted
+
+    /**
+     * @brief Pick the sensor for the gauge -- the primary unless it's faulted and the fallback isn't
+     */
+    void select() {
+        Sensor * active = mPrimary;
+        if (mPrimary->getHealth() != SensorHealth::Status::OK &&
+                mFallback->getHealth() == SensorHealth::Status::OK) {
+            active = mFallback;
+        }
+
+        if (active != mActive) {
+            qDebug() << "Gauge sensor" << (active == mFallback ? "falling back" : "back on primary")
+                     << SensorHealth::toString(mPrimary->getHealth());
+            mActive = active;
+        }
+        if (getHealth() != mReported) {
+            mReported = getHealth();
+            emit healthChanged((int) mReported);
+        }
+    }
+};
+
+#endif // SENSOR_FALLBACK_H
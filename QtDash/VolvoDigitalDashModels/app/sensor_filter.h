@@ -0,0 +1,545 @@
+#ifndef SENSOR_FILTER_H
+#define SENSOR_FILTER_H
+
+#include <QDebug>
+#include <QStringList>
+#include <QtMath>
+
+#include <algorithm>
+#include <array>
+#include <variant>
+
+/**
+ * @brief Fixed capacity ring buffer -- never allocates, the oldest sample is
+ * dropped once the buffer holds size() samples
+ */
+template <typename T, int N>
+class FilterRing {
+public:
+    static_assert(N > 0, "ring capacity must be positive");
+
+    /**
+     * @brief Set the number of samples kept, clears the buffer
+     * @param size: samples kept, clamped to 1..N
+     */
+    void resize(int size) {
+        mSize = qBound(1, size, N);
+        clear();
+    }
+
+    void clear() {
+        mHead = 0;
+        mCount = 0;
+    }
+
+    /**
+     * @brief Add a sample
+     * @param value: sample
+     */
+    void push(T value) {
+        mData[mHead] = value;
+        mHead = (mHead + 1) % mSize;
+        mCount = qMin(mCount + 1, mSize);
+    }
+
+    /**
+     * @brief Get a sample
+     * @param age: 0 is the newest sample
+     * @return sample
+     */
+    T at(int age) const {
+        return mData[(mHead - 1 - age + 2 * mSize) % mSize];
+    }
+
+    int count() const {
+        return mCount;
+    }
+
+    int size() const {
+        return mSize;
+    }
+
+    bool isFull() const {
+        return mCount == mSize;
+    }
+
+private:
+    std::array<T, N> mData = {}; //!< samples
+    int mSize = N; //!< samples kept
+    int mHead = 0; //!< next write position
+    int mCount = 0; //!< samples held
+};
+
+/**
+ * @brief First order lag y = lag * x + (1 - lag) * y[n-1], starts at the first sample
+ */
+class LagFilter {
+public:
+    LagFilter(qreal lag = 1.0) : mLag(lag) {}
+
+    qreal process(qreal x, qreal dt) {
+        Q_UNUSED(dt)
+        mValue = mPrimed ? (mLag * x) + (1 - mLag) * mValue : x;
+        mPrimed = true;
+        return mValue;
+    }
+
+    void reset() {
+        mPrimed = false;
+    }
+
+private:
+    qreal mLag; //!< lag coefficient (0-1), 1 = no filtering
+    qreal mValue = 0; //!< previous output
+    bool mPrimed = false; //!< has seen a sample
+};
+
+/**
+ * @brief Second order IIR section, direct form II transposed. Starts in the
+ * steady state of the first sample, so there's no startup transient.
+ */
+class BiquadFilter {
+public:
+    /**
+     * @brief Constructor -- coefficients normalized to a0 = 1
+     */
+    BiquadFilter(qreal b0 = 1, qreal b1 = 0, qreal b2 = 0, qreal a1 = 0, qreal a2 = 0) :
+        mB0(b0), mB1(b1), mB2(b2), mA1(a1), mA2(a2) {}
+
+    /**
+     * @brief Butterworth style low pass (RBJ cookbook)
+     * @param cutoffHz: cutoff frequency
+     * @param sampleHz: sample rate of the sensor
+     * @param q: quality factor, 1/sqrt(2) is maximally flat
+     * @return filter
+     */
+    static BiquadFilter lowPass(qreal cutoffHz, qreal sampleHz, qreal q = M_SQRT1_2) {
+        qreal w0 = 2 * M_PI * cutoffHz / sampleHz;
+        qreal alpha = qSin(w0) / (2 * q);
+        qreal cosW0 = qCos(w0);
+        qreal a0 = 1 + alpha;
+        qreal b1 = (1 - cosW0) / a0;
+        return BiquadFilter(b1 / 2, b1, b1 / 2, (-2 * cosW0) / a0, (1 - alpha) / a0);
+    }
+
+    qreal process(qreal x, qreal dt) {
+        Q_UNUSED(dt)
+        if (!mPrimed) {
+            qreal den = 1 + mA1 + mA2;
+            qreal y = (den != 0) ? x * (mB0 + mB1 + mB2) / den : x;
+            mZ2 = mB2 * x - mA2 * y;
+            mZ1 = mB1 * x - mA1 * y + mZ2;
+            mPrimed = true;
+        }
+        qreal y = mB0 * x + mZ1;
+        mZ1 = mB1 * x - mA1 * y + mZ2;
+        mZ2 = mB2 * x - mA2 * y;
+        return y;
+    }
+
+    void reset() {
+        mPrimed = false;
+    }
+
+private:
+    qreal mB0, mB1, mB2, mA1, mA2; //!< coefficients
+    qreal mZ1 = 0; //!< state
+    qreal mZ2 = 0; //!< state
+    bool mPrimed = false; //!< has seen a sample
+};
+
+/**
+ * @brief FIR filter over the last taps samples. Until the window fills the
+ * first sample stands in for the missing ones.
+ */
+template <int N>
+class FirFilter {
+public:
+    FirFilter() {
+        mTaps.fill(0);
+        mTaps[0] = 1;
+        mSamples.resize(1);
+    }
+
+    /**
+     * @brief Constructor
+     * @param taps: coefficients, newest sample first -- at most N
+     */
+    FirFilter(QList<qreal> taps) {
+        mTaps.fill(0);
+        int count = qMin(taps.size(), N);
+        for (int i = 0; i < count; i++) {
+            mTaps[i] = taps.at(i);
+        }
+        mSamples.resize(qMax(count, 1));
+    }
+
+    /**
+     * @brief Moving average
+     * @param window: samples to average, at most N
+     * @return filter
+     */
+    static FirFilter average(int window) {
+        window = qBound(1, window, N);
+        QList<qreal> taps;
+        for (int i = 0; i < window; i++) {
+            taps.append(1.0 / window);
+        }
+        return FirFilter(taps);
+    }
+
+    qreal process(qreal x, qreal dt) {
+        Q_UNUSED(dt)
+        if (mSamples.count() == 0) {
+            for (int i = 0; i < mSamples.size() - 1; i++) {
+                mSamples.push(x);
+            }
+        }
+        mSamples.push(x);
+
+        qreal y = 0;
+        for (int i = 0; i < mSamples.size(); i++) {
+            y += mTaps[i] * mSamples.at(i);
+        }
+        return y;
+    }
+
+    void reset() {
+        mSamples.clear();
+    }
+
+private:
+    std::array<qreal, N> mTaps; //!< coefficients, newest sample first
+    FilterRing<qreal, N> mSamples; //!< last samples
+};
+
+/**
+ * @brief Moving median -- rejects single sample spikes without smearing steps
+ */
+template <int N>
+class MedianFilter {
+public:
+    /**
+     * @brief Constructor
+     * @param window: samples in the window, at most N
+     */
+    MedianFilter(int window = 3) {
+        mSamples.resize(window);
+    }
+
+    qreal process(qreal x, qreal dt) {
+        Q_UNUSED(dt)
+        mSamples.push(x);
+
+        std::array<qreal, N> sorted;
+        int count = mSamples.count();
+        for (int i = 0; i < count; i++) {
+            sorted[i] = mSamples.at(i);
+        }
+        std::nth_element(sorted.begin(), sorted.begin() + count / 2, sorted.begin() + count);
+        return sorted[count / 2];
+    }
+
+    void reset() {
+        mSamples.clear();
+    }
+
+private:
+    FilterRing<qreal, N> mSamples; //!< window
+};
+
+/**
+ * @brief Slew rate limiter -- the output moves at most rate units per second
+ */
+class RateLimiter {
+public:
+    /**
+     * @brief Constructor
+     * @param rate: max change per second
+     */
+    RateLimiter(qreal rate = 0) : mRate(qAbs(rate)) {}
+
+    qreal process(qreal x, qreal dt) {
+        if (!mPrimed) {
+            mValue = x;
+            mPrimed = true;
+        } else {
+            qreal step = mRate * qMax(dt, 0.0);
+            mValue += qBound(-step, x - mValue, step);
+        }
+        return mValue;
+    }
+
+    void reset() {
+        mPrimed = false;
+    }
+
+private:
+    qreal mRate; //!< max change per second
+    qreal mValue = 0; //!< output
+    bool mPrimed = false; //!< has seen a sample
+};
+
+/**
+ * @brief Hysteresis -- the output only follows the input once it has moved
+ * more than band away, keeps readouts from flickering between two values
+ */
+class Hysteresis {
+public:
+    Hysteresis(qreal band = 0) : mBand(qAbs(band)) {}
+
+    qreal process(qreal x, qreal dt) {
+        Q_UNUSED(dt)
+        if (!mPrimed || qAbs(x - mValue) > mBand) {
+            mValue = x;
+            mPrimed = true;
+        }
+        return mValue;
+    }
+
+    void reset() {
+        mPrimed = false;
+    }
+
+private:
+    qreal mBand; //!< dead band
+    qreal mValue = 0; //!< output
+    bool mPrimed = false; //!< has seen a sample
+};
+
+/**
+ * @brief Anti-aliasing decimator -- takes every sample, outputs every
+ * factor'th. The samples go through a Hamming windowed sinc low pass cut off at
+ * the output Nyquist frequency, which is only evaluated when an output is due.
+ * The delay is factor samples, i.e. one output period.
+ */
+class Decimator {
+public:
+    static constexpr int MAX_FACTOR = 31; //!< largest decimation factor
+    static constexpr int MAX_TAPS = 2 * MAX_FACTOR + 1; //!< taps at the largest factor
+
+    /**
+     * @brief Constructor
+     * @param factor: input samples per output sample, 1 = pass through
+     */
+    Decimator(int factor = 1) {
+        mFactor = qBound(1, factor, MAX_FACTOR);
+        int taps = 2 * mFactor + 1;
+        mSamples.resize(taps);
+
+        // windowed sinc, cutoff 0.5 / factor cycles per sample, unity dc gain
+        qreal fc = 0.5 / mFactor;
+        qreal sum = 0;
+        for (int i = 0; i < taps; i++) {
+            qreal n = i - mFactor;
+            qreal sinc = (n == 0) ? 2 * fc : qSin(2 * M_PI * fc * n) / (M_PI * n);
+            qreal window = 0.54 - 0.46 * qCos(2 * M_PI * i / (taps - 1));
+            mTaps[i] = sinc * window;
+            sum += mTaps[i];
+        }
+        for (int i = 0; i < taps; i++) {
+            mTaps[i] /= sum;
+        }
+    }
+
+    /**
+     * @brief Add a sample
+     * @param x: sample
+     * @param y: output sample, set when one is due
+     * @return true if an output sample is due
+     */
+    bool process(qreal x, qreal & y) {
+        if (mFactor == 1) {
+            y = x;
+            return true;
+        }
+
+        // the first sample fills the window, and is output straight away
+        bool first = (mSamples.count() == 0);
+        if (first) {
+            for (int i = 0; i < mSamples.size() - 1; i++) {
+                mSamples.push(x);
+            }
+        }
+        mSamples.push(x);
+
+        if (!first && ++mPhase < mFactor) {
+            return false;
+        }
+        mPhase = 0;
+
+        y = 0;
+        for (int i = 0; i < mSamples.size(); i++) {
+            y += mTaps[i] * mSamples.at(i);
+        }
+        return true;
+    }
+
+    void reset() {
+        mSamples.clear();
+        mPhase = 0;
+    }
+
+    int getFactor() const {
+        return mFactor;
+    }
+
+private:
+    int mFactor = 1; //!< input samples per output sample
+    int mPhase = 0; //!< input samples since the last output
+    std::array<qreal, MAX_TAPS> mTaps; //!< low pass taps (symmetric)
+    FilterRing<qreal, MAX_TAPS> mSamples; //!< last input samples
+};
+
+/**
+ * @brief Chain of filter stages applied to a sensor's output, configured per
+ * sensor in the [sensor_filter] group of config.ini, e.g.
+ *
+ *  fuel_level=median:5, lag:0.2
+ *
+ * Stages run in order:
+ *  lag:<coefficient>                        first order lag, 1 = off
+ *  lowpass:<cutoff hz>:<sample hz>[:<q>]    biquad low pass
+ *  biquad:<b0>:<b1>:<b2>:<a1>:<a2>          biquad, a0 = 1
+ *  average:<samples>                        moving average
+ *  fir:<c0>:<c1>:...                        fir taps, newest sample first
+ *  median:<samples>                         moving median
+ *  rate:<units per second>                  slew rate limit
+ *  hysteresis:<band>                        dead band
+ *
+ * All state is fixed size, nothing is allocated once the chain is built.
+ */
+class SensorFilter {
+public:
+    static constexpr int MAX_STAGES = 6; //!< stages per sensor
+    static constexpr int MAX_TAPS = 32; //!< fir taps / average window
+    static constexpr int MAX_MEDIAN_WINDOW = 15; //!< median window
+
+    static constexpr char STAGE_LAG[] = "lag";
+    static constexpr char STAGE_LOWPASS[] = "lowpass";
+    static constexpr char STAGE_BIQUAD[] = "biquad";
+    static constexpr char STAGE_AVERAGE[] = "average";
+    static constexpr char STAGE_FIR[] = "fir";
+    static constexpr char STAGE_MEDIAN[] = "median";
+    static constexpr char STAGE_RATE[] = "rate";
+    static constexpr char STAGE_HYSTERESIS[] = "hysteresis";
+
+    typedef std::variant<LagFilter, BiquadFilter, FirFilter<MAX_TAPS>,
+                         MedianFilter<MAX_MEDIAN_WINDOW>, RateLimiter, Hysteresis> Stage;
+
+    /**
+     * @brief Build a chain from config stage specs
+     * @param specs: stage specs, see the class description
+     * @return true if every spec was valid -- invalid ones are skipped
+     */
+    bool parse(QStringList specs) {
+        bool ok = true;
+        for (QString spec : specs) {
+            spec = spec.trimmed();
+            if (spec.isEmpty()) {
+                continue;
+            }
+            Stage stage;
+            if (!parseStage(spec, stage) || !addStage(stage)) {
+                qDebug() << "Invalid sensor filter stage: " << spec;
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Append a stage
+     * @param stage: stage
+     * @return false if the chain is full
+     */
+    bool addStage(Stage stage) {
+        if (mCount >= MAX_STAGES) {
+            return false;
+        }
+        mStages[mCount++] = stage;
+        return true;
+    }
+
+    /**
+     * @brief Run a sample through every stage
+     * @param x: sample
+     * @param dt: seconds since the previous sample
+     * @return filtered sample
+     */
+    qreal process(qreal x, qreal dt) {
+        for (int i = 0; i < mCount; i++) {
+            x = std::visit([x, dt](auto & stage) { return stage.process(x, dt); }, mStages[i]);
+        }
+        return x;
+    }
+
+    /**
+     * @brief Forget the history, the next sample restarts every stage
+     */
+    void reset() {
+        for (int i = 0; i < mCount; i++) {
+            std::visit([](auto & stage) { stage.reset(); }, mStages[i]);
+        }
+    }
+
+    int getStageCount() const {
+        return mCount;
+    }
+
+    bool isEmpty() const {
+        return mCount == 0;
+    }
+
+private:
+    std::array<Stage, MAX_STAGES> mStages; //!< stages
+    int mCount = 0; //!< stages in use
+
+    /**
+     * @brief Parse a single stage spec
+     * @param spec: "type:param:param..."
+     * @param stage: parsed stage
+     * @return true if valid
+     */
+    static bool parseStage(QString spec, Stage & stage) {
+        QStringList parts = spec.split(':');
+        QString type = parts.takeFirst().trimmed().toLower();
+
+        QList<qreal> params;
+        for (QString part : parts) {
+            bool ok = false;
+            params.append(part.trimmed().toDouble(&ok));
+            if (!ok) {
+                return false;
+            }
+        }
+
+        if (type == STAGE_LAG && params.size() == 1 && params.at(0) > 0 && params.at(0) <= 1) {
+            stage = LagFilter(params.at(0));
+        } else if (type == STAGE_LOWPASS && (params.size() == 2 || params.size() == 3) &&
+                   params.at(0) > 0 && params.at(1) > 2 * params.at(0)) {
+            qreal q = (params.size() == 3) ? params.at(2) : M_SQRT1_2;
+            if (q <= 0) {
+                return false;
+            }
+            stage = BiquadFilter::lowPass(params.at(0), params.at(1), q);
+        } else if (type == STAGE_BIQUAD && params.size() == 5) {
+            stage = BiquadFilter(params.at(0), params.at(1), params.at(2), params.at(3), params.at(4));
+        } else if (type == STAGE_AVERAGE && params.size() == 1 && params.at(0) >= 1 && params.at(0) <= MAX_TAPS) {
+            stage = FirFilter<MAX_TAPS>::average(params.at(0));
+        } else if (type == STAGE_FIR && params.size() >= 1 && params.size() <= MAX_TAPS) {
+            stage = FirFilter<MAX_TAPS>(params);
+        } else if (type == STAGE_MEDIAN && params.size() == 1 && params.at(0) >= 1 && params.at(0) <= MAX_MEDIAN_WINDOW) {
+            stage = MedianFilter<MAX_MEDIAN_WINDOW>(params.at(0));
+        } else if (type == STAGE_RATE && params.size() == 1 && params.at(0) > 0) {
+            stage = RateLimiter(params.at(0));
+        } else if (type == STAGE_HYSTERESIS && params.size() == 1 && params.at(0) >= 0) {
+            stage = Hysteresis(params.at(0));
+        } else {
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // SENSOR_FILTER_H
@@ -0,0 +1,212 @@
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <chrono>
+
+#include <sensor_utils.h>
+
+/**
+ * @brief Health of one sensor channel.
+ *
+ * Every sample is classified where it's transformed and counted here, from
+ * the thread that reads the sensor. @ref evaluate runs on the health
+ * monitor's thread: it folds the samples since the last evaluation into a
+ * raw status, and the reported status only follows the raw status once it
+ * has held for a while -- FAULT_MSEC to go bad, RECOVER_MSEC to come back
+ * -- so a flaky connector reads as one fault instead of a flickering gauge.
+ * A channel with no samples for its timeout is stale.
+ */
+class SensorHealth {
+public:
+    static constexpr qint64 DEFAULT_TIMEOUT_MSEC = 2000; //!< no samples for this long is stale
+    static constexpr qint64 DEFAULT_FAULT_MSEC = 300; //!< a fault has to hold this long to be reported
+    static constexpr qint64 DEFAULT_RECOVER_MSEC = 2000; //!< ok has to hold this long to clear a fault
+
+    /**
+     * @brief Channel status, also the status of a single sample
+     */
+    enum class Status {
+        OK = 0,
+        STALE, //!< no samples within the timeout
+        OUT_OF_RANGE, //!< not a number, or outside what the sensor can read
+        OPEN, //!< sensor disconnected -- input pulled up to the supply
+        SHORT, //!< sensor shorted to ground
+        BUS_OFF, //!< the bus the channel arrives on is down
+    };
+    static constexpr int NUM_STATUS = (int) Status::BUS_OFF + 1;
+
+    /**
+     * @brief Constructor
+     * @param startMsec: monotonic time the channel starts waiting for samples, see @ref nowMsec
+     */
+    SensorHealth(qint64 startMsec = nowMsec()) :
+        mLastSampleMsec(startMsec), mPendingMsec(startMsec) {
+        for (int i = 0; i < NUM_STATUS; i++) {
+            mCounts[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Set the timing
+     * @param timeoutMsec: no samples for this long is stale
+     * @param faultMsec: a fault has to hold this long to be reported
+     * @param recoverMsec: ok has to hold this long to clear a fault
+     */
+    void setTiming(qint64 timeoutMsec, qint64 faultMsec, qint64 recoverMsec) {
+        mTimeoutMsec = timeoutMsec;
+        mFaultMsec = faultMsec;
+        mRecoverMsec = recoverMsec;
+    }
+
+    qint64 getTimeout() const {
+        return mTimeoutMsec;
+    }
+
+    /**
+     * @brief Count samples -- called for every sample, from the sensor's thread
+     * @param status: sample status
+     * @param msec: monotonic time
+     * @param count: number of samples
+     */
+    void record(Status status, qint64 msec, quint32 count = 1) {
+        mCounts[(int) status].fetch_add(count, std::memory_order_relaxed);
+        mLastSampleMsec.store(msec, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Latch a condition that holds whether or not samples arrive (bus off)
+     * @param status: condition, OK to clear it
+     */
+    void setLatched(Status status) {
+        mLatched.store((int) status, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Fold in the samples since the last call -- monitor thread only
+     * @param msec: monotonic time
+     * @return true if the reported status changed
+     */
+    bool evaluate(qint64 msec) {
+        quint32 counts[NUM_STATUS];
+        quint32 total = 0;
+        for (int i = 0; i < NUM_STATUS; i++) {
+            counts[i] = mCounts[i].exchange(0, std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        Status latched = (Status) mLatched.load(std::memory_order_relaxed);
+        if (latched != Status::OK) {
+            mRaw = latched;
+        } else if (total == 0) {
+            if (msec - mLastSampleMsec.load(std::memory_order_relaxed) > mTimeoutMsec) {
+                mRaw = Status::STALE;
+            }
+        } else if (counts[(int) Status::OK] * 2 >= total) {
+            // mostly good -- the odd bad sample is held over, not reported
+            mRaw = Status::OK;
+        } else {
+            int worst = (int) Status::STALE;
+            for (int i = worst + 1; i < NUM_STATUS; i++) {
+                if (counts[i] > counts[worst]) {
+                    worst = i;
+                }
+            }
+            mRaw = (Status) worst;
+        }
+
+        Status status = getStatus();
+        if (mRaw == status) {
+            mPending = status;
+            mPendingMsec = msec;
+            return false;
+        }
+        if (mRaw != mPending) {
+            mPending = mRaw;
+            mPendingMsec = msec;
+        }
+
+        qint64 hold = (mRaw == Status::OK) ? mRecoverMsec : mFaultMsec;
+        if (msec - mPendingMsec < hold) {
+            return false;
+        }
+        mStatus.store((int) mRaw, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Get the reported status -- safe from any thread
+     * @return status
+     */
+    Status getStatus() const {
+        return (Status) mStatus.load(std::memory_order_relaxed);
+    }
+
+    bool isOk() const {
+        return getStatus() == Status::OK;
+    }
+
+    /**
+     * @brief Classify a sensor voltage, same limits as @ref SensorUtils::isValid.
+     * The sensor is on the low side of a divider, so a disconnected sensor
+     * pulls the input up to the supply.
+     * @param volts: adc voltage
+     * @param vSupply: divider supply voltage
+     * @return sample status
+     */
+    static constexpr Status classifyVoltage(qreal volts, qreal vSupply) {
+        return (volts != volts) ? Status::OUT_OF_RANGE :
+               (volts > vSupply * SensorUtils::SENSOR_MAX_PCT) ? Status::OPEN :
+               (volts < vSupply * (1 - SensorUtils::SENSOR_MAX_PCT)) ? Status::SHORT : Status::OK;
+    }
+
+    /**
+     * @brief Get a status name
+     * @param status: status
+     * @return name, empty for OK
+     */
+    static QString toString(Status status) {
+        switch (status) {
+        case Status::STALE:
+            return "stale";
+        case Status::OUT_OF_RANGE:
+            return "range";
+        case Status::OPEN:
+            return "open";
+        case Status::SHORT:
+            return "short";
+        case Status::BUS_OFF:
+            return "bus off";
+        default:
+            return "";
+        }
+    }
+
+    /**
+     * @brief Monotonic clock shared by all channels
+     * @return milliseconds
+     */
+    static qint64 nowMsec() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    std::atomic<quint32> mCounts[NUM_STATUS]; //!< samples by status since the last evaluation
+    std::atomic<qint64> mLastSampleMsec; //!< newest sample
+    std::atomic<int> mLatched {(int) Status::OK}; //!< condition set outside the samples
+    std::atomic<int> mStatus {(int) Status::OK}; //!< reported status
+
+    qint64 mTimeoutMsec = DEFAULT_TIMEOUT_MSEC; //!< stale timeout
+    qint64 mFaultMsec = DEFAULT_FAULT_MSEC; //!< fault hysteresis
+    qint64 mRecoverMsec = DEFAULT_RECOVER_MSEC; //!< recovery hysteresis
+
+    // monitor thread only
+    Status mRaw = Status::OK; //!< status of the latest evaluation
+    Status mPending = Status::OK; //!< raw status waiting out its hysteresis
+    qint64 mPendingMsec; //!< when the pending status started
+};
+
+#endif // SENSOR_HEALTH_H
@@ -0,0 +1,115 @@
+#ifndef SENSOR_HEALTH_MONITOR_H
+#define SENSOR_HEALTH_MONITOR_H
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <sensor.h>
+
+/**
+ * @brief Evaluates the sensors' health on its own thread, so the timeouts
+ * and hysteresis cost the GUI thread nothing. A sensor's healthChanged is
+ * queued back to the GUI thread, and only on a change.
+ */
+class SensorHealthMonitor : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int INTERVAL_MSEC = 100; //!< evaluation interval
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     */
+    SensorHealthMonitor(QObject * parent) : QObject(parent), mThread(this) {
+    }
+
+    ~SensorHealthMonitor() {
+        stop();
+    }
+
+    /**
+     * @brief Watch a sensor -- only before @ref start
+     * @param sensor: sensor
+     */
+    void addSensor(Sensor * sensor) {
+        if (sensor != nullptr && !mSensors.contains(sensor)) {
+            mSensors.append(sensor);
+        }
+    }
+
+    /**
+     * @brief Start evaluating
+     */
+    void start() {
+        if (mThread.isRunning() || mSensors.isEmpty()) {
+            return;
+        }
+        mStopping = false;
+        mThread.start(QThread::LowPriority);
+    }
+
+    /**
+     * @brief Stop evaluating
+     */
+    void stop() {
+        if (!mThread.isRunning()) {
+            return;
+        }
+
+        mMutex.lock();
+        mStopping = true;
+        mWake.wakeOne();
+        mMutex.unlock();
+
+        mThread.wait();
+    }
+
+private:
+    /**
+     * @brief Background monitor thread
+     */
+    class MonitorThread : public QThread {
+    public:
+        MonitorThread(SensorHealthMonitor * monitor) : mMonitor(monitor) {}
+
+    protected:
+        void run() override {
+            mMonitor->monitorLoop();
+        }
+
+    private:
+        SensorHealthMonitor * mMonitor;
+    };
+
+    QList<Sensor *> mSensors; //!< watched sensors, fixed while running
+    MonitorThread mThread; //!< monitor thread
+
+    QMutex mMutex; //!< guards mStopping
+    QWaitCondition mWake; //!< wakes the monitor to stop
+    bool mStopping = false; //!< monitor should exit
+
+    /**
+     * @brief Monitor thread body
+     */
+    void monitorLoop() {
+        bool stopping = false;
+        while (!stopping) {
+            mMutex.lock();
+            if (!mStopping) {
+                mWake.wait(&mMutex, INTERVAL_MSEC);
+            }
+            stopping = mStopping;
+            mMutex.unlock();
+
+            qint64 now = SensorHealth::nowMsec();
+            for (Sensor * sensor : mSensors) {
+                sensor->updateHealth(now);
+            }
+        }
+    }
+};
+
+#endif // SENSOR_HEALTH_MONITOR_H
@@ -0,0 +1,315 @@
+#ifndef SENSOR_LOG_H
+#define SENSOR_LOG_H
+
+#include <QFile>
+#include <QDataStream>
+#include <QVariant>
+#include <QMap>
+#include <QDebug>
+
+/**
+ * @brief Binary session log format shared by the recorder and the replay source.
+ *
+ * Layout (QDataStream, big endian):
+ *  header:  quint32 magic, quint16 version, qint64 session start (ms since epoch),
+ *           quint8 embedded file count, then {QString name, QByteArray contents} per file
+ *  records: quint8 tag followed by
+ *           TAG_STREAM:        quint8 stream id, QString stream name
+ *           TAG_SAMPLE_REAL:   quint32 delta us, quint8 stream id, quint8 channel, double value
+ *           TAG_SAMPLE_INT:    quint32 delta us, quint8 stream id, quint8 channel, qint32 value
+ *           TAG_SAMPLE_STRING: quint32 delta us, quint8 stream id, quint8 channel, QString value
+ *
+ * Timestamps are stored as the delta from the previous sample so a record is
+ * 11-15 bytes for numeric data.
+ */
+class SensorLog {
+public:
+    static constexpr quint32 MAGIC = 0x56444C47; //!< "VDLG"
+    static constexpr quint16 VERSION = 1; //!< current format version
+    static constexpr int MAX_STREAMS = 256; //!< stream ids are a single byte
+
+    static constexpr char FILE_EXTENSION[] = ".vdlog"; //!< session log extension
+
+    enum RecordTag : quint8 {
+        TAG_STREAM = 0x01,
+        TAG_SAMPLE_REAL = 0x10,
+        TAG_SAMPLE_INT = 0x11,
+        TAG_SAMPLE_STRING = 0x12
+    };
+
+    /**
+     * @struct Sample
+     */
+    typedef struct Sample {
+        qint64 timeUs; //!< time since the start of the session
+        int stream; //!< stream id
+        int channel; //!< source channel
+        QVariant value; //!< value emitted by the source
+    } Sample_t;
+};
+
+/**
+ * @brief Writes a session log
+ */
+class SensorLogWriter {
+public:
+    SensorLogWriter() {}
+
+    /**
+     * @brief Open the log and write the header
+     * @param path: log file path
+     * @param startTimeMs: session start time (ms since epoch)
+     * @param embeddedFiles: files stored in the header (name -> contents)
+     * @return true if the file was opened
+     */
+    bool open(QString path, qint64 startTimeMs, QMap<QString, QByteArray> embeddedFiles = {}) {
+        mFile.setFileName(path);
+        if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qDebug() << "Unable to open sensor log: " << path;
+            return false;
+        }
+
+        mStream.setDevice(&mFile);
+        mStream.setVersion(QDataStream::Qt_5_0);
+        mStream << SensorLog::MAGIC << SensorLog::VERSION << startTimeMs;
+        mStream << (quint8) embeddedFiles.size();
+        for (auto name : embeddedFiles.keys()) {
+            mStream << name << embeddedFiles.value(name);
+        }
+
+        mLastTimeUs = 0;
+        mNextStreamId = 0;
+        return true;
+    }
+
+    bool isOpen() {
+        return mFile.isOpen();
+    }
+
+    /**
+     * @brief Declare a new stream
+     * @param name: stream name (usually the sensor source name)
+     * @return stream id, -1 if no more streams are available
+     */
+    int addStream(QString name) {
+        if (!isOpen() || mNextStreamId >= SensorLog::MAX_STREAMS) {
+            return -1;
+        }
+        int id = mNextStreamId++;
+        mStream << (quint8) SensorLog::TAG_STREAM << (quint8) id << name;
+        return id;
+    }
+
+    /**
+     * @brief Write a single sample
+     * @param stream: stream id from addStream
+     * @param channel: source channel
+     * @param value: sample value
+     * @param timeUs: sample time since the start of the session
+     */
+    void write(int stream, int channel, QVariant value, qint64 timeUs) {
+        if (!isOpen() || stream < 0) {
+            return;
+        }
+
+        quint32 delta = (quint32) qBound<qint64>(0, timeUs - mLastTimeUs, UINT32_MAX);
+        mLastTimeUs += delta;
+
+        switch (static_cast<QMetaType::Type>(value.type())) {
+        case QMetaType::Bool:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::UChar:
+        case QMetaType::Char:
+            mStream << (quint8) SensorLog::TAG_SAMPLE_INT << delta << (quint8) stream << (quint8) channel
+                    << (qint32) value.toInt();
+            break;
+        case QMetaType::QString:
+            mStream << (quint8) SensorLog::TAG_SAMPLE_STRING << delta << (quint8) stream << (quint8) channel
+                    << value.toString();
+            break;
+        default:
+            mStream << (quint8) SensorLog::TAG_SAMPLE_REAL << delta << (quint8) stream << (quint8) channel
+                    << value.toDouble();
+            break;
+        }
+    }
+
+    /**
+     * @brief Push buffered records to the OS
+     */
+    void flush() {
+        if (isOpen()) {
+            mFile.flush();
+        }
+    }
+
+    void close() {
+        if (isOpen()) {
+            mFile.close();
+        }
+    }
+
+private:
+    QFile mFile; //!< log file
+    QDataStream mStream; //!< record serializer
+    qint64 mLastTimeUs = 0; //!< time of the last written sample
+    int mNextStreamId = 0; //!< next free stream id
+};
+
+/**
+ * @brief Reads a session log written by SensorLogWriter
+ */
+class SensorLogReader {
+public:
+    SensorLogReader() {}
+
+    /**
+     * @brief Open the log and read the header
+     * @param path: log file path
+     * @return true if the file is a session log of a supported version
+     */
+    bool open(QString path) {
+        close();
+        mFile.setFileName(path);
+        if (!mFile.open(QIODevice::ReadOnly)) {
+            qDebug() << "Unable to open sensor log: " << path;
+            return false;
+        }
+
+        mStream.setDevice(&mFile);
+        mStream.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0;
+        quint16 version = 0;
+        quint8 fileCount = 0;
+        mStream >> magic >> version >> mStartTimeMs >> fileCount;
+        if (magic != SensorLog::MAGIC || version > SensorLog::VERSION) {
+            qDebug() << "Not a sensor log (or unsupported version): " << path;
+            close();
+            return false;
+        }
+
+        for (int i = 0; i < fileCount; i++) {
+            QString name;
+            QByteArray contents;
+            mStream >> name >> contents;
+            mEmbeddedFiles.insert(name, contents);
+        }
+
+        return mStream.status() == QDataStream::Ok;
+    }
+
+    bool isOpen() {
+        return mFile.isOpen();
+    }
+
+    void close() {
+        if (mFile.isOpen()) {
+            mFile.close();
+        }
+        mStream.resetStatus();
+        mStreams.clear();
+        mEmbeddedFiles.clear();
+        mTimeUs = 0;
+        mStartTimeMs = 0;
+    }
+
+    /**
+     * @brief Get the session start time
+     * @return ms since epoch
+     */
+    qint64 getStartTime() {
+        return mStartTimeMs;
+    }
+
+    /**
+     * @brief Get the files stored in the log header
+     * @return map of file name -> contents
+     */
+    QMap<QString, QByteArray> getEmbeddedFiles() {
+        return mEmbeddedFiles;
+    }
+
+    /**
+     * @brief Get the name of a declared stream
+     * @param stream: stream id
+     * @return stream name, empty if not declared yet
+     */
+    QString getStreamName(int stream) {
+        return mStreams.value(stream, "");
+    }
+
+    /**
+     * @brief Read the next sample
+     * @param sample: sample to fill in
+     * @return false at the end of the log or on a corrupt record
+     */
+    bool readNext(SensorLog::Sample_t & sample) {
+        while (isOpen() && !mStream.atEnd()) {
+            quint8 tag = 0;
+            mStream >> tag;
+
+            if (tag == SensorLog::TAG_STREAM) {
+                quint8 id = 0;
+                QString name;
+                mStream >> id >> name;
+                mStreams.insert(id, name);
+                continue;
+            }
+
+            quint32 delta = 0;
+            quint8 stream = 0;
+            quint8 channel = 0;
+            mStream >> delta >> stream >> channel;
+
+            switch (tag) {
+            case SensorLog::TAG_SAMPLE_REAL: {
+                double value = 0;
+                mStream >> value;
+                sample.value = value;
+                break;
+            }
+            case SensorLog::TAG_SAMPLE_INT: {
+                qint32 value = 0;
+                mStream >> value;
+                sample.value = value;
+                break;
+            }
+            case SensorLog::TAG_SAMPLE_STRING: {
+                QString value;
+                mStream >> value;
+                sample.value = value;
+                break;
+            }
+            default:
+                qDebug() << "Corrupt sensor log record: " << tag;
+                return false;
+            }
+
+            if (mStream.status() != QDataStream::Ok) {
+                // truncated tail (power cut while recording)
+                return false;
+            }
+
+            mTimeUs += delta;
+            sample.timeUs = mTimeUs;
+            sample.stream = stream;
+            sample.channel = channel;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    QFile mFile; //!< log file
+    QDataStream mStream; //!< record deserializer
+    QMap<int, QString> mStreams; //!< stream id -> name
+    QMap<QString, QByteArray> mEmbeddedFiles; //!< files stored in the header
+    qint64 mTimeUs = 0; //!< time of the last read sample
+    qint64 mStartTimeMs = 0; //!< session start time
+};
+
+#endif // SENSOR_LOG_H
@@ -53,7 +53,7 @@ public slots:
         if (channel == getChannel()) {
             qreal volts = data.toReal();
             qreal pressure = mMapSensor->getAbsolutePressure(volts, Config::PressureUnits::PSI) - mPressureAtm;
-            emit sensorDataReady(pressure);
+            publish(pressure);
         }
     }
 
@@ -61,14 +61,23 @@ public slots:
             qreal volts = data.toReal();
 
             qreal value = mNtc->calculateTemp(volts, NTC_INTERNAL_UNITS);
-            qreal vRef = ((AdcSource *)mSource)->getVRef();
-            // Check that we're not shorted to ground or VDD (could be disconnected)
-            if (!SensorUtils::isValid(volts, vRef)) {
-                value = 0;
-            }
+            publish(value, classify(volts, value));
+        }
+    }
 
-            emit sensorDataReady(value);
+protected:
+    /**
+     * @brief Check that we're not shorted to ground or VDD (could be disconnected)
+     * @param raw: adc voltage
+     * @param value: temperature
+     * @return sample status
+     */
+    SensorHealth::Status classify(qreal raw, qreal value) override {
+        SensorHealth::Status status = SensorHealth::classifyVoltage(raw, ((AdcSource *)mSource)->getVRef());
+        if (status == SensorHealth::Status::OK) {
+            return Sensor::classify(raw, value);
         }
+        return status;
     }
 
 private:
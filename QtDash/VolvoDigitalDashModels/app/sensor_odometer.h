@@ -20,7 +20,7 @@ public:
     OdometerSensor(QObject * parent, Config * config,
                    VssSource * source, int channel,
                    Config::OdometerConfig_t * odoConfig = nullptr) :
-           Sensor(parent, config, source, channel) {
+           Sensor(parent, config, source, channel), mVssSource(source) {
 
         // Check if the optional input
         if (odoConfig != nullptr) {
@@ -72,15 +72,12 @@ public slots:
             int pulseCount = data.toInt();
             int diff = pulseCount - mLastPulseCount;
 
-            // calculate distance
-            qreal distance = (qreal)diff / (qreal)mConfig->getVssConfig().pulsePerUnitDistance;
-
-            // convert to odo units
-            qreal distanceConverted = SensorUtils::convertDistance(distance,
-                                                                   mOdoConfig.units,
-                                                                   mConfig->getVssConfig().distanceUnits);
+            // calculate distance -- the source's distance per pulse includes its calibration
+            qreal distance = SensorUtils::convertDistance(diff * mVssSource->getMetersPerPulse(),
+                                                          mOdoConfig.units,
+                                                          Config::DistanceUnits::METER);
             // emit
-            emit sensorDataReady(distanceConverted + mOdoConfig.value);
+            emit sensorDataReady(distance + mOdoConfig.value);
 
             // update internal values and emit write signal
             mLastPulseCount = pulseCount;
@@ -94,6 +91,7 @@ public slots:
     }
 
 private:
+    VssSource * mVssSource; //!< pulse source
     Config::OdometerConfig_t mOdoConfig;
     int mLastPulseCount = 0;
     int mUpdatePulseCount = 0;
@@ -0,0 +1,133 @@
+#ifndef SENSOR_RECORDER_H
+#define SENSOR_RECORDER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTimer>
+
+#include <config.h>
+#include <sensor_log.h>
+#include <sensor_source.h>
+
+/**
+ * @brief Records every sample emitted by the dash sensor sources to a session
+ * log so the drive can be replayed on the desktop with SensorReplay.
+ */
+class SensorRecorder : public QObject {
+    Q_OBJECT
+public:
+    static constexpr char FILE_PREFIX[] = "session_"; //!< session log file name prefix
+    static constexpr int FLUSH_INTERVAL_MSEC = 1000; //!< how often buffered records are pushed to disk
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param config: dash config -- the ini files it was loaded from are embedded in the log
+     */
+    SensorRecorder(QObject * parent, Config * config) :
+        QObject(parent), mConfig(config) {
+        mFlushTimer.setInterval(FLUSH_INTERVAL_MSEC);
+        QObject::connect(&mFlushTimer, &QTimer::timeout, [=]() {
+            mWriter.flush();
+        });
+    }
+
+    ~SensorRecorder() {
+        stop();
+    }
+
+    /**
+     * @brief Open a new session log in the configured directory
+     * @return true if recording
+     */
+    bool start() {
+        QDir dir(mConfig->getRecorderConfig().path);
+        if (!dir.exists() && !dir.mkpath(".")) {
+            qDebug() << "Unable to create recorder directory: " << dir.path();
+            return false;
+        }
+
+        // embed the config so the replay runs the exact same transforms
+        QMap<QString, QByteArray> files;
+        for (QString path : mConfig->getConfigFilePaths()) {
+            QFile file(path);
+            if (file.open(QIODevice::ReadOnly)) {
+                files.insert(QFileInfo(path).fileName(), file.readAll());
+            }
+        }
+
+        QDateTime now = QDateTime::currentDateTime();
+        QString path = dir.filePath(
+                    FILE_PREFIX + now.toString("yyyyMMdd-hhmmss") + SensorLog::FILE_EXTENSION);
+        if (!mWriter.open(path, now.toMSecsSinceEpoch(), files)) {
+            return false;
+        }
+
+        for (QString name : mStreams.keys()) {
+            mStreams.insert(name, mWriter.addStream(name));
+        }
+
+        qDebug() << "Recording sensor session to: " << path;
+        mClock.start();
+        mFlushTimer.start();
+        return true;
+    }
+
+    /**
+     * @brief Flush and close the session log
+     */
+    void stop() {
+        mFlushTimer.stop();
+        mWriter.close();
+    }
+
+    bool isRecording() {
+        return mWriter.isOpen();
+    }
+
+    /**
+     * @brief Register a named stream that is fed through record()
+     * @param name: stream name
+     * @return stream name to pass to record()
+     */
+    QString addStream(QString name) {
+        mStreams.insert(name, mWriter.addStream(name));
+        return name;
+    }
+
+    /**
+     * @brief Record everything the sensor source emits
+     * @param source: sensor source -- replayed by the source with the same name
+     */
+    void addSource(SensorSource * source) {
+        QString stream = addStream(source->getName());
+        QObject::connect(source, &SensorSource::dataReady, this, [=](QVariant data, int channel) {
+            record(stream, channel, data);
+        });
+    }
+
+public slots:
+    /**
+     * @brief Record a sample with the current session time
+     * @param stream: stream name
+     * @param channel: channel
+     * @param value: sample value
+     */
+    void record(QString stream, int channel, QVariant value) {
+        if (isRecording()) {
+            mWriter.write(mStreams.value(stream, -1), channel, value, mClock.nsecsElapsed() / 1000);
+        }
+    }
+
+private:
+    Config * mConfig; //!< dash config
+    SensorLogWriter mWriter; //!< session log writer
+    QMap<QString, int> mStreams; //!< stream name -> log stream id
+    QElapsedTimer mClock; //!< session clock
+    QTimer mFlushTimer; //!< periodic flush timer
+};
+
+#endif // SENSOR_RECORDER_H
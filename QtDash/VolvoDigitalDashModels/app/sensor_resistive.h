@@ -22,9 +22,11 @@ public:
                     AdcSource * source, int channel,
                     Config::ResistiveSensorConfig_t sensorConfig) :
         Sensor(parent, config, source, channel), mSensorConfig(sensorConfig) {
-        // calculate curve
-        mSensorConfig.coeff = SensorUtils::polynomialRegression(
-                    mSensorConfig.x, mSensorConfig.y, mSensorConfig.order);
+        // calculate curve unless the config cache already has
+        if (mSensorConfig.coeff.size() != mSensorConfig.order + 1) {
+            mSensorConfig.coeff = SensorUtils::polynomialRegression(
+                        mSensorConfig.x, mSensorConfig.y, mSensorConfig.order);
+        }
         // use vref from adc source
         mSensorConfig.vSupply = ((AdcSource *)mSource)->getVRef();
     }
@@ -48,28 +50,28 @@ public slots:
             qreal value = SensorUtils::polynomialValue(
                         resistance, mSensorConfig.coeff);
 
-            // check for nan
-            if (value != value) {
-                value = 0;
-            }
-
-            // Check that we're not shorted to ground or VDD (could be disconnected)
-            qreal vRef = ((AdcSource *)mSource)->getVRef();
-            if (!SensorUtils::isValid(volts, vRef)) {
-                value = 0;
-            }
-
-            value = (mSensorConfig.lag * value) + (1 - mSensorConfig.lag) * mPreviousValue;
-
-            mPreviousValue = value;
+            // the config's lag is the first stage of the filter chain
+            publish(value, classify(volts, value));
+        }
+    }
 
-            emit sensorDataReady(value);
+protected:
+    /**
+     * @brief Check that we're not shorted to ground or VDD (could be disconnected)
+     * @param raw: adc voltage
+     * @param value: transformed value
+     * @return sample status
+     */
+    SensorHealth::Status classify(qreal raw, qreal value) override {
+        SensorHealth::Status status = SensorHealth::classifyVoltage(raw, ((AdcSource *)mSource)->getVRef());
+        if (status == SensorHealth::Status::OK) {
+            return Sensor::classify(raw, value);
         }
+        return status;
     }
 
 private:
     Config::ResistiveSensorConfig_t mSensorConfig; //!< resistive sensor config
-    qreal mPreviousValue = 0; //!< previous value (used for filtering)
 };
 
 #endif // SENSOR_RESISTIVE_H
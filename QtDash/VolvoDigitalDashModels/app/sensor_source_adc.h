@@ -1,11 +1,14 @@
 #ifndef SENSOR_SOURCE_ADC_H
 #define SENSOR_SOURCE_ADC_H
 
+#include <QMutex>
+#include <QMutexLocker>
 #include <sensor_source.h>
 #include <adc.h>
 
 /**
- * @brief The AdcSource class
+ * @brief The AdcSource class -- channels can be read from the acquisition
+ * thread and the GUI thread at once
  */
 class AdcSource : public SensorSource {
     Q_OBJECT
@@ -75,12 +78,18 @@ public slots:
      * @param channel: adc channel
      */
     void update(int channel) override {
-        qreal volts = mAdc->readValue(channel);
+        qreal volts = 0;
+        {
+            // the reference measurement is shared by every channel
+            QMutexLocker locker(&mMutex);
+            volts = mAdc->readValue(channel);
+        }
         emit dataReady(volts, channel);
     }
 
 private:
     Adc * mAdc; //!< ADC object
+    QMutex mMutex; //!< serializes reads
 };
 
 #endif // SENSOR_SOURCE_ADC_H
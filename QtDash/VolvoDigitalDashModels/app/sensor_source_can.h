@@ -94,10 +94,21 @@ public:
                     qDebug() << "Error String: " << errorString;
                 } else {
                     qDebug() << "Attempting connection";
+                    // bus off arrives as an error frame
+                    mDevice->setConfigurationParameter(
+                                QCanBusDevice::ErrorFilterKey,
+                                QVariant::fromValue(QCanBusFrame::FrameErrors(QCanBusFrame::BusOffError)));
                     mDevice->connectDevice();
 
                     QObject::connect(mDevice, &QCanBusDevice::framesReceived,
                                      this, &SensorSource::updateAll);
+                    QObject::connect(mDevice, &QCanBusDevice::errorOccurred,
+                                     [=](QCanBusDevice::CanBusError error) {
+                        qDebug() << "CAN error: " << error << mDevice->errorString();
+                        if (error == QCanBusDevice::ConnectionError) {
+                            setBusOff(true);
+                        }
+                    });
                 }
             }
         }
@@ -185,13 +196,30 @@ public:
         emit stop();
     }
 
+    bool isBusOff() {
+        return mBusOff;
+    }
+
 signals:
     void stop();
 
+    /**
+     * @brief Emitted when the bus goes down or comes back
+     * @param busOff: true if the bus is down
+     */
+    void busStateChanged(bool busOff);
+
 public slots:
     void updateAll() override {
         while(mDevice->framesAvailable()) {
             QCanBusFrame frame = mDevice->readFrame();
+            if (frame.frameType() == QCanBusFrame::ErrorFrame) {
+                if (frame.error() & QCanBusFrame::BusOffError) {
+                    setBusOff(true);
+                }
+                continue;
+            }
+            setBusOff(false);
 //            /*** test frame start ***/
 //            qDebug() << "Frame type: " << frame.frameType();
 //            qDebug() << "*** Begin Frame ID: " << frame.frameId();
@@ -226,6 +254,19 @@ private:
     QMap<int, QString> mCanMap;
     QCanBusDevice * mDevice;
     int mOtherChannels;
+    bool mBusOff = false; //!< bus is down
+
+    /**
+     * @brief Track the bus state
+     * @param busOff: true if the bus is down
+     */
+    void setBusOff(bool busOff) {
+        if (busOff != mBusOff) {
+            mBusOff = busOff;
+            qDebug() << "CAN bus" << (busOff ? "off" : "on");
+            emit busStateChanged(busOff);
+        }
+    }
 };
 
 #endif // SENSOR_SOURCE_CAN_H
@@ -0,0 +1,189 @@
+#ifndef SENSOR_SOURCE_DERIVED_H
+#define SENSOR_SOURCE_DERIVED_H
+
+#include <QVector>
+#include <QtMath>
+
+#include <sensor.h>
+#include <channel_expression.h>
+
+/**
+ * @brief Derived channel source -- each channel is an expression over the
+ * latest samples of other sensors (see @ref ChannelExpression), e.g. fuel
+ * economy from injector pulse width and speed.
+ *
+ * Inputs are updated at their sensors' full sample rate, a channel is
+ * evaluated when it is updated. A channel can read the channels added before
+ * it, and isn't emitted until every input it reads has a sample.
+ *
+ * An input whose sensor reports a fault has no value until the sensor
+ * recovers and samples again, and one without a sample for the timeout is
+ * stale. The channels reading either emit NaN meanwhile, so their own health
+ * faults and a fallback can take over.
+ */
+class DerivedSource : public SensorSource {
+    Q_OBJECT
+public:
+    /**
+     * @brief DerivedSource constructor
+     * @param parent: parent qobject
+     * @param config: dash config
+     * @param name: source name
+     */
+    DerivedSource(QObject * parent, Config * config, QString name = "derived") :
+        SensorSource(parent, config, name) {
+    }
+
+    bool init() override {
+        return true;
+    }
+
+    int getNumChannels() override {
+        return mChannels.size();
+    }
+
+    QString getUnits(int channel) override {
+        if (channel < 0 || channel >= mChannels.size()) {
+            return "";
+        }
+        return mChannels.at(channel).config.units;
+    }
+
+    /**
+     * @brief Get a channel's config
+     * @param channel: source channel
+     * @return config, empty if there's no such channel
+     */
+    Config::DerivedChannelConfig_t getChannelConfig(int channel) {
+        if (channel < 0 || channel >= mChannels.size()) {
+            return Config::DerivedChannelConfig_t();
+        }
+        return mChannels.at(channel).config;
+    }
+
+    /**
+     * @brief Set how long an input can go without a sample
+     * @param timeoutMsec: an older input is stale, 0 never is
+     */
+    void setTimeout(qint64 timeoutMsec) {
+        mTimeoutMsec = timeoutMsec;
+    }
+
+    /**
+     * @brief Add a sensor expressions can read
+     * @param name: channel name in expressions
+     * @param sensor: sensor, its filtered full rate samples and its health are read
+     */
+    void addInput(QString name, Sensor * sensor) {
+        int index = addInputSlot(name);
+        QObject::connect(sensor, &Sensor::sampleReady, this, [this, index](qreal value) {
+            if (!mFaulted.at(index)) {
+                mInputs[index] = value;
+                mSampleMsec[index] = SensorHealth::nowMsec();
+            }
+        });
+        QObject::connect(sensor, &Sensor::healthChanged, this, [this, index](int status) {
+            mFaulted[index] = (SensorHealth::Status) status != SensorHealth::Status::OK;
+            if (mFaulted.at(index)) {
+                mInputs[index] = qQNaN();
+            }
+        });
+    }
+
+    /**
+     * @brief Compile a derived channel
+     * @param config: channel config
+     * @return source channel, -1 if the expression didn't compile
+     */
+    int addChannel(Config::DerivedChannelConfig_t config) {
+        Channel_t channel;
+        channel.config = config;
+        if (!channel.expression.compile(config.expression, mInputNames)) {
+            qDebug() << "Invalid derived channel " << config.name << ": "
+                     << channel.expression.getError();
+            return -1;
+        }
+        channel.inputs = channel.expression.getInputs();
+
+        // later channels can read this one
+        channel.output = addInputSlot(config.name);
+        mChannels.append(channel);
+        return mChannels.size() - 1;
+    }
+
+public slots:
+    void updateAll() override {
+        for (int i = 0; i < mChannels.size(); i++) {
+            update(i);
+        }
+    }
+
+    /**
+     * @brief Evaluate a channel and emit its value
+     * @param channel: source channel
+     */
+    void update(int channel) override {
+        if (channel < 0 || channel >= mChannels.size()) {
+            return;
+        }
+
+        const Channel_t & c = mChannels.at(channel);
+        qint64 staleMsec = mTimeoutMsec > 0 ? SensorHealth::nowMsec() - mTimeoutMsec : -1;
+        bool waiting = false;
+        for (int input : c.inputs) {
+            bool stale = mSampleMsec.at(input) >= 0 && mSampleMsec.at(input) < staleMsec;
+            if (mFaulted.at(input) || stale) {
+                // a faulted or stale input (or a channel reading one) faults this channel too
+                mInputs[c.output] = qQNaN();
+                mFaulted[c.output] = true;
+                emit dataReady(qQNaN(), channel);
+                return;
+            }
+            waiting |= qIsNaN(mInputs.at(input));
+        }
+        mFaulted[c.output] = false;
+        if (waiting) {
+            return;
+        }
+
+        // division by zero (no fuel flow, standing still) isn't shown
+        qreal value = c.expression.evaluate(mInputs.constData());
+        if (qIsFinite(value)) {
+            mInputs[c.output] = value;
+            emit dataReady(value, channel);
+        }
+    }
+
+private:
+    /**
+     * @brief A compiled derived channel
+     */
+    typedef struct Channel {
+        Config::DerivedChannelConfig_t config; //!< channel config
+        ChannelExpression expression; //!< compiled expression
+        QVector<int> inputs; //!< inputs the expression reads
+        int output = -1; //!< input index other channels read this one from
+    } Channel_t;
+
+    QStringList mInputNames; //!< input names, in expression variable order
+    QVector<qreal> mInputs; //!< latest input values, NaN until the first sample
+    QVector<bool> mFaulted; //!< inputs whose sensor, or a channel's input, reports a fault
+    QVector<qint64> mSampleMsec; //!< time of each sensor input's latest sample, -1 for none and for channels
+    qint64 mTimeoutMsec = 0; //!< sensor inputs older than this are stale, 0 for never
+    QVector<Channel_t> mChannels; //!< derived channels
+
+    /**
+     * @brief Add an input slot
+     * @param name: channel name in expressions
+     * @return input index
+     */
+    int addInputSlot(QString name) {
+        mInputNames.append(name);
+        mInputs.append(qQNaN());
+        mFaulted.append(false);
+        mSampleMsec.append(-1);
+        return mInputs.size() - 1;
+    }
+};
+
+#endif // SENSOR_SOURCE_DERIVED_H
@@ -10,11 +10,10 @@
 #include <QGeoPositionInfoSource>
 #include <QVariantMap>
 #include <cmath>
-#include <QProcess>
 #include <QDateTime>
-#include <QTimeZone>
 #include <QtMath>
 #include <sensor_utils.h>
+#include <ubx_parser.h>
 
 class GpsSource : public SensorSource {
     Q_OBJECT
@@ -38,9 +37,13 @@ public:
         SPEED_METERS_PER_SEC,
         SPEED_KILOMETERS_PER_HOUR,
         HEADING_DEGREES,
-        HEADING_CARDINAL
+        HEADING_CARDINAL,
+        FIX_TYPE,
+        NUM_SATELLITES,
     };
 
+    static constexpr int MIN_MEASUREMENT_MSEC = 40; //!< fastest u-blox navigation rate, 25 Hz
+
     GpsSource(QObject * parent, Config * config, QString name = "gps") :
         SensorSource(parent, config, name) {
         mLastData.insert(GpsDataChannel::HEADING_CARDINAL, "");
@@ -48,11 +51,13 @@ public:
         mLastData.insert(GpsDataChannel::SPEED_METERS_PER_SEC, 0.0);
         mLastData.insert(GpsDataChannel::SPEED_MILES_PER_HOUR, 0.0);
         mLastData.insert(GpsDataChannel::SPEED_KILOMETERS_PER_HOUR, 0.0);
+        mLastData.insert(GpsDataChannel::FIX_TYPE, 0);
+        mLastData.insert(GpsDataChannel::NUM_SATELLITES, 0);
 
         // serial port
+        Config::GpsConfig_t gpsConfig = config->getGpsConfig();
         QVariantMap params;
-        // TODO: get port from config? Find ACMx port?
-        QString port = "/dev/ttyACM0";
+        QString port = gpsConfig.port;
         params["serialnmea.serial_port"] = port;
         QStringList sources = QGeoPositionInfoSource::availableSources();
 
@@ -67,9 +72,11 @@ public:
         serialPort->setDataBits(QSerialPort::Data8);
         serialPort->setParity(QSerialPort::NoParity);
         serialPort->setStopBits(QSerialPort::OneStop);
-        serialPort->open(QIODevice::ReadOnly);
+        serialPort->open(gpsConfig.useUbx ? QIODevice::ReadWrite : QIODevice::ReadOnly);
 
-        if(serialPort->isOpen()) {
+        if (serialPort->isOpen() && gpsConfig.useUbx) {
+            initUbx(serialPort, gpsConfig.rateHz);
+        } else if(serialPort->isOpen()) {
             QNmeaPositionInfoSource *source = new QNmeaPositionInfoSource(QNmeaPositionInfoSource::RealTimeMode);
             source->setDevice(serialPort);
 
@@ -93,7 +100,7 @@ public:
     }
 
     int getNumChannels() override {
-        return 5;
+        return 7;
     }
 
     QString getUnits(int channel) override {
@@ -108,6 +115,10 @@ public:
             return "mph";
         case GpsDataChannel::SPEED_KILOMETERS_PER_HOUR:
             return "kph";
+        case GpsDataChannel::FIX_TYPE:
+            return "fix";
+        case GpsDataChannel::NUM_SATELLITES:
+            return "satellites";
         default:
             return "";
         }
@@ -120,6 +131,16 @@ public:
 signals:
     void stop();
 
+    /**
+     * @brief Emitted for every position fix
+     * @param nsec: fix time (UTC, from the receiver)
+     * @param latitude: latitude (degrees)
+     * @param longitude: longitude (degrees)
+     * @param speed: ground speed (m/s)
+     * @param speedAccuracy: speed accuracy estimate (m/s), NaN if the receiver doesn't report it
+     */
+    void fixReady(qint64 nsec, qreal latitude, qreal longitude, qreal speed, qreal speedAccuracy);
+
 public slots:
     void updateAll() override {
         // add the last data points
@@ -133,39 +154,74 @@ public slots:
     }
 
     void updatePosition(QGeoPositionInfo data) {
-        if (data.hasAttribute(QGeoPositionInfo::Direction)) {
-            qreal heading = data.attribute(QGeoPositionInfo::Direction);
+        qreal heading = data.hasAttribute(QGeoPositionInfo::Direction) ?
+                    data.attribute(QGeoPositionInfo::Direction) : qQNaN();
+        qint64 nsec = data.timestamp().isValid() ? data.timestamp().toMSecsSinceEpoch() * 1000000 : 0;
 
-#ifdef RASPBERRY_PI
-            // setting time -- this is gross
-            if (!mTimeSet) {
-                auto ts = data.timestamp();
-
-                auto coord = data.coordinate();
-                auto tz = guessAtTheTimeZone(coord);
-                //ts.setTimeZone(tz);
-
-                std::cout << "Timezone? maybe?: " << tz.abbreviation(ts).toStdString() << std::endl;
+        publishFix(nsec, data.coordinate(),
+                   data.attribute(QGeoPositionInfo::GroundSpeed), heading, qQNaN());
+    }
 
-                QString pg = "/bin/date";
-                QStringList args;
-                args << "-s" << ts.toString("yyyy-MM-dd hh:mm:ss") << "-u";
+    /**
+     * @brief Publish a UBX NAV-PVT solution
+     * @param pvt: solution
+     */
+    void updatePvt(const UbxParser::NavPvt_t & pvt) {
+        emit dataReady((int) pvt.fixType, (int) GpsDataChannel::FIX_TYPE);
+        emit dataReady(pvt.numSatellites, (int) GpsDataChannel::NUM_SATELLITES);
+        mLastData.insert(GpsDataChannel::FIX_TYPE, (int) pvt.fixType);
+        mLastData.insert(GpsDataChannel::NUM_SATELLITES, pvt.numSatellites);
+
+        if (!pvt.fixOk) {
+            return;
+        }
 
-                QProcess *proc = new QProcess(this);
+        publishFix(pvt.utcNsec, QGeoCoordinate(pvt.latitude, pvt.longitude, pvt.altitude),
+                   pvt.speed, pvt.heading, pvt.speedAccuracy);
+    }
 
-                QObject::connect(proc, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-                                 [=](int exitCode, QProcess::ExitStatus exitStatus) {
-                    (void)exitStatus;
-                    std::cout << "finished date set: " << exitCode << std::endl;
-                });
 
-                proc->startDetached(pg, args);
-                mTimeSet = true;
+private:
+    QMap<GpsDataChannel, QVariant> mLastData;
+    UbxParser mUbxParser; //!< UBX frame parser
+    QByteArray mUbxBuffer; //!< received bytes not parsed yet
 
-                std::cout << "Set Time to: " << ts.toString("yyyy-MM-dd hh:mm:ss").toStdString() << std::endl;
-            }
-#endif
+    /**
+     * @brief Configure a u-blox receiver for NAV-PVT and read it. The config
+     * isn't saved, the receiver is back to NMEA after a power cycle.
+     * @param serialPort: open receiver port
+     * @param rateHz: navigation rate -- M8 receivers do up to 10 Hz with
+     * several constellations, M9 up to 25 Hz
+     */
+    void initUbx(QSerialPort * serialPort, qreal rateHz) {
+        int measurementMsec = qMax(MIN_MEASUREMENT_MSEC, qRound(1000.0 / qMax(rateHz, 1.0)));
+        serialPort->write(UbxParser::cfgPrtUsb(UbxParser::PROTO_UBX | UbxParser::PROTO_NMEA, UbxParser::PROTO_UBX));
+        serialPort->write(UbxParser::cfgMsg(UbxParser::CLASS_NAV, UbxParser::NAV_PVT, 1));
+        serialPort->write(UbxParser::cfgRate(measurementMsec));
+        std::cout << "UBX NAV-PVT every " << measurementMsec << " msec" << std::endl;
+
+        connect(serialPort, &QSerialPort::readyRead, this, [this, serialPort]() {
+            mUbxBuffer.append(serialPort->readAll());
+            int used = mUbxParser.parse(mUbxBuffer.constData(), mUbxBuffer.size(),
+                                        [this](const UbxParser::NavPvt_t & pvt) {
+                updatePvt(pvt);
+            });
+            mUbxBuffer.remove(0, used);
+        });
+
+        QObject::connect(this, &GpsSource::stop, serialPort, &QSerialPort::close);
+    }
 
+    /**
+     * @brief Publish a position fix
+     * @param nsec: fix time in nanoseconds since the epoch, 0 if unknown
+     * @param coordinate: position
+     * @param speed: ground speed (m/s)
+     * @param heading: heading (degrees), NaN if unknown
+     * @param speedAccuracy: speed accuracy estimate (m/s), NaN if unknown
+     */
+    void publishFix(qint64 nsec, QGeoCoordinate coordinate, qreal speed, qreal heading, qreal speedAccuracy) {
+        if (!qIsNaN(heading)) {
             QString headingString = headingToDirectionString(heading);
             //std::cout << "heading: " << heading << " (" << headingString.toStdString() << ")" << std::endl;
 
@@ -175,7 +231,6 @@ public slots:
             mLastData.insert(GpsDataChannel::HEADING_DEGREES, heading);
             mLastData.insert(GpsDataChannel::HEADING_CARDINAL, headingString);
         }
-        double speed = data.attribute(QGeoPositionInfo::GroundSpeed);
 
         qreal speedMph = SensorUtils::convert(speed, Config::UNITS_MPH, Config::UNITS_METERS_PER_SECOND);
         qreal speedKph = SensorUtils::convert(speed, Config::UNITS_KPH, Config::UNITS_METERS_PER_SECOND);
@@ -189,22 +244,14 @@ public slots:
         emit dataReady(speed, (int) GpsDataChannel::SPEED_METERS_PER_SEC);
         emit dataReady(speedMph, (int) GpsDataChannel::SPEED_MILES_PER_HOUR);
         emit dataReady(speedKph, (int) GpsDataChannel::SPEED_KILOMETERS_PER_HOUR);
-    }
-
 
-private:
-    bool mTimeSet = false;
-    QMap<GpsDataChannel, QVariant> mLastData;
-
-    QTimeZone guessAtTheTimeZone(QGeoCoordinate coord) {
-        // this is more gross
-        std::cout << "Current longitude: " << coord.longitude() << std::endl;
-
-        int offset = qRound(coord.longitude() / 15.0) * 3600;
-        return QTimeZone(offset);
+        if (coordinate.isValid() && nsec != 0) {
+            emit fixReady(nsec, coordinate.latitude(), coordinate.longitude(), speed, speedAccuracy);
+        }
     }
 
 
+
     /**
      * @brief Convert heading angle to cardinal direction (enum)
      * @param angle: heading direction retrieved from QGeoPositionInfo structure
@@ -0,0 +1,210 @@
+#ifndef SENSOR_SOURCE_REPLAY_H
+#define SENSOR_SOURCE_REPLAY_H
+
+#include <QObject>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTimer>
+#include <functional>
+#include <type_traits>
+
+#include <config.h>
+#include <sensor_log.h>
+#include <sensor_source.h>
+#include <sensor_source_gps.h>
+
+/**
+ * @brief Sensor source that takes its data from a recorded session instead of
+ * the hardware. Wraps the real source type so the sensors built on top of it
+ * (which take typed source pointers) see the same channels, units and config.
+ * Polling is a no-op -- samples arrive at their recorded times from SensorReplay.
+ */
+template <class T>
+class ReplaySource : public T {
+public:
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param config: dash config
+     */
+    ReplaySource(QObject * parent, Config * config) :
+        T(parent, config) {
+        if constexpr (std::is_base_of<GpsSource, T>::value) {
+            // don't mix fixes from an attached receiver into the replay
+            this->close();
+        }
+    }
+
+    /**
+     * @brief Emit a recorded sample
+     * @param data: sample value
+     * @param channel: source channel
+     */
+    void replay(QVariant data, int channel) {
+        emit this->dataReady(data, channel);
+    }
+
+    void updateAll() override {}
+
+    void update(int channel) override {
+        (void) channel;
+    }
+};
+
+/**
+ * @brief Plays a session log back into ReplaySources (and any other registered
+ * stream handlers) at real time or a multiple of it.
+ */
+class SensorReplay : public QObject {
+    Q_OBJECT
+public:
+    static constexpr char EXTRACT_DIR[] = "volvo-dash-replay"; //!< temp dir the embedded config is written to
+
+    typedef std::function<void(QVariant, int)> StreamHandler;
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param path: session log path
+     * @param speed: playback speed (1.0 = real time)
+     * @param loop: restart from the beginning at the end of the log
+     */
+    SensorReplay(QObject * parent, QString path, qreal speed = 1.0, bool loop = false) :
+        QObject(parent), mPath(path), mSpeed(speed > 0 ? speed : 1.0), mLoop(loop) {
+        mTimer.setSingleShot(true);
+        mTimer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&mTimer, &QTimer::timeout, this, &SensorReplay::step);
+    }
+
+    /**
+     * @brief Write the config files embedded in a session log to a temp dir
+     * @param path: session log path
+     * @return config, gauge, odometer and can config paths -- defaults for anything not embedded
+     */
+    static QStringList configPaths(QString path) {
+        QStringList paths = {Config::DEFAULT_CONFIG_PATH, Config::DEFAULT_GAUGE_CONFIG_PATH,
+                             Config::DEFAULT_ODO_CONFIG_PATH, Config::DEFAULT_CAN_CONFIG_PATH};
+        if (path.isEmpty()) {
+            return paths;
+        }
+
+        SensorLogReader reader;
+        if (!reader.open(path)) {
+            return paths;
+        }
+
+        QDir dir(QDir::temp().filePath(EXTRACT_DIR));
+        dir.mkpath(".");
+
+        QMap<QString, QByteArray> files = reader.getEmbeddedFiles();
+        for (int i = 0; i < paths.size(); i++) {
+            QString name = QFileInfo(paths.at(i)).fileName();
+            if (files.contains(name)) {
+                QFile file(dir.filePath(name));
+                if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                    file.write(files.value(name));
+                    paths.replace(i, file.fileName());
+                }
+            }
+        }
+        return paths;
+    }
+
+    /**
+     * @brief Route a stream to a handler
+     * @param name: stream name
+     * @param handler: called with (value, channel) for every sample
+     */
+    void addStreamHandler(QString name, StreamHandler handler) {
+        mHandlers.insert(name, handler);
+    }
+
+    /**
+     * @brief Route the stream recorded from the source of the same name
+     * @param source: replay source
+     */
+    template <class T>
+    void addSource(ReplaySource<T> * source) {
+        addStreamHandler(source->getName(), [source](QVariant data, int channel) {
+            source->replay(data, channel);
+        });
+    }
+
+signals:
+    void finished();
+
+public slots:
+    /**
+     * @brief Start playback from the beginning of the log
+     * @return true if the log could be opened
+     */
+    bool start() {
+        if (!rewind()) {
+            return false;
+        }
+        mTimer.start(0);
+        return true;
+    }
+
+    void stop() {
+        mTimer.stop();
+        mReader.close();
+    }
+
+private slots:
+    /**
+     * @brief Emit every sample that is due and schedule the next one
+     */
+    void step() {
+        qint64 now = (qint64)((mClock.nsecsElapsed() / 1000) * mSpeed);
+
+        while (mPending && mNext.timeUs <= now) {
+            dispatch(mNext);
+            mPending = mReader.readNext(mNext);
+        }
+
+        if (!mPending) {
+            if (mLoop && rewind()) {
+                mTimer.start(0);
+            } else {
+                qDebug() << "Replay finished: " << mPath;
+                mReader.close();
+                emit finished();
+            }
+            return;
+        }
+
+        // round up so the timer never fires before the sample is due
+        mTimer.start((int)((mNext.timeUs - now) / mSpeed / 1000) + 1);
+    }
+
+private:
+    QString mPath; //!< session log path
+    qreal mSpeed; //!< playback speed
+    bool mLoop; //!< loop playback
+    SensorLogReader mReader; //!< session log reader
+    QMap<QString, StreamHandler> mHandlers; //!< stream name -> handler
+    QTimer mTimer; //!< next sample timer
+    QElapsedTimer mClock; //!< playback clock
+    SensorLog::Sample_t mNext; //!< next sample to dispatch
+    bool mPending = false; //!< mNext holds a sample
+
+    bool rewind() {
+        if (!mReader.open(mPath)) {
+            return false;
+        }
+        mPending = mReader.readNext(mNext);
+        mClock.start();
+        return true;
+    }
+
+    void dispatch(const SensorLog::Sample_t & sample) {
+        auto handler = mHandlers.find(mReader.getStreamName(sample.stream));
+        if (handler != mHandlers.end()) {
+            (*handler)(sample.value, sample.channel);
+        }
+    }
+};
+
+#endif // SENSOR_SOURCE_REPLAY_H
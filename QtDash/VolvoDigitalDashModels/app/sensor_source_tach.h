@@ -61,6 +61,14 @@ public:
         }
     }
 
+signals:
+    /**
+     * @brief Emitted for every new pulse, see @ref updateEdges
+     * @param nsec: CLOCK_MONOTONIC time of the pulse
+     * @param count: pulse count
+     */
+    void pulseEdge(qint64 nsec, quint32 count);
+
 public slots:
     /**
      * @brief update all channel and emit dataReady
@@ -85,8 +93,22 @@ public slots:
         }
     }
 
+    /**
+     * @brief Emit pulseEdge for the pulses since the last call, with their
+     * kernel timestamps -- the shift light predicts from these, not the poll
+     */
+    void updateEdges() {
+        for (const PulseCounter::PulseEdge_t & edge : mTachInput.getEdges()) {
+            if (edge.nsec > mLastEdgeNsec) {
+                mLastEdgeNsec = edge.nsec;
+                emit pulseEdge(edge.nsec, edge.count);
+            }
+        }
+    }
+
 private:
     TachInput mTachInput; //!< internal tach input
+    qint64 mLastEdgeNsec = 0; //!< newest pulse emitted
 
     /**
      * @brief get value
@@ -67,6 +67,34 @@ public:
         }
     }
 
+    /**
+     * @brief Get the distance between pulses
+     * @return meters per pulse
+     */
+    qreal getMetersPerPulse() {
+        return mVssInput.getMetersPerPulse();
+    }
+
+    /**
+     * @brief Set the calibration factor, see @ref SpeedFusion
+     * @param calibration: true distance over configured distance
+     */
+    void setCalibration(qreal calibration) {
+        mVssInput.setCalibration(calibration);
+    }
+
+    qreal getCalibration() {
+        return mVssInput.getCalibration();
+    }
+
+signals:
+    /**
+     * @brief Emitted for every new pulse, see @ref updateEdges
+     * @param nsec: CLOCK_MONOTONIC time of the pulse
+     * @param count: pulse count
+     */
+    void pulseEdge(qint64 nsec, quint32 count);
+
 public slots:
     /**
      * @brief Update all channels and emit results
@@ -94,8 +122,22 @@ public slots:
         }
     }
 
+    /**
+     * @brief Emit pulseEdge for the pulses since the last call, with their
+     * kernel timestamps -- precise timing doesn't depend on the poll rate
+     */
+    void updateEdges() {
+        for (const PulseCounter::PulseEdge_t & edge : mVssInput.getEdges()) {
+            if (edge.nsec > mLastEdgeNsec) {
+                mLastEdgeNsec = edge.nsec;
+                emit pulseEdge(edge.nsec, edge.count);
+            }
+        }
+    }
+
 private:
     VssInput mVssInput; //!< VSS input
+    qint64 mLastEdgeNsec = 0; //!< newest pulse emitted
 
     /**
      * @brief getValue
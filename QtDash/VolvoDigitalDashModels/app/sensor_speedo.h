@@ -41,16 +41,29 @@ public slots:
             // gps speed
             if (channel == getChannel()) {
                 qreal speed = data.toReal();
-                sensorDataReady(speed);
+                publish(speed, classify(speed, speed));
             }
         } else if (std::is_base_of<T, VssSource>::value) {
             // vss speed
             if (channel == getChannel()) {
                 qreal speed = data.toReal();
-                sensorDataReady(speed);
+                publish(speed, classify(speed, speed));
             }
         }
     }
+
+protected:
+    /**
+     * @brief A speed can't be negative -- the VSS pulse counter reads -1 when
+     * it can't be read, and an nmea fix without a speed is NaN
+     * @param raw: speed
+     * @param value: speed
+     * @return sample status
+     */
+    SensorHealth::Status classify(qreal raw, qreal value) override {
+        Q_UNUSED(raw)
+        return (qIsNaN(value) || value < 0) ? SensorHealth::Status::OUT_OF_RANGE : SensorHealth::Status::OK;
+    }
 };
 
 #endif // SENSOR_SPEEDO_H
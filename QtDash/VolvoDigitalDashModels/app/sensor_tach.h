@@ -34,9 +34,21 @@ public slots:
     void transform(QVariant data, int channel) override {
         if (channel == getChannel()) {
             int rpm = data.toInt();
-            emit sensorDataReady(rpm);
+            publish(rpm, classify(rpm, rpm));
         }
     }
+
+protected:
+    /**
+     * @brief The pulse counter reads -1 when it can't be read
+     * @param raw: rpm
+     * @param value: rpm
+     * @return sample status
+     */
+    SensorHealth::Status classify(qreal raw, qreal value) override {
+        Q_UNUSED(raw)
+        return value < 0 ? SensorHealth::Status::OUT_OF_RANGE : SensorHealth::Status::OK;
+    }
 };
 
 #endif // SENSOR_TACH_H
@@ -40,7 +40,7 @@ public slots:
             qreal adcVolts = data.toReal() / Adc::VOLTAGE_CONVERSION_CORRECTION_FACTOR;
             adcVolts *= (3.3 / ((AdcSource *)mSource)->getVRef()); // convert to 3.3V vref
             qreal volts = m12VInput.getVoltage(adcVolts);
-            emit sensorDataReady(volts);
+            publish(volts);
         }
     }
 
@@ -0,0 +1,270 @@
+#ifndef SHIFT_LIGHT_H
+#define SHIFT_LIGHT_H
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QtMath>
+
+#include <config.h>
+
+/**
+ * @brief Progressive shift light.
+ *
+ * The rpm is taken from the tach pulse timestamps -- each pulse interval
+ * gives the mean rpm at its middle -- and a line fitted over the last
+ * FIT_NSEC predicts the rpm the lead time ahead. The tach is only polled
+ * every 50 ms and the driver needs time to react, so the light follows the
+ * predicted rpm rather than the shown one. Without pulse timestamps (an
+ * older pulse counter module, a replay) the polled rpm is fitted instead.
+ *
+ * The gear is the one whose rpm/speed ratio is nearest the current one, and
+ * picks the shift point. The stages light up stage_rpm apart, the last one at
+ * the shift point.
+ */
+class ShiftLight : public QObject {
+    Q_OBJECT
+public:
+    static constexpr qint64 FIT_NSEC = 200000000; //!< rpm samples the prediction is fitted over
+    static constexpr qint64 MAX_INTERVAL_NSEC = 100000000; //!< longer pulse intervals aren't an rpm (engine off, lost pulses)
+    static constexpr qint64 EDGE_TIMEOUT_NSEC = 250000000; //!< the polled rpm is used after this long without pulses
+    static constexpr qreal HYSTERESIS_RPM = 50; //!< a stage goes out this far below where it lit
+    static constexpr qreal MIN_GEAR_SPEED = 5; //!< slower than this has no gear
+    static constexpr qreal GEAR_TOLERANCE = 0.15; //!< ratio error a gear is recognized within, the clutch is in otherwise
+
+    /**
+     * @brief Constructor
+     * @param parent: parent object
+     * @param config: shift light config, with at least one shift point
+     * @param pulsesPerRot: tach pulses per rotation
+     */
+    ShiftLight(QObject * parent, Config::ShiftLightConfig_t config, int pulsesPerRot) :
+        QObject(parent), mConfig(config), mPulsesPerRot(pulsesPerRot) {
+        if (mConfig.stages < 1) {
+            mConfig.stages = 1;
+        }
+    }
+
+    int getStages() const {
+        return mConfig.stages;
+    }
+
+    /**
+     * @brief Get the number of stages lit
+     * @return 0 to @ref getStages, all lit is time to shift
+     */
+    int getStage() const {
+        return mStage;
+    }
+
+    /**
+     * @brief Get the gear
+     * @return 1 based gear, 0 if unknown
+     */
+    int getGear() const {
+        return mGear;
+    }
+
+    /**
+     * @brief Get the rpm predicted by the last update
+     * @return rpm, NaN without recent rpm samples
+     */
+    qreal getPredictedRpm() const {
+        return mPredicted;
+    }
+
+    /**
+     * @brief Get the shift point of a gear -- gears past the shift_rpm list, and an unknown gear, use its last entry
+     * @param gear: 1 based gear, 0 if unknown
+     * @return rpm
+     */
+    qreal getShiftRpm(int gear) const {
+        if (mConfig.shiftRpm.isEmpty()) {
+            return qQNaN();
+        }
+        if (gear < 1 || gear > mConfig.shiftRpm.size()) {
+            return mConfig.shiftRpm.last();
+        }
+        return mConfig.shiftRpm.at(gear - 1);
+    }
+
+signals:
+    /**
+     * @brief The number of stages lit changed
+     * @param stage: stages lit
+     */
+    void stageChanged(int stage);
+
+    /**
+     * @brief The gear changed
+     * @param gear: 1 based gear, 0 if unknown
+     */
+    void gearChanged(int gear);
+
+public slots:
+    /**
+     * @brief Add a tach pulse
+     * @param nsec: CLOCK_MONOTONIC time of the pulse
+     * @param count: pulse count
+     */
+    void addPulse(qint64 nsec, quint32 count) {
+        qint64 interval = nsec - mLastEdgeNsec;
+        quint32 pulses = count - mLastEdgeCount;
+        if (mLastEdgeNsec > 0 && interval > 0 && interval <= MAX_INTERVAL_NSEC && pulses > 0) {
+            qreal rpm = pulses * 60.0e9 / (mPulsesPerRot * (qreal) interval);
+            addSample(mLastEdgeNsec + interval / 2, rpm);
+        }
+        mLastEdgeNsec = nsec;
+        mLastEdgeCount = count;
+    }
+
+    /**
+     * @brief Add a polled rpm, used while there are no tach pulses
+     * @param rpm: rpm, negative if invalid
+     * @param nsec: CLOCK_MONOTONIC time it was read
+     */
+    void addRpm(qreal rpm, qint64 nsec) {
+        if (rpm >= 0 && nsec - mLastEdgeNsec > EDGE_TIMEOUT_NSEC) {
+            addSample(nsec, rpm);
+        }
+    }
+
+    /**
+     * @brief Set the road speed the gear is inferred from
+     * @param speed: speed, in the units the gear ratios are in
+     */
+    void setSpeed(qreal speed) {
+        mSpeed = speed;
+    }
+
+    /**
+     * @brief Predict the rpm and update the gear and the stages lit
+     * @param nsec: CLOCK_MONOTONIC time
+     */
+    void update(qint64 nsec) {
+        while (!mSamples.isEmpty() && mSamples.first().nsec < nsec - FIT_NSEC) {
+            mSamples.removeFirst();
+        }
+        mPredicted = predict(nsec + mConfig.leadMsec * 1000000LL);
+
+        int gear = inferGear();
+        if (gear != mGear) {
+            mGear = gear;
+            emit gearChanged(mGear);
+        }
+
+        int stage = stageAt(mPredicted);
+        if (stage < mStage) {
+            // only go out once clearly below, so a stage doesn't flicker at its threshold
+            stage = qMax(stage, qMin(mStage, stageAt(mPredicted + HYSTERESIS_RPM)));
+        }
+        if (stage != mStage) {
+            mStage = stage;
+            emit stageChanged(mStage);
+        }
+    }
+
+private:
+    /**
+     * @brief An rpm sample
+     */
+    typedef struct Sample {
+        qint64 nsec; //!< time of the rpm
+        qreal rpm; //!< rpm
+    } Sample_t;
+
+    Config::ShiftLightConfig_t mConfig; //!< shift points, stages and gear ratios
+    int mPulsesPerRot; //!< tach pulses per rotation
+    QList<Sample_t> mSamples; //!< rpm samples in the fit window, oldest first
+    qint64 mLastEdgeNsec = 0; //!< latest tach pulse
+    quint32 mLastEdgeCount = 0; //!< pulse count of the latest tach pulse
+    qreal mSpeed = 0; //!< road speed
+    qreal mPredicted = qQNaN(); //!< rpm the lead time ahead
+    int mGear = 0; //!< 1 based gear, 0 if unknown
+    int mStage = 0; //!< stages lit
+
+    void addSample(qint64 nsec, qreal rpm) {
+        mSamples.append({nsec, rpm});
+    }
+
+    /**
+     * @brief Extrapolate a least squares line through the samples
+     * @param nsec: time to predict the rpm at
+     * @return rpm, NaN without samples
+     */
+    qreal predict(qint64 nsec) const {
+        int n = mSamples.size();
+        if (n == 0) {
+            return qQNaN();
+        }
+        if (n == 1) {
+            return mSamples.first().rpm;
+        }
+
+        // seconds relative to the first sample keep the sums well conditioned
+        qint64 origin = mSamples.first().nsec;
+        qreal sumT = 0, sumRpm = 0;
+        for (const Sample_t & s : mSamples) {
+            sumT += (s.nsec - origin) / 1.0e9;
+            sumRpm += s.rpm;
+        }
+        qreal meanT = sumT / n;
+        qreal meanRpm = sumRpm / n;
+
+        qreal stt = 0, str = 0;
+        for (const Sample_t & s : mSamples) {
+            qreal dt = (s.nsec - origin) / 1.0e9 - meanT;
+            stt += dt * dt;
+            str += dt * (s.rpm - meanRpm);
+        }
+        if (stt <= 0) {
+            return meanRpm;
+        }
+        qreal slope = str / stt;
+        return meanRpm + slope * ((nsec - origin) / 1.0e9 - meanT);
+    }
+
+    /**
+     * @brief Find the gear whose rpm/speed ratio is nearest the current one
+     * @return 1 based gear, the previous gear if none is near (the clutch is in), 0 if unknown
+     */
+    int inferGear() const {
+        if (mConfig.ratios.isEmpty() || mSamples.isEmpty() || mSpeed < MIN_GEAR_SPEED) {
+            return 0;
+        }
+
+        qreal ratio = mSamples.last().rpm / mSpeed;
+        int nearest = 0;
+        qreal error = 0;
+        for (int i = 0; i < mConfig.ratios.size(); i++) {
+            qreal e = qAbs(ratio / mConfig.ratios.at(i) - 1);
+            if (i == 0 || e < error) {
+                nearest = i;
+                error = e;
+            }
+        }
+        return error <= GEAR_TOLERANCE ? nearest + 1 : mGear;
+    }
+
+    /**
+     * @brief Get the stages lit at an rpm, for the current gear
+     * @param rpm: rpm
+     * @return stages lit
+     */
+    int stageAt(qreal rpm) const {
+        qreal shift = getShiftRpm(mGear);
+        if (qIsNaN(rpm) || qIsNaN(shift)) {
+            return 0;
+        }
+        qreal first = shift - (mConfig.stages - 1) * mConfig.stageRpm;
+        if (rpm < first) {
+            return 0;
+        }
+        if (mConfig.stageRpm <= 0) {
+            return rpm >= shift ? mConfig.stages : 0;
+        }
+        return qMin(mConfig.stages, (int) qFloor((rpm - first) / mConfig.stageRpm) + 1);
+    }
+};
+
+#endif // SHIFT_LIGHT_H
@@ -0,0 +1,101 @@
+#include "shift_light_model.h"
+
+ShiftLightModel::ShiftLightModel(QObject *parent) :
+    QAbstractListModel(parent),
+    mStage(0), mStages(0), mGear(0)
+{
+
+}
+
+QHash<int, QByteArray> ShiftLightModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[ShiftLightRoles::StageRole] = "shiftStage";
+    roles[ShiftLightRoles::StagesRole] = "shiftStages";
+    roles[ShiftLightRoles::GearRole] = "gear";
+    return roles;
+}
+
+QVariant ShiftLightModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    Q_UNUSED(section)
+    Q_UNUSED(orientation)
+    return roleNames().value(role, "");
+}
+
+int ShiftLightModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return 1;
+}
+
+QVariant ShiftLightModel::data(const QModelIndex &index, int role) const
+{
+    Q_UNUSED(index)
+    if (role == ShiftLightRoles::StagesRole)
+    {
+        return mStages;
+    }
+    else if (role == ShiftLightRoles::GearRole)
+    {
+        return mGear;
+    }
+    // Default return:
+    return mStage;
+}
+
+Qt::ItemFlags ShiftLightModel::flags(const QModelIndex &index) const
+{
+    Q_UNUSED(index)
+    return Qt::ItemIsEnabled;
+}
+
+void ShiftLightModel::setStage(int stage)
+{
+    if (stage == mStage) {
+        return;
+    }
+    mStage = stage;
+    notify(ShiftLightRoles::StageRole);
+    emit stageChanged();
+}
+
+int ShiftLightModel::stage()
+{
+    return mStage;
+}
+
+void ShiftLightModel::setStages(int stages)
+{
+    if (stages == mStages) {
+        return;
+    }
+    mStages = stages;
+    notify(ShiftLightRoles::StagesRole);
+    emit stagesChanged();
+}
+
+int ShiftLightModel::stages()
+{
+    return mStages;
+}
+
+void ShiftLightModel::setGear(int gear)
+{
+    if (gear == mGear) {
+        return;
+    }
+    mGear = gear;
+    notify(ShiftLightRoles::GearRole);
+    emit gearChanged();
+}
+
+int ShiftLightModel::gear()
+{
+    return mGear;
+}
+
+void ShiftLightModel::notify(int role)
+{
+    emit dataChanged(createIndex(0,0), createIndex(0, 0), QVector<int>() << role);
+}
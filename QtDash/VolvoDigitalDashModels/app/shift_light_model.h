@@ -0,0 +1,94 @@
+#ifndef SHIFT_LIGHT_MODEL_H
+#define SHIFT_LIGHT_MODEL_H
+#include <QObject>
+#include <QAbstractItemModel>
+
+/**
+ * @brief Progressive shift light -- the stages lit, out of how many, and the gear
+ */
+class ShiftLightModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int stage READ stage WRITE setStage NOTIFY stageChanged)
+    Q_PROPERTY(int stages READ stages WRITE setStages NOTIFY stagesChanged)
+    Q_PROPERTY(int gear READ gear WRITE setGear NOTIFY gearChanged)
+
+public:
+    static constexpr char SHIFT_LIGHT_MODEL_NAME[] = "shiftLightModel";
+
+    enum ShiftLightRoles {
+        StageRole   = Qt::UserRole + 1,
+        StagesRole  = Qt::UserRole + 2,
+        GearRole    = Qt::UserRole + 3,
+    };
+
+    explicit ShiftLightModel(QObject *parent = nullptr);
+
+    /**
+     * Provides the header data for given params.
+     *
+     * @param section section of data
+     * @param orientation orientation of data
+     * @param role role of data
+     * @return
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * Returns the row count for given index.
+     *
+     * @param parent
+     * @return
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * Provides the data found at given index and role.
+     *
+     * @param index
+     * @param role
+     * @return
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * Returns the flags for model.
+     *
+     * @param index index to consider when providing flags
+     */
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    /**
+     * Enables integration with QML by providing names for use as refs in QML.
+     *
+     * @return hash map of role (int) -> name
+     */
+    QHash<int, QByteArray> roleNames() const override;
+
+    int stage();
+
+    int stages();
+
+    int gear();
+
+public slots:
+    void setStage(int stage);
+
+    void setStages(int stages);
+
+    void setGear(int gear);
+
+signals:
+    void stageChanged();
+    void stagesChanged();
+    void gearChanged();
+
+private:
+    int mStage; //!< stages lit
+    int mStages; //!< number of stages
+    int mGear; //!< 1 based gear, 0 if unknown
+
+    void notify(int role);
+};
+
+#endif // SHIFT_LIGHT_MODEL_H
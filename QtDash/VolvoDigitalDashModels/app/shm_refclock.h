@@ -0,0 +1,110 @@
+#ifndef SHM_REFCLOCK_H
+#define SHM_REFCLOCK_H
+
+#include <QtGlobal>
+#include <QDebug>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+/**
+ * @brief Serves gps time to ntpd or chrony over the ntp shared memory
+ * refclock segment, the same one gpsd writes (chrony: "refclock SHM 0").
+ */
+class ShmRefclock {
+public:
+    static constexpr key_t BASE_KEY = 0x4e545030; //!< "NTP0", the key of unit 0
+    static constexpr int PRECISION = -10; //!< log2 seconds, ~1 ms of serial jitter
+
+    /**
+     * @brief ntp shared memory segment layout -- has to match ntpd's refclock_shm.c
+     */
+    typedef struct ShmTime {
+        int mode; //!< 1: count is bumped before and after each write
+        volatile int count; //!< write sequence
+        time_t clockTimeStampSec; //!< reference (gps) time
+        int clockTimeStampUSec;
+        time_t receiveTimeStampSec; //!< system time the reference arrived
+        int receiveTimeStampUSec;
+        int leap; //!< leap second indicator
+        int precision; //!< log2 seconds
+        int nsamples; //!< unused
+        volatile int valid; //!< set when a new sample is ready
+        unsigned clockTimeStampNSec;
+        unsigned receiveTimeStampNSec;
+        int dummy[8];
+    } ShmTime_t;
+
+    ~ShmRefclock() {
+        if (mShm != nullptr) {
+            shmdt(mShm);
+        }
+    }
+
+    /**
+     * @brief Attach to (and create) the segment of a unit. Units 0 and 1 are
+     * only readable by root, as ntpd expects.
+     * @param unit: refclock unit
+     * @return true if successful
+     */
+    bool open(int unit) {
+        int perms = unit <= 1 ? 0600 : 0666;
+        int id = shmget(BASE_KEY + unit, sizeof(ShmTime_t), IPC_CREAT | perms);
+        if (id < 0) {
+            qDebug() << "shmget failed for refclock unit" << unit << ": " << strerror(errno);
+            return false;
+        }
+
+        void * shm = shmat(id, nullptr, 0);
+        if (shm == (void *) -1) {
+            qDebug() << "shmat failed for refclock unit" << unit << ": " << strerror(errno);
+            return false;
+        }
+
+        mShm = static_cast<ShmTime_t *>(shm);
+        std::memset(mShm, 0, sizeof(ShmTime_t));
+        mShm->mode = 1;
+        mShm->precision = PRECISION;
+        return true;
+    }
+
+    bool isOpen() const {
+        return mShm != nullptr;
+    }
+
+    /**
+     * @brief Publish a sample
+     * @param fixNsec: gps time (UTC nanoseconds since the epoch)
+     * @param systemNsec: system time it arrived at
+     */
+    void publish(qint64 fixNsec, qint64 systemNsec) {
+        if (mShm == nullptr) {
+            return;
+        }
+
+        // mode 1: the reader throws the sample away if count moved under it
+        mShm->valid = 0;
+        mShm->count++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        mShm->clockTimeStampSec = fixNsec / NSEC_PER_SEC;
+        mShm->clockTimeStampUSec = (fixNsec % NSEC_PER_SEC) / 1000;
+        mShm->clockTimeStampNSec = fixNsec % NSEC_PER_SEC;
+        mShm->receiveTimeStampSec = systemNsec / NSEC_PER_SEC;
+        mShm->receiveTimeStampUSec = (systemNsec % NSEC_PER_SEC) / 1000;
+        mShm->receiveTimeStampNSec = systemNsec % NSEC_PER_SEC;
+        mShm->leap = 0;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        mShm->count++;
+        mShm->valid = 1;
+    }
+
+private:
+    static constexpr qint64 NSEC_PER_SEC = 1000000000;
+
+    ShmTime_t * mShm = nullptr; //!< attached segment
+};
+
+#endif // SHM_REFCLOCK_H
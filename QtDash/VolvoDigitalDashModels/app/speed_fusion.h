@@ -0,0 +1,153 @@
+#ifndef SPEED_FUSION_H
+#define SPEED_FUSION_H
+
+#include <QList>
+#include <QtMath>
+
+/**
+ * @brief Learns the VSS calibration from gps ground speed.
+ *
+ * The speedo and odometer stay on the VSS -- fast and smooth -- scaled by a
+ * calibration factor, the true distance per configured distance. The factor
+ * is a one state Kalman filter: each gps fix is a measurement of
+ * gps speed / raw VSS speed, weighted by the receiver's speed accuracy. Only
+ * fixes at a steady speed above MIN_SPEED are used, so gps latency and wheel
+ * spin don't bias it. A slow random walk lets it follow tire wear, and a run
+ * of rejected measurements (new tires) reopens the estimate.
+ */
+class SpeedFusion {
+public:
+    static constexpr qreal MIN_SPEED = 8.0; //!< slowest VSS speed (m/s) used to calibrate
+    static constexpr qreal MAX_ACCELERATION = 0.5; //!< fastest VSS speed change (m/s^2) used to calibrate
+    static constexpr qint64 STEADY_MSEC = 1000; //!< window the speed has to be steady over
+    static constexpr qreal MAX_GPS_ACCURACY = 1.0; //!< worst gps speed accuracy (m/s) used
+    static constexpr qreal DEFAULT_GPS_ACCURACY = 0.5; //!< gps speed accuracy (m/s) when the receiver doesn't report it
+    static constexpr qreal VSS_NOISE = 0.01; //!< relative VSS speed noise (pulse quantization)
+    static constexpr qreal MIN_CALIBRATION = 0.7; //!< smallest plausible factor
+    static constexpr qreal MAX_CALIBRATION = 1.4; //!< largest plausible factor
+    static constexpr qreal INITIAL_STDDEV = 0.05; //!< uncertainty of a stored factor
+    static constexpr qreal PROCESS_STDDEV = 3e-5; //!< random walk per measurement
+    static constexpr qreal GATE_SIGMA = 4.0; //!< measurements further out are outliers
+    static constexpr int MAX_REJECTED = 50; //!< outliers (net of accepted measurements) that reopen the estimate
+    static constexpr qreal CALIBRATED_STDDEV = 0.003; //!< uncertainty the factor is trusted at
+    static constexpr qreal PERSIST_CHANGE = 0.002; //!< change from the stored factor worth writing
+
+    /**
+     * @brief Constructor
+     * @param calibration: stored calibration factor
+     */
+    SpeedFusion(qreal calibration = 1.0) :
+        mCalibration(calibration), mStoredCalibration(calibration),
+        mVariance(INITIAL_STDDEV * INITIAL_STDDEV) {
+    }
+
+    /**
+     * @brief A VSS speed
+     * @param msec: monotonic time
+     * @param speed: uncalibrated VSS speed (m/s)
+     */
+    void addVss(qint64 msec, qreal speed) {
+        mVss.append({msec, speed});
+        while (mVss.size() > 2 && mVss.at(1).msec <= msec - STEADY_MSEC) {
+            mVss.removeFirst();
+        }
+    }
+
+    /**
+     * @brief A gps fix
+     * @param msec: monotonic time the fix arrived
+     * @param speed: ground speed (m/s)
+     * @param accuracy: speed accuracy (m/s), NaN if unknown
+     * @return true if the calibration was updated
+     */
+    bool addGps(qint64 msec, qreal speed, qreal accuracy) {
+        if (qIsNaN(accuracy)) {
+            accuracy = DEFAULT_GPS_ACCURACY;
+        }
+        if (mVss.isEmpty() || qIsNaN(speed) || accuracy > MAX_GPS_ACCURACY) {
+            return false;
+        }
+
+        // steady speed over the window ending now
+        const Sample_t & first = mVss.first();
+        const Sample_t & last = mVss.last();
+        qreal vss = last.speed;
+        if (vss < MIN_SPEED || msec - last.msec > STEADY_MSEC ||
+                last.msec - first.msec < STEADY_MSEC / 2 ||
+                qAbs(last.speed - first.speed) * 1000.0 / (last.msec - first.msec) > MAX_ACCELERATION) {
+            return false;
+        }
+
+        qreal z = speed / vss;
+        if (z < MIN_CALIBRATION || z > MAX_CALIBRATION) {
+            return false;
+        }
+
+        mVariance += PROCESS_STDDEV * PROCESS_STDDEV;
+        qreal relative = accuracy / vss;
+        qreal r = relative * relative + VSS_NOISE * VSS_NOISE;
+
+        qreal innovation = z - mCalibration;
+        if (qAbs(innovation) > GATE_SIGMA * qSqrt(mVariance + r)) {
+            if (++mRejected >= MAX_REJECTED) {
+                // consistently off -- the tires changed, start over
+                mVariance = INITIAL_STDDEV * INITIAL_STDDEV;
+                mRejected = 0;
+            }
+            return false;
+        }
+        // a noise hit shouldn't hide a real step
+        mRejected = qMax(0, mRejected - 1);
+
+        qreal gain = mVariance / (mVariance + r);
+        mCalibration += gain * innovation;
+        mVariance *= (1 - gain);
+        return true;
+    }
+
+    qreal getCalibration() const {
+        return mCalibration;
+    }
+
+    /**
+     * @brief Get the calibration uncertainty
+     * @return standard deviation of the factor
+     */
+    qreal getStdDev() const {
+        return qSqrt(mVariance);
+    }
+
+    bool isCalibrated() const {
+        return getStdDev() <= CALIBRATED_STDDEV;
+    }
+
+    /**
+     * @brief Check whether the factor should be written back -- it's trusted
+     * and moved from the stored one. True once per change, so the caller writes it.
+     * @return true to write @ref getCalibration
+     */
+    bool takeStoreDue() {
+        if (!isCalibrated() || qAbs(mCalibration - mStoredCalibration) < PERSIST_CHANGE) {
+            return false;
+        }
+        mStoredCalibration = mCalibration;
+        return true;
+    }
+
+private:
+    /**
+     * @brief A VSS speed sample
+     */
+    typedef struct Sample {
+        qint64 msec; //!< monotonic time
+        qreal speed; //!< uncalibrated speed (m/s)
+    } Sample_t;
+
+    qreal mCalibration; //!< calibration factor estimate
+    qreal mStoredCalibration; //!< last written factor
+    qreal mVariance; //!< estimate variance
+    int mRejected = 0; //!< outliers, less the accepted measurements since
+    QList<Sample_t> mVss; //!< VSS speeds over the steady window
+};
+
+#endif // SPEED_FUSION_H
@@ -38,7 +38,11 @@ public:
      * @return -1 if invalid 0 to max rpm if valid
      */
     int getRpm() {
-        return (int) std::round(getFrequency() * 60.0 / mConfig.pulsesPerRot);
+        int frequency = getFrequency();
+        if (frequency < 0) {
+            return -1;
+        }
+        return (int) std::round(frequency * 60.0 / mConfig.pulsesPerRot);
     }
 
     /**
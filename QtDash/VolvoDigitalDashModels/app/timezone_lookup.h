@@ -0,0 +1,361 @@
+#ifndef TIMEZONE_LOOKUP_H
+#define TIMEZONE_LOOKUP_H
+
+#include <QByteArray>
+#include <QTimeZone>
+#include <QtMath>
+#include <ctime>
+
+/**
+ * @brief Time zone from a position, without a boundary database.
+ *
+ * An embedded table of reference towns, each with its tz database id; the
+ * nearest one wins, so the boundaries fall halfway between neighbors. Towns
+ * are dense along the zone lines that matter (US, Canada, Europe) and sparse
+ * elsewhere. Too far from any of them (at sea) it falls back to a fixed
+ * offset from the longitude. Near a line it can still guess wrong -- set the
+ * zone in the config then.
+ */
+class TimeZoneLookup {
+public:
+    static constexpr qreal MAX_DISTANCE_KM = 800; //!< further from every town uses the longitude offset
+    static constexpr qreal KM_PER_DEGREE = 111.2; //!< km per degree of latitude
+
+    /**
+     * @brief A reference town
+     */
+    typedef struct Town {
+        float latitude; //!< degrees
+        float longitude; //!< degrees
+        const char * zone; //!< tz database id
+    } Town_t;
+
+    /**
+     * @brief Look up the zone of a position
+     * @param latitude: degrees
+     * @param longitude: degrees
+     * @return tz database id of the nearest town, empty if there's none within MAX_DISTANCE_KM
+     */
+    static QByteArray lookup(qreal latitude, qreal longitude) {
+        const char * zone = nullptr;
+        qreal best = MAX_DISTANCE_KM / KM_PER_DEGREE;
+        best *= best;
+        qreal scale = qCos(qDegreesToRadians(latitude));
+
+        for (const Town_t & town : TOWNS) {
+            qreal dLat = town.latitude - latitude;
+            qreal dLon = qAbs(town.longitude - longitude);
+            if (dLon > 180) {
+                dLon = 360 - dLon;
+            }
+            dLon *= scale;
+            qreal distance = dLat * dLat + dLon * dLon;
+            if (distance < best) {
+                best = distance;
+                zone = town.zone;
+            }
+        }
+        return zone == nullptr ? QByteArray() : QByteArray(zone);
+    }
+
+    /**
+     * @brief POSIX TZ for the nautical zone of a longitude
+     * @param longitude: degrees
+     * @return fixed offset TZ string, eg "<-06>6"
+     */
+    static QByteArray fixedOffset(qreal longitude) {
+        int hours = qRound(longitude / 15.0);
+        QByteArray name = (hours < 0 ? "-" : "+") + QByteArray::number(qAbs(hours)).rightJustified(2, '0');
+        // POSIX offsets are hours behind UTC
+        return "<" + name + ">" + QByteArray::number(-hours);
+    }
+
+    /**
+     * @brief Look up the TZ for a position -- the town's zone if this system
+     * has it, the longitude offset if not
+     * @param latitude: degrees
+     * @param longitude: degrees
+     * @return TZ string
+     */
+    static QByteArray resolve(qreal latitude, qreal longitude) {
+        QByteArray zone = lookup(latitude, longitude);
+        if (zone.isEmpty() || !QTimeZone::isTimeZoneIdAvailable(zone)) {
+            return fixedOffset(longitude);
+        }
+        return zone;
+    }
+
+    /**
+     * @brief Make a zone this process's local time
+     * @param tz: tz database id or POSIX TZ string
+     */
+    static void apply(QByteArray tz) {
+        qputenv("TZ", tz);
+        tzset();
+    }
+
+private:
+    static constexpr Town_t TOWNS[] = {
+        // US pacific
+        {47.61f, -122.33f, "America/Los_Angeles"}, // Seattle
+        {47.66f, -117.43f, "America/Los_Angeles"}, // Spokane
+        {47.68f, -116.78f, "America/Los_Angeles"}, // Coeur d'Alene
+        {46.42f, -117.02f, "America/Los_Angeles"}, // Lewiston
+        {45.52f, -122.68f, "America/Los_Angeles"}, // Portland
+        {44.06f, -121.31f, "America/Los_Angeles"}, // Bend
+        {42.33f, -122.87f, "America/Los_Angeles"}, // Medford
+        {37.77f, -122.42f, "America/Los_Angeles"}, // San Francisco
+        {38.58f, -121.49f, "America/Los_Angeles"}, // Sacramento
+        {36.74f, -119.79f, "America/Los_Angeles"}, // Fresno
+        {34.05f, -118.24f, "America/Los_Angeles"}, // Los Angeles
+        {32.72f, -117.16f, "America/Los_Angeles"}, // San Diego
+        {32.79f, -115.56f, "America/Los_Angeles"}, // El Centro
+        {39.53f, -119.81f, "America/Los_Angeles"}, // Reno
+        {40.83f, -115.76f, "America/Los_Angeles"}, // Elko
+        {36.17f, -115.14f, "America/Los_Angeles"}, // Las Vegas
+        // US mountain
+        {43.62f, -116.20f, "America/Boise"},
+        {42.56f, -114.46f, "America/Boise"}, // Twin Falls
+        {40.76f, -111.89f, "America/Denver"}, // Salt Lake City
+        {46.87f, -113.99f, "America/Denver"}, // Missoula
+        {46.59f, -112.04f, "America/Denver"}, // Helena
+        {45.78f, -108.50f, "America/Denver"}, // Billings
+        {42.87f, -106.31f, "America/Denver"}, // Casper
+        {41.14f, -104.82f, "America/Denver"}, // Cheyenne
+        {39.74f, -104.99f, "America/Denver"},
+        {39.06f, -108.55f, "America/Denver"}, // Grand Junction
+        {38.25f, -104.61f, "America/Denver"}, // Pueblo
+        {35.08f, -106.65f, "America/Denver"}, // Albuquerque
+        {31.76f, -106.49f, "America/Denver"}, // El Paso
+        {44.08f, -103.23f, "America/Denver"}, // Rapid City
+        {48.15f, -103.62f, "America/Denver"}, // Williston
+        {33.45f, -112.07f, "America/Phoenix"},
+        {32.22f, -110.97f, "America/Phoenix"}, // Tucson
+        {35.20f, -111.65f, "America/Phoenix"}, // Flagstaff
+        {35.19f, -114.05f, "America/Phoenix"}, // Kingman
+        {32.69f, -114.63f, "America/Phoenix"}, // Yuma
+        // US central
+        {46.81f, -100.78f, "America/Chicago"}, // Bismarck
+        {46.88f, -96.79f, "America/Chicago"}, // Fargo
+        {44.37f, -100.35f, "America/Chicago"}, // Pierre
+        {43.54f, -96.73f, "America/Chicago"}, // Sioux Falls
+        {41.14f, -100.77f, "America/Chicago"}, // North Platte
+        {41.26f, -95.93f, "America/Chicago"}, // Omaha
+        {37.75f, -100.02f, "America/Chicago"}, // Dodge City
+        {37.69f, -97.34f, "America/Chicago"}, // Wichita
+        {35.22f, -101.83f, "America/Chicago"}, // Amarillo
+        {33.58f, -101.86f, "America/Chicago"}, // Lubbock
+        {32.00f, -102.08f, "America/Chicago"}, // Midland
+        {32.78f, -96.80f, "America/Chicago"}, // Dallas
+        {29.76f, -95.37f, "America/Chicago"}, // Houston
+        {29.42f, -98.49f, "America/Chicago"}, // San Antonio
+        {35.47f, -97.52f, "America/Chicago"}, // Oklahoma City
+        {39.10f, -94.58f, "America/Chicago"}, // Kansas City
+        {44.98f, -93.27f, "America/Chicago"}, // Minneapolis
+        {46.79f, -92.10f, "America/Chicago"}, // Duluth
+        {41.59f, -93.62f, "America/Chicago"}, // Des Moines
+        {38.63f, -90.20f, "America/Chicago"}, // St. Louis
+        {41.88f, -87.63f, "America/Chicago"},
+        {43.04f, -87.91f, "America/Chicago"}, // Milwaukee
+        {44.51f, -88.01f, "America/Chicago"}, // Green Bay
+        {37.97f, -87.57f, "America/Chicago"}, // Evansville
+        {36.99f, -86.44f, "America/Chicago"}, // Bowling Green
+        {36.16f, -86.78f, "America/Chicago"}, // Nashville
+        {35.15f, -90.05f, "America/Chicago"}, // Memphis
+        {34.75f, -92.29f, "America/Chicago"}, // Little Rock
+        {32.30f, -90.18f, "America/Chicago"}, // Jackson
+        {29.95f, -90.07f, "America/Chicago"}, // New Orleans
+        {33.52f, -86.80f, "America/Chicago"}, // Birmingham
+        {32.37f, -86.30f, "America/Chicago"}, // Montgomery
+        {31.22f, -85.39f, "America/Chicago"}, // Dothan
+        {30.42f, -87.22f, "America/Chicago"}, // Pensacola
+        {30.16f, -85.66f, "America/Chicago"}, // Panama City
+        // US eastern
+        {42.33f, -83.05f, "America/Detroit"},
+        {42.96f, -85.67f, "America/Detroit"}, // Grand Rapids
+        {44.76f, -85.62f, "America/Detroit"}, // Traverse City
+        {46.54f, -87.40f, "America/Detroit"}, // Marquette
+        {39.77f, -86.16f, "America/Indiana/Indianapolis"},
+        {41.08f, -85.14f, "America/Indiana/Indianapolis"}, // Fort Wayne
+        {38.25f, -85.76f, "America/Kentucky/Louisville"},
+        {38.04f, -84.50f, "America/New_York"}, // Lexington
+        {39.10f, -84.51f, "America/New_York"}, // Cincinnati
+        {39.96f, -83.00f, "America/New_York"}, // Columbus
+        {41.50f, -81.69f, "America/New_York"}, // Cleveland
+        {40.44f, -79.99f, "America/New_York"}, // Pittsburgh
+        {35.96f, -83.92f, "America/New_York"}, // Knoxville
+        {35.05f, -85.31f, "America/New_York"}, // Chattanooga
+        {33.75f, -84.39f, "America/New_York"}, // Atlanta
+        {32.46f, -84.99f, "America/New_York"}, // Columbus, GA
+        {30.44f, -84.28f, "America/New_York"}, // Tallahassee
+        {30.33f, -81.66f, "America/New_York"}, // Jacksonville
+        {27.95f, -82.46f, "America/New_York"}, // Tampa
+        {25.76f, -80.19f, "America/New_York"}, // Miami
+        {35.23f, -80.84f, "America/New_York"}, // Charlotte
+        {35.78f, -78.64f, "America/New_York"}, // Raleigh
+        {37.54f, -77.44f, "America/New_York"}, // Richmond
+        {38.91f, -77.04f, "America/New_York"}, // Washington
+        {39.95f, -75.17f, "America/New_York"}, // Philadelphia
+        {40.71f, -74.01f, "America/New_York"},
+        {42.65f, -73.76f, "America/New_York"}, // Albany
+        {42.89f, -78.88f, "America/New_York"}, // Buffalo
+        {42.36f, -71.06f, "America/New_York"}, // Boston
+        {44.48f, -73.21f, "America/New_York"}, // Burlington
+        {43.66f, -70.26f, "America/New_York"}, // Portland, ME
+        {44.80f, -68.78f, "America/New_York"}, // Bangor
+        // alaska and hawaii
+        {61.22f, -149.90f, "America/Anchorage"},
+        {64.84f, -147.72f, "America/Anchorage"}, // Fairbanks
+        {58.30f, -134.42f, "America/Juneau"},
+        {21.31f, -157.86f, "Pacific/Honolulu"},
+        // canada
+        {49.28f, -123.12f, "America/Vancouver"},
+        {49.89f, -119.50f, "America/Vancouver"}, // Kelowna
+        {53.92f, -122.75f, "America/Vancouver"}, // Prince George
+        {60.72f, -135.06f, "America/Whitehorse"},
+        {51.05f, -114.07f, "America/Edmonton"}, // Calgary
+        {53.55f, -113.49f, "America/Edmonton"},
+        {50.45f, -104.61f, "America/Regina"},
+        {52.13f, -106.67f, "America/Regina"}, // Saskatoon
+        {49.90f, -97.14f, "America/Winnipeg"},
+        {48.38f, -89.25f, "America/Toronto"}, // Thunder Bay
+        {46.49f, -80.99f, "America/Toronto"}, // Sudbury
+        {43.65f, -79.38f, "America/Toronto"},
+        {45.42f, -75.70f, "America/Toronto"}, // Ottawa
+        {45.50f, -73.57f, "America/Toronto"}, // Montreal
+        {46.81f, -71.21f, "America/Toronto"}, // Quebec City
+        {46.09f, -64.78f, "America/Moncton"},
+        {44.65f, -63.57f, "America/Halifax"},
+        {47.56f, -52.71f, "America/St_Johns"},
+        // mexico
+        {32.51f, -117.04f, "America/Tijuana"},
+        {32.62f, -115.45f, "America/Tijuana"}, // Mexicali
+        {29.07f, -110.96f, "America/Hermosillo"},
+        {24.14f, -110.31f, "America/Mazatlan"}, // La Paz
+        {28.63f, -106.07f, "America/Chihuahua"},
+        {25.69f, -100.32f, "America/Monterrey"},
+        {20.67f, -103.35f, "America/Mexico_City"}, // Guadalajara
+        {19.43f, -99.13f, "America/Mexico_City"},
+        {20.97f, -89.62f, "America/Merida"},
+        {21.16f, -86.85f, "America/Cancun"},
+        // western europe
+        {64.15f, -21.94f, "Atlantic/Reykjavik"},
+        {53.35f, -6.26f, "Europe/Dublin"},
+        {51.90f, -8.47f, "Europe/Dublin"}, // Cork
+        {53.27f, -9.05f, "Europe/Dublin"}, // Galway
+        {54.60f, -5.93f, "Europe/London"}, // Belfast
+        {51.51f, -0.13f, "Europe/London"},
+        {53.48f, -2.24f, "Europe/London"}, // Manchester
+        {55.95f, -3.19f, "Europe/London"}, // Edinburgh
+        {57.48f, -4.22f, "Europe/London"}, // Inverness
+        {50.37f, -4.14f, "Europe/London"}, // Plymouth
+        {38.72f, -9.14f, "Europe/Lisbon"},
+        {41.15f, -8.61f, "Europe/Lisbon"}, // Porto
+        {37.02f, -7.93f, "Europe/Lisbon"}, // Faro
+        {40.42f, -3.70f, "Europe/Madrid"},
+        {42.24f, -8.72f, "Europe/Madrid"}, // Vigo
+        {40.97f, -5.66f, "Europe/Madrid"}, // Salamanca
+        {38.88f, -6.97f, "Europe/Madrid"}, // Badajoz
+        {37.39f, -5.98f, "Europe/Madrid"}, // Seville
+        {43.26f, -2.93f, "Europe/Madrid"}, // Bilbao
+        {41.39f, 2.17f, "Europe/Madrid"}, // Barcelona
+        {48.86f, 2.35f, "Europe/Paris"},
+        {48.39f, -4.49f, "Europe/Paris"}, // Brest
+        {44.84f, -0.58f, "Europe/Paris"}, // Bordeaux
+        {45.76f, 4.84f, "Europe/Paris"}, // Lyon
+        {43.30f, 5.37f, "Europe/Paris"}, // Marseille
+        {50.85f, 4.35f, "Europe/Brussels"},
+        {52.37f, 4.90f, "Europe/Amsterdam"},
+        {49.61f, 6.13f, "Europe/Luxembourg"},
+        // central europe
+        {52.52f, 13.40f, "Europe/Berlin"},
+        {53.55f, 9.99f, "Europe/Berlin"}, // Hamburg
+        {50.94f, 6.96f, "Europe/Berlin"}, // Cologne
+        {48.14f, 11.58f, "Europe/Berlin"}, // Munich
+        {47.37f, 8.54f, "Europe/Zurich"},
+        {48.21f, 16.37f, "Europe/Vienna"},
+        {45.46f, 9.19f, "Europe/Rome"}, // Milan
+        {41.90f, 12.50f, "Europe/Rome"},
+        {38.12f, 13.36f, "Europe/Rome"}, // Palermo
+        {55.68f, 12.57f, "Europe/Copenhagen"},
+        {59.91f, 10.75f, "Europe/Oslo"},
+        {60.39f, 5.32f, "Europe/Oslo"}, // Bergen
+        {63.43f, 10.40f, "Europe/Oslo"}, // Trondheim
+        {69.65f, 18.96f, "Europe/Oslo"}, // Tromso
+        {69.73f, 30.05f, "Europe/Oslo"}, // Kirkenes
+        {59.33f, 18.07f, "Europe/Stockholm"},
+        {57.71f, 11.97f, "Europe/Stockholm"}, // Gothenburg
+        {55.60f, 13.00f, "Europe/Stockholm"}, // Malmo
+        {62.39f, 17.31f, "Europe/Stockholm"}, // Sundsvall
+        {63.83f, 20.26f, "Europe/Stockholm"}, // Umea
+        {65.58f, 22.15f, "Europe/Stockholm"}, // Lulea
+        {67.86f, 20.23f, "Europe/Stockholm"}, // Kiruna
+        {52.23f, 21.01f, "Europe/Warsaw"},
+        {54.35f, 18.65f, "Europe/Warsaw"}, // Gdansk
+        {50.06f, 19.94f, "Europe/Warsaw"}, // Krakow
+        {53.13f, 23.16f, "Europe/Warsaw"}, // Bialystok
+        {50.08f, 14.44f, "Europe/Prague"},
+        {48.15f, 17.11f, "Europe/Bratislava"},
+        {47.50f, 19.04f, "Europe/Budapest"},
+        {46.06f, 14.51f, "Europe/Ljubljana"},
+        {45.81f, 15.98f, "Europe/Zagreb"},
+        {43.86f, 18.41f, "Europe/Sarajevo"},
+        {44.79f, 20.46f, "Europe/Belgrade"},
+        {41.33f, 19.82f, "Europe/Tirane"},
+        {41.99f, 21.43f, "Europe/Skopje"},
+        // eastern europe
+        {60.17f, 24.94f, "Europe/Helsinki"},
+        {60.45f, 22.27f, "Europe/Helsinki"}, // Turku
+        {63.10f, 21.62f, "Europe/Helsinki"}, // Vaasa
+        {65.01f, 25.47f, "Europe/Helsinki"}, // Oulu
+        {66.50f, 25.73f, "Europe/Helsinki"}, // Rovaniemi
+        {59.44f, 24.75f, "Europe/Tallinn"},
+        {56.95f, 24.11f, "Europe/Riga"},
+        {54.69f, 25.28f, "Europe/Vilnius"},
+        {54.90f, 23.90f, "Europe/Vilnius"}, // Kaunas
+        {54.71f, 20.51f, "Europe/Kaliningrad"},
+        {53.90f, 27.57f, "Europe/Minsk"},
+        {53.68f, 23.83f, "Europe/Minsk"}, // Grodno
+        {52.10f, 23.70f, "Europe/Minsk"}, // Brest
+        {50.45f, 30.52f, "Europe/Kiev"},
+        {49.84f, 24.03f, "Europe/Kiev"}, // Lviv
+        {46.48f, 30.72f, "Europe/Kiev"}, // Odesa
+        {49.99f, 36.23f, "Europe/Kiev"}, // Kharkiv
+        {47.01f, 28.86f, "Europe/Chisinau"},
+        {44.43f, 26.10f, "Europe/Bucharest"},
+        {46.77f, 23.60f, "Europe/Bucharest"}, // Cluj
+        {42.70f, 23.32f, "Europe/Sofia"},
+        {37.98f, 23.73f, "Europe/Athens"},
+        {40.64f, 22.94f, "Europe/Athens"}, // Thessaloniki
+        {41.01f, 28.98f, "Europe/Istanbul"},
+        {39.93f, 32.86f, "Europe/Istanbul"}, // Ankara
+        {55.76f, 37.62f, "Europe/Moscow"},
+        {59.94f, 30.31f, "Europe/Moscow"}, // St. Petersburg
+        // rest of the world
+        {-33.87f, 151.21f, "Australia/Sydney"},
+        {-37.81f, 144.96f, "Australia/Melbourne"},
+        {-27.47f, 153.03f, "Australia/Brisbane"},
+        {-34.93f, 138.60f, "Australia/Adelaide"},
+        {-31.95f, 115.86f, "Australia/Perth"},
+        {-12.46f, 130.84f, "Australia/Darwin"},
+        {-23.70f, 133.88f, "Australia/Darwin"}, // Alice Springs
+        {-42.88f, 147.33f, "Australia/Hobart"},
+        {-36.85f, 174.76f, "Pacific/Auckland"},
+        {-43.53f, 172.64f, "Pacific/Auckland"}, // Christchurch
+        {35.68f, 139.69f, "Asia/Tokyo"},
+        {37.57f, 126.98f, "Asia/Seoul"},
+        {31.23f, 121.47f, "Asia/Shanghai"},
+        {22.32f, 114.17f, "Asia/Hong_Kong"},
+        {1.35f, 103.82f, "Asia/Singapore"},
+        {28.61f, 77.21f, "Asia/Kolkata"}, // Delhi
+        {22.57f, 88.36f, "Asia/Kolkata"},
+        {25.20f, 55.27f, "Asia/Dubai"},
+        {-26.20f, 28.05f, "Africa/Johannesburg"},
+        {-33.92f, 18.42f, "Africa/Johannesburg"}, // Cape Town
+        {-23.55f, -46.63f, "America/Sao_Paulo"},
+        {-34.60f, -58.38f, "America/Argentina/Buenos_Aires"},
+        {-33.45f, -70.67f, "America/Santiago"},
+    };
+};
+
+#endif // TIMEZONE_LOOKUP_H
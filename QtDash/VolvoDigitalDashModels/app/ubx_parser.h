@@ -0,0 +1,260 @@
+#ifndef UBX_PARSER_H
+#define UBX_PARSER_H
+
+#include <QByteArray>
+#include <QDate>
+#include <QDateTime>
+#include <QTime>
+#include <QtEndian>
+#include <cstring>
+
+/**
+ * @brief u-blox UBX binary protocol reader and config message builder.
+ *
+ * Frames are parsed in place from the receive buffer -- fields are read
+ * straight out of the bytes, nothing is copied per frame. Any bytes that
+ * aren't a frame with a good checksum (NMEA sentences, line noise) are
+ * skipped.
+ *
+ * Frame: 0xB5 0x62, class, id, little endian u16 payload length, payload,
+ * two byte 8-bit Fletcher checksum over class through payload.
+ */
+class UbxParser {
+public:
+    static constexpr quint8 SYNC_1 = 0xB5; //!< first sync char
+    static constexpr quint8 SYNC_2 = 0x62; //!< second sync char
+    static constexpr int HEADER_SIZE = 6; //!< sync chars, class, id and length
+    static constexpr int CHECKSUM_SIZE = 2; //!< checksum bytes after the payload
+    static constexpr int MAX_PAYLOAD = 1024; //!< longer lengths are a false sync
+
+    static constexpr quint8 CLASS_NAV = 0x01; //!< navigation results
+    static constexpr quint8 NAV_PVT = 0x07; //!< position, velocity and time solution
+    static constexpr int NAV_PVT_SIZE = 92; //!< NAV-PVT payload size
+
+    static constexpr quint8 CLASS_CFG = 0x06; //!< configuration
+    static constexpr quint8 CFG_PRT = 0x00; //!< port config
+    static constexpr quint8 CFG_MSG = 0x01; //!< message rate
+    static constexpr quint8 CFG_RATE = 0x08; //!< navigation rate
+
+    static constexpr quint8 PORT_USB = 3; //!< CFG-PRT port id of the USB port
+    static constexpr quint16 PROTO_UBX = 0x01; //!< UBX protocol mask bit
+    static constexpr quint16 PROTO_NMEA = 0x02; //!< NMEA protocol mask bit
+
+    /**
+     * @brief GNSS fix type
+     */
+    enum class FixType {
+        NONE = 0,
+        DEAD_RECKONING,
+        FIX_2D,
+        FIX_3D,
+        GNSS_DEAD_RECKONING,
+        TIME_ONLY,
+    };
+
+    /**
+     * @brief A decoded NAV-PVT solution
+     */
+    typedef struct NavPvt {
+        qint64 utcNsec; //!< UTC nanoseconds since the epoch, 0 if the time isn't valid and fully resolved yet
+        FixType fixType; //!< fix type
+        bool fixOk; //!< fix within the receiver's accuracy limits
+        int numSatellites; //!< satellites used in the solution
+        qreal latitude; //!< degrees
+        qreal longitude; //!< degrees
+        qreal altitude; //!< meters above mean sea level
+        qreal speed; //!< ground speed (m/s)
+        qreal heading; //!< heading of motion (degrees)
+        qreal speedAccuracy; //!< speed accuracy estimate (m/s)
+        qreal horizontalAccuracy; //!< position accuracy estimate (m)
+    } NavPvt_t;
+
+    /**
+     * @brief Parse every complete frame in a buffer
+     * @param data: received bytes
+     * @param size: number of bytes
+     * @param onPvt: called with each NAV-PVT solution (const NavPvt_t &)
+     * @return bytes used -- anything after them is the start of a frame, keep it for the next call
+     */
+    template <class F>
+    int parse(const char * data, int size, F onPvt) {
+        int pos = 0;
+        while (pos < size) {
+            const void * sync = std::memchr(data + pos, SYNC_1, size - pos);
+            if (sync == nullptr) {
+                return size;
+            }
+            pos = static_cast<const char *>(sync) - data;
+
+            const uchar * frame = reinterpret_cast<const uchar *>(data + pos);
+            int available = size - pos;
+            if (available < HEADER_SIZE) {
+                return pos;
+            }
+
+            int length = qFromLittleEndian<quint16>(frame + 4);
+            if (frame[1] != SYNC_2 || length > MAX_PAYLOAD) {
+                pos++;
+                continue;
+            }
+
+            int frameSize = HEADER_SIZE + length + CHECKSUM_SIZE;
+            if (available < frameSize) {
+                return pos;
+            }
+
+            quint8 a = 0, b = 0;
+            checksum(frame + 2, 4 + length, a, b);
+            if (a != frame[HEADER_SIZE + length] || b != frame[HEADER_SIZE + length + 1]) {
+                // a false sync inside other data -- resync from the next byte
+                mChecksumErrors++;
+                pos++;
+                continue;
+            }
+
+            mFrames++;
+            if (frame[2] == CLASS_NAV && frame[3] == NAV_PVT && length >= NAV_PVT_SIZE) {
+                onPvt(decodeNavPvt(frame + HEADER_SIZE));
+            }
+            pos += frameSize;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Get the number of good frames parsed
+     * @return frames
+     */
+    quint64 getFrames() const {
+        return mFrames;
+    }
+
+    /**
+     * @brief Get the number of frames dropped for a bad checksum
+     * @return frames
+     */
+    quint64 getChecksumErrors() const {
+        return mChecksumErrors;
+    }
+
+    /**
+     * @brief Decode a NAV-PVT payload
+     * @param p: payload, at least NAV_PVT_SIZE bytes
+     * @return solution
+     */
+    static NavPvt_t decodeNavPvt(const uchar * p) {
+        NavPvt_t pvt;
+
+        // valid date and time, and the second fully resolved -- before the
+        // leap seconds are known the time can be seconds off
+        pvt.utcNsec = 0;
+        if ((p[11] & 0x07) == 0x07) {
+            QDateTime utc(QDate(qFromLittleEndian<quint16>(p + 4), p[6], p[7]),
+                          QTime(p[8], p[9], qMin<int>(p[10], 59)), Qt::UTC);
+            if (utc.isValid()) {
+                pvt.utcNsec = utc.toMSecsSinceEpoch() * 1000000 + qFromLittleEndian<qint32>(p + 16);
+            }
+        }
+
+        pvt.fixType = static_cast<FixType>(qMin<int>(p[20], (int) FixType::TIME_ONLY));
+        pvt.fixOk = p[21] & 0x01;
+        pvt.numSatellites = p[23];
+        pvt.longitude = qFromLittleEndian<qint32>(p + 24) * 1e-7;
+        pvt.latitude = qFromLittleEndian<qint32>(p + 28) * 1e-7;
+        pvt.altitude = qFromLittleEndian<qint32>(p + 36) * 1e-3;
+        pvt.horizontalAccuracy = qFromLittleEndian<quint32>(p + 40) * 1e-3;
+        pvt.speed = qFromLittleEndian<qint32>(p + 60) * 1e-3;
+        pvt.heading = qFromLittleEndian<qint32>(p + 64) * 1e-5;
+        pvt.speedAccuracy = qFromLittleEndian<quint32>(p + 68) * 1e-3;
+        return pvt;
+    }
+
+    /**
+     * @brief Build a UBX frame
+     * @param cls: message class
+     * @param id: message id
+     * @param payload: payload
+     * @return frame with checksum
+     */
+    static QByteArray message(quint8 cls, quint8 id, QByteArray payload) {
+        QByteArray frame;
+        frame.reserve(HEADER_SIZE + payload.size() + CHECKSUM_SIZE);
+        frame.append((char) SYNC_1);
+        frame.append((char) SYNC_2);
+        frame.append((char) cls);
+        frame.append((char) id);
+        frame.append((char) (payload.size() & 0xFF));
+        frame.append((char) ((payload.size() >> 8) & 0xFF));
+        frame.append(payload);
+
+        quint8 a = 0, b = 0;
+        checksum(reinterpret_cast<const uchar *>(frame.constData()) + 2, frame.size() - 2, a, b);
+        frame.append((char) a);
+        frame.append((char) b);
+        return frame;
+    }
+
+    /**
+     * @brief CFG-RATE -- measurement rate, one solution per measurement, GPS time aligned
+     * @param measurementMsec: milliseconds between measurements
+     * @return frame
+     */
+    static QByteArray cfgRate(int measurementMsec) {
+        QByteArray payload(6, 0);
+        qToLittleEndian<quint16>(measurementMsec, payload.data());
+        qToLittleEndian<quint16>(1, payload.data() + 2);
+        qToLittleEndian<quint16>(1, payload.data() + 4);
+        return message(CLASS_CFG, CFG_RATE, payload);
+    }
+
+    /**
+     * @brief CFG-MSG -- output rate of a message on the port the config arrives on
+     * @param cls: message class
+     * @param id: message id
+     * @param rate: output every rate solutions, 0 for off
+     * @return frame
+     */
+    static QByteArray cfgMsg(quint8 cls, quint8 id, quint8 rate) {
+        QByteArray payload;
+        payload.append((char) cls);
+        payload.append((char) id);
+        payload.append((char) rate);
+        return message(CLASS_CFG, CFG_MSG, payload);
+    }
+
+    /**
+     * @brief CFG-PRT for the USB port
+     * @param inProtocols: protocol mask accepted
+     * @param outProtocols: protocol mask sent
+     * @return frame
+     */
+    static QByteArray cfgPrtUsb(quint16 inProtocols, quint16 outProtocols) {
+        QByteArray payload(20, 0);
+        payload[0] = (char) PORT_USB;
+        qToLittleEndian<quint16>(inProtocols, payload.data() + 12);
+        qToLittleEndian<quint16>(outProtocols, payload.data() + 14);
+        return message(CLASS_CFG, CFG_PRT, payload);
+    }
+
+private:
+    quint64 mFrames = 0; //!< good frames parsed
+    quint64 mChecksumErrors = 0; //!< frames dropped for a bad checksum
+
+    /**
+     * @brief 8-bit Fletcher checksum
+     * @param data: class through payload
+     * @param size: number of bytes
+     * @param a: first checksum byte
+     * @param b: second checksum byte
+     */
+    static void checksum(const uchar * data, int size, quint8 & a, quint8 & b) {
+        a = 0;
+        b = 0;
+        for (int i = 0; i < size; i++) {
+            a += data[i];
+            b += a;
+        }
+    }
+};
+
+#endif // UBX_PARSER_H
@@ -9,6 +9,7 @@
 #include <cstring>
 #include <filesystem>
 #include <map>
+#include <atomic>
 #include <cmath>
 #include <sensor_utils.h>
 #include <pulse_counter.h>
@@ -43,27 +44,55 @@ public:
 
     /**
      * @brief Get speed in mph
-     * @return speed in mph
+     * @return speed in mph, -1 if invalid
      */
     qreal getMph() {
         qreal pulsesPerSecond = getFrequency();
-        return pulsesPerSecond * (1.0 / mConfig.pulsePerUnitDistance) * 3600.0;
+        if (pulsesPerSecond < 0) {
+            return -1;
+        }
+        return pulsesPerSecond * (getCalibration() / mConfig.pulsePerUnitDistance) * 3600.0;
     }
 
     /**
      * @brief Get speed in kph
-     * @return speed in kph
+     * @return speed in kph, -1 if invalid
      */
     qreal getKph() {
         qreal mph = getMph();
+        if (mph < 0) {
+            return -1;
+        }
         return SensorUtils::toMeters(mph, Config::DistanceUnits::MILE) / 1000.0;
     }
 
+    /**
+     * @brief Get the distance between pulses
+     * @return meters per pulse
+     */
+    qreal getMetersPerPulse() {
+        return SensorUtils::toMeters(getCalibration() / mConfig.pulsePerUnitDistance, mConfig.distanceUnits);
+    }
+
+    /**
+     * @brief Set the calibration factor -- true distance over configured distance.
+     * The speed can be read on the acquisition thread while this is set.
+     * @param calibration: scales speed and distance per pulse
+     */
+    void setCalibration(qreal calibration) {
+        mCalibration.store(calibration, std::memory_order_relaxed);
+    }
+
+    qreal getCalibration() {
+        return mCalibration.load(std::memory_order_relaxed);
+    }
+
 
 private:
     static constexpr char DEFAULT_VSS_PULSE_PATH[] = "/sys/class/volvo_dash/vss_counter/"; //!< default pulse counter location
 
     Config::VssInputConfig_t mConfig; //!< VSS configuration
+    std::atomic<qreal> mCalibration{1.0}; //!< learned correction of the configured pulses per distance
 };
 
 #endif // VSS_INPUT_H
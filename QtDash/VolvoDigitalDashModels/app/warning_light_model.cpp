@@ -133,6 +133,9 @@ QColor WarningLightModel::lightColor()
 
 void WarningLightModel::setOn(bool on)
 {
+    if (on == mOn) {
+        return;
+    }
     mOn = on;
     emit dataChanged(createIndex(0,0),
                      createIndex(1, 0),
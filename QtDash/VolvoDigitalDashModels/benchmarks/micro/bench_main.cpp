@@ -0,0 +1,22 @@
+#include <QTest>
+
+#include <sensor_utils_bench.h>
+#include <ntc_bench.h>
+#include <map_bench.h>
+#include <can_frame_bench.h>
+
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    auto ASSERT_TEST = [&status, argc, argv](QObject* obj) {
+      status |= QTest::qExec(obj, argc, argv);
+      delete obj;
+    };
+
+    ASSERT_TEST(new SensorUtilsBench());
+    ASSERT_TEST(new NtcBench());
+    ASSERT_TEST(new MapBench());
+    ASSERT_TEST(new CanFrameBench());
+
+    return status;
+}
@@ -0,0 +1,47 @@
+#include "can_frame_bench.h"
+#include <can_frame_config.h>
+
+void CanFrameBench::bench_getValue() {
+    QFETCH(int, payloadSize);
+    QFETCH(int, offset);
+    QFETCH(int, size);
+    QFETCH(bool, sign);
+    QFETCH(bool, operations);
+
+    CanFrameConfig config(0x5e8, offset, size, sign, "kPa", "map", "boost");
+    if (operations) {
+        config.addOperation(CanFrameConfig::OperationType::MULTIPLY, 1.8);
+        config.addOperation(CanFrameConfig::OperationType::DIVIDE, 10);
+        config.addOperation(CanFrameConfig::OperationType::ADD, 32);
+    }
+
+    QByteArray payload(payloadSize, 0);
+    for (int i = 0; i < payloadSize; i++) {
+        payload[i] = static_cast<char>(i * 37);
+    }
+
+    qreal sum = 0;
+    QBENCHMARK {
+        sum += config.getValue(payload);
+    }
+    mSink = sum;
+}
+
+void CanFrameBench::bench_getValue_data() {
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("sign");
+    QTest::addColumn<bool>("operations");
+
+    // classic CAN (8 byte) payloads
+    QTest::newRow("8B u8") << 8 << 0 << 1 << false << false;
+    QTest::newRow("8B s16") << 8 << 0 << 2 << true << false;
+    QTest::newRow("8B s16 ops") << 8 << 0 << 2 << true << true;
+    QTest::newRow("8B u32 offset 4") << 8 << 4 << 4 << false << false;
+    QTest::newRow("8B s16 offset 6 ops") << 8 << 6 << 2 << true << true;
+
+    // CAN FD (64 byte) payloads
+    QTest::newRow("64B s16 ops") << 64 << 0 << 2 << true << true;
+    QTest::newRow("64B s32 offset 60 ops") << 64 << 60 << 4 << true << true;
+}
@@ -0,0 +1,22 @@
+#ifndef CAN_FRAME_BENCH_H
+#define CAN_FRAME_BENCH_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+
+class CanFrameBench : public QObject
+{
+    Q_OBJECT
+public:
+
+signals:
+
+private slots:
+    void bench_getValue();
+    void bench_getValue_data();
+
+private:
+    volatile qreal mSink = 0; //!< keeps the benchmarked results alive
+};
+
+#endif // CAN_FRAME_BENCH_H
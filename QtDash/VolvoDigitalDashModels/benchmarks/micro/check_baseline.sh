@@ -0,0 +1,108 @@
+#!/bin/sh
+#
+# Run DashMicroBenchmarks and compare the results against the committed baseline.
+#
+# usage: check_baseline.sh [-m walltime|callgrind|perf] [-t threshold_pct] [-u] <DashMicroBenchmarks>
+#   -m  measurement mode (default callgrind -- instruction counts are stable across runs)
+#   -t  allowed slowdown in percent before a result counts as a regression
+#   -u  update the baseline with the current results instead of checking
+#
+# Exits 1 if any benchmark is slower than baseline * (1 + threshold / 100), or has
+# no baseline -- an unchecked result isn't a pass. A baseline with no results yet
+# (not recorded on the reference target) only reports them as NEW.
+
+MODE=callgrind
+THRESHOLD=
+UPDATE=0
+
+while getopts "m:t:u" opt; do
+    case $opt in
+        m) MODE=$OPTARG ;;
+        t) THRESHOLD=$OPTARG ;;
+        u) UPDATE=1 ;;
+        *) sed -n '3,12p' "$0"; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+BIN=$1
+if [ -z "$BIN" ] || [ ! -x "$BIN" ]; then
+    sed -n '3,12p' "$0"
+    exit 2
+fi
+
+case $MODE in
+    walltime)  FLAG= ; DEFAULT_THRESHOLD=20 ;;
+    callgrind) FLAG=-callgrind ; DEFAULT_THRESHOLD=2 ;;
+    perf)      FLAG=-perf ; DEFAULT_THRESHOLD=10 ;;
+    *) echo "unknown mode: $MODE"; exit 2 ;;
+esac
+[ -z "$THRESHOLD" ] && THRESHOLD=$DEFAULT_THRESHOLD
+
+BASELINE="$(dirname "$0")/baselines/$MODE.csv"
+CURRENT=$(mktemp)
+trap 'rm -f "$CURRENT"' EXIT
+
+# QtTest csv lines: "function","tag","metric",value_per_iteration,total,iterations
+"$BIN" -csv $FLAG | grep '^"' > "$CURRENT"
+if [ ! -s "$CURRENT" ]; then
+    echo "no benchmark results produced"
+    exit 1
+fi
+
+if [ $UPDATE -eq 1 ]; then
+    {
+        echo "# DashMicroBenchmarks baseline ($MODE): \"function\",\"tag\",\"metric\",value_per_iteration,total,iterations"
+        echo "# regenerate on the reference target with: check_baseline.sh -m $MODE -u <DashMicroBenchmarks>"
+        cat "$CURRENT"
+    } > "$BASELINE"
+    echo "baseline updated: $BASELINE"
+    exit 0
+fi
+
+if [ ! -f "$BASELINE" ]; then
+    echo "no baseline for mode $MODE, create one with -u"
+    exit 1
+fi
+
+awk -F',' -v threshold="$THRESHOLD" '
+    # first file: baseline -- by name, an empty baseline has no records for FNR == NR
+    FILENAME == ARGV[1] {
+        if ($0 !~ /^#/ && NF >= 4) {
+            base[$1 "," $2 "," $3] = $4
+            recorded = 1
+        }
+        next
+    }
+    # second file: current results
+    {
+        key = $1 "," $2 "," $3
+        seen[key] = 1
+        if (!(key in base)) {
+            printf "NEW        %s %s (no baseline)\n", key, $4
+            if (recorded) {
+                failed = 1
+            }
+            next
+        }
+        limit = base[key] * (1 + threshold / 100.0)
+        change = base[key] > 0 ? ($4 - base[key]) * 100.0 / base[key] : 0
+        if ($4 > limit) {
+            printf "REGRESSION %s %s -> %s (%+.1f%%)\n", key, base[key], $4, change
+            failed = 1
+        } else {
+            printf "OK         %s %s -> %s (%+.1f%%)\n", key, base[key], $4, change
+        }
+    }
+    END {
+        for (key in base) {
+            if (!(key in seen)) {
+                printf "MISSING    %s\n", key
+            }
+        }
+        if (!recorded) {
+            print "baseline not recorded yet, nothing checked -- record it on the reference target with -u"
+        }
+        exit failed
+    }
+' "$BASELINE" "$CURRENT"
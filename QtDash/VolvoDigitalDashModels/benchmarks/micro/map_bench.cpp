@@ -0,0 +1,25 @@
+#include "map_bench.h"
+#include <map_sensor.h>
+
+void MapBench::bench_getAbsolutePressure() {
+    QFETCH(int, units);
+
+    // 3 bar sensor from the default config.ini
+    MapSensor sensor(3.6, 315, 5.0, Config::PressureUnits::KPA);
+    Config::PressureUnits u = static_cast<Config::PressureUnits>(units);
+
+    qreal volts = 1.8;
+    qreal sum = 0;
+    QBENCHMARK {
+        sum += sensor.getAbsolutePressure(volts, u);
+    }
+    mSink = sum;
+}
+
+void MapBench::bench_getAbsolutePressure_data() {
+    QTest::addColumn<int>("units");
+
+    QTest::newRow("kpa") << static_cast<int>(Config::PressureUnits::KPA);
+    QTest::newRow("psi") << static_cast<int>(Config::PressureUnits::PSI);
+    QTest::newRow("bar") << static_cast<int>(Config::PressureUnits::BAR);
+}
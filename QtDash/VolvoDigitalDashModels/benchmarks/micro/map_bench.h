@@ -0,0 +1,23 @@
+#ifndef MAP_BENCH_H
+#define MAP_BENCH_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <config.h>
+
+class MapBench : public QObject
+{
+    Q_OBJECT
+public:
+
+signals:
+
+private slots:
+    void bench_getAbsolutePressure();
+    void bench_getAbsolutePressure_data();
+
+private:
+    volatile qreal mSink = 0; //!< keeps the benchmarked results alive
+};
+
+#endif // MAP_BENCH_H
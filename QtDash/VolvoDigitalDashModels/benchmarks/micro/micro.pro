@@ -0,0 +1,34 @@
+QT += core testlib
+
+TARGET = DashMicroBenchmarks
+TEMPLATE = app
+
+CONFIG += console
+CONFIG += c++17
+
+SOURCES += \
+    can_frame_bench.cpp \
+    map_bench.cpp \
+    ntc_bench.cpp \
+    sensor_utils_bench.cpp \
+    bench_main.cpp
+
+INCLUDEPATH += \
+    ../../app/
+
+HEADERS += \
+    ../../app/can_frame_config.h\
+    ../../app/config.h\
+    ../../app/map_sensor.h\
+    ../../app/ntc.h\
+    ../../app/sensor_utils.h\
+    can_frame_bench.h \
+    map_bench.h \
+    ntc_bench.h \
+    sensor_utils_bench.h
+
+DISTFILES += \
+    check_baseline.sh \
+    baselines/walltime.csv \
+    baselines/callgrind.csv \
+    baselines/perf.csv
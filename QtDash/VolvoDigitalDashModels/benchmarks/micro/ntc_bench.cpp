@@ -0,0 +1,37 @@
+#include "ntc_bench.h"
+#include <ntc.h>
+
+void NtcBench::bench_ntcConstructor() {
+    Config::TempSensorConfig_t config = coolantConfig();
+
+    qreal sum = 0;
+    QBENCHMARK {
+        Ntc ntc(config);
+        sum += ntc.getCoefficients().A;
+    }
+    mSink = sum;
+}
+
+void NtcBench::bench_calculateTemp() {
+    QFETCH(qreal, volts);
+    QFETCH(int, units);
+
+    Ntc ntc(coolantConfig());
+    Config::TemperatureUnits u = static_cast<Config::TemperatureUnits>(units);
+
+    qreal sum = 0;
+    QBENCHMARK {
+        sum += ntc.calculateTemp(volts, u);
+    }
+    mSink = sum;
+}
+
+void NtcBench::bench_calculateTemp_data() {
+    QTest::addColumn<qreal>("volts");
+    QTest::addColumn<int>("units");
+
+    QTest::newRow("kelvin") << 1.2 << static_cast<int>(Config::TemperatureUnits::KELVIN);
+    QTest::newRow("celsius") << 1.2 << static_cast<int>(Config::TemperatureUnits::CELSIUS);
+    QTest::newRow("fahrenheit") << 1.2 << static_cast<int>(Config::TemperatureUnits::FAHRENHEIT);
+    QTest::newRow("fahrenheit (open circuit)") << 5.0 << static_cast<int>(Config::TemperatureUnits::FAHRENHEIT);
+}
@@ -0,0 +1,44 @@
+#ifndef NTC_BENCH_H
+#define NTC_BENCH_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <config.h>
+
+class NtcBench : public QObject
+{
+    Q_OBJECT
+public:
+
+signals:
+
+private slots:
+    void bench_ntcConstructor();
+
+    void bench_calculateTemp();
+    void bench_calculateTemp_data();
+
+private:
+    volatile qreal mSink = 0; //!< keeps the benchmarked results alive
+
+    /**
+     * @brief Coolant sensor config from the default config.ini
+     * @return temp sensor config
+     */
+    static Config::TempSensorConfig_t coolantConfig() {
+        Config::TempSensorConfig_t config;
+        config.t1 = 60;
+        config.r1 = 217;
+        config.t2 = 90;
+        config.r2 = 87;
+        config.t3 = 100;
+        config.r3 = 67;
+        config.rBalance = 470;
+        config.vSupply = 5.0;
+        config.type = Config::TemperatureSensorType::COOLANT;
+        config.units = Config::TemperatureUnits::CELSIUS;
+        return config;
+    }
+};
+
+#endif // NTC_BENCH_H
@@ -0,0 +1,90 @@
+#include "sensor_utils_bench.h"
+#include <sensor_utils.h>
+
+void SensorUtilsBench::bench_convert() {
+    QFETCH(qreal, value);
+    QFETCH(QString, to);
+    QFETCH(QString, from);
+
+    qreal sum = 0;
+    QBENCHMARK {
+        sum += SensorUtils::convert(value, to, from);
+    }
+    mSink = sum;
+}
+
+void SensorUtilsBench::bench_convert_data() {
+    QTest::addColumn<qreal>("value");
+    QTest::addColumn<QString>("to");
+    QTest::addColumn<QString>("from");
+
+    // ordered roughly by how far down the string dispatch the source units are
+    QTest::newRow("F->F (same units)") << 180.0 << QString(Config::UNITS_F) << QString(Config::UNITS_F);
+    QTest::newRow("C->F") << 85.0 << QString(Config::UNITS_F) << QString(Config::UNITS_C);
+    QTest::newRow("kpa->psi") << 150.0 << QString(Config::UNITS_PSI) << QString(Config::UNITS_KPA);
+    QTest::newRow("bar->psi") << 3.5 << QString(Config::UNITS_PSI) << QString(Config::UNITS_BAR);
+    QTest::newRow("kph->mph") << 100.0 << QString(Config::UNITS_MPH) << QString(Config::UNITS_KPH);
+    QTest::newRow("m/s->mph") << 27.0 << QString(Config::UNITS_MPH) << QString(Config::UNITS_METERS_PER_SECOND);
+    QTest::newRow("inch->mile") << 24.9 << QString(Config::UNITS_MILE) << QString(Config::UNITS_INCH);
+    QTest::newRow("yard->mile") << 440.0 << QString(Config::UNITS_MILE) << QString(Config::UNITS_YARD);
+    QTest::newRow("V->V (unknown units)") << 13.8 << QString("V") << QString("volts");
+}
+
+void SensorUtilsBench::bench_polynomialValue() {
+    QFETCH(int, order);
+
+    QList<qreal> coeff;
+    for (int i = 0; i <= order; i++) {
+        coeff.append(1.0 / (i + 1));
+    }
+
+    qreal x = 87.0;
+    qreal sum = 0;
+    QBENCHMARK {
+        sum += SensorUtils::polynomialValue(x, coeff);
+    }
+    mSink = sum;
+}
+
+void SensorUtilsBench::bench_polynomialValue_data() {
+    QTest::addColumn<int>("order");
+
+    QTest::newRow("order 1") << 1;
+    QTest::newRow("order 2") << 2;
+    QTest::newRow("order 3") << 3;
+    QTest::newRow("order 5") << 5;
+}
+
+void SensorUtilsBench::bench_polynomialRegression() {
+    QFETCH(QList<qreal>, x);
+    QFETCH(QList<qreal>, y);
+    QFETCH(int, order);
+
+    qreal sum = 0;
+    QBENCHMARK {
+        sum += SensorUtils::polynomialRegression(x, y, order).at(0);
+    }
+    mSink = sum;
+}
+
+void SensorUtilsBench::bench_polynomialRegression_data() {
+    QTest::addColumn<QList<qreal>>("x");
+    QTest::addColumn<QList<qreal>>("y");
+    QTest::addColumn<int>("order");
+
+    // curves from the default config.ini
+    QTest::newRow("oil pressure 5pts order 2")
+            << QList<qreal>({10.0, 48.0, 82.0, 116.0, 184.0})
+            << QList<qreal>({0.0, 1.0, 2.0, 3.0, 5.0})
+            << 2;
+
+    QTest::newRow("fuel level 9pts order 3")
+            << QList<qreal>({240, 196, 153, 125, 103, 87, 67, 45, 33})
+            << QList<qreal>({0.0, 12.5, 25.0, 37.5, 50.0, 62.5, 75.0, 87.5, 100})
+            << 3;
+
+    QTest::newRow("12v input 11pts order 3")
+            << QList<qreal>({1.05, 1.15, 1.25, 1.35, 1.45, 1.55, 1.65, 1.76, 1.85, 1.95, 2.05})
+            << QList<qreal>({8.25, 9.05, 9.87, 10.67, 11.52, 12.37, 13.30, 14.15, 14.96, 15.78, 16.78})
+            << 3;
+}
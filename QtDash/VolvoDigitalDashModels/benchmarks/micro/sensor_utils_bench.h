@@ -0,0 +1,29 @@
+#ifndef SENSOR_UTILS_BENCH_H
+#define SENSOR_UTILS_BENCH_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <config.h>
+
+class SensorUtilsBench : public QObject
+{
+    Q_OBJECT
+public:
+
+signals:
+
+private slots:
+    void bench_convert();
+    void bench_convert_data();
+
+    void bench_polynomialValue();
+    void bench_polynomialValue_data();
+
+    void bench_polynomialRegression();
+    void bench_polynomialRegression_data();
+
+private:
+    volatile qreal mSink = 0; //!< keeps the benchmarked results alive
+};
+
+#endif // SENSOR_UTILS_BENCH_H
@@ -0,0 +1,94 @@
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#include <perf_counters.h>
+
+std::atomic<uint64_t> AllocationCounter::sAllocations(0);
+std::atomic<uint64_t> AllocationCounter::sBytes(0);
+
+#if defined(__GLIBC__)
+// Interpose the C allocator so Qt's own QArrayData/QVariant allocations (which
+// go straight to malloc) are counted as well as operator new. The aligned
+// allocators are hooked too -- the aligned operator new and Eigen's fixed size
+// vectorizable types allocate through them rather than malloc.
+extern "C" {
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t n, std::size_t size);
+void * __libc_realloc(void * p, std::size_t size);
+void __libc_free(void * p);
+void * __libc_memalign(std::size_t alignment, std::size_t size);
+
+void * malloc(std::size_t size) {
+    AllocationCounter::record(size);
+    return __libc_malloc(size);
+}
+
+void * calloc(std::size_t n, std::size_t size) {
+    AllocationCounter::record(n * size);
+    return __libc_calloc(n, size);
+}
+
+void * realloc(void * p, std::size_t size) {
+    AllocationCounter::record(size);
+    return __libc_realloc(p, size);
+}
+
+void free(void * p) {
+    __libc_free(p);
+}
+
+void * memalign(std::size_t alignment, std::size_t size) {
+    AllocationCounter::record(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void ** p, std::size_t alignment, std::size_t size) {
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    AllocationCounter::record(size);
+    void * memory = __libc_memalign(alignment, size);
+    if (memory == nullptr) {
+        return ENOMEM;
+    }
+    *p = memory;
+    return 0;
+}
+
+void * aligned_alloc(std::size_t alignment, std::size_t size) {
+    AllocationCounter::record(size);
+    return __libc_memalign(alignment, size);
+}
+}
+#else
+// Non-glibc hosts: only C++ allocations can be counted portably.
+void * operator new(std::size_t size) {
+    AllocationCounter::record(size);
+    void * p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void * operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
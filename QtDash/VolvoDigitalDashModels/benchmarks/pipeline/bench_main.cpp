@@ -0,0 +1,179 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QQmlEngine>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QFile>
+#include <iostream>
+#include <sstream>
+
+#include <config.h>
+#include <pipeline_benchmark.h>
+
+#ifndef BENCHMARK_CONFIG_DIR
+#define BENCHMARK_CONFIG_DIR "./"
+#endif
+
+#ifndef GIT_COMMIT
+#define GIT_COMMIT "unknown"
+#endif
+
+static constexpr char FORMAT_JSON[] = "json";
+static constexpr char FORMAT_CSV[] = "csv";
+
+/**
+ * @brief Convert a scenario result to json
+ * @param r: scenario result
+ * @return json object
+ */
+static QJsonObject toJson(const PipelineBenchmark::ScenarioResult_t & r) {
+    QJsonObject o;
+    o["name"] = r.name;
+    o["samples"] = r.samples;
+    o["total_ns"] = r.totalNs;
+    o["samples_per_sec"] = r.samplesPerSec;
+    o["latency_min_ns"] = r.latencyMinNs;
+    o["latency_mean_ns"] = r.latencyMeanNs;
+    o["latency_p50_ns"] = r.latencyP50Ns;
+    o["latency_p99_ns"] = r.latencyP99Ns;
+    o["latency_max_ns"] = r.latencyMaxNs;
+    o["allocations_per_sample"] = r.allocationsPerSample;
+    o["alloc_bytes_per_sample"] = r.bytesPerSample;
+    o["cache_misses"] = r.cacheMisses;
+    o["cache_references"] = r.cacheReferences;
+    o["instructions"] = r.instructions;
+    o["cache_misses_per_sample"] = r.cacheMisses < 0 ? -1.0 : (qreal) r.cacheMisses / r.samples;
+    return o;
+}
+
+/**
+ * @brief Convert a scenario result to a csv line
+ * @param r: scenario result
+ * @return csv line
+ */
+static QString toCsv(const PipelineBenchmark::ScenarioResult_t & r) {
+    return QStringList({
+        r.name,
+        QString::number(r.samples),
+        QString::number(r.totalNs),
+        QString::number(r.samplesPerSec, 'f', 1),
+        QString::number(r.latencyMinNs, 'f', 1),
+        QString::number(r.latencyMeanNs, 'f', 1),
+        QString::number(r.latencyP50Ns, 'f', 1),
+        QString::number(r.latencyP99Ns, 'f', 1),
+        QString::number(r.latencyMaxNs, 'f', 1),
+        QString::number(r.allocationsPerSample, 'f', 3),
+        QString::number(r.bytesPerSample, 'f', 1),
+        QString::number(r.cacheMisses),
+        QString::number(r.cacheReferences),
+        QString::number(r.instructions)
+    }).join(",");
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("DashPipelineBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless sensor -> gauge -> model pipeline benchmark");
+    parser.addHelpOption();
+    QCommandLineOption samplesOption({"n", "samples"}, "Measured samples per scenario.", "count", "100000");
+    QCommandLineOption warmupOption({"w", "warmup"}, "Unmeasured warmup samples per scenario.", "count", "1000");
+    QCommandLineOption scenarioOption({"s", "scenario"}, "Scenario to run (repeatable, default all).", "name");
+    QCommandLineOption formatOption({"f", "format"}, "Output format: json or csv.", "format", FORMAT_JSON);
+    QCommandLineOption outputOption({"o", "output"}, "Output file (default stdout).", "file");
+    QCommandLineOption configOption("config-dir", "Directory holding config*.ini.", "dir", BENCHMARK_CONFIG_DIR);
+    QCommandLineOption listOption({"l", "list"}, "List scenarios and exit.");
+    parser.addOptions({samplesOption, warmupOption, scenarioOption, formatOption,
+                       outputOption, configOption, listOption});
+    parser.process(app);
+
+    // keep the config/adc/qml setup chatter off stdout so the results stay machine readable
+    qInstallMessageHandler([](QtMsgType, const QMessageLogContext &, const QString &) {});
+    std::ostringstream setupLog;
+    std::streambuf * coutBuffer = std::cout.rdbuf(setupLog.rdbuf());
+
+    QString configDir = parser.value(configOption);
+    if (!configDir.endsWith("/")) {
+        configDir += "/";
+    }
+
+    Config config(&app,
+                  configDir + "config.ini",
+                  configDir + "config_gauges.ini",
+                  configDir + "config_odo.ini",
+                  configDir + "config_can.ini");
+
+    QQmlEngine engine;
+    PipelineBenchmark benchmark(&app, &config, engine.rootContext());
+    std::cout.rdbuf(coutBuffer);
+
+    if (parser.isSet(listOption)) {
+        for (QString name : benchmark.getScenarioNames()) {
+            std::cout << name.toStdString() << std::endl;
+        }
+        return 0;
+    }
+
+    QStringList scenarios = parser.values(scenarioOption);
+    if (scenarios.isEmpty()) {
+        scenarios = benchmark.getScenarioNames();
+    }
+
+    int samples = parser.value(samplesOption).toInt();
+    int warmup = parser.value(warmupOption).toInt();
+
+    QList<PipelineBenchmark::ScenarioResult_t> results;
+    for (QString name : scenarios) {
+        if (!benchmark.hasScenario(name)) {
+            std::cerr << "Unknown scenario: " << name.toStdString() << std::endl;
+            return 1;
+        }
+        results.append(benchmark.run(name, samples, warmup));
+    }
+
+    // format results
+    QByteArray out;
+    if (parser.value(formatOption) == FORMAT_CSV) {
+        QStringList lines;
+        lines.append("name,samples,total_ns,samples_per_sec,latency_min_ns,latency_mean_ns,"
+                     "latency_p50_ns,latency_p99_ns,latency_max_ns,allocations_per_sample,"
+                     "alloc_bytes_per_sample,cache_misses,cache_references,instructions");
+        for (auto r : results) {
+            lines.append(toCsv(r));
+        }
+        out = lines.join("\n").toUtf8() + "\n";
+    } else {
+        QJsonArray array;
+        for (auto r : results) {
+            array.append(toJson(r));
+        }
+
+        QJsonObject root;
+        root["benchmark"] = "sensor_pipeline";
+        root["commit"] = GIT_COMMIT;
+        root["qt_version"] = qVersion();
+        root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        root["samples"] = samples;
+        root["warmup"] = warmup;
+        root["results"] = array;
+        out = QJsonDocument(root).toJson();
+    }
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << "Unable to open output file" << std::endl;
+            return 1;
+        }
+        file.write(out);
+        file.close();
+    } else {
+        std::cout << out.toStdString();
+    }
+
+    return 0;
+}
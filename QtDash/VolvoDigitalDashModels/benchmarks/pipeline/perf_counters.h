@@ -0,0 +1,133 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/**
+ * @brief Counts heap allocations made by the process. The allocator hooks
+ * live in allocation_counter.cpp and bump these counters.
+ */
+class AllocationCounter {
+public:
+    /**
+     * @brief Number of allocations since start
+     * @return allocation count
+     */
+    static uint64_t count() {
+        return sAllocations.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of bytes allocated since start
+     * @return allocated bytes
+     */
+    static uint64_t bytes() {
+        return sBytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record an allocation (called from the allocator hooks)
+     * @param size: allocation size in bytes
+     */
+    static void record(std::size_t size) {
+        sAllocations.fetch_add(1, std::memory_order_relaxed);
+        sBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<uint64_t> sAllocations; //!< total allocations
+    static std::atomic<uint64_t> sBytes; //!< total bytes allocated
+};
+
+/**
+ * @brief Thin wrapper around a Linux perf_event hardware counter for the calling thread.
+ * isValid() is false when the kernel/CPU doesn't expose the counter (VMs, containers,
+ * perf_event_paranoid too strict, non-linux hosts) -- results are then reported as -1.
+ */
+class PerfEventCounter {
+public:
+    /**
+     * @brief PerfEventCounter constructor
+     * @param type: perf event type (PERF_TYPE_HARDWARE, ...)
+     * @param config: perf event config (PERF_COUNT_HW_CACHE_MISSES, ...)
+     */
+    PerfEventCounter(uint32_t type, uint64_t config) {
+#ifdef __linux__
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        mFd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void) type;
+        (void) config;
+#endif
+    }
+
+    ~PerfEventCounter() {
+#ifdef __linux__
+        if (mFd >= 0) {
+            close(mFd);
+        }
+#endif
+    }
+
+    PerfEventCounter(const PerfEventCounter &) = delete;
+    PerfEventCounter &operator=(const PerfEventCounter &) = delete;
+
+    /**
+     * @brief Check that the counter could be opened
+     * @return true if counter is available
+     */
+    bool isValid() const {
+        return mFd >= 0;
+    }
+
+    /**
+     * @brief Reset and start counting
+     */
+    void start() {
+#ifdef __linux__
+        if (mFd >= 0) {
+            ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stop counting and read the counter
+     * @return counter value, -1 if unavailable
+     */
+    int64_t stop() {
+#ifdef __linux__
+        if (mFd >= 0) {
+            ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value = 0;
+            if (read(mFd, &value, sizeof(value)) == sizeof(value)) {
+                return static_cast<int64_t>(value);
+            }
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int mFd = -1; //!< perf event file descriptor
+};
+
+#endif // PERF_COUNTERS_H
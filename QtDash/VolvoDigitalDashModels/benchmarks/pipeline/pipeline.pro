@@ -0,0 +1,65 @@
+QT += core qml positioning serialport
+
+TARGET = DashPipelineBenchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG += c++17
+
+# default config location (QtDash/config*.ini) and commit id for the results
+DEFINES += BENCHMARK_CONFIG_DIR=\\\"$$PWD/../../../\\\"
+GIT_COMMIT = $$system(git -C $$PWD rev-parse --short HEAD)
+!isEmpty(GIT_COMMIT): DEFINES += GIT_COMMIT=\\\"$$GIT_COMMIT\\\"
+
+SOURCES += \
+    ../../app/accessory_gauge_model.cpp \
+    ../../app/speedometer_model.cpp \
+    ../../app/tachometer_model.cpp \
+    ../../app/temp_and_fuel_gauge_model.cpp \
+    allocation_counter.cpp \
+    bench_main.cpp
+
+# QtDash/eigen -- sensor_utils.h includes it relative to ../../app/
+INCLUDEPATH += \
+    ../../app/ \
+    ../../../eigen/
+
+HEADERS += \
+    ../../app/config.h\
+    ../../app/sensor.h\
+    ../../app/sensor_source.h\
+    ../../app/sensor_source_adc.h\
+    ../../app/sensor_source_tach.h\
+    ../../app/sensor_source_vss.h\
+    ../../app/accessory_gauge_model.h\
+    ../../app/speedometer_model.h\
+    ../../app/tachometer_model.h\
+    ../../app/temp_and_fuel_gauge_model.h\
+    ../../app/adc.h\
+    ../../app/analog_12v_input.h\
+    ../../app/can_frame_config.h\
+    ../../app/gauge.h\
+    ../../app/gauge_accessory.h\
+    ../../app/gauge_speedo.h\
+    ../../app/gauge_tach.h\
+    ../../app/gauge_temp_fuel_cluster.h\
+    ../../app/map_sensor.h\
+    ../../app/ntc.h\
+    ../../app/pulse_counter.h\
+    ../../app/sensor_filter.h\
+    ../../app/sensor_health.h\
+    ../../app/sensor_map.h\
+    ../../app/sensor_ntc.h\
+    ../../app/sensor_resistive.h\
+    ../../app/sensor_source_gps.h\
+    ../../app/sensor_speedo.h\
+    ../../app/sensor_tach.h\
+    ../../app/sensor_utils.h\
+    ../../app/sensor_voltmeter.h\
+    ../../app/tach_input.h\
+    ../../app/ubx_parser.h\
+    ../../app/vss_input.h\
+    perf_counters.h \
+    pipeline_benchmark.h \
+    synthetic_signal.h \
+    synthetic_sources.h
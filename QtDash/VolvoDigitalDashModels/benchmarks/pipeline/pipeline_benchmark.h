@@ -0,0 +1,306 @@
+#ifndef PIPELINE_BENCHMARK_H
+#define PIPELINE_BENCHMARK_H
+
+#include <QObject>
+#include <QQmlContext>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QStringList>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <accessory_gauge_model.h>
+#include <speedometer_model.h>
+#include <tachometer_model.h>
+#include <temp_and_fuel_gauge_model.h>
+
+#include <config.h>
+
+#include <sensor_map.h>
+#include <sensor_ntc.h>
+#include <sensor_resistive.h>
+#include <sensor_voltmeter.h>
+#include <sensor_speedo.h>
+#include <sensor_tach.h>
+
+#include <gauge_accessory.h>
+#include <gauge_speedo.h>
+#include <gauge_tach.h>
+#include <gauge_temp_fuel_cluster.h>
+
+#include <perf_counters.h>
+#include <synthetic_sources.h>
+
+/**
+ * @brief Runs the real Sensor -> Gauge -> model pipeline (wired the same way as DashNew)
+ * from synthetic sources and measures throughput, per sample latency, allocations
+ * and cache misses for each scenario.
+ */
+class PipelineBenchmark : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @struct ScenarioResult
+     */
+    typedef struct ScenarioResult {
+        QString name; //!< scenario name
+        int samples = 0; //!< number of measured samples
+        qint64 totalNs = 0; //!< total time for all samples
+        qreal samplesPerSec = 0; //!< throughput
+        qreal latencyMinNs = 0; //!< fastest sample
+        qreal latencyMeanNs = 0; //!< mean sample latency
+        qreal latencyP50Ns = 0; //!< median sample latency
+        qreal latencyP99Ns = 0; //!< 99th percentile sample latency
+        qreal latencyMaxNs = 0; //!< slowest sample
+        qreal allocationsPerSample = 0; //!< heap allocations per sample
+        qreal bytesPerSample = 0; //!< heap bytes allocated per sample
+        qint64 cacheMisses = -1; //!< hw cache misses (-1 if unavailable)
+        qint64 cacheReferences = -1; //!< hw cache references (-1 if unavailable)
+        qint64 instructions = -1; //!< retired instructions (-1 if unavailable)
+    } ScenarioResult_t;
+
+    /**
+     * @brief PipelineBenchmark constructor
+     * @param parent: parent object
+     * @param config: dash config (sensor channels, sensor curves and gauge configs)
+     * @param context: QML context the models are registered in
+     */
+    PipelineBenchmark(QObject * parent, Config * config, QQmlContext * context) :
+        QObject(parent), mConfig(config), mContext(context) {
+        initSources();
+        initSensors();
+        initGauges();
+        initScenarios();
+    }
+
+    /**
+     * @brief Get the names of all scenarios (in run order)
+     * @return scenario names
+     */
+    QStringList getScenarioNames() {
+        return mScenarioNames;
+    }
+
+    /**
+     * @brief Check if the scenario exists
+     * @param name: scenario name
+     * @return true if found
+     */
+    bool hasScenario(QString name) {
+        return mScenarios.contains(name);
+    }
+
+    /**
+     * @brief Run a scenario
+     * @param name: scenario name
+     * @param samples: number of measured samples
+     * @param warmup: number of unmeasured samples run first
+     * @return scenario result
+     */
+    ScenarioResult_t run(QString name, int samples, int warmup) {
+        ScenarioResult_t result;
+        result.name = name;
+        result.samples = samples;
+
+        std::function<void()> step = mScenarios.value(name);
+        if (!step || samples <= 0) {
+            return result;
+        }
+
+        for (int i = 0; i < warmup; i++) {
+            step();
+        }
+
+        // allocate everything up front so the measurement loop is clean
+        std::vector<qint64> latency(samples);
+        PerfEventCounter cacheMisses(PERF_TYPE_HARDWARE_ID, PERF_COUNT_CACHE_MISSES_ID);
+        PerfEventCounter cacheReferences(PERF_TYPE_HARDWARE_ID, PERF_COUNT_CACHE_REFERENCES_ID);
+        PerfEventCounter instructions(PERF_TYPE_HARDWARE_ID, PERF_COUNT_INSTRUCTIONS_ID);
+        QElapsedTimer timer;
+
+        uint64_t allocStart = AllocationCounter::count();
+        uint64_t bytesStart = AllocationCounter::bytes();
+
+        cacheMisses.start();
+        cacheReferences.start();
+        instructions.start();
+        timer.start();
+
+        for (int i = 0; i < samples; i++) {
+            qint64 t0 = timer.nsecsElapsed();
+            step();
+            latency[i] = timer.nsecsElapsed() - t0;
+        }
+
+        result.totalNs = timer.nsecsElapsed();
+        result.instructions = instructions.stop();
+        result.cacheReferences = cacheReferences.stop();
+        result.cacheMisses = cacheMisses.stop();
+
+        result.allocationsPerSample = (qreal)(AllocationCounter::count() - allocStart) / samples;
+        result.bytesPerSample = (qreal)(AllocationCounter::bytes() - bytesStart) / samples;
+
+        // latency statistics
+        std::sort(latency.begin(), latency.end());
+        qreal sum = 0;
+        for (qint64 l : latency) {
+            sum += l;
+        }
+        result.latencyMinNs = latency.front();
+        result.latencyMaxNs = latency.back();
+        result.latencyMeanNs = sum / samples;
+        result.latencyP50Ns = latency[samples / 2];
+        result.latencyP99Ns = latency[qMin(samples - 1, (int)(samples * 0.99))];
+        result.samplesPerSec = result.totalNs > 0 ? samples * 1.0e9 / result.totalNs : 0;
+
+        return result;
+    }
+
+private:
+#ifdef __linux__
+    static constexpr uint32_t PERF_TYPE_HARDWARE_ID = PERF_TYPE_HARDWARE;
+    static constexpr uint64_t PERF_COUNT_CACHE_MISSES_ID = PERF_COUNT_HW_CACHE_MISSES;
+    static constexpr uint64_t PERF_COUNT_CACHE_REFERENCES_ID = PERF_COUNT_HW_CACHE_REFERENCES;
+    static constexpr uint64_t PERF_COUNT_INSTRUCTIONS_ID = PERF_COUNT_HW_INSTRUCTIONS;
+#else
+    static constexpr uint32_t PERF_TYPE_HARDWARE_ID = 0;
+    static constexpr uint64_t PERF_COUNT_CACHE_MISSES_ID = 0;
+    static constexpr uint64_t PERF_COUNT_CACHE_REFERENCES_ID = 0;
+    static constexpr uint64_t PERF_COUNT_INSTRUCTIONS_ID = 0;
+#endif
+
+    Config * mConfig; //!< dash config
+    QQmlContext * mContext; //!< QML context
+
+    QMap<QString, std::function<void()>> mScenarios; //!< scenario name -> single sample step
+    QStringList mScenarioNames; //!< scenario run order
+
+    SyntheticAdcSource * mAdcSource; //!< synthetic adc source
+    SyntheticTachSource * mTachSource; //!< synthetic tach source
+    SyntheticVssSource * mVssSource; //!< synthetic vss source
+
+    Map_Sensor * mMapSensor; //!< map sensor
+    NtcSensor * mCoolantTempSensor; //!< coolant temp sensor
+    NtcSensor * mAmbientTempSensor; //!< ambient temp sensor
+    NtcSensor * mOilTempSensor; //!< oil temp sensor
+    VoltmeterSensor * mVoltmeterSensor; //!< voltmeter sensor
+    VoltmeterSensor * mDimmerVoltageSensor; //!< rheostat dimmer voltage
+    ResistiveSensor * mOilPressureSensor; //!< oil pressure sensor
+    ResistiveSensor * mFuelLevelSensor; //!< fuel level sensor
+    SpeedometerSensor<VssSource> * mSpeedoSensor; //!< speedometer w/ vss input
+    TachSensor * mTachSensor; //!< tachometer sensor
+
+    AccessoryGaugeModel mBoostModel; //!< boost pressure QML model
+    AccessoryGaugeModel mOilTemperatureModel; //!< oil temperature QML model
+    AccessoryGaugeModel mCoolantTempModel; //!< coolant temperature QML model
+    AccessoryGaugeModel mOilPressureModel; //!< oil pressure QML model
+    AccessoryGaugeModel mFuelLevelModel; //!< fuel level QML model
+    AccessoryGaugeModel mVoltMeterModel; //!< voltmeter QML model
+    TempAndFuelGaugeModel mTempFuelModel; //!< 240 combined temp/fuel QML model
+    SpeedometerModel mSpeedoModel; //!< speedometer QML model
+    TachometerModel mTachoModel; //!< Tachometer QML model
+
+    /**
+     * @brief Get the configured adc channel of a sensor
+     * @param key: sensor channel key
+     * @return adc channel
+     */
+    int channel(QString key) {
+        return mConfig->getSensorConfig().value(key, -1);
+    }
+
+    /**
+     * @brief Initialize the synthetic sources with repeatable signals
+     */
+    void initSources() {
+        mAdcSource = new SyntheticAdcSource(this, mConfig);
+        mAdcSource->setSignal(channel(Config::MAP_SENSOR_KEY), SyntheticSignal::randomWalk(1.0, 0.05, 0.5, 4.5, 1));
+        mAdcSource->setSignal(channel(Config::COOLANT_TEMP_KEY), SyntheticSignal::randomWalk(2.0, 0.01, 1.0, 3.5, 2));
+        mAdcSource->setSignal(channel(Config::AMBIENT_TEMP_KEY), SyntheticSignal::randomWalk(2.5, 0.01, 1.0, 4.0, 3));
+        mAdcSource->setSignal(channel(Config::OIL_TEMP_KEY), SyntheticSignal::randomWalk(2.0, 0.01, 1.0, 3.5, 4));
+        mAdcSource->setSignal(channel(Config::OIL_PRESSURE_KEY), SyntheticSignal::randomWalk(2.0, 0.05, 0.5, 4.0, 5));
+        mAdcSource->setSignal(channel(Config::FUEL_LEVEL_KEY), SyntheticSignal::randomWalk(2.5, 0.01, 1.0, 4.0, 6));
+        mAdcSource->setSignal(channel(Config::FUSE8_12V_KEY), SyntheticSignal::randomWalk(1.6, 0.01, 1.3, 1.9, 7));
+        mAdcSource->setSignal(channel(Config::DIMMER_VOLTAGE_KEY), SyntheticSignal::randomWalk(1.5, 0.01, 1.3, 1.9, 8));
+
+        mTachSource = new SyntheticTachSource(this, mConfig, SyntheticSignal::sweep(800, 6500, 200));
+        mVssSource = new SyntheticVssSource(this, mConfig, SyntheticSignal::sweep(0, 120, 200));
+    }
+
+    /**
+     * @brief Initialize the sensors (same as DashNew::initSensors)
+     */
+    void initSensors() {
+        mMapSensor = new Map_Sensor(this, mConfig, mAdcSource, channel(Config::MAP_SENSOR_KEY));
+        mCoolantTempSensor = new NtcSensor(this, mConfig, mAdcSource, channel(Config::COOLANT_TEMP_KEY),
+                                           Config::TemperatureSensorType::COOLANT);
+        mAmbientTempSensor = new NtcSensor(this, mConfig, mAdcSource, channel(Config::AMBIENT_TEMP_KEY),
+                                           Config::TemperatureSensorType::AMBIENT);
+        mOilTempSensor = new NtcSensor(this, mConfig, mAdcSource, channel(Config::OIL_TEMP_KEY),
+                                       Config::TemperatureSensorType::OIL);
+        mOilPressureSensor = new ResistiveSensor(this, mConfig, mAdcSource, channel(Config::OIL_PRESSURE_KEY),
+                                                 mConfig->getResistiveSensorConfig(Config::RES_SENSOR_TYPE_OIL_PRESSURE));
+        mFuelLevelSensor = new ResistiveSensor(this, mConfig, mAdcSource, channel(Config::FUEL_LEVEL_KEY),
+                                               mConfig->getResistiveSensorConfig(Config::RES_SENSOR_TYPE_FUEL_LEVEL));
+        mVoltmeterSensor = new VoltmeterSensor(this, mConfig, mAdcSource, channel(Config::FUSE8_12V_KEY),
+                                               mConfig->getAnalog12VInputConfig(Config::ANALOG_INPUT_12V_VOLTMETER));
+        mDimmerVoltageSensor = new VoltmeterSensor(this, mConfig, mAdcSource, channel(Config::DIMMER_VOLTAGE_KEY),
+                                                   mConfig->getAnalog12VInputConfig(Config::ANALOG_INPUT_12V_RHEOSTAT));
+        mSpeedoSensor = new SpeedometerSensor<VssSource>(this, mConfig, mVssSource,
+                                                         (int) VssSource::VssDataChannel::MPH);
+        mTachSensor = new TachSensor(this, mConfig, mTachSource,
+                                     (int) TachSource::TachDataChannel::RPM_CHANNEL);
+    }
+
+    /**
+     * @brief Initialize the gauges (same as DashNew::initAccessoryGauges/initSpeedo/initTacho)
+     */
+    void initGauges() {
+        new AccessoryGauge(this, mConfig, {mMapSensor}, &mBoostModel,
+                           AccessoryGaugeModel::BOOST_GAUGE_MODEL_NAME, mContext);
+        new AccessoryGauge(this, mConfig, {mCoolantTempSensor}, &mCoolantTempModel,
+                           AccessoryGaugeModel::COOLANT_TEMP_MODEL_NAME, mContext);
+        new AccessoryGauge(this, mConfig, {mOilTempSensor}, &mOilTemperatureModel,
+                           AccessoryGaugeModel::OIL_TEMPERATURE_MODEL_NAME, mContext);
+        new AccessoryGauge(this, mConfig, {mVoltmeterSensor}, &mVoltMeterModel,
+                           AccessoryGaugeModel::VOLT_METER_MODEL_NAME, mContext);
+        new AccessoryGauge(this, mConfig, {mFuelLevelSensor}, &mFuelLevelModel,
+                           AccessoryGaugeModel::FUEL_LEVEL_MODEL_NAME, mContext);
+        new AccessoryGauge(this, mConfig, {mOilPressureSensor}, &mOilPressureModel,
+                           AccessoryGaugeModel::OIL_PRESSURE_MODEL_NAME, mContext);
+        new TempFuelClusterGauge(this, mConfig, {mCoolantTempSensor, mFuelLevelSensor}, &mTempFuelModel,
+                                 TempAndFuelGaugeModel::TEMP_FUEL_CLUSTER_MODEL_NAME, mContext);
+        new SpeedometerGauge(this, mConfig, {mSpeedoSensor, mAmbientTempSensor}, &mSpeedoModel,
+                             SpeedometerModel::SPEEDO_MODEL_NAME, mContext);
+        new TachometerGauge(this, mConfig, {mTachSensor}, &mTachoModel,
+                            TachometerModel::TACH_MODEL_NAME, mContext);
+    }
+
+    /**
+     * @brief Add a scenario
+     * @param name: scenario name
+     * @param step: function producing a single sample
+     */
+    void addScenario(QString name, std::function<void()> step) {
+        mScenarios.insert(name, step);
+        mScenarioNames.append(name);
+    }
+
+    /**
+     * @brief Setup the scenarios -- one sample is one source update as issued by the DashNew timers
+     */
+    void initScenarios() {
+        addScenario("map_boost", [=]() { mAdcSource->update(mMapSensor->getChannel()); });
+        addScenario("ntc_coolant", [=]() { mAdcSource->update(mCoolantTempSensor->getChannel()); });
+        addScenario("ntc_ambient", [=]() { mAdcSource->update(mAmbientTempSensor->getChannel()); });
+        addScenario("resistive_oil_pressure", [=]() { mAdcSource->update(mOilPressureSensor->getChannel()); });
+        addScenario("resistive_fuel_level", [=]() { mAdcSource->update(mFuelLevelSensor->getChannel()); });
+        addScenario("voltmeter", [=]() { mAdcSource->update(mVoltmeterSensor->getChannel()); });
+        addScenario("tach", [=]() { mTachSource->update((int) TachSource::TachDataChannel::RPM_CHANNEL); });
+        addScenario("speedo_vss", [=]() { mVssSource->update((int) VssSource::VssDataChannel::MPH); });
+        addScenario("adc_scan", [=]() { mAdcSource->updateAll(); });
+    }
+};
+
+#endif // PIPELINE_BENCHMARK_H
@@ -0,0 +1,125 @@
+#ifndef SYNTHETIC_SIGNAL_H
+#define SYNTHETIC_SIGNAL_H
+
+#include <QList>
+#include <QRandomGenerator>
+#include <QtGlobal>
+
+/**
+ * @brief Deterministic signal generator used to drive the synthetic sensor sources.
+ * Either replays a scripted list of values in a loop, or produces a bounded
+ * random walk from a fixed seed so that runs are repeatable across commits.
+ */
+class SyntheticSignal {
+public:
+    /**
+     * @brief The SignalType enum
+     */
+    enum class SignalType {
+        CONSTANT, //!< always returns the start value
+        SCRIPTED, //!< loops over a list of values
+        RANDOM_WALK, //!< bounded random walk
+    };
+
+    /**
+     * @brief Default constructor -- constant 0
+     */
+    SyntheticSignal() {}
+
+    /**
+     * @brief Create a constant signal
+     * @param value: constant output value
+     * @return signal
+     */
+    static SyntheticSignal constant(qreal value) {
+        SyntheticSignal s;
+        s.mType = SignalType::CONSTANT;
+        s.mValue = value;
+        return s;
+    }
+
+    /**
+     * @brief Create a scripted signal
+     * @param values: values to replay (looped)
+     * @return signal
+     */
+    static SyntheticSignal scripted(QList<qreal> values) {
+        SyntheticSignal s;
+        s.mType = values.isEmpty() ? SignalType::CONSTANT : SignalType::SCRIPTED;
+        s.mScript = values;
+        return s;
+    }
+
+    /**
+     * @brief Create a linear sweep between min and max and back again
+     * @param min: minimum value
+     * @param max: maximum value
+     * @param steps: number of steps from min to max
+     * @return signal
+     */
+    static SyntheticSignal sweep(qreal min, qreal max, int steps) {
+        QList<qreal> values;
+        steps = qMax(1, steps);
+        for (int i = 0; i <= steps; i++) {
+            values.append(min + (max - min) * i / steps);
+        }
+        for (int i = steps - 1; i > 0; i--) {
+            values.append(min + (max - min) * i / steps);
+        }
+        return scripted(values);
+    }
+
+    /**
+     * @brief Create a bounded random walk
+     * @param start: start value
+     * @param step: maximum step size per sample
+     * @param min: lower bound
+     * @param max: upper bound
+     * @param seed: random seed
+     * @return signal
+     */
+    static SyntheticSignal randomWalk(qreal start, qreal step, qreal min, qreal max, quint32 seed = 240) {
+        SyntheticSignal s;
+        s.mType = SignalType::RANDOM_WALK;
+        s.mValue = start;
+        s.mStep = step;
+        s.mMin = min;
+        s.mMax = max;
+        s.mRandom.seed(seed);
+        return s;
+    }
+
+    /**
+     * @brief Get the next value of the signal
+     * @return next value
+     */
+    qreal next() {
+        switch (mType) {
+        case SignalType::SCRIPTED:
+            mValue = mScript.at(mIndex);
+            mIndex = (mIndex + 1) % mScript.size();
+            break;
+        case SignalType::RANDOM_WALK:
+            mValue += (mRandom.generateDouble() * 2.0 - 1.0) * mStep;
+            mValue = qBound(mMin, mValue, mMax);
+            break;
+        case SignalType::CONSTANT:
+        default:
+            break;
+        }
+
+        return mValue;
+    }
+
+private:
+    SignalType mType = SignalType::CONSTANT; //!< signal type
+    qreal mValue = 0; //!< current value
+    qreal mStep = 0; //!< random walk step
+    qreal mMin = 0; //!< random walk lower bound
+    qreal mMax = 0; //!< random walk upper bound
+    QList<qreal> mScript; //!< scripted values
+    int mIndex = 0; //!< current script index
+    QRandomGenerator mRandom; //!< random walk generator
+};
+
+#endif // SYNTHETIC_SIGNAL_H
@@ -0,0 +1,175 @@
+#ifndef SYNTHETIC_SOURCES_H
+#define SYNTHETIC_SOURCES_H
+
+#include <QVector>
+
+#include <sensor_source_adc.h>
+#include <sensor_source_tach.h>
+#include <sensor_source_vss.h>
+#include <sensor_utils.h>
+
+#include <synthetic_signal.h>
+
+/**
+ * @brief ADC source that emits synthetic voltages instead of reading the iio device.
+ * Derives from AdcSource so the real ADC sensors (Map_Sensor, NtcSensor, ResistiveSensor,
+ * VoltmeterSensor) can be attached to it unchanged.
+ */
+class SyntheticAdcSource : public AdcSource {
+    Q_OBJECT
+public:
+    static constexpr int NUM_CHANNELS = 8; //!< MCP3208 channel count
+
+    /**
+     * @brief SyntheticAdcSource constructor
+     * @param parent: parent object
+     * @param config: dash config
+     * @param name: source name
+     */
+    SyntheticAdcSource(QObject * parent, Config * config, QString name = "syntheticAdc") :
+        AdcSource(parent, config, name), mSignals(NUM_CHANNELS) {
+    }
+
+    /**
+     * @brief Set the signal for a channel
+     * @param channel: adc channel
+     * @param signal: signal generator (volts)
+     */
+    void setSignal(int channel, SyntheticSignal signal) {
+        if (channel >= 0 && channel < NUM_CHANNELS) {
+            mSignals[channel] = signal;
+        }
+    }
+
+    /**
+     * @brief get number of channels
+     * @return number of synthetic ADC channels
+     */
+    int getNumChannels() override {
+        return NUM_CHANNELS;
+    }
+
+public slots:
+    /**
+     * @brief update all channels and emit dataReady
+     */
+    void updateAll() override {
+        for (int i = 0; i < NUM_CHANNELS; i++) {
+            update(i);
+        }
+    }
+
+    /**
+     * @brief update given channel
+     * @param channel: adc channel
+     */
+    void update(int channel) override {
+        if (channel >= 0 && channel < NUM_CHANNELS) {
+            emit dataReady(mSignals[channel].next(), channel);
+        }
+    }
+
+private:
+    QVector<SyntheticSignal> mSignals; //!< per channel signal generators
+};
+
+/**
+ * @brief Tach source that emits a synthetic rpm signal instead of reading the pulse counter
+ */
+class SyntheticTachSource : public TachSource {
+    Q_OBJECT
+public:
+    /**
+     * @brief SyntheticTachSource constructor
+     * @param parent: parent object
+     * @param config: dash config
+     * @param signal: rpm signal generator
+     * @param name: source name
+     */
+    SyntheticTachSource(QObject * parent, Config * config, SyntheticSignal signal,
+                        QString name = "syntheticTach") :
+        TachSource(parent, config, name), mRpm(signal) {
+    }
+
+public slots:
+    /**
+     * @brief update all channels and emit dataReady
+     */
+    void updateAll() override {
+        for (int i = 0; i < getNumChannels(); i++) {
+            update(i);
+        }
+    }
+
+    /**
+     * @brief update single channel
+     * @param channel: channel to update
+     */
+    void update(int channel) override {
+        switch (channel) {
+        case (int) TachDataChannel::RPM_CHANNEL:
+            emit dataReady((int) mRpm.next(), channel);
+            break;
+        case (int) TachDataChannel::COUNT:
+            emit dataReady(++mPulseCount, channel);
+            break;
+        }
+    }
+
+private:
+    SyntheticSignal mRpm; //!< rpm signal
+    int mPulseCount = 0; //!< fake pulse count
+};
+
+/**
+ * @brief VSS source that emits a synthetic speed signal instead of reading the pulse counter
+ */
+class SyntheticVssSource : public VssSource {
+    Q_OBJECT
+public:
+    /**
+     * @brief SyntheticVssSource constructor
+     * @param parent: parent object
+     * @param config: dash config
+     * @param signal: speed signal generator (mph)
+     * @param name: source name
+     */
+    SyntheticVssSource(QObject * parent, Config * config, SyntheticSignal signal,
+                       QString name = "syntheticVss") :
+        VssSource(parent, config, name), mMph(signal) {
+    }
+
+public slots:
+    /**
+     * @brief Update all channels and emit results
+     */
+    void updateAll() override {
+        for (int i = 0; i < getNumChannels(); i++) {
+            update(i);
+        }
+    }
+
+    /**
+     * @brief Update source
+     * @param channel: channel to update
+     */
+    void update(int channel) override {
+        switch (channel) {
+        case (int) VssDataChannel::MPH:
+            emit dataReady(mMph.next(), channel);
+            break;
+        case (int) VssDataChannel::KPH:
+            emit dataReady(SensorUtils::convert(mMph.next(), Config::UNITS_KPH, Config::UNITS_MPH), channel);
+            break;
+        case (int) VssDataChannel::PULSE_COUNT:
+            emit dataReady(++mPulseCount, channel);
+            break;
+        }
+    }
+
+private:
+    SyntheticSignal mMph; //!< speed signal
+    int mPulseCount = 0; //!< fake pulse count
+};
+
+#endif // SYNTHETIC_SOURCES_H
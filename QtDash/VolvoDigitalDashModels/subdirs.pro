@@ -4,4 +4,5 @@ CONFIG+=ordered
 
 SUBDIRS = \
 	app \
-	tests
+	tests \
+	benchmarks
@@ -0,0 +1,201 @@
+#include "alarm_engine_test.h"
+#include "qsignalspy.h"
+
+namespace {
+    Config::AlarmConfig_t alarm(QString name, QString expression, QString clear = "", int delayMsec = 0) {
+        Config::AlarmConfig_t config;
+        config.name = name;
+        config.expression = expression;
+        config.clear = clear;
+        config.delayMsec = delayMsec;
+        return config;
+    }
+}
+
+void AlarmEngineTest::hysteresis() {
+    AlarmEngine engine(nullptr);
+    int coolant = engine.addInput("coolant_temp");
+    QVERIFY(engine.addAlarm(alarm("hot", "coolant_temp > 110", "coolant_temp < 105")));
+    QSignalSpy spy(&engine, &AlarmEngine::alarmChanged);
+
+    qint64 msec = 0;
+    engine.setInput(coolant, 100, msec);
+    engine.evaluate(msec);
+    QCOMPARE(spy.count(), 0);
+
+    engine.setInput(coolant, 111, msec += 100);
+    engine.evaluate(msec);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(1).toBool(), true);
+
+    // between the thresholds -- stays on, no repeat notification
+    for (int i = 0; i < 10; i++) {
+        engine.setInput(coolant, 107, msec += 100);
+        engine.evaluate(msec);
+    }
+    QCOMPARE(spy.count(), 0);
+    QVERIFY(engine.isActive("hot"));
+
+    engine.setInput(coolant, 104, msec += 100);
+    engine.evaluate(msec);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(1).toBool(), false);
+}
+
+void AlarmEngineTest::delay() {
+    AlarmEngine engine(nullptr);
+    int oil = engine.addInput("oil_pressure");
+    QVERIFY(engine.addAlarm(alarm("low oil", "oil_pressure < 0.5", "", 500)));
+
+    // a dip shorter than the delay doesn't trigger
+    qint64 msec = 0;
+    engine.setInput(oil, 0.2, msec);
+    for (; msec < 400; msec += 100) {
+        engine.evaluate(msec);
+    }
+    engine.setInput(oil, 2.0, msec);
+    engine.evaluate(msec);
+    QVERIFY(!engine.isActive("low oil"));
+
+    // and the delay restarts
+    engine.setInput(oil, 0.2, msec += 100);
+    qint64 start = msec;
+    for (; msec < start + 500; msec += 100) {
+        engine.evaluate(msec);
+        QVERIFY(!engine.isActive("low oil"));
+    }
+    engine.evaluate(msec);
+    QVERIFY(engine.isActive("low oil"));
+}
+
+void AlarmEngineTest::combination() {
+    AlarmEngine engine(nullptr);
+    int oil = engine.addInput("oil_pressure");
+    int tach = engine.addInput("tach");
+    QVERIFY(engine.addAlarm(alarm("oil", "oil_pressure < 2 && tach > 3000")));
+
+    // no rpm yet -- not evaluated
+    engine.setInput(oil, 1.0, 0);
+    engine.evaluate(0);
+    QVERIFY(!engine.isActive("oil"));
+
+    engine.setInput(tach, 900, 100);
+    engine.evaluate(100);
+    QVERIFY(!engine.isActive("oil"));
+
+    engine.setInput(tach, 4000, 200);
+    engine.evaluate(200);
+    QVERIFY(engine.isActive("oil"));
+
+    engine.setInput(oil, 3.0, 300);
+    engine.evaluate(300);
+    QVERIFY(!engine.isActive("oil"));
+}
+
+void AlarmEngineTest::rateOfChange() {
+    AlarmEngine engine(nullptr);
+    int coolant = engine.addInput("coolant_temp");
+    QVERIFY(engine.addAlarm(alarm("climbing", "coolant_temp_rate > 2")));
+
+    // 1 degree/second
+    qint64 msec = 0;
+    qreal temp = 80;
+    for (; msec <= 2000; msec += 100) {
+        engine.setInput(coolant, temp, msec);
+        engine.evaluate(msec);
+        temp += 0.1;
+    }
+    QVERIFY(!engine.isActive("climbing"));
+
+    // 5 degrees/second
+    for (; msec <= 4000; msec += 100) {
+        engine.setInput(coolant, temp, msec);
+        engine.evaluate(msec);
+        temp += 0.5;
+    }
+    QVERIFY(engine.isActive("climbing"));
+}
+
+void AlarmEngineTest::lightsAndBuzzer() {
+    AlarmEngine engine(nullptr);
+    int oil = engine.addInput("oil_pressure");
+    int coolant = engine.addInput("coolant_temp");
+    Config::AlarmConfig_t oilAlarm = alarm("oil", "oil_pressure < 1");
+    oilAlarm.light = "checkEngineLightModel";
+    oilAlarm.buzzer = true;
+    Config::AlarmConfig_t hotAlarm = alarm("hot", "coolant_temp > 110");
+    hotAlarm.light = "checkEngineLightModel";
+    hotAlarm.buzzer = true;
+    QVERIFY(engine.addAlarm(oilAlarm));
+    QVERIFY(engine.addAlarm(hotAlarm));
+    QSignalSpy lights(&engine, &AlarmEngine::lightChanged);
+    QSignalSpy buzzer(&engine, &AlarmEngine::buzzerChanged);
+
+    engine.setInput(oil, 0.5, 0);
+    engine.setInput(coolant, 90, 0);
+    engine.evaluate(0);
+    QCOMPARE(lights.count(), 1);
+    QCOMPARE(lights.at(0).at(0).toString(), QString("checkEngineLightModel"));
+    QCOMPARE(lights.at(0).at(1).toBool(), true);
+    QCOMPARE(buzzer.count(), 1);
+
+    // a second alarm on the same light and buzzer changes nothing
+    engine.setInput(coolant, 115, 100);
+    engine.evaluate(100);
+    QCOMPARE(lights.count(), 1);
+    QCOMPARE(buzzer.count(), 1);
+
+    // both have to clear to turn them off
+    engine.setInput(oil, 3, 200);
+    engine.evaluate(200);
+    QCOMPARE(lights.count(), 1);
+    engine.setInput(coolant, 90, 300);
+    engine.evaluate(300);
+    QCOMPARE(lights.count(), 2);
+    QCOMPARE(lights.at(1).at(1).toBool(), false);
+    QCOMPARE(buzzer.count(), 2);
+    QCOMPARE(buzzer.at(1).at(0).toBool(), false);
+}
+
+void AlarmEngineTest::invalidRule() {
+    AlarmEngine engine(nullptr);
+    engine.addInput("tach");
+    QVERIFY(!engine.addAlarm(alarm("bad", "tach >")));
+    QVERIFY(!engine.addAlarm(alarm("unknown", "boost > 1")));
+    QVERIFY(!engine.addAlarm(alarm("bad clear", "tach > 6000", "tach <")));
+    QCOMPARE(engine.getNumAlarms(), 0);
+}
+
+void AlarmEngineTest::sensorFault() {
+    AlarmEngine engine(nullptr);
+    int oil = engine.addInput("oil_pressure");
+    QVERIFY(engine.addAlarm(alarm("low oil", "oil_pressure < 0.5", "", 500)));
+    QVERIFY(engine.addAlarm(alarm("falling", "oil_pressure_rate < -1")));
+
+    // the sender fails on a low reading -- its last value doesn't trigger the alarm
+    qint64 msec = 0;
+    engine.setInput(oil, 3.0, msec);
+    engine.evaluate(msec);
+    engine.setInput(oil, 0.2, msec += 100);
+    engine.evaluate(msec);
+    engine.setHealthy(oil, false);
+    for (int i = 0; i < 10; i++) {
+        engine.evaluate(msec += 100);
+    }
+    QVERIFY(!engine.isActive("low oil"));
+
+    // samples while faulted are ignored
+    engine.setInput(oil, 0.1, msec);
+    engine.evaluate(msec += 600);
+    QVERIFY(!engine.isActive("low oil"));
+
+    // recovered -- the delay starts from the first sample, and the rate isn't taken across the fault
+    engine.setHealthy(oil, true);
+    engine.setInput(oil, 0.2, msec += 100);
+    engine.evaluate(msec);
+    QVERIFY(!engine.isActive("low oil"));
+    engine.setInput(oil, 0.2, msec += 500);
+    engine.evaluate(msec);
+    QVERIFY(engine.isActive("low oil"));
+    QVERIFY(!engine.isActive("falling"));
+}
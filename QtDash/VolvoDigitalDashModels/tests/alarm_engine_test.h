@@ -0,0 +1,26 @@
+#ifndef ALARM_ENGINE_TEST_H
+#define ALARM_ENGINE_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <alarm_engine.h>
+
+class AlarmEngineTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void hysteresis();
+    void delay();
+    void combination();
+    void rateOfChange();
+    void lightsAndBuzzer();
+    void invalidRule();
+    void sensorFault();
+};
+
+#endif // ALARM_ENGINE_TEST_H
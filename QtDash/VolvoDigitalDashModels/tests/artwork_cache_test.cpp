@@ -0,0 +1,131 @@
+#include "artwork_cache_test.h"
+#include <artwork_cache.h>
+
+void ArtworkCacheTest::initTestCase() {
+    QVERIFY(mDir.isValid());
+    mPreviousDirectory = ArtworkCache::getDirectory();
+    ArtworkCache::setDirectory(mDir.filePath("cache"));
+}
+
+void ArtworkCacheTest::cleanupTestCase() {
+    ArtworkCache::clearMemory();
+    ArtworkCache::setDirectory(mPreviousDirectory);
+}
+
+void ArtworkCacheTest::test_localPath_data() {
+    QTest::addColumn<QString>("source");
+    QTest::addColumn<QString>("path");
+
+    QTest::newRow("qrc url") << "qrc:/needles/needle-240.png" << ":/needles/needle-240.png";
+    QTest::newRow("resource path") << ":/needles/needle-240.png" << ":/needles/needle-240.png";
+    QTest::newRow("file url") << "file:///opt/art/dial.png" << "/opt/art/dial.png";
+    QTest::newRow("local path") << "/opt/art/dial.png" << "/opt/art/dial.png";
+}
+
+void ArtworkCacheTest::test_localPath() {
+    QFETCH(QString, source);
+    QFETCH(QString, path);
+
+    QCOMPARE(ArtworkCache::localPath(source), path);
+}
+
+void ArtworkCacheTest::test_bake() {
+    QString source = writeSource("bake.png", Qt::red);
+
+    QImage image = ArtworkCache::load(source, QSize(32, 16));
+    QCOMPARE(image.size(), QSize(32, 16));
+    QCOMPARE(image.format(), QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(image.pixelColor(16, 8), QColor(Qt::red));
+
+    // a second size is a second entry
+    QCOMPARE(ArtworkCache::load(source, QSize(8, 8)).size(), QSize(8, 8));
+}
+
+void ArtworkCacheTest::test_diskCache() {
+    QString source = "file://" + writeSource("disk.png", Qt::blue);
+    int entries = cacheEntries();
+
+    QImage baked = ArtworkCache::load(source, QSize(20, 10));
+    QCOMPARE(cacheEntries(), entries + 1);
+
+    // a new boot -- the entry is read back instead of decoding the source
+    ArtworkCache::clearMemory();
+    QImage reloaded = ArtworkCache::load(source, QSize(20, 10));
+    QCOMPARE(cacheEntries(), entries + 1);
+    QCOMPARE(reloaded, baked);
+}
+
+void ArtworkCacheTest::test_staleEntry() {
+    QString source = writeSource("stale.png", Qt::green);
+    QCOMPARE(ArtworkCache::load(source, QSize(16, 16)).pixelColor(8, 8), QColor(Qt::green));
+
+    // new artwork replaces the disk entry
+    ArtworkCache::clearMemory();
+    writeSource("stale.png", Qt::yellow);
+    QFile file(source);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+    file.close();
+
+    QCOMPARE(ArtworkCache::load(source, QSize(16, 16)).pixelColor(8, 8), QColor(Qt::yellow));
+}
+
+void ArtworkCacheTest::test_missingSource() {
+    int entries = cacheEntries();
+
+    QVERIFY(ArtworkCache::load(mDir.filePath("missing.png"), QSize(16, 16)).isNull());
+    QVERIFY(ArtworkCache::load("", QSize(16, 16)).isNull());
+    QVERIFY(ArtworkCache::load(writeSource("empty_size.png", Qt::red), QSize()).isNull());
+    QCOMPARE(cacheEntries(), entries);
+}
+
+void ArtworkCacheTest::test_prune() {
+    ArtworkCache::setDirectory(mDir.filePath("prune"));
+    QDir dir(ArtworkCache::getDirectory());
+
+    // three 4 KB entries, last used an hour, a minute and a second ago
+    const int ages[] = {3600, 60, 1};
+    QStringList entries;
+    for (int age : ages) {
+        QStringList before = dir.entryList(QDir::Files);
+        QVERIFY(!ArtworkCache::load(writeSource(QString("prune%1.png").arg(age), Qt::red), QSize(32, 32)).isNull());
+        QStringList after = dir.entryList(QDir::Files);
+        QCOMPARE(after.size(), before.size() + 1);
+        for (const QString & entry : after) {
+            if (!before.contains(entry)) {
+                entries.append(dir.filePath(entry));
+            }
+        }
+
+        QFile file(entries.last());
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(-age), QFileDevice::FileModificationTime));
+        file.close();
+    }
+
+    // room for two -- the least recently used goes
+    ArtworkCache::prune(9);
+    QCOMPARE(cacheEntries(), 2);
+    QVERIFY(!QFile::exists(entries.at(0)));
+    QVERIFY(QFile::exists(entries.at(1)));
+    QVERIFY(QFile::exists(entries.at(2)));
+
+    ArtworkCache::prune(0);
+    QCOMPARE(cacheEntries(), 0);
+
+    ArtworkCache::clearMemory();
+    ArtworkCache::setDirectory(mDir.filePath("cache"));
+}
+
+QString ArtworkCacheTest::writeSource(QString name, QColor color) {
+    QImage image(64, 64, QImage::Format_ARGB32);
+    image.fill(color);
+    QString path = mDir.filePath(name);
+    image.save(path, "PNG");
+    return path;
+}
+
+int ArtworkCacheTest::cacheEntries() {
+    return QDir(ArtworkCache::getDirectory()).entryList(
+                {QString("*") + ArtworkCache::FILE_EXTENSION}, QDir::Files).size();
+}
@@ -0,0 +1,36 @@
+#ifndef ARTWORK_CACHE_TEST_H
+#define ARTWORK_CACHE_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class ArtworkCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_localPath_data();
+    void test_localPath();
+    void test_bake();
+    void test_diskCache();
+    void test_staleEntry();
+    void test_missingSource();
+    void test_prune();
+
+private:
+    QTemporaryDir mDir;
+    QString mPreviousDirectory;
+
+    QString writeSource(QString name, QColor color);
+    int cacheEntries();
+};
+
+#endif // ARTWORK_CACHE_TEST_H
@@ -0,0 +1,186 @@
+#include "channel_expression_test.h"
+#include "qsignalspy.h"
+
+namespace {
+    const QStringList VARIABLES = {"tach", "speedo", "pw1", "map_sensor"};
+    const qreal INPUTS[] = {3000, 60, 4.5, 150};
+}
+
+void ChannelExpressionTest::evaluate() {
+    QFETCH(QString, expression);
+    QFETCH(qreal, value);
+
+    ChannelExpression expr;
+    QVERIFY2(expr.compile(expression, VARIABLES), qPrintable(expr.getError()));
+    QVERIFY(qAbs(expr.evaluate(INPUTS) - value) < DELTA);
+}
+
+void ChannelExpressionTest::evaluate_data() {
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<qreal>("value");
+
+    QTest::newRow("precedence") << "1 + 2 * 3" << 7.0;
+    QTest::newRow("parentheses") << "(1 + 2) * 3" << 9.0;
+    QTest::newRow("unary minus") << "-2 ^ 2" << -4.0;
+    QTest::newRow("power right associative") << "2 ^ 3 ^ 2" << 512.0;
+    QTest::newRow("exponent") << "2.5e-1 + 1E3" << 1000.25;
+    QTest::newRow("channels") << "tach / speedo" << 50.0;
+    QTest::newRow("left associative") << "map_sensor / 100 * tach / 2" << 2250.0;
+    QTest::newRow("comparison") << "speedo > 50 && !(pw1 <= 4) || 0" << 1.0;
+    QTest::newRow("equality") << "(speedo == 60) + (speedo != 60)" << 1.0;
+    QTest::newRow("min") << "min(tach, speedo, 7)" << 7.0;
+    QTest::newRow("max") << "max(tach, speedo)" << 3000.0;
+    QTest::newRow("clamp") << "clamp(tach, 0, 100)" << 100.0;
+    QTest::newRow("if") << "if(speedo < 5, 0, pw1)" << 4.5;
+    QTest::newRow("functions") << "abs(-3) + sqrt(16) + floor(1.5) + round(2.5)" << 11.0;
+    QTest::newRow("log exp") << "log(exp(2))" << 2.0;
+    QTest::newRow("gear") << "nearest(tach / speedo, 100, 60, 45, 35, 28)" << 3.0;
+}
+
+void ChannelExpressionTest::errors() {
+    QFETCH(QString, expression);
+
+    ChannelExpression expr;
+    QVERIFY(!expr.compile(expression, VARIABLES));
+    QVERIFY(!expr.isValid());
+    QVERIFY(!expr.getError().isEmpty());
+    QVERIFY(qIsNaN(expr.evaluate(INPUTS)));
+}
+
+void ChannelExpressionTest::errors_data() {
+    QTest::addColumn<QString>("expression");
+
+    QTest::newRow("empty") << "";
+    QTest::newRow("missing operand") << "1 +";
+    QTest::newRow("unknown channel") << "rpm * 2";
+    QTest::newRow("unknown function") << "sin(tach)";
+    QTest::newRow("argument count") << "if(tach, 1)";
+    QTest::newRow("unbalanced") << "(tach + 1";
+    QTest::newRow("trailing") << "tach speedo";
+    QTest::newRow("bad number") << "1.2.3";
+}
+
+void ChannelExpressionTest::folding() {
+    ChannelExpression expr;
+    QVERIFY(expr.compile("tach * (60 / 2 + 1) - -1", VARIABLES));
+
+    // load, const, mul, const, sub
+    QCOMPARE(expr.getCode().size(), 5);
+    QCOMPARE(expr.evaluate(INPUTS), 3000.0 * 31 + 1);
+    QCOMPARE(expr.getInputs(), QVector<int>({0}));
+
+    QVERIFY(expr.compile("min(1, 2) + max(pw1, 2 * 3)", VARIABLES));
+    QCOMPARE(expr.getCode().size(), 5);
+    QCOMPARE(expr.getInputs(), QVector<int>({2}));
+}
+
+void ChannelExpressionTest::derivedSource() {
+    TestSource source(this, nullptr);
+    PublishingTestSensor speed(this, nullptr, &source, 0);
+    PublishingTestSensor rpm(this, nullptr, &source, 1);
+
+    DerivedSource derived(this, nullptr);
+    derived.addInput("speedo", &speed);
+    derived.addInput("tach", &rpm);
+
+    Config::DerivedChannelConfig_t ratio = {"ratio", "tach / speedo", "", ""};
+    Config::DerivedChannelConfig_t gear = {"gear", "nearest(ratio, 100, 60, 45)", "", "boost"};
+    Config::DerivedChannelConfig_t invalid = {"invalid", "gear +", "", ""};
+    QCOMPARE(derived.addChannel(ratio), 0);
+    QCOMPARE(derived.addChannel(gear), 1);
+    QCOMPARE(derived.addChannel(invalid), -1);
+    QCOMPARE(derived.getNumChannels(), 2);
+    QCOMPARE(derived.getChannelConfig(1).gauge, QString("boost"));
+
+    QSignalSpy spy(&derived, SIGNAL(dataReady(QVariant,int)));
+
+    // nothing until every input has a sample
+    derived.updateAll();
+    QCOMPARE(spy.count(), 0);
+
+    source.send(50, 0);
+    source.send(3000, 1);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(0).at(0).toReal(), 60.0);
+    QCOMPARE(spy.at(1).at(0).toReal(), 2.0);
+
+    // standing still -- the ratio isn't finite, the gear keeps its last input
+    spy.clear();
+    source.send(0, 0);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(1).toInt(), 1);
+}
+
+void ChannelExpressionTest::derivedFault() {
+    TestSource source(this, nullptr);
+    PublishingTestSensor speed(this, nullptr, &source, 0);
+    PublishingTestSensor rpm(this, nullptr, &source, 1);
+
+    DerivedSource derived(this, nullptr);
+    derived.addInput("speedo", &speed);
+    derived.addInput("tach", &rpm);
+
+    Config::DerivedChannelConfig_t ratio = {"ratio", "tach / speedo", "", ""};
+    Config::DerivedChannelConfig_t gear = {"gear", "nearest(ratio, 100, 60, 45)", "", ""};
+    QCOMPARE(derived.addChannel(ratio), 0);
+    QCOMPARE(derived.addChannel(gear), 1);
+
+    source.send(50, 0);
+    source.send(3000, 1);
+    QSignalSpy spy(&derived, SIGNAL(dataReady(QVariant,int)));
+
+    // the speed sensor goes stale -- both channels go NaN rather than holding
+    emit speed.healthChanged((int) SensorHealth::Status::STALE);
+    source.send(60, 0);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 2);
+    QVERIFY(qIsNaN(spy.at(0).at(0).toReal()));
+    QVERIFY(qIsNaN(spy.at(1).at(0).toReal()));
+
+    // recovered -- nothing until it samples again
+    spy.clear();
+    emit speed.healthChanged((int) SensorHealth::Status::OK);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 0);
+
+    source.send(50, 0);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(0).at(0).toReal(), 60.0);
+    QCOMPARE(spy.at(1).at(0).toReal(), 2.0);
+}
+
+void ChannelExpressionTest::derivedTimeout() {
+    TestSource source(this, nullptr);
+    PublishingTestSensor speed(this, nullptr, &source, 0);
+
+    DerivedSource derived(this, nullptr);
+    derived.addInput("speedo", &speed);
+    derived.setTimeout(50);
+    Config::DerivedChannelConfig_t kph = {"kph", "speedo * 1.609", "", ""};
+    QCOMPARE(derived.addChannel(kph), 0);
+    QSignalSpy spy(&derived, SIGNAL(dataReady(QVariant,int)));
+
+    // no sample yet isn't stale
+    QTest::qSleep(100);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 0);
+
+    source.send(100, 0);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(qIsFinite(spy.at(0).at(0).toReal()));
+
+    // the sensor stops sampling without reporting a fault
+    QTest::qSleep(100);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 2);
+    QVERIFY(qIsNaN(spy.at(1).at(0).toReal()));
+
+    source.send(100, 0);
+    derived.updateAll();
+    QCOMPARE(spy.count(), 3);
+    QVERIFY(qIsFinite(spy.at(2).at(0).toReal()));
+}
@@ -0,0 +1,31 @@
+#ifndef CHANNEL_EXPRESSION_TEST_H
+#define CHANNEL_EXPRESSION_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <channel_expression.h>
+#include <sensor_source_derived.h>
+#include <sensor_test.h>
+
+class ChannelExpressionTest : public QObject
+{
+    Q_OBJECT
+
+    static constexpr qreal DELTA = 1e-9;
+
+public:
+
+signals:
+
+private slots:
+    void evaluate();
+    void evaluate_data();
+    void errors();
+    void errors_data();
+    void folding();
+    void derivedSource();
+    void derivedFault();
+    void derivedTimeout();
+};
+
+#endif // CHANNEL_EXPRESSION_TEST_H
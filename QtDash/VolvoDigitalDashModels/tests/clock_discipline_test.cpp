@@ -0,0 +1,76 @@
+#include "clock_discipline_test.h"
+
+namespace {
+    static constexpr qint64 MSEC = 1000000; //!< nanoseconds
+    static constexpr qint64 FIX_NSEC = 1715949296000000000; //!< 2024-05-17 12:34:56 UTC
+
+    /**
+     * @brief Feed a window of 10 Hz fixes
+     * @param discipline: clock discipline
+     * @param fixNsec: fix time, advanced
+     * @param offsetNsec: system clock behind gps time
+     * @param delaysMsec: serial delay of each fix, repeated to fill the window
+     * @return correction after the last fix
+     */
+    ClockDiscipline::Correction_t window(ClockDiscipline & discipline, qint64 & fixNsec,
+                                         qint64 offsetNsec, QList<int> delaysMsec) {
+        ClockDiscipline::Correction_t correction = {ClockDiscipline::Action::NONE, 0};
+        for (int i = 0; i < ClockDiscipline::WINDOW; i++) {
+            fixNsec += 100 * MSEC;
+            qint64 arrival = fixNsec + delaysMsec.at(i % delaysMsec.size()) * MSEC - offsetNsec;
+            correction = discipline.addFix(fixNsec, arrival);
+        }
+        return correction;
+    }
+}
+
+void ClockDisciplineTest::firstFixSteps() {
+    // booted in 1970
+    ClockDiscipline discipline;
+    QVERIFY(!discipline.isSynced());
+    ClockDiscipline::Correction_t correction = discipline.addFix(FIX_NSEC, 30 * ClockDiscipline::NSEC_PER_SEC);
+    QCOMPARE(correction.action, ClockDiscipline::Action::STEP);
+    QCOMPARE(correction.offsetNsec, FIX_NSEC - 30 * ClockDiscipline::NSEC_PER_SEC);
+    QVERIFY(discipline.isSynced());
+
+    // close enough on the first fix -- no step, just a window
+    ClockDiscipline close;
+    QCOMPARE(close.addFix(FIX_NSEC, FIX_NSEC + 40 * MSEC).action, ClockDiscipline::Action::NONE);
+}
+
+void ClockDisciplineTest::slewLeastDelayed() {
+    ClockDiscipline discipline;
+    qint64 fix = FIX_NSEC;
+
+    // 30 ms behind, fixes delayed 20 to 60 ms -- the 20 ms one is the estimate
+    ClockDiscipline::Correction_t correction = window(discipline, fix, 30 * MSEC, {45, 20, 60, 33});
+    QCOMPARE(correction.action, ClockDiscipline::Action::SLEW);
+    QCOMPARE(correction.offsetNsec, 10 * MSEC);
+    QCOMPARE(discipline.getOffsetNsec(), 10 * MSEC);
+
+    // a second off mid drive is stepped
+    correction = window(discipline, fix, 2000 * MSEC, {20});
+    QCOMPARE(correction.action, ClockDiscipline::Action::STEP);
+    QCOMPARE(correction.offsetNsec, 1980 * MSEC);
+}
+
+void ClockDisciplineTest::deadband() {
+    ClockDiscipline discipline;
+    qint64 fix = FIX_NSEC;
+    ClockDiscipline::Correction_t correction = window(discipline, fix, 21 * MSEC, {20, 25});
+    QCOMPARE(correction.action, ClockDiscipline::Action::NONE);
+    QCOMPARE(discipline.getOffsetNsec(), 1 * MSEC);
+}
+
+void ClockDisciplineTest::latency() {
+    // a known 20 ms of serial delay is taken off
+    ClockDiscipline discipline(20 * MSEC);
+    qint64 fix = FIX_NSEC;
+    ClockDiscipline::Correction_t correction = window(discipline, fix, 0, {20, 24});
+    QCOMPARE(correction.action, ClockDiscipline::Action::NONE);
+    QCOMPARE(discipline.getOffsetNsec(), 0LL);
+
+    correction = window(discipline, fix, -50 * MSEC, {20, 24});
+    QCOMPARE(correction.action, ClockDiscipline::Action::SLEW);
+    QCOMPARE(correction.offsetNsec, -50 * MSEC);
+}
@@ -0,0 +1,23 @@
+#ifndef CLOCK_DISCIPLINE_TEST_H
+#define CLOCK_DISCIPLINE_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <clock_discipline.h>
+
+class ClockDisciplineTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void firstFixSteps();
+    void slewLeastDelayed();
+    void deadband();
+    void latency();
+};
+
+#endif // CLOCK_DISCIPLINE_TEST_H
@@ -0,0 +1,231 @@
+#include "config_cache_test.h"
+#include <config_cache.h>
+
+void ConfigCacheTest::initTestCase() {
+    QVERIFY(mDir.isValid());
+    mPreviousPath = ConfigCache::getPath();
+    ConfigCache::setPath(mDir.filePath("cache/config.cache"));
+}
+
+void ConfigCacheTest::cleanupTestCase() {
+    ConfigCache::setPath(mPreviousPath);
+}
+
+void ConfigCacheTest::test_snapshotRoundTrip() {
+    QStringList paths = writeConfig("roundtrip", 3);
+    Config parsed(this, paths, QByteArray());
+    Config restored(this, paths, parsed.snapshot());
+
+    QCOMPARE(restored.getSensorConfig(), parsed.getSensorConfig());
+    QCOMPARE(restored.getSensorConfig().value(Config::COOLANT_TEMP_KEY), 3);
+    QCOMPARE(restored.getMapSensorConfig().p5V, 250.0);
+    QCOMPARE(restored.getMapSensorConfig().units, Config::PressureUnits::KPA);
+    QCOMPARE(restored.getTempSensorConfigs()->size(), 1);
+    QCOMPARE(restored.getTempSensorConfigs()->at(0).r2, 1000.0);
+    QCOMPARE(restored.getTempSensorConfigs()->at(0).type, Config::TemperatureSensorType::OIL);
+    QCOMPARE(restored.getTachInputConfig().pulsesPerRot, 3);
+    QCOMPARE(restored.getVssConfig().distanceUnits, Config::DistanceUnits::KILOMETER);
+    QCOMPARE(restored.getGaugeConfig(Config::BOOST_GAUGE_GROUP).max, 30.0);
+    QCOMPARE(restored.getSpeedoConfig().topUnits, QString("rpm"));
+    QCOMPARE(restored.getResistiveSensorConfig(Config::RES_SENSOR_TYPE_FUEL_LEVEL).x,
+             parsed.getResistiveSensorConfig(Config::RES_SENSOR_TYPE_FUEL_LEVEL).x);
+    QCOMPARE(restored.getSensorFilterConfig(Config::FILTER_TACH_KEY), QStringList({"median:3", "rate:2000"}));
+    QCOMPARE(restored.getSensorFilterConfig(Config::FUEL_LEVEL_KEY), QStringList({"lag:0.5", "median:5"}));
+    QCOMPARE(restored.getSensorFilterConfig(Config::OIL_TEMP_KEY), QStringList());
+    QCOMPARE(restored.getSampleRateConfig().displayHz, 25.0);
+    QCOMPARE(restored.getSampleRateConfig().acquireHz.value(Config::MAP_SENSOR_KEY), 100.0);
+    QCOMPARE(restored.getSampleRateConfig().acquireHz.contains(Config::OIL_PRESSURE_KEY), false);
+    QCOMPARE(restored.getDerivedChannelConfigs().size(), 1);
+    QCOMPARE(restored.getDerivedChannelConfigs().at(0).name, QString("ratio"));
+    QCOMPARE(restored.getDerivedChannelConfigs().at(0).expression, QString("min(tach,speedo)"));
+    QCOMPARE(restored.getDerivedChannelConfigs().at(0).gauge, QString(Config::BOOST_GAUGE_GROUP));
+    QCOMPARE(restored.isCanEnabled(), true);
+    QCOMPARE(restored.getCanFrameConfig("boost").getFrameId(), 0x123u);
+    QCOMPARE(restored.getCanFrameConfig("boost").getValue(QByteArray::fromHex("0064")), 25.0);
+    QCOMPARE(restored.getConfigFilePaths(), paths);
+
+    // the odometer isn't part of the snapshot, but is still loaded
+    QCOMPARE(restored.getOdometerConfig(Config::ODO_NAME_ODOMETER).value, 1234.5);
+}
+
+void ConfigCacheTest::test_fitCurves() {
+    QStringList paths = writeConfig("fit", 0);
+    Config config(this, paths, ConfigCache::load(paths));
+
+    // y = 100 - r, fitted once when the files were parsed
+    QList<qreal> coeff = config.getResistiveSensorConfig(Config::RES_SENSOR_TYPE_FUEL_LEVEL).coeff;
+    QCOMPARE(coeff.size(), 2);
+    QVERIFY(qAbs(coeff.at(0) - 100) < 1e-6);
+    QVERIFY(qAbs(coeff.at(1) + 1) < 1e-6);
+}
+
+void ConfigCacheTest::test_diskCache() {
+    QStringList paths = writeConfig("disk", 1);
+    QFile::remove(ConfigCache::getPath());
+
+    QByteArray parsed = ConfigCache::load(paths);
+    QVERIFY(!parsed.isEmpty());
+    QVERIFY(QFile::exists(ConfigCache::getPath()));
+
+    // unchanged files are read back from the disk entry
+    QCOMPARE(ConfigCache::load(paths), parsed);
+
+    // disabling the disk cache still parses
+    ConfigCache::setPath(QString());
+    QCOMPARE(ConfigCache::load(paths), parsed);
+    ConfigCache::setPath(mDir.filePath("cache/config.cache"));
+}
+
+void ConfigCacheTest::test_staleEntry() {
+    QStringList paths = writeConfig("stale", 2);
+    QCOMPARE(Config(this, paths, ConfigCache::load(paths)).getSensorConfig().value(Config::COOLANT_TEMP_KEY), 2);
+
+    // an edited config replaces the disk entry
+    writeConfig("stale", 5);
+    QFile file(paths.at(0));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+    file.close();
+
+    QCOMPARE(Config(this, paths, ConfigCache::load(paths)).getSensorConfig().value(Config::COOLANT_TEMP_KEY), 5);
+}
+
+void ConfigCacheTest::test_corruptSnapshot() {
+    QStringList paths = writeConfig("corrupt", 4);
+
+    // a bad snapshot falls back to parsing the files
+    QByteArray snapshot = Config(this, paths, QByteArray()).snapshot();
+    Config truncated(this, paths, snapshot.left(snapshot.size() / 2));
+    QCOMPARE(truncated.getSensorConfig().value(Config::COOLANT_TEMP_KEY), 4);
+
+    Config garbage(this, paths, QByteArray("not a snapshot"));
+    QCOMPARE(garbage.getSensorConfig().value(Config::COOLANT_TEMP_KEY), 4);
+
+    // nothing read before the error is left for the files to be parsed on top of
+    for (int size = snapshot.size() / 4; size < snapshot.size(); size += snapshot.size() / 4) {
+        Config partial(this, paths, snapshot.left(size));
+        QCOMPARE(partial.getTempSensorConfigs()->size(), 1);
+        QCOMPARE(partial.getDerivedChannelConfigs().size(), 1);
+        QCOMPARE(partial.getAlarmConfigs().size(), 1);
+        QCOMPARE(partial.getCanFrameConfigs().size(), 1);
+    }
+}
+
+void ConfigCacheTest::test_preload() {
+    QStringList paths = writeConfig("preload", 6);
+
+    ConfigCache::preload(paths);
+    QByteArray snapshot = ConfigCache::take(paths);
+    QVERIFY(!snapshot.isEmpty());
+    QCOMPARE(Config(this, paths, snapshot).getSensorConfig().value(Config::COOLANT_TEMP_KEY), 6);
+
+    // nothing preloaded -- loaded on the calling thread
+    QCOMPARE(ConfigCache::take(paths), snapshot);
+}
+
+QStringList ConfigCacheTest::writeConfig(QString name, int coolantChannel) {
+    QStringList paths = {mDir.filePath(name + "_config.ini"), mDir.filePath(name + "_gauges.ini"),
+                         mDir.filePath(name + "_odo.ini"), mDir.filePath(name + "_can.ini")};
+
+    QSettings config(paths.at(0), QSettings::IniFormat);
+    config.clear();
+    config.beginGroup(Config::SENSOR_CHANNEL_GROUP);
+    config.setValue(Config::COOLANT_TEMP_KEY, coolantChannel);
+    config.setValue(Config::FUEL_LEVEL_KEY, 7);
+    config.endGroup();
+
+    config.beginGroup(Config::MAP_SENSOR_GROUP);
+    config.setValue(Config::PRESSURE_AT_0V, 10);
+    config.setValue(Config::PRESSURE_AT_5V, 250);
+    config.setValue(Config::PRESSURE_UNITS, Config::UNITS_KPA);
+    config.endGroup();
+
+    config.beginWriteArray(Config::TEMP_SENSOR_GROUP);
+    config.setArrayIndex(0);
+    config.setValue(Config::TEMP_TYPE, Config::TEMP_TYPE_OIL);
+    config.setValue(Config::T1_TEMP, 0);
+    config.setValue(Config::T1_RES, 5000);
+    config.setValue(Config::T2_TEMP, 50);
+    config.setValue(Config::T2_RES, 1000);
+    config.setValue(Config::T3_TEMP, 100);
+    config.setValue(Config::T3_RES, 200);
+    config.endArray();
+
+    config.beginGroup(Config::TACH_INPUT_GROUP);
+    config.setValue(Config::TACH_PULSES_PER_ROTATION, 3);
+    config.endGroup();
+
+    config.beginGroup(Config::VSS_INPUT_GROUP);
+    config.setValue(Config::VSS_DISTANCE_UNITS, Config::UNITS_KILOMETER);
+    config.endGroup();
+
+    config.beginWriteArray(Config::RESISTIVE_SENSOR_GROUP);
+    config.setArrayIndex(0);
+    config.setValue(Config::RES_SENSOR_TYPE, Config::RES_SENSOR_TYPE_FUEL_LEVEL);
+    config.setValue(Config::RES_SENSOR_FIT_TYPE, QStringList({Config::RES_SENSOR_FIT_TYPE_POLYNOMIAL, "1"}));
+    config.setValue(Config::RES_SENSOR_R_VALUES, QStringList({"10", "50", "90"}));
+    config.setValue(Config::RES_SENSOR_Y_VALUES, QStringList({"90", "50", "10"}));
+    config.setValue(Config::RES_SENSOR_LAG, 0.5);
+    config.endArray();
+
+    config.beginGroup(Config::SENSOR_FILTER_GROUP);
+    config.setValue(Config::FILTER_TACH_KEY, QStringList({"median:3", "rate:2000"}));
+    config.setValue(Config::FUEL_LEVEL_KEY, "median:5");
+    config.endGroup();
+
+    config.beginGroup(Config::SAMPLE_RATE_GROUP);
+    config.setValue(Config::SAMPLE_RATE_DISPLAY_HZ, 25);
+    config.setValue(Config::MAP_SENSOR_KEY, 100);
+    config.endGroup();
+
+    // an unquoted expression with a comma is written as a list
+    config.beginWriteArray(Config::DERIVED_CHANNEL_GROUP);
+    config.setArrayIndex(0);
+    config.setValue(Config::DERIVED_CHANNEL_NAME, "ratio");
+    config.setValue(Config::DERIVED_CHANNEL_EXPRESSION, QStringList({"min(tach", "speedo)"}));
+    config.setValue(Config::DERIVED_CHANNEL_GAUGE, Config::BOOST_GAUGE_GROUP);
+    config.endArray();
+
+    config.beginWriteArray(Config::ALARM_GROUP);
+    config.setArrayIndex(0);
+    config.setValue(Config::ALARM_NAME, "overrev");
+    config.setValue(Config::ALARM_EXPRESSION, "tach > 6500");
+    config.endArray();
+    config.sync();
+
+    QSettings gauges(paths.at(1), QSettings::IniFormat);
+    gauges.clear();
+    gauges.beginGroup(Config::BOOST_GAUGE_GROUP);
+    gauges.setValue(Config::MAX_VALUE, 30);
+    gauges.endGroup();
+    gauges.beginGroup(Config::SPEEDOMETER_GAUGE_GROUP);
+    gauges.setValue(Config::TOP_VALUE_UNITS, "rpm");
+    gauges.endGroup();
+    gauges.sync();
+
+    QSettings odo(paths.at(2), QSettings::IniFormat);
+    odo.clear();
+    odo.beginWriteArray(Config::ODOMETER_GROUP);
+    odo.setArrayIndex(0);
+    odo.setValue(Config::ODO_NAME, Config::ODO_NAME_ODOMETER);
+    odo.setValue(Config::ODO_VALUE, 1234.5);
+    odo.endArray();
+    odo.sync();
+
+    QSettings can(paths.at(3), QSettings::IniFormat);
+    can.clear();
+    can.beginGroup(Config::CAN_CONFIG_START);
+    can.setValue(Config::CAN_CONFIG_ENABLE, true);
+    can.endGroup();
+    can.beginWriteArray(Config::CAN_FRAME);
+    can.setArrayIndex(0);
+    can.setValue(Config::CAN_FRAME_ID, 0x123);
+    can.setValue(Config::CAN_FRAME_OFFSET, 0);
+    can.setValue(Config::CAN_FRAME_SIZE, 2);
+    can.setValue(Config::CAN_FRAME_NAME, "boost");
+    can.setValue(Config::CAN_FRAME_DIVIDE, 4);
+    can.endArray();
+    can.sync();
+
+    return paths;
+}
@@ -0,0 +1,34 @@
+#ifndef CONFIG_CACHE_TEST_H
+#define CONFIG_CACHE_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class ConfigCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_snapshotRoundTrip();
+    void test_fitCurves();
+    void test_diskCache();
+    void test_staleEntry();
+    void test_corruptSnapshot();
+    void test_preload();
+
+private:
+    QTemporaryDir mDir;
+    QString mPreviousPath;
+
+    QStringList writeConfig(QString name, int coolantChannel);
+};
+
+#endif // CONFIG_CACHE_TEST_H
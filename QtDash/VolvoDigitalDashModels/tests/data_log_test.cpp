@@ -0,0 +1,178 @@
+#include "data_log_test.h"
+#include <data_log.h>
+#include <data_logger.h>
+#include <QRandomGenerator>
+
+void DataLogTest::initTestCase() {
+    QVERIFY(mDir.isValid());
+}
+
+void DataLogTest::test_varint() {
+    QFETCH(qint64, value);
+    QFETCH(int, size);
+
+    QByteArray out;
+    DataLog::putVarint(out, DataLog::zigzag(value));
+    QCOMPARE(out.size(), size);
+
+    int pos = 0;
+    quint64 raw = 0;
+    QVERIFY(DataLog::getVarint(out, pos, raw));
+    QCOMPARE(pos, size);
+    QCOMPARE(DataLog::unzigzag(raw), value);
+}
+
+void DataLogTest::test_varint_data() {
+    QTest::addColumn<qint64>("value");
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("zero") << qint64(0) << 1;
+    QTest::newRow("one") << qint64(1) << 1;
+    QTest::newRow("minus one") << qint64(-1) << 1;
+    QTest::newRow("63") << qint64(63) << 1;
+    QTest::newRow("-64") << qint64(-64) << 1;
+    QTest::newRow("64") << qint64(64) << 2;
+    QTest::newRow("rpm") << qint64(6500) << 2;
+    QTest::newRow("timestamp") << qint64(36000000000) << 6;
+    QTest::newRow("max") << std::numeric_limits<qint64>::max() << 10;
+    QTest::newRow("min") << std::numeric_limits<qint64>::min() << 10;
+}
+
+void DataLogTest::test_blockRoundTrip() {
+    QVector<DataLog::Channel_t> channels = {
+        {"rpm", "rpm", 1.0},
+        {"coolant_temp", "F", 0.1},
+        {"fuse8_12v", "V", 0.001}
+    };
+
+    QVector<DataLog::Sample_t> samples = {
+        {1000000, 850, 0},
+        {1000100, 185.04, 1},
+        {1010000, 900.4, 0},
+        {1020300, -12.5, 1},
+        {1020400, 13.8124, 2},
+        {1030000, 1200, 0}
+    };
+
+    QByteArray block = DataLog::encodeBlock(samples, channels, samples.first().timeUs);
+
+    QVector<DataLog::Sample_t> decoded;
+    QVERIFY(DataLog::decodeBlock(block, channels, samples.first().timeUs, decoded));
+    QCOMPARE(decoded.size(), samples.size());
+
+    // decoded samples are grouped by channel
+    for (auto sample : samples) {
+        bool found = false;
+        for (auto d : decoded) {
+            if (d.channel == sample.channel && d.timeUs == sample.timeUs) {
+                QVERIFY(qAbs(d.value - sample.value) <= channels.at(sample.channel).resolution / 2);
+                found = true;
+            }
+        }
+        QVERIFY2(found, qPrintable(QString("missing sample at %1").arg(sample.timeUs)));
+    }
+
+    // truncated payload is rejected
+    QVERIFY(!DataLog::decodeBlock(block.left(block.size() - 1), channels, samples.first().timeUs, decoded));
+}
+
+void DataLogTest::test_nonFinite() {
+    QVector<DataLog::Channel_t> channels = {
+        {"oil_pressure", "psi", 0.01}
+    };
+
+    // a sensor dropping out mid block, and values too big to quantize
+    QVector<DataLog::Sample_t> samples = {
+        {0, 45.5, 0},
+        {10000, qQNaN(), 0},
+        {20000, qInf(), 0},
+        {30000, 44.25, 0},
+        {40000, -qInf(), 0},
+        {50000, 1e300, 0},
+        {60000, -12.5, 0}
+    };
+
+    QByteArray block = DataLog::encodeBlock(samples, channels, 0);
+    QVector<DataLog::Sample_t> decoded;
+    QVERIFY(DataLog::decodeBlock(block, channels, 0, decoded));
+    QCOMPARE(decoded.size(), samples.size());
+
+    QCOMPARE(decoded.at(0).value, 45.5);
+    QVERIFY(qIsNaN(decoded.at(1).value));
+    QVERIFY(qIsNaN(decoded.at(2).value));
+    QCOMPARE(decoded.at(3).value, 44.25);
+    QVERIFY(qIsNaN(decoded.at(4).value));
+    QCOMPARE(decoded.at(5).value, DataLog::MAX_QUANTIZED * 0.01);
+    QCOMPARE(decoded.at(6).value, -12.5);
+}
+
+void DataLogTest::test_blockSize() {
+    // ten channels at 100 Hz with timer jitter and sensor noise for one 10 s block
+    static constexpr int CHANNELS = 10;
+    static constexpr int RATE_HZ = 100;
+    static constexpr int SECONDS = 10;
+
+    QRandomGenerator random(240);
+    QVector<DataLog::Channel_t> channels;
+    for (int ch = 0; ch < CHANNELS; ch++) {
+        channels.append({QString("ch%1").arg(ch), "V", 0.001});
+    }
+
+    QVector<DataLog::Sample_t> samples;
+    qreal value[CHANNELS] = {0};
+    for (int i = 0; i < RATE_HZ * SECONDS; i++) {
+        for (int ch = 0; ch < CHANNELS; ch++) {
+            qint64 t = (qint64) i * (1000000 / RATE_HZ) + random.bounded(300);
+            value[ch] += (random.generateDouble() - 0.5) * 0.01;
+            samples.append({t, 2.5 + value[ch], (quint16) ch});
+        }
+    }
+
+    QByteArray block = qCompress(DataLog::encodeBlock(samples, channels, 0), DataLog::COMPRESSION_LEVEL);
+    qreal bytesPerHour = (qreal) block.size() * 3600 / SECONDS;
+    qDebug() << "bytes per sample: " << (qreal) block.size() / samples.size()
+             << " MB per hour: " << bytesPerHour / 1.0e6;
+    QVERIFY(bytesPerHour < 5.0e6);
+}
+
+void DataLogTest::test_loggerRoundTrip() {
+    Config::DataLoggerConfig_t config = {true, mDir.path(), 1, 1, 1024};
+    DataLogger * logger = new DataLogger(this, config);
+    int rpm = logger->addChannel("rpm", "rpm");
+    int boost = logger->addChannel("map_sensor", "psi");
+    QCOMPARE(rpm, 0);
+    QCOMPARE(boost, 1);
+
+    QVERIFY(logger->start());
+    QVERIFY(logger->isLogging());
+    QCOMPARE(logger->addChannel("late", "V"), -1);
+
+    for (int i = 0; i < 100; i++) {
+        logger->log(rpm, 800 + i * 10);
+        logger->log(boost, i * 0.1);
+    }
+    logger->stop();
+    QVERIFY(!logger->isLogging());
+    delete logger;
+
+    QStringList logs = QDir(mDir.path()).entryList({QString("*") + DataLog::FILE_EXTENSION});
+    QCOMPARE(logs.size(), 1);
+
+    DataLogReader reader;
+    QVERIFY(reader.open(QDir(mDir.path()).filePath(logs.first())));
+    QCOMPARE(reader.getChannels().size(), 2);
+    QCOMPARE(reader.getChannels().at(1).name, QString("map_sensor"));
+    QCOMPARE(reader.getChannels().at(1).resolution, 0.01);
+    QVERIFY(reader.getBlockIndex().size() >= 1);
+
+    QVector<DataLog::Sample_t> samples = reader.readRange(0, std::numeric_limits<qint64>::max());
+    QCOMPARE(samples.size(), 200);
+
+    qreal lastRpm = 0;
+    for (auto sample : samples) {
+        if (sample.channel == rpm) {
+            lastRpm = sample.value;
+        }
+    }
+    QCOMPARE(lastRpm, 1790.0);
+}
@@ -0,0 +1,31 @@
+#ifndef DATA_LOG_TEST_H
+#define DATA_LOG_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class DataLogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void initTestCase();
+
+    void test_varint();
+    void test_varint_data();
+
+    void test_blockRoundTrip();
+    void test_nonFinite();
+    void test_blockSize();
+    void test_loggerRoundTrip();
+
+private:
+    QTemporaryDir mDir;
+};
+
+#endif // DATA_LOG_TEST_H
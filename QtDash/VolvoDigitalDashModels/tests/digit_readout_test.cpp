@@ -0,0 +1,72 @@
+#include "digit_readout_test.h"
+#include <digit_readout.h>
+
+/**
+ * @brief Glyphs back to text so failures are readable
+ */
+static QString glyphText(qreal value, int decimals, DigitReadout::Format format) {
+    static const char characters[] = "0123456789.-:";
+    quint8 glyphs[DigitReadout::MAX_CELLS];
+    int count = DigitReadout::formatGlyphs(value, decimals, format, glyphs);
+
+    QString text;
+    for (int i = 0; i < count; i++) {
+        text += characters[glyphs[i]];
+    }
+    return text;
+}
+
+void DigitReadoutTest::test_number_data() {
+    QTest::addColumn<qreal>("value");
+    QTest::addColumn<int>("decimals");
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("integer") << 1234.0 << 0 << "1234";
+    QTest::newRow("zero") << 0.0 << 1 << "0.0";
+    QTest::newRow("decimals") << 12.345 << 2 << "12.35";
+    QTest::newRow("leading zero decimals") << 3.05 << 2 << "3.05";
+    QTest::newRow("round up") << 9.96 << 1 << "10.0";
+    QTest::newRow("negative") << -40.25 << 1 << "-40.3";
+    QTest::newRow("negative zero") << -0.01 << 1 << "0.0";
+    QTest::newRow("negative decimals clamped") << 7.6 << -1 << "8";
+}
+
+void DigitReadoutTest::test_number() {
+    QFETCH(qreal, value);
+    QFETCH(int, decimals);
+    QFETCH(QString, text);
+
+    QCOMPARE(glyphText(value, decimals, DigitReadout::Number), text);
+}
+
+void DigitReadoutTest::test_time_data() {
+    QTest::addColumn<qreal>("seconds");
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("midnight") << 0.0 << "0:00:00";
+    QTest::newRow("morning") << 9 * 3600.0 + 5 * 60 + 7 << "9:05:07";
+    QTest::newRow("evening") << 23 * 3600.0 + 59 * 60 + 59 << "23:59:59";
+    QTest::newRow("negative") << -5.0 << "0:00:00";
+}
+
+void DigitReadoutTest::test_time() {
+    QFETCH(qreal, seconds);
+    QFETCH(QString, text);
+
+    QCOMPARE(glyphText(seconds, 0, DigitReadout::Time), text);
+}
+
+void DigitReadoutTest::test_nonFinite() {
+    QCOMPARE(glyphText(qQNaN(), 1, DigitReadout::Number), QString("--"));
+    QCOMPARE(glyphText(qInf(), 1, DigitReadout::Number), QString("--"));
+    QCOMPARE(glyphText(qQNaN(), 0, DigitReadout::Time), QString("--"));
+}
+
+void DigitReadoutTest::test_overflow() {
+    // never writes past the cell array
+    quint8 glyphs[DigitReadout::MAX_CELLS + 1];
+    glyphs[DigitReadout::MAX_CELLS] = 0xff;
+    int count = DigitReadout::formatGlyphs(-1e30, 6, DigitReadout::Number, glyphs);
+    QVERIFY(count <= DigitReadout::MAX_CELLS);
+    QCOMPARE(glyphs[DigitReadout::MAX_CELLS], (quint8) 0xff);
+}
@@ -0,0 +1,24 @@
+#ifndef DIGIT_READOUT_TEST_H
+#define DIGIT_READOUT_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+
+class DigitReadoutTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void test_number_data();
+    void test_number();
+    void test_time_data();
+    void test_time();
+    void test_nonFinite();
+    void test_overflow();
+};
+
+#endif // DIGIT_READOUT_TEST_H
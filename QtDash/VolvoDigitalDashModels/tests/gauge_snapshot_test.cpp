@@ -0,0 +1,136 @@
+#include "gauge_snapshot_test.h"
+#include <gauge_snapshot.h>
+
+void GaugeSnapshotTest::initTestCase() {
+    QVERIFY(mDir.isValid());
+}
+
+void GaugeSnapshotTest::test_roundTrip() {
+    QString path = mDir.filePath("roundtrip.dat");
+    SnapshotTestModel coolant, light;
+
+    GaugeSnapshot first(this, path);
+    first.addChannel("coolant", &coolant, "value", &coolant, &SnapshotTestModel::sampleReady);
+    first.addChannel("oil_light", &light, "on", &light, &SnapshotTestModel::sampleReady);
+    QCOMPARE(first.restore(), 0);
+
+    coolant.sample(87.5);
+    light.mOn = true;
+    light.sample(0);
+    QVERIFY(first.isLive("coolant"));
+    first.save();
+    QVERIFY(QFile::exists(path));
+
+    // next boot -- shown before the sensors report
+    SnapshotTestModel coolant2, light2;
+    GaugeSnapshot second(this, path);
+    second.addChannel("coolant", &coolant2, "value", &coolant2, &SnapshotTestModel::sampleReady);
+    second.addChannel("oil_light", &light2, "on", &light2, &SnapshotTestModel::sampleReady);
+    QCOMPARE(second.restore(), 2);
+    QCOMPARE(coolant2.mValue, 87.5);
+    QCOMPARE(light2.mOn, true);
+    QVERIFY(!second.isLive("coolant"));
+
+    // the first sample takes over
+    coolant2.sample(20);
+    QVERIFY(second.isLive("coolant"));
+    QCOMPARE(coolant2.mValue, 20.0);
+}
+
+void GaugeSnapshotTest::test_liveBeforeRestore() {
+    QString path = mDir.filePath("live.dat");
+    SnapshotTestModel fuel;
+    {
+        GaugeSnapshot snapshot(this, path);
+        snapshot.addChannel("fuel", &fuel, "value", &fuel, &SnapshotTestModel::sampleReady);
+        fuel.sample(40);
+        snapshot.save();
+    }
+
+    // a source that already reported isn't overwritten
+    SnapshotTestModel fuel2;
+    GaugeSnapshot snapshot(this, path);
+    snapshot.addChannel("fuel", &fuel2, "value", &fuel2, &SnapshotTestModel::sampleReady);
+    fuel2.sample(35);
+    QCOMPARE(snapshot.restore(), 0);
+    QCOMPARE(fuel2.mValue, 35.0);
+}
+
+void GaugeSnapshotTest::test_invalidSample() {
+    QString path = mDir.filePath("invalid.dat");
+    SnapshotTestModel temp;
+    {
+        GaugeSnapshot snapshot(this, path);
+        snapshot.addChannel("temp", &temp, "value", &temp, &SnapshotTestModel::sampleReady);
+        temp.sample(90);
+        snapshot.save();
+    }
+
+    SnapshotTestModel temp2;
+    GaugeSnapshot snapshot(this, path);
+    snapshot.addChannel("temp", &temp2, "value", &temp2, &SnapshotTestModel::sampleReady);
+    QCOMPARE(snapshot.restore(), 1);
+
+    // no reading yet -- still not live
+    temp2.sample(qQNaN());
+    QVERIFY(!snapshot.isLive("temp"));
+    temp2.sample(85);
+    QVERIFY(snapshot.isLive("temp"));
+
+    // nothing shown yet is nothing to save
+    SnapshotTestModel unused;
+    GaugeSnapshot empty(this, mDir.filePath("empty.dat"));
+    empty.addChannel("unused", &unused, "value", &unused, &SnapshotTestModel::sampleReady);
+    empty.save();
+    QVERIFY(!QFile::exists(mDir.filePath("empty.dat")));
+}
+
+void GaugeSnapshotTest::test_unconfirmed() {
+    QString path = mDir.filePath("unconfirmed.dat");
+    {
+        SnapshotTestModel coolant, oil;
+        GaugeSnapshot snapshot(this, path);
+        snapshot.addChannel("coolant", &coolant, "value", &coolant, &SnapshotTestModel::sampleReady);
+        snapshot.addChannel("oil", &oil, "value", &oil, &SnapshotTestModel::sampleReady);
+        coolant.sample(90);
+        oil.sample(100);
+        snapshot.save();
+    }
+
+    // the oil temp sender died since -- its restored value doesn't stay up
+    SnapshotTestModel coolant, oil;
+    oil.mValue = -40;
+    GaugeSnapshot snapshot(this, path);
+    snapshot.addChannel("coolant", &coolant, "value", &coolant, &SnapshotTestModel::sampleReady);
+    snapshot.addChannel("oil", &oil, "value", &oil, &SnapshotTestModel::sampleReady);
+    QCOMPARE(snapshot.restore(50), 2);
+    QCOMPARE(oil.mValue, 100.0);
+    coolant.sample(85);
+    QTRY_COMPARE(oil.mValue, -40.0);
+    QCOMPARE(coolant.mValue, 85.0);
+
+    // and isn't carried over to the next boot
+    snapshot.save();
+    SnapshotTestModel coolant2, oil2;
+    GaugeSnapshot next(this, path);
+    next.addChannel("coolant", &coolant2, "value", &coolant2, &SnapshotTestModel::sampleReady);
+    next.addChannel("oil", &oil2, "value", &oil2, &SnapshotTestModel::sampleReady);
+    QCOMPARE(next.restore(), 1);
+    QCOMPARE(coolant2.mValue, 85.0);
+    QCOMPARE(oil2.mValue, 0.0);
+}
+
+void GaugeSnapshotTest::test_corruptFile() {
+    QString path = mDir.filePath("corrupt.dat");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("not a snapshot");
+    file.close();
+
+    SnapshotTestModel model;
+    model.mValue = 12;
+    GaugeSnapshot snapshot(this, path);
+    snapshot.addChannel("value", &model, "value", &model, &SnapshotTestModel::sampleReady);
+    QCOMPARE(snapshot.restore(), 0);
+    QCOMPARE(model.mValue, 12.0);
+}
@@ -0,0 +1,51 @@
+#ifndef GAUGE_SNAPSHOT_TEST_H
+#define GAUGE_SNAPSHOT_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+/**
+ * @brief Stand-in for a gauge model and the sensor driving it
+ */
+class SnapshotTestModel : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal value MEMBER mValue)
+    Q_PROPERTY(bool on MEMBER mOn)
+
+public:
+    qreal mValue = 0;
+    bool mOn = false;
+
+    void sample(qreal value) {
+        mValue = value;
+        emit sampleReady();
+    }
+
+signals:
+    void sampleReady();
+};
+
+class GaugeSnapshotTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void initTestCase();
+
+    void test_roundTrip();
+    void test_liveBeforeRestore();
+    void test_invalidSample();
+    void test_unconfirmed();
+    void test_corruptFile();
+
+private:
+    QTemporaryDir mDir;
+};
+
+#endif // GAUGE_SNAPSHOT_TEST_H
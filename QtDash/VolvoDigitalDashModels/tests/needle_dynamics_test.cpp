@@ -0,0 +1,118 @@
+#include "needle_dynamics_test.h"
+#include <needle_dynamics.h>
+
+static constexpr qint64 FRAME_US = 16667;
+
+void NeedleDynamicsTest::test_stepNoOvershoot() {
+    NeedleDynamics dynamics;
+    dynamics.reset(0, 0);
+    dynamics.addSample(100, 0);
+
+    qreal max = 0;
+    qint64 within = -1;
+    for (qint64 t = FRAME_US; t < 400000; t += FRAME_US) {
+        qreal position = dynamics.advance(t);
+        max = qMax(max, position);
+        if (within < 0 && qAbs(position - 100) < 0.5) {
+            within = t;
+        }
+    }
+
+    QVERIFY(max <= 100);
+    // about as quick as the old 150 ms needle animation
+    QVERIFY(within > 0 && within <= 160000);
+    QVERIFY(dynamics.isSettled(400000));
+}
+
+void NeedleDynamicsTest::test_rampTracking() {
+    // 20 Hz samples of a 1000 deg/s sweep drawn at 60 fps
+    const qreal rate = 1000.0 / 1e6;
+    NeedleDynamics dynamics;
+    dynamics.reset(0, 0);
+
+    qreal worst = 0;
+    qint64 nextSample = 0;
+    for (qint64 t = 0; t < 2000000; t += FRAME_US) {
+        while (nextSample <= t) {
+            dynamics.addSample(rate * nextSample, nextSample);
+            nextSample += 50000;
+        }
+        qreal position = dynamics.advance(t);
+        if (t > 500000) {
+            worst = qMax(worst, qAbs(position - rate * t));
+        }
+    }
+
+    // within one frame of the true value -- a lagging 150 ms animation is ~150 degrees behind
+    QVERIFY(worst < rate * FRAME_US);
+}
+
+void NeedleDynamicsTest::test_rampStop() {
+    const qreal rate = 1000.0 / 1e6;
+    const qint64 sampleInterval = 50000;
+    NeedleDynamics dynamics;
+    dynamics.reset(0, 0);
+
+    qreal max = 0;
+    qint64 nextSample = 0;
+    qint64 t = 0;
+    for (; t < 3000000; t += FRAME_US) {
+        while (nextSample <= t) {
+            dynamics.addSample(qMin(rate * nextSample, 1000.0), nextSample);
+            nextSample += sampleInterval;
+        }
+        max = qMax(max, dynamics.advance(t));
+    }
+
+    // runs past by less than one sample's change, then settles on the value
+    QVERIFY(max < 1000 + rate * sampleInterval);
+    QVERIFY(qAbs(dynamics.getPosition() - 1000) < NeedleDynamics::SETTLED_POSITION);
+    QVERIFY(dynamics.isSettled(t));
+}
+
+void NeedleDynamicsTest::test_sporadicSamples() {
+    NeedleDynamics dynamics;
+    dynamics.reset(0, 0);
+    dynamics.addSample(10, 0);
+    dynamics.addSample(20, NeedleDynamics::MAX_PREDICTION_INTERVAL_US + 1);
+
+    // too far apart to extrapolate
+    QCOMPARE(dynamics.predict(NeedleDynamics::MAX_PREDICTION_INTERVAL_US * 2), 20.0);
+}
+
+void NeedleDynamicsTest::test_irregularFrames() {
+    NeedleDynamics dynamics;
+    dynamics.reset(0, 0);
+    dynamics.addSample(50, 0);
+
+    // a long stall doesn't blow up the integration
+    qreal position = dynamics.advance(5000);
+    position = dynamics.advance(2005000);
+    QVERIFY(qAbs(position - 50) < NeedleDynamics::SETTLED_POSITION);
+
+    // time going backwards is ignored
+    QCOMPARE(dynamics.advance(1000), position);
+}
+
+void NeedleDynamicsTest::test_settle() {
+    // a coarse tolerance stops the needle well before the spring's tail dies out
+    NeedleDynamics dynamics;
+    dynamics.reset(0, 0);
+    dynamics.addSample(100, 0);
+
+    qint64 coarse = -1;
+    for (qint64 t = FRAME_US; t < 400000; t += FRAME_US) {
+        dynamics.advance(t);
+        if (dynamics.isSettled(t, 0.5, 30)) {
+            coarse = t;
+            break;
+        }
+    }
+    QVERIFY(coarse > 0);
+    QVERIFY(!dynamics.isSettled(coarse));
+
+    QCOMPARE(dynamics.settle(coarse), 100.0);
+    QCOMPARE(dynamics.getVelocity(), 0.0);
+    QVERIFY(dynamics.isSettled(coarse));
+    QCOMPARE(dynamics.advance(coarse + FRAME_US), 100.0);
+}
@@ -0,0 +1,24 @@
+#ifndef NEEDLE_DYNAMICS_TEST_H
+#define NEEDLE_DYNAMICS_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+
+class NeedleDynamicsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void test_stepNoOvershoot();
+    void test_rampTracking();
+    void test_rampStop();
+    void test_sporadicSamples();
+    void test_irregularFrames();
+    void test_settle();
+};
+
+#endif // NEEDLE_DYNAMICS_TEST_H
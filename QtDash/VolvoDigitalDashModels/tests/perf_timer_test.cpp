@@ -0,0 +1,104 @@
+#include "perf_timer_test.h"
+#include "qsignalspy.h"
+
+namespace {
+    /**
+     * @brief Time of a constant acceleration run at a distance
+     */
+    qreal secondsAt(qreal meters, qreal acceleration) {
+        return qSqrt(2 * meters / acceleration);
+    }
+}
+
+void PerfTimerTest::vssRun() {
+    const qreal metersPerPulse = 0.5;
+    PerfTimer timer(nullptr, metersPerPulse);
+    QSignalSpy spy(&timer, &PerfTimer::runChanged);
+
+    timer.update(START_NSEC - PerfTimer::STANDSTILL_NSEC * 2);
+    QCOMPARE(timer.getState(), PerfTimer::RunState::ARMED);
+
+    // constant acceleration from the first pulse
+    for (quint32 pulse = 0; pulse < 1000; pulse++) {
+        qreal seconds = secondsAt(pulse * metersPerPulse, ACCELERATION);
+        timer.addPulse(START_NSEC + qRound64(seconds * 1e9), 100 + pulse);
+    }
+
+    // every target is reached, the run is over
+    QCOMPARE(timer.getState(), PerfTimer::RunState::IDLE);
+    QVERIFY(spy.count() >= 3);
+
+    QVERIFY(qAbs(timer.getResult(0).seconds - 6.0) < 1e-3);
+    QVERIFY(qAbs(timer.getResult(1).seconds - (100 / 3.6) / ACCELERATION) < 1e-3);
+    QVERIFY(qAbs(timer.getResult(2).seconds - secondsAt(201.168, ACCELERATION)) < 1e-3);
+    QVERIFY(qAbs(timer.getResult(3).seconds - secondsAt(402.336, ACCELERATION)) < 1e-3);
+
+    // trap speed
+    qreal trap = ACCELERATION * secondsAt(402.336, ACCELERATION);
+    QVERIFY(qAbs(timer.getResult(3).speed - trap) < 0.5);
+}
+
+void PerfTimerTest::vssStandstill() {
+    PerfTimer timer(nullptr, 0.5);
+    timer.update(START_NSEC);
+    QCOMPARE(timer.getState(), PerfTimer::RunState::ARMED);
+
+    // rolling, then stopped before reaching anything
+    timer.addPulse(START_NSEC, 0);
+    timer.addPulse(START_NSEC + 100000000, 1);
+    QCOMPARE(timer.getState(), PerfTimer::RunState::RUNNING);
+    timer.update(START_NSEC + 100000000 + PerfTimer::STANDSTILL_NSEC * 2);
+    QCOMPARE(timer.getState(), PerfTimer::RunState::ARMED);
+    QVERIFY(qIsNaN(timer.getResult(0).seconds));
+
+    // a gps fix doesn't drive a VSS timer
+    timer.addFix(START_NSEC, 0, 0, 30);
+    QCOMPARE(timer.getState(), PerfTimer::RunState::ARMED);
+}
+
+void PerfTimerTest::gpsRun() {
+    PerfTimer timer(nullptr, 0.5, true);
+
+    // standing still, then constant acceleration from 1 second -- 10 Hz fixes
+    const qint64 fixNsec = 100000000;
+    for (int i = 0; i < 300; i++) {
+        qreal seconds = i * 0.1;
+        qreal speed = qMax(0.0, ACCELERATION * (seconds - 1.0));
+        timer.addFix(START_NSEC + i * fixNsec, 0, 0, speed);
+        if (i == 5) {
+            QCOMPARE(timer.getState(), PerfTimer::RunState::ARMED);
+        }
+    }
+
+    // timed from LAUNCH_SPEED
+    qreal launch = PerfTimer::LAUNCH_SPEED / ACCELERATION;
+    QCOMPARE(timer.getState(), PerfTimer::RunState::IDLE);
+    QVERIFY(qAbs(timer.getResult(0).seconds - (6.0 - launch)) < 1e-3);
+    QVERIFY(qAbs(timer.getResult(3).seconds - (secondsAt(402.336, ACCELERATION) - launch)) < 0.01);
+}
+
+void PerfTimerTest::laps() {
+    // east-west line across the equator at the prime meridian
+    PerfTimer timer(nullptr, 0.5, false, {0, -0.001, 0, 0.001});
+    QSignalSpy spy(&timer, &PerfTimer::lapChanged);
+
+    // northbound across the line 10 m per fix, then back south well clear of it
+    auto drive = [&timer](qint64 start) {
+        for (int i = 0; i < 10; i++) {
+            timer.addFix(start + i * 1000000000LL, -0.00045 + i * 0.0001, 0, 10);
+        }
+        timer.addFix(start + 20000000000LL, 0.01, 0.01, 10);
+        timer.addFix(start + 30000000000LL, -0.01, 0.01, 10);
+        timer.addFix(start + 40000000000LL, -0.01, 0, 10);
+    };
+
+    drive(START_NSEC);
+    QCOMPARE(timer.getLapCount(), 0);
+    drive(START_NSEC + 60000000000LL);
+    drive(START_NSEC + 115000000000LL);
+
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(timer.getLapCount(), 2);
+    QVERIFY(qAbs(timer.getLastLap() - 55.0) < 1e-3);
+    QVERIFY(qAbs(timer.getBestLap() - 55.0) < 1e-3);
+}
@@ -0,0 +1,26 @@
+#ifndef PERF_TIMER_TEST_H
+#define PERF_TIMER_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <perf_timer.h>
+
+class PerfTimerTest : public QObject
+{
+    Q_OBJECT
+
+    static constexpr qreal ACCELERATION = 26.8224 / 6.0; //!< 0-60 mph in 6 seconds (m/s^2)
+    static constexpr qint64 START_NSEC = 10000000000; //!< launch time
+
+public:
+
+signals:
+
+private slots:
+    void vssRun();
+    void vssStandstill();
+    void gpsRun();
+    void laps();
+};
+
+#endif // PERF_TIMER_TEST_H
@@ -0,0 +1,208 @@
+#include "sensor_filter_test.h"
+
+void SensorFilterTest::ring() {
+    FilterRing<int, 4> ring;
+    ring.resize(3);
+    QCOMPARE(ring.count(), 0);
+
+    for (int i = 1; i <= 5; i++) {
+        ring.push(i);
+    }
+
+    // only the last 3 are kept, newest first
+    QVERIFY(ring.isFull());
+    QCOMPARE(ring.count(), 3);
+    QCOMPARE(ring.at(0), 5);
+    QCOMPARE(ring.at(1), 4);
+    QCOMPARE(ring.at(2), 3);
+
+    // capacity is clamped
+    ring.resize(10);
+    QCOMPARE(ring.size(), 4);
+    QCOMPARE(ring.count(), 0);
+}
+
+void SensorFilterTest::lag() {
+    LagFilter filter(0.2);
+
+    // starts at the first sample, then y = lag * x + (1 - lag) * y[n-1]
+    QCOMPARE(filter.process(50, 0), 50.0);
+    QVERIFY(qAbs(filter.process(100, 0) - 60) < DELTA);
+    QVERIFY(qAbs(filter.process(100, 0) - 68) < DELTA);
+
+    filter.reset();
+    QCOMPARE(filter.process(10, 0), 10.0);
+}
+
+void SensorFilterTest::lowPass() {
+    BiquadFilter filter = BiquadFilter::lowPass(1, 20);
+
+    // no startup transient from the first sample
+    for (int i = 0; i < 5; i++) {
+        QVERIFY(qAbs(filter.process(12, 0) - 12) < 1e-6);
+    }
+
+    // a step settles to the new value
+    qreal y = 0;
+    for (int i = 0; i < 200; i++) {
+        y = filter.process(14, 0);
+    }
+    QVERIFY(qAbs(y - 14) < 1e-6);
+
+    // alternating samples (nyquist) are rejected
+    qreal peak = 0;
+    for (int i = 0; i < 200; i++) {
+        y = filter.process((i % 2) ? 1 : -1, 0);
+        if (i > 100) {
+            peak = qMax(peak, qAbs(y));
+        }
+    }
+    QVERIFY(peak < 0.05);
+}
+
+void SensorFilterTest::average() {
+    FirFilter<8> filter = FirFilter<8>::average(4);
+
+    // the first sample fills the window
+    QCOMPARE(filter.process(4, 0), 4.0);
+    QVERIFY(qAbs(filter.process(8, 0) - 5) < DELTA);
+    QVERIFY(qAbs(filter.process(8, 0) - 6) < DELTA);
+    QVERIFY(qAbs(filter.process(8, 0) - 7) < DELTA);
+    QVERIFY(qAbs(filter.process(8, 0) - 8) < DELTA);
+
+    // explicit taps, newest sample first
+    FirFilter<8> taps({0.5, 0.5});
+    taps.process(0, 0);
+    QVERIFY(qAbs(taps.process(10, 0) - 5) < DELTA);
+}
+
+void SensorFilterTest::median() {
+    MedianFilter<15> filter(5);
+    QList<qreal> input = {10, 10, 250, 10, 11, 10, -90, 12, 12, 12};
+    for (qreal x : input) {
+        qreal y = filter.process(x, 0);
+        // single spikes never get through
+        QVERIFY(y >= 10 && y <= 12);
+    }
+
+    // a real step does, after half the window
+    QCOMPARE(filter.process(40, 0), 12.0);
+    QCOMPARE(filter.process(40, 0), 12.0);
+    QCOMPARE(filter.process(40, 0), 40.0);
+}
+
+void SensorFilterTest::rateLimit() {
+    RateLimiter filter(100);
+
+    QCOMPARE(filter.process(0, 0), 0.0);
+    QVERIFY(qAbs(filter.process(1000, 0.5) - 50) < DELTA);
+    QVERIFY(qAbs(filter.process(1000, 1.0) - 150) < DELTA);
+    QVERIFY(qAbs(filter.process(-1000, 0.1) - 140) < DELTA);
+
+    // small changes pass straight through
+    QVERIFY(qAbs(filter.process(145, 0.1) - 145) < DELTA);
+}
+
+void SensorFilterTest::hysteresis() {
+    Hysteresis filter(0.5);
+
+    QCOMPARE(filter.process(13.8, 0), 13.8);
+    QCOMPARE(filter.process(14.1, 0), 13.8);
+    QCOMPARE(filter.process(13.4, 0), 13.8);
+    QCOMPARE(filter.process(14.4, 0), 14.4);
+}
+
+void SensorFilterTest::decimator() {
+    Decimator decimator(5);
+    QCOMPARE(decimator.getFactor(), 5);
+
+    // first sample straight out, then every 5th, unity gain
+    int outputs = 0;
+    qreal y = 0;
+    for (int i = 0; i < 21; i++) {
+        if (decimator.process(3, y)) {
+            outputs++;
+            QVERIFY(qAbs(y - 3) < 1e-9);
+        }
+    }
+    QCOMPARE(outputs, 5);
+
+    // a tone above the output nyquist frequency doesn't alias into the output
+    decimator.reset();
+    qreal peak = 0;
+    for (int i = 0; i < 500; i++) {
+        if (decimator.process(qSin(M_PI * 0.9 * i), y) && i > 50) {
+            peak = qMax(peak, qAbs(y));
+        }
+    }
+    QVERIFY(peak < 0.01);
+
+    // a slow one passes
+    decimator.reset();
+    peak = 0;
+    for (int i = 0; i < 500; i++) {
+        if (decimator.process(qSin(M_PI * 0.02 * i), y) && i > 50) {
+            peak = qMax(peak, qAbs(y));
+        }
+    }
+    QVERIFY(peak > 0.9);
+
+    // factor 1 passes every sample
+    Decimator passThrough(1);
+    QVERIFY(passThrough.process(7, y));
+    QCOMPARE(y, 7.0);
+}
+
+void SensorFilterTest::chain() {
+    SensorFilter filter;
+    QVERIFY(filter.isEmpty());
+    QCOMPARE(filter.process(3, 0), 3.0);
+
+    QVERIFY(filter.parse({"median:3", "hysteresis:1"}));
+    QCOMPARE(filter.getStageCount(), 2);
+
+    QCOMPARE(filter.process(20, 0), 20.0);
+    QCOMPARE(filter.process(20, 0), 20.0);
+    // spike removed by the median, the small change held by the hysteresis
+    QCOMPARE(filter.process(90, 0), 20.0);
+    QCOMPARE(filter.process(20.5, 0), 20.0);
+    QCOMPARE(filter.process(22, 0), 22.0);
+
+    // the chain is full at MAX_STAGES
+    for (int i = filter.getStageCount(); i < SensorFilter::MAX_STAGES; i++) {
+        QVERIFY(filter.addStage(LagFilter(0.5)));
+    }
+    QVERIFY(!filter.addStage(LagFilter(0.5)));
+    QVERIFY(!filter.parse({"lag:0.5"}));
+}
+
+void SensorFilterTest::parse() {
+    QFETCH(QString, spec);
+    QFETCH(bool, valid);
+
+    SensorFilter filter;
+    QCOMPARE(filter.parse({spec}), valid);
+    QCOMPARE(filter.getStageCount(), valid ? 1 : 0);
+}
+
+void SensorFilterTest::parse_data() {
+    QTest::addColumn<QString>("spec");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("lag") << "lag:0.2" << true;
+    QTest::newRow("lag out of range") << "lag:1.5" << false;
+    QTest::newRow("lowpass") << "lowpass:2:20" << true;
+    QTest::newRow("lowpass q") << " LowPass : 2 : 20 : 0.5 " << true;
+    QTest::newRow("lowpass above nyquist") << "lowpass:15:20" << false;
+    QTest::newRow("biquad") << "biquad:0.2:0.4:0.2:-0.5:0.3" << true;
+    QTest::newRow("biquad missing") << "biquad:0.2:0.4:0.2" << false;
+    QTest::newRow("average") << "average:8" << true;
+    QTest::newRow("average too long") << "average:64" << false;
+    QTest::newRow("fir") << "fir:0.25:0.5:0.25" << true;
+    QTest::newRow("median") << "median:5" << true;
+    QTest::newRow("median too long") << "median:31" << false;
+    QTest::newRow("rate") << "rate:500" << true;
+    QTest::newRow("hysteresis") << "hysteresis:0.1" << true;
+    QTest::newRow("not a number") << "median:five" << false;
+    QTest::newRow("unknown") << "kalman:1" << false;
+}
@@ -0,0 +1,32 @@
+#ifndef SENSOR_FILTER_TEST_H
+#define SENSOR_FILTER_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <sensor_filter.h>
+
+class SensorFilterTest : public QObject
+{
+    Q_OBJECT
+
+    static constexpr qreal DELTA = 1e-9;
+
+public:
+
+signals:
+
+private slots:
+    void ring();
+    void lag();
+    void lowPass();
+    void average();
+    void median();
+    void rateLimit();
+    void hysteresis();
+    void decimator();
+    void chain();
+    void parse();
+    void parse_data();
+};
+
+#endif // SENSOR_FILTER_TEST_H
@@ -0,0 +1,168 @@
+#include "sensor_health_test.h"
+#include "qsignalspy.h"
+#include <functional>
+
+namespace {
+    /**
+     * @brief Feed samples at 100 Hz and evaluate every 100 msec, like the monitor
+     * @param health: channel health
+     * @param msec: clock, advanced
+     * @param duration: milliseconds to run for
+     * @param status: status of each sample, by sample index
+     * @return number of reported status changes
+     */
+    int run(SensorHealth & health, qint64 & msec, qint64 duration,
+            std::function<SensorHealth::Status(int)> status) {
+        int changes = 0;
+        for (int i = 0; i < duration / 10; i++) {
+            msec += 10;
+            health.record(status(i), msec);
+            if (i % 10 == 9) {
+                changes += health.evaluate(msec) ? 1 : 0;
+            }
+        }
+        return changes;
+    }
+
+    SensorHealth::Status ok(int) {
+        return SensorHealth::Status::OK;
+    }
+
+    SensorHealth::Status open(int) {
+        return SensorHealth::Status::OPEN;
+    }
+}
+
+void SensorHealthTest::faultHysteresis() {
+    SensorHealth health(0);
+    qint64 msec = 0;
+    QCOMPARE(run(health, msec, 1000, ok), 0);
+    QVERIFY(health.isOk());
+
+    // a fault shorter than the fault time isn't reported
+    QCOMPARE(run(health, msec, SensorHealth::DEFAULT_FAULT_MSEC - 100, open), 0);
+    QCOMPARE(run(health, msec, 1000, ok), 0);
+    QVERIFY(health.isOk());
+
+    // a lasting one is, once
+    QCOMPARE(run(health, msec, 1000, open), 1);
+    QCOMPARE(health.getStatus(), SensorHealth::Status::OPEN);
+
+    // and it takes the recovery time to clear
+    QCOMPARE(run(health, msec, SensorHealth::DEFAULT_RECOVER_MSEC - 100, ok), 0);
+    QCOMPARE(health.getStatus(), SensorHealth::Status::OPEN);
+    QCOMPARE(run(health, msec, 200, ok), 1);
+    QVERIFY(health.isOk());
+}
+
+void SensorHealthTest::flakyConnector() {
+    SensorHealth health(0);
+    qint64 msec = 0;
+
+    // the odd bad sample never reaches the status
+    QCOMPARE(run(health, msec, 5000, [](int i) {
+        return (i % 7 == 0) ? SensorHealth::Status::OPEN : SensorHealth::Status::OK;
+    }), 0);
+    QVERIFY(health.isOk());
+
+    // a connector that's mostly open is one fault, not a fault per bounce
+    QCOMPARE(run(health, msec, 5000, [](int i) {
+        return (i % 80 < 70) ? SensorHealth::Status::OPEN : SensorHealth::Status::OK;
+    }), 1);
+    QCOMPARE(health.getStatus(), SensorHealth::Status::OPEN);
+}
+
+void SensorHealthTest::stale() {
+    SensorHealth health(0);
+    health.setTiming(500, 100, 1000);
+
+    // no samples from the start
+    QVERIFY(!health.evaluate(400));
+    QVERIFY(!health.evaluate(600));
+    QVERIFY(health.evaluate(700));
+    QCOMPARE(health.getStatus(), SensorHealth::Status::STALE);
+
+    // samples again
+    health.record(SensorHealth::Status::OK, 800);
+    QVERIFY(!health.evaluate(800));
+    health.record(SensorHealth::Status::OK, 1800);
+    QVERIFY(health.evaluate(1800));
+    QVERIFY(health.isOk());
+}
+
+void SensorHealthTest::busOff() {
+    SensorHealth health(0);
+    health.setTiming(500, 0, 0);
+
+    // latched whether or not samples arrive
+    health.setLatched(SensorHealth::Status::BUS_OFF);
+    health.record(SensorHealth::Status::OK, 100);
+    QVERIFY(health.evaluate(100));
+    QCOMPARE(health.getStatus(), SensorHealth::Status::BUS_OFF);
+
+    health.setLatched(SensorHealth::Status::OK);
+    health.record(SensorHealth::Status::OK, 200);
+    QVERIFY(health.evaluate(200));
+    QVERIFY(health.isOk());
+}
+
+void SensorHealthTest::classifyVoltage() {
+    QCOMPARE(SensorHealth::classifyVoltage(2.5, 5.0), SensorHealth::Status::OK);
+    QCOMPARE(SensorHealth::classifyVoltage(4.9, 5.0), SensorHealth::Status::OPEN);
+    QCOMPARE(SensorHealth::classifyVoltage(0.1, 5.0), SensorHealth::Status::SHORT);
+    QCOMPARE(SensorHealth::classifyVoltage(qQNaN(), 5.0), SensorHealth::Status::OUT_OF_RANGE);
+}
+
+void SensorHealthTest::badSampleHeld() {
+    Config config(this, "validConfig.ini");
+    TestSource source(this, &config);
+    PublishingTestSensor sensor(this, &config, &source, 0);
+    QSignalSpy spy(&sensor, SIGNAL(sensorDataReady(QVariant)));
+
+    source.send(1.0, 0);
+    source.send(qQNaN(), 0);
+    source.send(2.0, 0);
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(0).toReal(), 2.0);
+}
+
+void SensorHealthTest::fallback() {
+    Config config(this, "validConfig.ini");
+    TestSource source(this, &config);
+    PublishingTestSensor primary(this, &config, &source, 0);
+    PublishingTestSensor secondary(this, &config, &source, 1);
+    primary.setHealthTiming(50, 0, 0);
+    secondary.setHealthTiming(50, 0, 0);
+
+    FallbackSensor sensor(this, &config, &primary, &secondary);
+    QSignalSpy spy(&sensor, SIGNAL(sensorDataReady(QVariant)));
+    QSignalSpy healthSpy(&sensor, SIGNAL(healthChanged(int)));
+
+    source.send(1.0, 0);
+    source.send(2.0, 1);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(0).toReal(), 1.0);
+
+    // primary goes quiet
+    QTest::qWait(100);
+    source.send(3.0, 1);
+    qint64 now = SensorHealth::nowMsec();
+    primary.updateHealth(now);
+    secondary.updateHealth(now);
+    QCOMPARE(primary.getHealth(), SensorHealth::Status::STALE);
+    QCOMPARE(sensor.getActive(), &secondary);
+    QCOMPARE(sensor.getHealth(), SensorHealth::Status::OK);
+    QCOMPARE(healthSpy.count(), 0);
+
+    source.send(4.0, 0);
+    source.send(5.0, 1);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(0).toReal(), 5.0);
+
+    // and comes back
+    primary.updateHealth(SensorHealth::nowMsec());
+    QCOMPARE(sensor.getActive(), &primary);
+    source.send(6.0, 0);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(0).toReal(), 6.0);
+}
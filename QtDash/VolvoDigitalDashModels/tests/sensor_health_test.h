@@ -0,0 +1,28 @@
+#ifndef SENSOR_HEALTH_TEST_H
+#define SENSOR_HEALTH_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <sensor_health.h>
+#include <sensor_fallback.h>
+#include <sensor_test.h>
+
+class SensorHealthTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void faultHysteresis();
+    void flakyConnector();
+    void stale();
+    void busOff();
+    void classifyVoltage();
+    void badSampleHeld();
+    void fallback();
+};
+
+#endif // SENSOR_HEALTH_TEST_H
@@ -0,0 +1,97 @@
+#include "sensor_log_test.h"
+#include <sensor_log.h>
+
+void SensorLogTest::initTestCase() {
+    QVERIFY(mDir.isValid());
+}
+
+void SensorLogTest::test_roundTrip() {
+    QString path = mDir.filePath("round_trip.vdlog");
+
+    SensorLogWriter writer;
+    QVERIFY(writer.open(path, 1234));
+    int adc = writer.addStream("adc");
+    int gps = writer.addStream("gps");
+    QCOMPARE(adc, 0);
+    QCOMPARE(gps, 1);
+
+    writer.write(adc, 5, 2.5, 100);
+    writer.write(gps, 4, QString("NW"), 150);
+    writer.write(adc, 0, 0xA5, 1000150);
+    writer.close();
+
+    SensorLogReader reader;
+    QVERIFY(reader.open(path));
+    QCOMPARE(reader.getStartTime(), qint64(1234));
+
+    SensorLog::Sample_t sample;
+    QVERIFY(reader.readNext(sample));
+    QCOMPARE(sample.timeUs, qint64(100));
+    QCOMPARE(reader.getStreamName(sample.stream), QString("adc"));
+    QCOMPARE(sample.channel, 5);
+    QCOMPARE(sample.value.toDouble(), 2.5);
+
+    QVERIFY(reader.readNext(sample));
+    QCOMPARE(sample.timeUs, qint64(150));
+    QCOMPARE(reader.getStreamName(sample.stream), QString("gps"));
+    QCOMPARE(sample.channel, 4);
+    QCOMPARE(sample.value.toString(), QString("NW"));
+
+    QVERIFY(reader.readNext(sample));
+    QCOMPARE(sample.timeUs, qint64(1000150));
+    QCOMPARE(sample.channel, 0);
+    QCOMPARE(sample.value.type(), QVariant::Int);
+    QCOMPARE(sample.value.toInt(), 0xA5);
+
+    QVERIFY(!reader.readNext(sample));
+}
+
+void SensorLogTest::test_embeddedFiles() {
+    QString path = mDir.filePath("embedded.vdlog");
+
+    SensorLogWriter writer;
+    QVERIFY(writer.open(path, 0, {{"config.ini", "[sensor_channels]\ncoolant_temp=0\n"}}));
+    writer.close();
+
+    SensorLogReader reader;
+    QVERIFY(reader.open(path));
+    QCOMPARE(reader.getEmbeddedFiles().size(), 1);
+    QCOMPARE(reader.getEmbeddedFiles().value("config.ini"), QByteArray("[sensor_channels]\ncoolant_temp=0\n"));
+}
+
+void SensorLogTest::test_truncatedLog() {
+    QString path = mDir.filePath("truncated.vdlog");
+
+    SensorLogWriter writer;
+    QVERIFY(writer.open(path, 0));
+    int stream = writer.addStream("tach");
+    writer.write(stream, 0, 900.0, 10);
+    writer.write(stream, 0, 950.0, 20);
+    writer.close();
+
+    // cut the last sample in half like a power loss would
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 4));
+    file.close();
+
+    SensorLogReader reader;
+    QVERIFY(reader.open(path));
+
+    SensorLog::Sample_t sample;
+    QVERIFY(reader.readNext(sample));
+    QCOMPARE(sample.value.toDouble(), 900.0);
+    QVERIFY(!reader.readNext(sample));
+}
+
+void SensorLogTest::test_notALog() {
+    QString path = mDir.filePath("not_a_log.vdlog");
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("[sensor_channels]\n");
+    file.close();
+
+    SensorLogReader reader;
+    QVERIFY(!reader.open(path));
+}
@@ -0,0 +1,28 @@
+#ifndef SENSOR_LOG_TEST_H
+#define SENSOR_LOG_TEST_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class SensorLogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void initTestCase();
+
+    void test_roundTrip();
+    void test_embeddedFiles();
+    void test_truncatedLog();
+    void test_notALog();
+
+private:
+    QTemporaryDir mDir;
+};
+
+#endif // SENSOR_LOG_TEST_H
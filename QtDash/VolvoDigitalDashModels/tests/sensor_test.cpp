@@ -58,6 +58,30 @@ void SensorTest::test_channelUpdate() {
     QCOMPARE(args.at(1), 1);
 }
 
+void SensorTest::test_decimation() {
+    PublishingTestSensor sensor(this, nullptr, testSource, 3);
+    sensor.setDecimation(4);
+    QCOMPARE(sensor.getDecimation(), 4);
+
+    QSignalSpy displaySpy(&sensor, SIGNAL(sensorDataReady(QVariant)));
+    QSignalSpy sampleSpy(&sensor, SIGNAL(sampleReady(qreal)));
+
+    for (int i = 0; i < 9; i++) {
+        testSource->send(10.0, 3);
+    }
+
+    // every sample at full rate, the gauge gets the first and then every 4th
+    QCOMPARE(sampleSpy.count(), 9);
+    QCOMPARE(displaySpy.count(), 3);
+    QVERIFY(qAbs(displaySpy.last().at(0).toReal() - 10.0) < 1e-9);
+
+    // the history holds the full rate samples, oldest first
+    testSource->send(20.0, 3);
+    QVector<qreal> history = sensor.getHistory(3);
+    QCOMPARE(history, QVector<qreal>({10.0, 10.0, 20.0}));
+    QCOMPARE(sensor.getHistory().size(), 10);
+}
+
 void SensorTest::cleanupTestCase() {
     delete(testSource);
     delete(testSensor);
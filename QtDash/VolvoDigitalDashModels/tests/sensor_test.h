@@ -51,6 +51,10 @@ public slots:
         emit dataReady(24.0, channel);
     }
 
+    void send(qreal value, int channel) {
+        emit dataReady(value, channel);
+    }
+
 private:
     bool mInit = false;
 };
@@ -95,6 +99,26 @@ public slots:
     }
 };
 
+class PublishingTestSensor : public Sensor {
+    Q_OBJECT
+public:
+    PublishingTestSensor(QObject * parent, Config * config, SensorSource * source, int channel)
+        : Sensor(parent, config, source, channel) {
+
+    }
+
+    QString getUnits() override {
+        return Config::UNITS_METER;
+    }
+
+public slots:
+    void transform(QVariant data, int channel) override {
+        if (channel == getChannel()) {
+            publish(data.toReal());
+        }
+    }
+};
+
 class SensorTest : public QObject
 {
     Q_OBJECT
@@ -109,6 +133,7 @@ private slots:
     void test_sensorConstructor();
     void test_sensor1Constructor();
     void test_channelUpdate();
+    void test_decimation();
 
     void cleanupTestCase();
 
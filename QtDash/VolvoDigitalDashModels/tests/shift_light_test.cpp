@@ -0,0 +1,182 @@
+#include "shift_light_test.h"
+#include "qsignalspy.h"
+
+namespace {
+    constexpr int PULSES_PER_ROT = 2;
+
+    Config::ShiftLightConfig_t config(QList<qreal> shiftRpm, QList<qreal> ratios = QList<qreal>()) {
+        Config::ShiftLightConfig_t conf;
+        conf.shiftRpm = shiftRpm;
+        conf.ratios = ratios;
+        return conf;
+    }
+
+    /**
+     * @brief Feed tach pulses for an rpm rising at a constant rate, updating every 50 msec and at the end
+     * @param light: shift light
+     * @param nsec: clock, advanced
+     * @param count: pulse count, advanced
+     * @param rpm: rpm, advanced
+     * @param rpmPerSec: rpm rate of change
+     * @param duration: nanoseconds to run for
+     */
+    void rev(ShiftLight & light, qint64 & nsec, quint32 & count, qreal & rpm, qreal rpmPerSec, qint64 duration) {
+        qint64 end = nsec + duration;
+        qint64 nextUpdate = nsec + 50000000;
+        while (nsec < end) {
+            qint64 interval = (qint64) (60.0e9 / (rpm * PULSES_PER_ROT));
+            nsec += interval;
+            rpm += rpmPerSec * interval / 1.0e9;
+            light.addPulse(nsec, ++count);
+            if (nsec >= nextUpdate) {
+                light.update(nsec);
+                nextUpdate += 50000000;
+            }
+        }
+        light.update(nsec);
+    }
+}
+
+void ShiftLightTest::predictsAhead() {
+    ShiftLight light(nullptr, config({7000}), PULSES_PER_ROT);
+    qint64 nsec = 1000000000;
+    quint32 count = 0;
+    qreal rpm = 3000;
+
+    // 5000 rpm/s -- 100 msec ahead is 500 rpm up
+    rev(light, nsec, count, rpm, 5000, 500000000);
+    light.update(nsec);
+    QVERIFY(qAbs(light.getPredictedRpm() - (rpm + 500)) < 50);
+
+    // steady
+    rev(light, nsec, count, rpm, 0, 500000000);
+    light.update(nsec);
+    QVERIFY(qAbs(light.getPredictedRpm() - rpm) < 20);
+}
+
+void ShiftLightTest::stages() {
+    // 5 stages from 6000, 250 rpm apart
+    ShiftLight light(nullptr, config({7000}), PULSES_PER_ROT);
+    QSignalSpy spy(&light, &ShiftLight::stageChanged);
+    qint64 nsec = 1000000000;
+    quint32 count = 0;
+    qreal rpm = 4000;
+
+    rev(light, nsec, count, rpm, 0, 300000000);
+    QCOMPARE(light.getStage(), 0);
+    QCOMPARE(spy.count(), 0);
+
+    // revving through 6000 at 5000 rpm/s -- once the fit window is all acceleration,
+    // the first stage lights 100 msec (500 rpm) early
+    while (light.getStage() == 0) {
+        rev(light, nsec, count, rpm, 5000, 10000000);
+    }
+    QVERIFY(rpm > 5450 && rpm < 5580);
+
+    // all lit before the shift point
+    while (light.getStage() < light.getStages()) {
+        rev(light, nsec, count, rpm, 5000, 10000000);
+    }
+    QVERIFY(rpm > 6450 && rpm < 6580);
+    QCOMPARE(spy.count(), light.getStages());
+
+    // holding just under a threshold doesn't flicker
+    rpm = 6240;
+    rev(light, nsec, count, rpm, 0, 500000000);
+    QCOMPARE(light.getStage(), 1);
+    spy.clear();
+    for (int i = 0; i < 10; i++) {
+        rpm = (i % 2) ? 6260 : 6230;
+        rev(light, nsec, count, rpm, 0, 100000000);
+    }
+    QVERIFY(spy.count() <= 1);
+    QVERIFY(light.getStage() >= 1);
+}
+
+void ShiftLightTest::gearShiftPoints() {
+    // rpm per mph: 1st 113, 2nd 67, 3rd 45
+    ShiftLight light(nullptr, config({6500, 6800, 7000}, {113, 67, 45}), PULSES_PER_ROT);
+    QSignalSpy gears(&light, &ShiftLight::gearChanged);
+    qint64 nsec = 1000000000;
+    quint32 count = 0;
+    qreal rpm = 4520;
+
+    light.setSpeed(40);
+    rev(light, nsec, count, rpm, 0, 300000000);
+    QCOMPARE(light.getGear(), 1);
+    QCOMPARE(light.getShiftRpm(light.getGear()), 6500.0);
+
+    // clutch in -- no gear matches, the gear holds
+    rpm = 1200;
+    rev(light, nsec, count, rpm, 0, 300000000);
+    QCOMPARE(light.getGear(), 1);
+
+    rpm = 2680;
+    rev(light, nsec, count, rpm, 0, 300000000);
+    QCOMPARE(light.getGear(), 2);
+    QCOMPARE(gears.count(), 2);
+
+    // standing still has no gear, and uses the last shift point
+    light.setSpeed(0);
+    rev(light, nsec, count, rpm, 0, 100000000);
+    QCOMPARE(light.getGear(), 0);
+    QCOMPARE(light.getShiftRpm(0), 7000.0);
+}
+
+void ShiftLightTest::polledFallback() {
+    ShiftLight light(nullptr, config({7000}), PULSES_PER_ROT);
+    qint64 nsec = 1000000000;
+
+    // polled every 50 msec, rising 5000 rpm/s
+    for (int i = 0; i < 10; i++) {
+        nsec += 50000000;
+        light.addRpm(5000 + i * 250, nsec);
+        light.update(nsec);
+    }
+    QVERIFY(qAbs(light.getPredictedRpm() - (5000 + 9 * 250 + 500)) < 1);
+    QVERIFY(light.getStage() > 0);
+}
+
+void ShiftLightTest::pulsesOverPolled() {
+    ShiftLight light(nullptr, config({7000}), PULSES_PER_ROT);
+    qint64 nsec = 1000000000;
+    quint32 count = 100;
+
+    // 6000 rpm is a pulse every 5 msec
+    light.addPulse(nsec, count);
+    for (int i = 0; i < 20; i++) {
+        nsec += 5000000;
+        count++;
+        light.addPulse(nsec, count);
+    }
+
+    // edges missed between two reads of pulse_edges -- the count still gives the rpm
+    nsec += 15000000;
+    count += 3;
+    light.addPulse(nsec, count);
+
+    // a stale polled rpm is ignored while there are pulses
+    light.addRpm(1000, nsec);
+    light.update(nsec);
+    QVERIFY(qAbs(light.getPredictedRpm() - 6000) < 1);
+
+    // the first pulse after a long gap isn't an rpm
+    nsec += 400000000;
+    light.addPulse(nsec, count + 1);
+    light.update(nsec);
+    QVERIFY(qIsNaN(light.getPredictedRpm()));
+}
+
+void ShiftLightTest::engineOff() {
+    ShiftLight light(nullptr, config({7000}), PULSES_PER_ROT);
+    qint64 nsec = 1000000000;
+    quint32 count = 0;
+    qreal rpm = 7100;
+    rev(light, nsec, count, rpm, 0, 300000000);
+    QCOMPARE(light.getStage(), light.getStages());
+
+    // no more pulses -- the light goes out
+    light.update(nsec + 500000000);
+    QVERIFY(qIsNaN(light.getPredictedRpm()));
+    QCOMPARE(light.getStage(), 0);
+}
@@ -0,0 +1,25 @@
+#ifndef SHIFT_LIGHT_TEST_H
+#define SHIFT_LIGHT_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <shift_light.h>
+
+class ShiftLightTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void predictsAhead();
+    void stages();
+    void gearShiftPoints();
+    void polledFallback();
+    void pulsesOverPolled();
+    void engineOff();
+};
+
+#endif // SHIFT_LIGHT_TEST_H
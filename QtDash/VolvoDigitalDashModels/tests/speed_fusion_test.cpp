@@ -0,0 +1,107 @@
+#include "speed_fusion_test.h"
+
+namespace {
+    static constexpr qreal SPEED = 25.0; //!< raw VSS speed (m/s)
+
+    /**
+     * @brief Cruise at a steady speed -- VSS at 20 Hz, gps at 10 Hz with +/- 0.2 m/s of noise
+     * @param fusion: estimator
+     * @param msec: clock, advanced
+     * @param truth: true distance per VSS distance
+     * @param seconds: time to drive
+     * @return calibration updates
+     */
+    int cruise(SpeedFusion & fusion, qint64 & msec, qreal truth, qreal seconds) {
+        int updates = 0;
+        for (int i = 0; i < seconds * 20; i++) {
+            msec += 50;
+            fusion.addVss(msec, SPEED);
+            if (i % 2 == 0) {
+                qreal noise = (i % 4 == 0) ? 0.2 : -0.2;
+                updates += fusion.addGps(msec, SPEED * truth + noise, 0.2) ? 1 : 0;
+            }
+        }
+        return updates;
+    }
+}
+
+void SpeedFusionTest::convergence() {
+    SpeedFusion fusion;
+    qint64 msec = 0;
+    QVERIFY(!fusion.isCalibrated());
+
+    QVERIFY(cruise(fusion, msec, 1.03, 10) > 0);
+    QVERIFY(qAbs(fusion.getCalibration() - 1.03) < 0.002);
+    QVERIFY(fusion.isCalibrated());
+
+    // unknown accuracy (NMEA) still counts
+    qreal stdDev = fusion.getStdDev();
+    msec += 50;
+    fusion.addVss(msec, SPEED);
+    QVERIFY(fusion.addGps(msec, SPEED * 1.03, qQNaN()));
+    QVERIFY(fusion.getStdDev() < stdDev);
+
+    // a poor fix doesn't
+    QVERIFY(!fusion.addGps(msec, SPEED * 1.03, 2.0));
+}
+
+void SpeedFusionTest::steadyOnly() {
+    // accelerating -- gps lags the VSS
+    SpeedFusion accelerating;
+    qint64 msec = 0;
+    for (int i = 0; i < 400; i++) {
+        msec += 50;
+        qreal speed = 10 + i * 0.05;
+        accelerating.addVss(msec, speed);
+        QVERIFY(!accelerating.addGps(msec, speed * 1.03, 0.2));
+    }
+    QCOMPARE(accelerating.getCalibration(), 1.0);
+
+    // too slow for the pulse rate and gps to be accurate
+    SpeedFusion slow;
+    msec = 0;
+    for (int i = 0; i < 400; i++) {
+        msec += 50;
+        slow.addVss(msec, 5);
+        QVERIFY(!slow.addGps(msec, 5 * 1.03, 0.2));
+    }
+
+    // VSS stopped reporting
+    SpeedFusion stale;
+    msec = 0;
+    cruise(stale, msec, 1.0, 2);
+    QVERIFY(!stale.addGps(msec + 2 * SpeedFusion::STEADY_MSEC, SPEED, 0.2));
+
+    // implausible factor
+    msec += 50;
+    stale.addVss(msec, SPEED);
+    QVERIFY(!stale.addGps(msec, SPEED * 2, 0.2));
+}
+
+void SpeedFusionTest::tireChange() {
+    SpeedFusion fusion;
+    qint64 msec = 0;
+    cruise(fusion, msec, 1.03, 120);
+    QVERIFY(qAbs(fusion.getCalibration() - 1.03) < 0.001);
+
+    // smaller tires -- outliers at first, then the estimate reopens
+    cruise(fusion, msec, 0.97, 30);
+    QVERIFY(qAbs(fusion.getCalibration() - 0.97) < 0.002);
+    QVERIFY(fusion.isCalibrated());
+}
+
+void SpeedFusionTest::store() {
+    SpeedFusion fusion(1.03);
+    qint64 msec = 0;
+
+    // agrees with the stored factor -- nothing to write
+    cruise(fusion, msec, 1.03, 30);
+    QVERIFY(fusion.isCalibrated());
+    QVERIFY(!fusion.takeStoreDue());
+
+    SpeedFusion learning;
+    msec = 0;
+    cruise(learning, msec, 1.03, 30);
+    QVERIFY(learning.takeStoreDue());
+    QVERIFY(!learning.takeStoreDue());
+}
@@ -0,0 +1,23 @@
+#ifndef SPEED_FUSION_TEST_H
+#define SPEED_FUSION_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <speed_fusion.h>
+
+class SpeedFusionTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void convergence();
+    void steadyOnly();
+    void tireChange();
+    void store();
+};
+
+#endif // SPEED_FUSION_TEST_H
@@ -5,6 +5,23 @@
 #include <ntc_test.h>
 #include <sensor_utils_test.h>
 #include <sensor_test.h>
+#include <sensor_log_test.h>
+#include <data_log_test.h>
+#include <artwork_cache_test.h>
+#include <needle_dynamics_test.h>
+#include <digit_readout_test.h>
+#include <config_cache_test.h>
+#include <gauge_snapshot_test.h>
+#include <sensor_filter_test.h>
+#include <channel_expression_test.h>
+#include <perf_timer_test.h>
+#include <ubx_parser_test.h>
+#include <speed_fusion_test.h>
+#include <clock_discipline_test.h>
+#include <timezone_lookup_test.h>
+#include <sensor_health_test.h>
+#include <alarm_engine_test.h>
+#include <shift_light_test.h>
 
 int main(int argc, char *argv[])
 {
@@ -19,4 +36,21 @@ int main(int argc, char *argv[])
     ASSERT_TEST(new NtcTest());
     ASSERT_TEST(new SensorUtilsTest);
     ASSERT_TEST(new SensorTest);
+    ASSERT_TEST(new SensorLogTest);
+    ASSERT_TEST(new DataLogTest);
+    ASSERT_TEST(new ArtworkCacheTest);
+    ASSERT_TEST(new NeedleDynamicsTest);
+    ASSERT_TEST(new DigitReadoutTest);
+    ASSERT_TEST(new ConfigCacheTest);
+    ASSERT_TEST(new GaugeSnapshotTest);
+    ASSERT_TEST(new SensorFilterTest);
+    ASSERT_TEST(new ChannelExpressionTest);
+    ASSERT_TEST(new PerfTimerTest);
+    ASSERT_TEST(new UbxParserTest);
+    ASSERT_TEST(new SpeedFusionTest);
+    ASSERT_TEST(new ClockDisciplineTest);
+    ASSERT_TEST(new TimeZoneLookupTest);
+    ASSERT_TEST(new SensorHealthTest);
+    ASSERT_TEST(new AlarmEngineTest);
+    ASSERT_TEST(new ShiftLightTest);
 }
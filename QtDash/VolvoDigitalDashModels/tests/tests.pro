@@ -1,4 +1,4 @@
-QT += core gui testlib
+QT += core gui quick testlib
 
 TARGET = DashUnitTests
 TEMPLATE = app
@@ -7,25 +7,80 @@ CONFIG += console
 CONFIG += c++17
 
 SOURCES += \
+    alarm_engine_test.cpp \
+    artwork_cache_test.cpp \
+    channel_expression_test.cpp \
+    clock_discipline_test.cpp \
+    config_cache_test.cpp \
     config_test.cpp \
+    data_log_test.cpp \
+    digit_readout_test.cpp \
+    gauge_snapshot_test.cpp \
     map_test.cpp \
+    needle_dynamics_test.cpp \
     ntc_test.cpp \
+    perf_timer_test.cpp \
+    sensor_filter_test.cpp \
+    sensor_health_test.cpp \
+    sensor_log_test.cpp \
     sensor_test.cpp \
     sensor_utils_test.cpp \
-    test_main.cpp
+    shift_light_test.cpp \
+    speed_fusion_test.cpp \
+    test_main.cpp \
+    timezone_lookup_test.cpp \
+    ubx_parser_test.cpp \
+    ../app/digit_readout.cpp
 
 INCLUDEPATH += \
     ../app/
 
 HEADERS += \
+    ../app/alarm_engine.h\
+    ../app/artwork_cache.h\
     ../app/map_sensor.h\
+    ../app/needle_dynamics.h\
+    ../app/channel_expression.h\
+    ../app/clock_discipline.h\
     ../app/config.h\
+    ../app/config_cache.h\
+    ../app/data_log.h\
+    ../app/data_logger.h\
+    ../app/digit_readout.h\
+    ../app/gauge_snapshot.h\
     ../app/ntc.h\
+    ../app/perf_timer.h\
     ../app/sensor.h\
+    ../app/sensor_fallback.h\
+    ../app/sensor_filter.h\
+    ../app/sensor_health.h\
+    ../app/sensor_log.h\
     ../app/sensor_source.h\
+    ../app/sensor_source_derived.h\
+    ../app/shift_light.h\
+    ../app/speed_fusion.h\
+    ../app/timezone_lookup.h\
+    ../app/ubx_parser.h\
+    alarm_engine_test.h \
+    artwork_cache_test.h \
+    channel_expression_test.h \
+    clock_discipline_test.h \
     compare_float.h \
     map_test.h \
+    needle_dynamics_test.h \
+    config_cache_test.h \
     config_test.h \
+    data_log_test.h \
+    digit_readout_test.h \
+    gauge_snapshot_test.h \
     ntc_test.h \
+    perf_timer_test.h \
+    sensor_filter_test.h \
+    sensor_health_test.h \
+    sensor_log_test.h \
     sensor_test.h \
-    sensor_utils_test.h
+    sensor_utils_test.h \
+    shift_light_test.h \
+    speed_fusion_test.h \
+    timezone_lookup_test.h \
+    ubx_parser_test.h
@@ -0,0 +1,24 @@
+#include "timezone_lookup_test.h"
+
+void TimeZoneLookupTest::towns() {
+    QCOMPARE(TimeZoneLookup::lookup(57.72, 11.86), QByteArray("Europe/Stockholm")); // Torslanda
+    QCOMPARE(TimeZoneLookup::lookup(39.60, -104.90), QByteArray("America/Denver"));
+    QCOMPARE(TimeZoneLookup::lookup(42.00, -88.00), QByteArray("America/Chicago"));
+    QCOMPARE(TimeZoneLookup::lookup(51.00, 0.50), QByteArray("Europe/London"));
+    QCOMPARE(TimeZoneLookup::lookup(-33.80, 151.00), QByteArray("Australia/Sydney"));
+}
+
+void TimeZoneLookupTest::zoneLines() {
+    QCOMPARE(TimeZoneLookup::lookup(43.58, -116.56), QByteArray("America/Boise")); // Nampa
+    QCOMPARE(TimeZoneLookup::lookup(35.15, -114.57), QByteArray("America/Phoenix")); // Bullhead City
+    QCOMPARE(TimeZoneLookup::lookup(35.00, -85.35), QByteArray("America/New_York")); // Chattanooga
+    QCOMPARE(TimeZoneLookup::lookup(30.63, -87.04), QByteArray("America/Chicago")); // Milton
+    QCOMPARE(TimeZoneLookup::lookup(36.99, -86.50), QByteArray("America/Chicago")); // Bowling Green
+}
+
+void TimeZoneLookupTest::atSea() {
+    QVERIFY(TimeZoneLookup::lookup(40.0, -40.0).isEmpty());
+    QCOMPARE(TimeZoneLookup::resolve(40.0, -40.0), QByteArray("<-03>3"));
+    QCOMPARE(TimeZoneLookup::fixedOffset(0), QByteArray("<+00>0"));
+    QCOMPARE(TimeZoneLookup::fixedOffset(100), QByteArray("<+07>-7"));
+}
@@ -0,0 +1,22 @@
+#ifndef TIMEZONE_LOOKUP_TEST_H
+#define TIMEZONE_LOOKUP_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <timezone_lookup.h>
+
+class TimeZoneLookupTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void towns();
+    void zoneLines();
+    void atSea();
+};
+
+#endif // TIMEZONE_LOOKUP_TEST_H
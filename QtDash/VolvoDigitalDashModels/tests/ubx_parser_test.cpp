@@ -0,0 +1,128 @@
+#include "ubx_parser_test.h"
+
+namespace {
+    /**
+     * @brief NAV-PVT frame: 2024-05-17 12:34:55.75 UTC, 3D fix, 60 mph east
+     * @param valid: validity flags, valid date, time and fully resolved by default
+     */
+    QByteArray navPvtFrame(char valid = 0x07) {
+        QByteArray payload(UbxParser::NAV_PVT_SIZE, 0);
+        char * p = payload.data();
+        qToLittleEndian<quint16>(2024, p + 4);
+        p[6] = 5;
+        p[7] = 17;
+        p[8] = 12;
+        p[9] = 34;
+        p[10] = 56;
+        p[11] = valid;
+        qToLittleEndian<qint32>(-250000000, p + 16);
+        p[20] = 3;
+        p[21] = 0x01;
+        p[23] = 14;
+        qToLittleEndian<qint32>(119601000, p + 24);
+        qToLittleEndian<qint32>(577815000, p + 28);
+        qToLittleEndian<qint32>(12345, p + 36);
+        qToLittleEndian<quint32>(1500, p + 40);
+        qToLittleEndian<qint32>(26822, p + 60);
+        qToLittleEndian<qint32>(9000000, p + 64);
+        qToLittleEndian<quint32>(300, p + 68);
+        return UbxParser::message(UbxParser::CLASS_NAV, UbxParser::NAV_PVT, payload);
+    }
+}
+
+void UbxParserTest::configMessages() {
+    // u-center's 10 Hz CFG-RATE
+    const char rate10Hz[] = {
+        '\xB5', '\x62', '\x06', '\x08', '\x06', '\x00', '\x64', '\x00', '\x01', '\x00', '\x01', '\x00', '\x7A', '\x12'
+    };
+    QCOMPARE(UbxParser::cfgRate(100), QByteArray(rate10Hz, sizeof(rate10Hz)));
+
+    QByteArray msg = UbxParser::cfgMsg(UbxParser::CLASS_NAV, UbxParser::NAV_PVT, 1);
+    QCOMPARE(msg.size(), UbxParser::HEADER_SIZE + 3 + UbxParser::CHECKSUM_SIZE);
+    QCOMPARE(msg.size(), 11);
+
+    // the builder's frames parse back
+    UbxParser parser;
+    QByteArray prt = UbxParser::cfgPrtUsb(UbxParser::PROTO_UBX, UbxParser::PROTO_UBX);
+    QByteArray all = msg + prt;
+    QCOMPARE(parser.parse(all.constData(), all.size(), [](const UbxParser::NavPvt_t &) {}), all.size());
+    QCOMPARE(parser.getFrames(), (quint64) 2);
+    QCOMPARE(parser.getChecksumErrors(), (quint64) 0);
+}
+
+void UbxParserTest::navPvt() {
+    QByteArray frame = navPvtFrame();
+    UbxParser parser;
+    QList<UbxParser::NavPvt_t> fixes;
+    parser.parse(frame.constData(), frame.size(), [&fixes](const UbxParser::NavPvt_t & pvt) {
+        fixes.append(pvt);
+    });
+
+    QCOMPARE(fixes.size(), 1);
+    const UbxParser::NavPvt_t & pvt = fixes.first();
+    QDateTime utc(QDate(2024, 5, 17), QTime(12, 34, 56), Qt::UTC);
+    QCOMPARE(pvt.utcNsec, utc.toMSecsSinceEpoch() * 1000000 - 250000000);
+    QCOMPARE(pvt.fixType, UbxParser::FixType::FIX_3D);
+    QVERIFY(pvt.fixOk);
+    QCOMPARE(pvt.numSatellites, 14);
+    QVERIFY(qAbs(pvt.latitude - 57.7815) < 1e-9);
+    QVERIFY(qAbs(pvt.longitude - 11.9601) < 1e-9);
+    QVERIFY(qAbs(pvt.altitude - 12.345) < 1e-9);
+    QVERIFY(qAbs(pvt.speed - 26.822) < 1e-9);
+    QVERIFY(qAbs(pvt.heading - 90.0) < 1e-9);
+    QVERIFY(qAbs(pvt.speedAccuracy - 0.3) < 1e-9);
+    QVERIFY(qAbs(pvt.horizontalAccuracy - 1.5) < 1e-9);
+}
+
+void UbxParserTest::resync() {
+    QByteArray frame = navPvtFrame();
+    QByteArray corrupt = frame;
+    corrupt[20] = corrupt[20] ^ 0x01;
+
+    // NMEA left on, a corrupt frame, then a good one
+    QByteArray data = QByteArray("$GPGGA,123456.00,,,,,0,00,99.99,,,,,,*6B\r\n") + corrupt + frame;
+
+    UbxParser parser;
+    int fixes = 0;
+    int used = parser.parse(data.constData(), data.size(), [&fixes](const UbxParser::NavPvt_t &) {
+        fixes++;
+    });
+
+    QCOMPARE(used, data.size());
+    QCOMPARE(fixes, 1);
+    QCOMPARE(parser.getChecksumErrors(), (quint64) 1);
+}
+
+void UbxParserTest::splitFrames() {
+    QByteArray stream = navPvtFrame() + navPvtFrame() + navPvtFrame();
+
+    // arrive in odd sized reads, unparsed bytes are kept
+    UbxParser parser;
+    QByteArray buffer;
+    int fixes = 0;
+    for (int pos = 0; pos < stream.size(); pos += 37) {
+        buffer.append(stream.mid(pos, 37));
+        int used = parser.parse(buffer.constData(), buffer.size(), [&fixes](const UbxParser::NavPvt_t &) {
+            fixes++;
+        });
+        buffer.remove(0, used);
+    }
+
+    QCOMPARE(fixes, 3);
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(parser.getChecksumErrors(), (quint64) 0);
+}
+
+void UbxParserTest::unresolvedTime() {
+    // valid date and time, but the leap seconds aren't known yet
+    QByteArray frame = navPvtFrame(0x03);
+    UbxParser parser;
+    QList<UbxParser::NavPvt_t> fixes;
+    parser.parse(frame.constData(), frame.size(), [&fixes](const UbxParser::NavPvt_t & pvt) {
+        fixes.append(pvt);
+    });
+
+    QCOMPARE(fixes.size(), 1);
+    QCOMPARE(fixes.first().utcNsec, (qint64) 0);
+    QCOMPARE(fixes.first().fixType, UbxParser::FixType::FIX_3D);
+}
@@ -0,0 +1,24 @@
+#ifndef UBX_PARSER_TEST_H
+#define UBX_PARSER_TEST_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <ubx_parser.h>
+
+class UbxParserTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+signals:
+
+private slots:
+    void configMessages();
+    void navPvt();
+    void resync();
+    void splitFrames();
+    void unresolvedTime();
+};
+
+#endif // UBX_PARSER_TEST_H
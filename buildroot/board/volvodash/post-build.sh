@@ -20,6 +20,26 @@ QT_FONTS_TARGET_DIR="${TARGET_DIR}/usr/lib/fonts"
 BOARD_DIR="$(dirname $0)"
 BOARD_NAME="$(basename ${BOARD_DIR})"
 
+# --fast-boot: release build of the dash, stripped and linked for fast
+# loading, and rcS starts it before the scripts it doesn't need
+FAST_BOOT="no"
+for arg in "$@"
+do
+	case "${arg}" in
+		--fast-boot)
+		FAST_BOOT="yes"
+		;;
+	esac
+done
+
+if [ "${FAST_BOOT}" = "yes" ]; then
+	QT_BUILD_CONFIG="CONFIG+=release CONFIG+=RPI"
+	QT_BUILD_LFLAGS="QMAKE_LFLAGS+=-Wl,-O1 -Wl,--hash-style=gnu -Wl,--as-needed"
+else
+	QT_BUILD_CONFIG="CONFIG+=debug CONFIG+=qml_debug CONFIG+=RPI"
+	QT_BUILD_LFLAGS=""
+fi
+
 # Add a console on tty1
 #if [ -e ${TARGET_DIR}/etc/inittab ]; then
 #    grep -qE '^tty1::' ${TARGET_DIR}/etc/inittab || \
@@ -32,7 +52,7 @@ mkdir -p "${QT_BUILD_DIR}"
 
 echo "Building Qt App (qmake + make)"
 cd "${QT_BUILD_DIR}"
-${QMAKE_CMD} ../subdirs.pro -spec devices/linux-buildroot-g++ CONFIG+=debug CONFIG+=qml_debug CONFIG+=RPI && /usr/bin/make qmake_all
+${QMAKE_CMD} ../subdirs.pro -spec devices/linux-buildroot-g++ ${QT_BUILD_CONFIG} ${QT_BUILD_LFLAGS:+"${QT_BUILD_LFLAGS}"} && /usr/bin/make qmake_all
 
 make -j
 
@@ -40,6 +60,16 @@ echo "Copying QtDash executable to /opt"
 cd "${BUILDROOT_DIR}"
 cp "${QT_EXEC_DIR}" "${QT_EXEC_TARGET_DIR}"
 
+if [ "${FAST_BOOT}" = "yes" ]; then
+	# buildroot strips the target before post-build runs, so strip the dash here
+	echo "Stripping QtDash executable"
+	STRIP_CMD="$(ls ${HOST_DIR}/bin/*-linux-*strip | head -n 1)"
+	${STRIP_CMD} --strip-unneeded "${QT_EXEC_TARGET_DIR}/VolvoDigitalDashModels"
+
+	echo "Enabling fast boot"
+	sed -i 's/^FAST_BOOT=.*/FAST_BOOT=yes/' "${TARGET_DIR}/etc/sysconfig/boot"
+fi
+
 echo "Copy custom config.txt"
 cp "${BOARD_DIR}/config.txt" "${BINARIES_DIR}/rpi-firmware"
 
@@ -12,6 +12,7 @@
 #include <linux/timer.h>
 #include <linux/jiffies.h>
 #include <linux/math64.h>
+#include <linux/spinlock.h>
 
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("whitfijs");
@@ -23,6 +24,7 @@ MODULE_AUTHOR("whitfijs");
 
 #define PULSE_SPACING_NUM_SAMPLES           4
 #define MAX_PULSE_SPACING_NUM_SAMPLES		32
+#define PULSE_EDGE_NUM_SAMPLES				64		// power of 2
 
 #define PULSE_SPACING_TIMEOUT_MSEC			200
 #define PULSE_SPACING_MIN_DEFAULT_USEC 		2500		
@@ -48,6 +50,12 @@ typedef struct {
 
 	 ktime_t last;
 	 int last_interrupt;
+
+	 // timestamps of the latest pulses, for timing between polls
+	 __u32 edge_count[PULSE_EDGE_NUM_SAMPLES];
+	 __u64 edge_nsec[PULSE_EDGE_NUM_SAMPLES];
+	 __u32 edge_index;
+	 spinlock_t edge_lock;
 	
 	struct timer_list timeout_timer;
 } pulse_counter_t;
@@ -63,6 +71,10 @@ void init_pulse_counter(pulse_counter_t * counter, int num_avg_samples, int spac
 	counter->spacing_avg = 0;
 	counter->spacing_avg_num_samples = num_avg_samples;
 	counter->spacing_min = spacing_min;
+	counter->edge_index = 0;
+	memset(counter->edge_count, 0, sizeof(counter->edge_count));
+	memset(counter->edge_nsec, 0, sizeof(counter->edge_nsec));
+	spin_lock_init(&counter->edge_lock);
 }
 
 pulse_counter_t * get_counter_from_device(struct device * dev) {
@@ -140,6 +152,13 @@ static irqreturn_t pulse_irq_handler(__u32 irq, void * dev_id, struct pt_regs *
 		}
 
 		counter->last = now;
+
+		// keep the pulse's timestamp
+		spin_lock(&counter->edge_lock);
+		counter->edge_count[counter->edge_index] = counter->count_total;
+		counter->edge_nsec[counter->edge_index] = now_nsec;
+		counter->edge_index = (counter->edge_index + 1) & (PULSE_EDGE_NUM_SAMPLES - 1);
+		spin_unlock(&counter->edge_lock);
 	}	
 
 	restart_timeout_timer(&counter->timeout_timer, PULSE_SPACING_TIMEOUT_MSEC);
@@ -258,10 +277,40 @@ static ssize_t show_avg_num_samples_callback(struct device * dev, struct device_
 	return 0;
 }
 
+static ssize_t show_pulse_edges_callback(struct device * dev, struct device_attribute * attr, char * buf) {
+	pulse_counter_t * counter = get_counter_from_device(dev);
+	__u32 count[PULSE_EDGE_NUM_SAMPLES];
+	__u64 nsec[PULSE_EDGE_NUM_SAMPLES];
+	__u32 index;
+	unsigned long flags;
+	ssize_t len = 0;
+
+	if (counter == NULL) {
+		return 0;
+	}
+
+	spin_lock_irqsave(&counter->edge_lock, flags);
+	memcpy(count, counter->edge_count, sizeof(count));
+	memcpy(nsec, counter->edge_nsec, sizeof(nsec));
+	index = counter->edge_index;
+	spin_unlock_irqrestore(&counter->edge_lock, flags);
+
+	// "count nsec" per pulse, oldest first -- nsec is CLOCK_MONOTONIC
+	for (int i = 0; i < PULSE_EDGE_NUM_SAMPLES; i++) {
+		__u32 n = (index + i) & (PULSE_EDGE_NUM_SAMPLES - 1);
+		if (nsec[n] != 0) {
+			len += scnprintf(buf + len, PAGE_SIZE - len, "%u %llu\n", count[n], nsec[n]);
+		}
+	}
+
+	return len;
+}
+
 static DEVICE_ATTR(pulse_count, 00664, show_pulse_count_callback, set_pulse_count_callback);
 static DEVICE_ATTR(pulse_spacing_avg, 00664, show_pulse_spacing_avg_callback, set_pulse_spacing_avg_callback);
 static DEVICE_ATTR(pulse_spacing_min, 00664, show_min_pulse_spacing_callback, set_min_pulse_spacing_callback);
 static DEVICE_ATTR(pulse_spacing_avg_num_samples, 00664, show_avg_num_samples_callback, set_avg_num_samples_callback);
+static DEVICE_ATTR(pulse_edges, 00444, show_pulse_edges_callback, NULL);
 
 static int __init pulseCounterModule_init(void){
 	int result;
@@ -281,6 +330,7 @@ static int __init pulseCounterModule_init(void){
 	result = device_create_file(s_pTachDeviceObject, &dev_attr_pulse_spacing_avg);
 	result = device_create_file(s_pTachDeviceObject, &dev_attr_pulse_spacing_min);
 	result = device_create_file(s_pTachDeviceObject, &dev_attr_pulse_spacing_avg_num_samples);
+	result = device_create_file(s_pTachDeviceObject, &dev_attr_pulse_edges);
 	tach_pulse_counter.dev = s_pTachDeviceObject;
 
 	// create vss pulse counting attribute
@@ -291,6 +341,7 @@ static int __init pulseCounterModule_init(void){
 	result = device_create_file(s_pVssDeviceObject, &dev_attr_pulse_spacing_avg);
 	result = device_create_file(s_pVssDeviceObject, &dev_attr_pulse_spacing_min);
 	result = device_create_file(s_pVssDeviceObject, &dev_attr_pulse_spacing_avg_num_samples);
+	result = device_create_file(s_pVssDeviceObject, &dev_attr_pulse_edges);
 	vss_pulse_counter.dev = s_pVssDeviceObject;
 
 	// Request GPIOS
@@ -353,11 +404,13 @@ static void __exit pulseCounterModule_exit(void) {
 	device_remove_file(s_pTachDeviceObject, &dev_attr_pulse_spacing_avg);
 	device_remove_file(s_pTachDeviceObject, &dev_attr_pulse_spacing_min);
 	device_remove_file(s_pTachDeviceObject, &dev_attr_pulse_spacing_avg_num_samples);
+	device_remove_file(s_pTachDeviceObject, &dev_attr_pulse_edges);
 
 	device_remove_file(s_pVssDeviceObject, &dev_attr_pulse_count);
 	device_remove_file(s_pVssDeviceObject, &dev_attr_pulse_spacing_avg);
 	device_remove_file(s_pVssDeviceObject, &dev_attr_pulse_spacing_min);
 	device_remove_file(s_pVssDeviceObject, &dev_attr_pulse_spacing_avg_num_samples);
+	device_remove_file(s_pVssDeviceObject, &dev_attr_pulse_edges);
 
 	device_destroy(s_pDeviceClass, 0);
 	class_destroy(s_pDeviceClass);